@@ -0,0 +1,535 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AudioCommon/AudioDumpEncoder.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "Common/Assert.h"
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+
+namespace AudioCommon
+{
+AudioDumpEncoder::~AudioDumpEncoder() = default;
+
+namespace
+{
+// ---------------------------------------------------------------------------------
+// WAV: uncompressed 16-bit stereo PCM
+// ---------------------------------------------------------------------------------
+class WavEncoder final : public AudioDumpEncoder
+{
+public:
+  bool Start(File::IOFile& file, u32 sample_rate) override
+  {
+    m_audio_size = 0;
+
+    Write4(file, "RIFF");
+    Write(file, 100 * 1000 * 1000);  // write big value in case the file gets truncated
+    Write4(file, "WAVE");
+    Write4(file, "fmt ");
+
+    Write(file, 16);          // size of fmt block
+    Write(file, 0x00020001);  // two channels, uncompressed
+
+    Write(file, sample_rate);
+    Write(file, sample_rate * 2 * 2);  // two channels, 16bit
+
+    Write(file, 0x00100004);
+    Write4(file, "data");
+    Write(file, 100 * 1000 * 1000 - 32);
+
+    // We are now at offset 44
+    return file.Tell() == 44;
+  }
+
+  void Encode(File::IOFile& file, const s16* samples, u32 frame_count) override
+  {
+    file.WriteArray(samples, frame_count * 2);
+    m_audio_size += frame_count * 4;
+  }
+
+  void Finish(File::IOFile& file) override
+  {
+    file.Seek(4, File::SeekOrigin::Begin);
+    Write(file, m_audio_size + 36);
+
+    file.Seek(40, File::SeekOrigin::Begin);
+    Write(file, m_audio_size);
+  }
+
+private:
+  static void Write(File::IOFile& file, u32 value) { file.WriteArray(&value, 1); }
+  static void Write4(File::IOFile& file, const char* ptr) { file.WriteBytes(ptr, 4); }
+
+  u32 m_audio_size = 0;
+};
+
+// ---------------------------------------------------------------------------------
+// FLAC: lossless, using the fixed predictors and Rice coded residuals
+// ---------------------------------------------------------------------------------
+constexpr u32 FLAC_BLOCK_SIZE = 4096;
+constexpr u32 FLAC_MAX_FIXED_ORDER = 4;
+constexpr u32 FLAC_MAX_PARTITION_ORDER = 6;
+constexpr u32 FLAC_MAX_RICE_PARAMETER = 14;
+constexpr u32 FLAC_STREAMINFO_SIZE = 4 + 4 + 34;
+
+class BitWriter
+{
+public:
+  void Write(u32 value, u32 bits)
+  {
+    if (bits == 0)
+      return;
+    m_buffer = (m_buffer << bits) | (value & (u64{0xFFFFFFFF} >> (32 - bits)));
+    m_bit_count += bits;
+    while (m_bit_count >= 8)
+    {
+      m_bit_count -= 8;
+      m_bytes.push_back(static_cast<u8>(m_buffer >> m_bit_count));
+    }
+  }
+
+  void WriteSigned(s32 value, u32 bits) { Write(static_cast<u32>(value), bits); }
+
+  // <value> zero bits, followed by a one bit.
+  void WriteUnary(u32 value)
+  {
+    for (; value >= 32; value -= 32)
+      Write(0, 32);
+    Write(1, value + 1);
+  }
+
+  void WriteRice(u32 value, u32 parameter)
+  {
+    WriteUnary(value >> parameter);
+    Write(value, parameter);
+  }
+
+  void AlignToByte()
+  {
+    if (m_bit_count != 0)
+      Write(0, 8 - m_bit_count);
+  }
+
+  const std::vector<u8>& GetBytes() const { return m_bytes; }
+
+private:
+  std::vector<u8> m_bytes;
+  u64 m_buffer = 0;
+  u32 m_bit_count = 0;
+};
+
+u8 CRC8(const std::vector<u8>& data)
+{
+  u8 crc = 0;
+  for (const u8 byte : data)
+  {
+    crc ^= byte;
+    for (int i = 0; i < 8; ++i)
+      crc = static_cast<u8>(crc & 0x80 ? (crc << 1) ^ 0x07 : crc << 1);
+  }
+  return crc;
+}
+
+u16 CRC16(const std::vector<u8>& data)
+{
+  u16 crc = 0;
+  for (const u8 byte : data)
+  {
+    crc ^= byte << 8;
+    for (int i = 0; i < 8; ++i)
+      crc = static_cast<u16>(crc & 0x8000 ? (crc << 1) ^ 0x8005 : crc << 1);
+  }
+  return crc;
+}
+
+u32 ZigZag(s32 value)
+{
+  return (static_cast<u32>(value) << 1) ^ static_cast<u32>(value >> 31);
+}
+
+s32 FixedResidual(const s32* x, u32 i, u32 order)
+{
+  switch (order)
+  {
+  case 0:
+    return x[i];
+  case 1:
+    return x[i] - x[i - 1];
+  case 2:
+    return x[i] - 2 * x[i - 1] + x[i - 2];
+  case 3:
+    return x[i] - 3 * x[i - 1] + 3 * x[i - 2] - x[i - 3];
+  default:
+    return x[i] - 4 * x[i - 1] + 6 * x[i - 2] - 4 * x[i - 3] + x[i - 4];
+  }
+}
+
+// Returns an estimate of the size of a Rice coded partition, and the parameter to use for it.
+std::pair<u64, u32> EstimateRicePartition(u64 sum, u32 count)
+{
+  u64 best_bits = std::numeric_limits<u64>::max();
+  u32 best_parameter = 0;
+  for (u32 parameter = 0; parameter <= FLAC_MAX_RICE_PARAMETER; ++parameter)
+  {
+    const u64 bits = 4 + u64{count} * (parameter + 1) + (sum >> parameter);
+    if (bits < best_bits)
+    {
+      best_bits = bits;
+      best_parameter = parameter;
+    }
+  }
+  return {best_bits, best_parameter};
+}
+
+struct SubframePlan
+{
+  enum class Type
+  {
+    Constant,
+    Verbatim,
+    Fixed,
+  };
+
+  Type type = Type::Verbatim;
+  u32 order = 0;
+  u32 partition_order = 0;
+  std::array<u32, 1 << FLAC_MAX_PARTITION_ORDER> rice_parameters{};
+  u64 bits = 0;
+};
+
+SubframePlan PlanSubframe(const s32* x, u32 count, u32 bps)
+{
+  SubframePlan plan;
+  plan.bits = 8 + u64{count} * bps;
+
+  if (std::all_of(x, x + count, [x](s32 sample) { return sample == x[0]; }))
+  {
+    plan.type = SubframePlan::Type::Constant;
+    plan.bits = 8 + bps;
+    return plan;
+  }
+
+  std::array<u64, 1 << FLAC_MAX_PARTITION_ORDER> sums;
+  for (u32 order = 0; order <= FLAC_MAX_FIXED_ORDER && order < count; ++order)
+  {
+    // Partitions have to split the block evenly, and the first one holds the warm-up samples.
+    u32 max_partition_order = 0;
+    while (max_partition_order < FLAC_MAX_PARTITION_ORDER &&
+           count % (2u << max_partition_order) == 0 &&
+           (count >> (max_partition_order + 1)) > order)
+    {
+      ++max_partition_order;
+    }
+
+    const u32 partitions = 1u << max_partition_order;
+    const u32 partition_size = count >> max_partition_order;
+    for (u32 p = 0; p < partitions; ++p)
+    {
+      u64 sum = 0;
+      for (u32 i = std::max(p * partition_size, order); i < (p + 1) * partition_size; ++i)
+        sum += ZigZag(FixedResidual(x, i, order));
+      sums[p] = sum;
+    }
+
+    for (u32 partition_order = max_partition_order;; --partition_order)
+    {
+      const u32 size = count >> partition_order;
+      u64 bits = 8 + u64{order} * bps + 2 + 4;
+      std::array<u32, 1 << FLAC_MAX_PARTITION_ORDER> parameters;
+      for (u32 p = 0; p < (1u << partition_order); ++p)
+      {
+        const auto [partition_bits, parameter] =
+            EstimateRicePartition(sums[p], p == 0 ? size - order : size);
+        bits += partition_bits;
+        parameters[p] = parameter;
+      }
+
+      if (bits < plan.bits)
+      {
+        plan.type = SubframePlan::Type::Fixed;
+        plan.order = order;
+        plan.partition_order = partition_order;
+        plan.rice_parameters = parameters;
+        plan.bits = bits;
+      }
+
+      if (partition_order == 0)
+        break;
+
+      // Merge neighbouring partitions for the next lower order.
+      for (u32 p = 0; p < (1u << (partition_order - 1)); ++p)
+        sums[p] = sums[p * 2] + sums[p * 2 + 1];
+    }
+  }
+
+  return plan;
+}
+
+void WriteSubframe(BitWriter& writer, const SubframePlan& plan, const s32* x, u32 count, u32 bps)
+{
+  switch (plan.type)
+  {
+  case SubframePlan::Type::Constant:
+    writer.Write(0b00000000, 8);
+    writer.WriteSigned(x[0], bps);
+    break;
+  case SubframePlan::Type::Verbatim:
+    writer.Write(0b00000010, 8);
+    for (u32 i = 0; i < count; ++i)
+      writer.WriteSigned(x[i], bps);
+    break;
+  case SubframePlan::Type::Fixed:
+  {
+    writer.Write((0b001000 | plan.order) << 1, 8);
+    for (u32 i = 0; i < plan.order; ++i)
+      writer.WriteSigned(x[i], bps);
+
+    // Rice coding with 4-bit parameters.
+    writer.Write(0b00, 2);
+    writer.Write(plan.partition_order, 4);
+    const u32 partition_size = count >> plan.partition_order;
+    for (u32 p = 0; p < (1u << plan.partition_order); ++p)
+    {
+      const u32 parameter = plan.rice_parameters[p];
+      writer.Write(parameter, 4);
+      for (u32 i = std::max(p * partition_size, plan.order); i < (p + 1) * partition_size; ++i)
+        writer.WriteRice(ZigZag(FixedResidual(x, i, plan.order)), parameter);
+    }
+    break;
+  }
+  }
+}
+
+// Writes a number in the UTF-8 like encoding used for frame numbers.
+void WriteFrameNumber(BitWriter& writer, u32 number)
+{
+  if (number < 0x80)
+  {
+    writer.Write(number, 8);
+    return;
+  }
+
+  u32 continuation_bytes = 1;
+  while (continuation_bytes < 5 && number >= (1u << (6 + 5 * continuation_bytes)))
+    ++continuation_bytes;
+
+  const u32 lead_marker = (0xFF00 >> (continuation_bytes + 1)) & 0xFF;
+  writer.Write(lead_marker | (number >> (6 * continuation_bytes)), 8);
+  for (u32 i = continuation_bytes; i-- > 0;)
+    writer.Write(0x80 | ((number >> (6 * i)) & 0x3F), 8);
+}
+
+class FlacEncoder final : public AudioDumpEncoder
+{
+public:
+  bool Start(File::IOFile& file, u32 sample_rate) override
+  {
+    m_sample_rate = sample_rate;
+    m_total_frames = 0;
+    m_frame_number = 0;
+    m_min_frame_size = 0;
+    m_max_frame_size = 0;
+    m_left.clear();
+    m_right.clear();
+    return WriteStreamInfo(file);
+  }
+
+  void Encode(File::IOFile& file, const s16* samples, u32 frame_count) override
+  {
+    for (u32 i = 0; i < frame_count; ++i)
+    {
+      m_left.push_back(samples[i * 2]);
+      m_right.push_back(samples[i * 2 + 1]);
+      if (m_left.size() == FLAC_BLOCK_SIZE)
+        WriteBlock(file);
+    }
+  }
+
+  void Finish(File::IOFile& file) override
+  {
+    if (!m_left.empty())
+      WriteBlock(file);
+
+    file.Seek(0, File::SeekOrigin::Begin);
+    WriteStreamInfo(file);
+    file.Seek(0, File::SeekOrigin::End);
+  }
+
+private:
+  bool WriteStreamInfo(File::IOFile& file)
+  {
+    BitWriter writer;
+    for (const char c : {'f', 'L', 'a', 'C'})
+      writer.Write(c, 8);
+
+    // Metadata block header: last block, STREAMINFO, length
+    writer.Write(0x80, 8);
+    writer.Write(34, 24);
+
+    writer.Write(FLAC_BLOCK_SIZE, 16);  // minimum block size
+    writer.Write(FLAC_BLOCK_SIZE, 16);  // maximum block size
+    writer.Write(m_min_frame_size, 24);
+    writer.Write(m_max_frame_size, 24);
+    writer.Write(m_sample_rate, 20);
+    writer.Write(2 - 1, 3);   // channels
+    writer.Write(16 - 1, 5);  // bits per sample
+    writer.Write(static_cast<u32>(m_total_frames >> 32), 4);
+    writer.Write(static_cast<u32>(m_total_frames), 32);
+    for (int i = 0; i < 4; ++i)
+      writer.Write(0, 32);  // no MD5 signature
+
+    DEBUG_ASSERT(writer.GetBytes().size() == FLAC_STREAMINFO_SIZE);
+    return file.WriteBytes(writer.GetBytes().data(), writer.GetBytes().size());
+  }
+
+  u32 GetSampleRateCode(BitWriter* extra_bits) const
+  {
+    static constexpr std::array<std::pair<u32, u32>, 11> codes = {{{88200, 1},
+                                                                   {176400, 2},
+                                                                   {192000, 3},
+                                                                   {8000, 4},
+                                                                   {16000, 5},
+                                                                   {22050, 6},
+                                                                   {24000, 7},
+                                                                   {32000, 8},
+                                                                   {44100, 9},
+                                                                   {48000, 10},
+                                                                   {96000, 11}}};
+    for (const auto& [rate, code] : codes)
+    {
+      if (rate == m_sample_rate)
+        return code;
+    }
+
+    if (m_sample_rate % 1000 == 0 && m_sample_rate / 1000 <= 0xFF)
+    {
+      extra_bits->Write(m_sample_rate / 1000, 8);
+      return 12;
+    }
+    if (m_sample_rate <= 0xFFFF)
+    {
+      extra_bits->Write(m_sample_rate, 16);
+      return 13;
+    }
+    if (m_sample_rate % 10 == 0 && m_sample_rate / 10 <= 0xFFFF)
+    {
+      extra_bits->Write(m_sample_rate / 10, 16);
+      return 14;
+    }
+    return 0;  // Only in STREAMINFO
+  }
+
+  void WriteBlock(File::IOFile& file)
+  {
+    const u32 count = static_cast<u32>(m_left.size());
+
+    // Try the four ways FLAC can store two channels, and keep the smallest.
+    m_side.resize(count);
+    m_mid.resize(count);
+    for (u32 i = 0; i < count; ++i)
+    {
+      m_side[i] = m_left[i] - m_right[i];
+      m_mid[i] = (m_left[i] + m_right[i]) >> 1;
+    }
+
+    const SubframePlan left = PlanSubframe(m_left.data(), count, 16);
+    const SubframePlan right = PlanSubframe(m_right.data(), count, 16);
+    const SubframePlan side = PlanSubframe(m_side.data(), count, 17);
+    const SubframePlan mid = PlanSubframe(m_mid.data(), count, 16);
+
+    struct Assignment
+    {
+      u32 code;
+      const SubframePlan* plans[2];
+      const s32* samples[2];
+      u32 bps[2];
+    };
+    const std::array<Assignment, 4> assignments = {{
+        {0b0001, {&left, &right}, {m_left.data(), m_right.data()}, {16, 16}},
+        {0b1000, {&left, &side}, {m_left.data(), m_side.data()}, {16, 17}},
+        {0b1001, {&side, &right}, {m_side.data(), m_right.data()}, {17, 16}},
+        {0b1010, {&mid, &side}, {m_mid.data(), m_side.data()}, {16, 17}},
+    }};
+    const Assignment& best = *std::min_element(
+        assignments.begin(), assignments.end(), [](const Assignment& a, const Assignment& b) {
+          return a.plans[0]->bits + a.plans[1]->bits < b.plans[0]->bits + b.plans[1]->bits;
+        });
+
+    BitWriter writer;
+    BitWriter sample_rate_bits;
+    const u32 sample_rate_code = GetSampleRateCode(&sample_rate_bits);
+
+    writer.Write(0xFFF8, 16);  // sync code, fixed block size
+    writer.Write(0b0111, 4);   // block size - 1 follows as 16 bits
+    writer.Write(sample_rate_code, 4);
+    writer.Write(best.code, 4);
+    writer.Write(0b100, 3);  // 16 bits per sample
+    writer.Write(0, 1);
+    WriteFrameNumber(writer, m_frame_number++);
+    writer.Write(count - 1, 16);
+    for (const u8 byte : sample_rate_bits.GetBytes())
+      writer.Write(byte, 8);
+    writer.Write(CRC8(writer.GetBytes()), 8);
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+      WriteSubframe(writer, *best.plans[channel], best.samples[channel], count,
+                    best.bps[channel]);
+    }
+    writer.AlignToByte();
+    writer.Write(CRC16(writer.GetBytes()), 16);
+
+    const std::vector<u8>& bytes = writer.GetBytes();
+    file.WriteBytes(bytes.data(), bytes.size());
+
+    const u32 frame_size = static_cast<u32>(bytes.size());
+    m_min_frame_size = m_min_frame_size == 0 ? frame_size : std::min(m_min_frame_size, frame_size);
+    m_max_frame_size = std::max(m_max_frame_size, frame_size);
+    m_total_frames += count;
+    m_left.clear();
+    m_right.clear();
+  }
+
+  u32 m_sample_rate = 0;
+  u64 m_total_frames = 0;
+  u32 m_frame_number = 0;
+  u32 m_min_frame_size = 0;
+  u32 m_max_frame_size = 0;
+  std::vector<s32> m_left;
+  std::vector<s32> m_right;
+  std::vector<s32> m_side;
+  std::vector<s32> m_mid;
+};
+}  // namespace
+
+std::unique_ptr<AudioDumpEncoder> CreateAudioDumpEncoder(AudioDumpFormat format)
+{
+  switch (format)
+  {
+  case AudioDumpFormat::FLAC:
+    return std::make_unique<FlacEncoder>();
+  case AudioDumpFormat::WAV:
+  default:
+    return std::make_unique<WavEncoder>();
+  }
+}
+
+std::string_view GetAudioDumpFileExtension(AudioDumpFormat format)
+{
+  switch (format)
+  {
+  case AudioDumpFormat::FLAC:
+    return "flac";
+  case AudioDumpFormat::WAV:
+  default:
+    return "wav";
+  }
+}
+}  // namespace AudioCommon
@@ -0,0 +1,36 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+
+#include "AudioCommon/Enums.h"
+#include "Common/CommonTypes.h"
+
+namespace File
+{
+class IOFile;
+}
+
+namespace AudioCommon
+{
+// Turns a 16-bit stereo stream into a file of some format. The encoders don't own the file, and
+// only write to it from within these calls.
+class AudioDumpEncoder
+{
+public:
+  virtual ~AudioDumpEncoder();
+
+  // Writes the file header. The file is empty when this is called.
+  virtual bool Start(File::IOFile& file, u32 sample_rate) = 0;
+  // Encodes interleaved left/right samples. Encoders may buffer frames until Finish is called.
+  virtual void Encode(File::IOFile& file, const s16* samples, u32 frame_count) = 0;
+  // Writes any buffered frames and fixes up the header.
+  virtual void Finish(File::IOFile& file) = 0;
+};
+
+std::unique_ptr<AudioDumpEncoder> CreateAudioDumpEncoder(AudioDumpFormat format);
+std::string_view GetAudioDumpFileExtension(AudioDumpFormat format);
+}  // namespace AudioCommon
@@ -0,0 +1,82 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AudioCommon/LatencyController.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace AudioCommon
+{
+namespace
+{
+// How many times the measured jitter is added to the target.
+constexpr int JITTER_MARGIN = 3;
+// Gaps between callbacks longer than this come from pausing, not from jitter.
+constexpr DT MAX_CALLBACK_GAP = std::chrono::milliseconds(500);
+constexpr DT JITTER_HALF_LIFE = std::chrono::seconds(5);
+constexpr DT HEADROOM_HALF_LIFE = std::chrono::seconds(5);
+
+DT Decay(DT value, DT elapsed, DT half_life)
+{
+  const double factor = std::exp2(-DT_s(elapsed).count() / DT_s(half_life).count());
+  return std::chrono::duration_cast<DT>(value * factor);
+}
+}  // namespace
+
+LatencyController::LatencyController(unsigned int sample_rate) : m_sample_rate(sample_rate)
+{
+  Reset();
+}
+
+void LatencyController::Reset()
+{
+  m_has_last_callback = false;
+  m_was_playing = false;
+  m_jitter = DT::zero();
+  // Start out conservatively, and shrink the buffer once the callbacks turn out to be stable.
+  m_headroom = MAX_LATENCY;
+  m_target = MAX_LATENCY;
+  m_underrun_count = 0;
+}
+
+bool LatencyController::Update(TimePoint now, u32 requested_frames, u32 mixed_frames)
+{
+  const DT period = std::chrono::duration_cast<DT>(
+      DT_s(static_cast<double>(requested_frames) / m_sample_rate));
+
+  if (m_has_last_callback)
+  {
+    const DT elapsed = now - m_last_callback;
+    if (elapsed < MAX_CALLBACK_GAP)
+    {
+      const DT deviation =
+          elapsed > m_last_period ? elapsed - m_last_period : m_last_period - elapsed;
+      m_jitter = std::max(deviation, Decay(m_jitter, elapsed, JITTER_HALF_LIFE));
+      m_headroom = Decay(m_headroom, elapsed, HEADROOM_HALF_LIFE);
+    }
+  }
+  m_has_last_callback = true;
+  m_last_callback = now;
+  m_last_period = period;
+
+  // Only count running dry after the fifo could keep up, so that silence (for example while
+  // emulation is paused) isn't reported as a continuous stream of underruns.
+  const bool underrun = m_was_playing && mixed_frames < requested_frames;
+  m_was_playing = mixed_frames >= requested_frames;
+  if (underrun)
+  {
+    ++m_underrun_count;
+    m_headroom += std::max(period, MIN_LATENCY);
+  }
+
+  m_target = std::clamp(period + JITTER_MARGIN * m_jitter + m_headroom, MIN_LATENCY, MAX_LATENCY);
+  return underrun;
+}
+
+int LatencyController::GetTargetLatencyMs() const
+{
+  return static_cast<int>(std::ceil(DT_ms(m_target).count()));
+}
+}  // namespace AudioCommon
@@ -0,0 +1,48 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace AudioCommon
+{
+// Picks how much audio the mixer fifos should keep buffered, based on how regularly the backend
+// asks for samples and on whether it has run out of samples recently.
+//
+// The target starts out at the length of a backend callback plus a margin for the measured
+// callback jitter. Every underrun adds headroom on top of that, which decays again while the
+// output is stable, so the buffer converges to the smallest size that doesn't underrun.
+class LatencyController
+{
+public:
+  explicit LatencyController(unsigned int sample_rate);
+
+  // Called once per backend callback, with the number of frames the backend asked for and the
+  // number of frames the fifo could actually provide. Returns true if this was an underrun.
+  bool Update(TimePoint now, u32 requested_frames, u32 mixed_frames);
+
+  void Reset();
+
+  DT GetTargetLatency() const { return m_target; }
+  int GetTargetLatencyMs() const;
+  DT GetJitter() const { return m_jitter; }
+  u64 GetUnderrunCount() const { return m_underrun_count; }
+
+  static constexpr DT MIN_LATENCY = std::chrono::milliseconds(5);
+  static constexpr DT MAX_LATENCY = std::chrono::milliseconds(80);
+
+private:
+  unsigned int m_sample_rate;
+
+  bool m_has_last_callback = false;
+  TimePoint m_last_callback{};
+  DT m_last_period{};
+  bool m_was_playing = false;
+
+  DT m_jitter{};
+  DT m_headroom{};
+  DT m_target = MAX_LATENCY;
+  u64 m_underrun_count = 0;
+};
+}  // namespace AudioCommon
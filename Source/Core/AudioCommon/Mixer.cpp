@@ -8,9 +8,11 @@
 #include <cstring>
 
 #include "AudioCommon/Enums.h"
+#include "AudioCommon/Resampler.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/MsgHandler.h"
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
@@ -34,7 +36,8 @@ static u32 DPL2QualityToFrameBlockSize(AudioCommon::DPL2Quality quality)
 Mixer::Mixer(unsigned int BackendSampleRate)
     : m_sampleRate(BackendSampleRate), m_stretcher(BackendSampleRate),
       m_surround_decoder(BackendSampleRate,
-                         DPL2QualityToFrameBlockSize(Config::Get(Config::MAIN_DPL2_QUALITY)))
+                         DPL2QualityToFrameBlockSize(Config::Get(Config::MAIN_DPL2_QUALITY))),
+      m_latency_controller(BackendSampleRate)
 {
   m_config_changed_callback_id = Config::AddConfigChangedCallback([this] { RefreshConfig(); });
   RefreshConfig();
@@ -71,8 +74,8 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   // so we will just ignore new written data while interpolating.
   // Without this cache, the compiler wouldn't be allowed to optimize the
   // interpolation loop.
-  u32 indexR = m_indexR.load();
-  u32 indexW = m_indexW.load();
+  u32 indexR = m_indexR.load(std::memory_order_relaxed);
+  u32 indexW = m_indexW.load(std::memory_order_acquire);
 
   // render numleft sample pairs to samples[]
   // advance indexR with sample position
@@ -107,29 +110,32 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
     return m_little_endian ? m_buffer[index] : Common::swap16(m_buffer[index]);
   };
 
-  // TODO: consider a higher-quality resampling algorithm.
-  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
+  // Copy the frames that are going to be read out of the ring buffer, swapping the channels to
+  // the output order (right, left), so that the whole block can be resampled at once.
+  const u32 available_frames = ((indexW - indexR) & INDEX_MASK) / 2;
+  const u32 count =
+      AudioCommon::GetResampleOutputCount(available_frames, m_frac, ratio, numSamples);
+  if (count != 0)
   {
-    u32 indexR2 = indexR + 2;  // next sample
-
-    s16 l1 = read_buffer(indexR & INDEX_MASK);   // current
-    s16 l2 = read_buffer(indexR2 & INDEX_MASK);  // next
-    int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
-    sampleL = (sampleL * lvolume) >> 8;
-    sampleL += samples[currentSample + 1];
-    samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
-
-    s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);   // current
-    s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);  // next
-    int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
-    sampleR = (sampleR * rvolume) >> 8;
-    sampleR += samples[currentSample];
-    samples[currentSample] = std::clamp(sampleR, -32767, 32767);
-
-    m_frac += ratio;
-    indexR += 2 * (u16)(m_frac >> 16);
-    m_frac &= 0xffff;
+    const u64 last_pos = m_frac + static_cast<u64>(count - 1) * ratio;
+    const u32 input_frames = static_cast<u32>(last_pos >> 16) + 2;
+    s16* frames = m_mixer->m_resample_buffer.data();
+    for (u32 i = 0; i < input_frames; ++i)
+    {
+      const u32 index = indexR + i * 2;
+      frames[i * 2] = read_buffer((index + 1) & INDEX_MASK);
+      frames[i * 2 + 1] = read_buffer(index & INDEX_MASK);
+    }
+
+    // TODO: consider a higher-quality resampling algorithm.
+    AudioCommon::ResampleAndMix(samples, frames, count, m_frac, ratio, rvolume, lvolume);
+
+    // Never move past the write index, even if the ratio skips over more than one frame.
+    const u64 end_pos = m_frac + static_cast<u64>(count) * ratio;
+    indexR += 2 * static_cast<u32>(std::min<u64>(end_pos >> 16, available_frames));
+    m_frac = static_cast<u32>(end_pos & 0xFFFF);
   }
+  currentSample = count * 2;
 
   // Actual number of samples written to the buffer without padding.
   unsigned int actual_sample_count = currentSample / 2;
@@ -150,7 +156,7 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   }
 
   // Flush cached variable
-  m_indexR.store(indexR);
+  m_indexR.store(indexR, std::memory_order_release);
 
   return actual_sample_count;
 }
@@ -165,7 +171,9 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   // TODO: Determine how emulation speed will be used in audio
   // const float emulation_speed = g_perf_metrics.GetSpeed();
   const float emulation_speed = m_config_emulation_speed;
-  const int timing_variance = m_config_timing_variance;
+  const int timing_variance = m_config_adaptive_latency && !m_config_audio_stretch ?
+                                  m_latency_controller.GetTargetLatencyMs() :
+                                  m_config_timing_variance;
   if (m_config_audio_stretch)
   {
     unsigned int available_samples =
@@ -202,7 +210,18 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   }
   else
   {
-    m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+    const TimePoint now = Clock::now();
+
+    // Samples that are pushed now have to wait for everything in the DMA fifo, as well as for
+    // the samples of this callback, to be played.
+    g_perf_metrics.SetAudioLatency(std::chrono::duration_cast<DT>(
+        DT_s(static_cast<double>(m_dma_mixer.AvailableSamples() + num_samples) / m_sampleRate)));
+
+    const unsigned int dma_samples =
+        m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+    if (m_latency_controller.Update(now, num_samples, dma_samples))
+      g_perf_metrics.CountAudioUnderrun();
+
     m_streaming_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     m_wiimote_speaker_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     m_skylander_portal_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
@@ -248,11 +267,12 @@ void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_sample
   // Cache access in non-volatile variable
   // indexR isn't allowed to cache in the audio throttling loop as it
   // needs to get updates to not deadlock.
-  u32 indexW = m_indexW.load();
+  u32 indexW = m_indexW.load(std::memory_order_relaxed);
 
   // Check if we have enough free space
   // indexW == m_indexR results in empty buffer, so indexR must always be smaller than indexW
-  if (num_samples * 2 + ((indexW - m_indexR.load()) & INDEX_MASK) >= MAX_SAMPLES * 2)
+  if (num_samples * 2 + ((indexW - m_indexR.load(std::memory_order_acquire)) & INDEX_MASK) >=
+      MAX_SAMPLES * 2)
     return;
 
   // AyuanX: Actual re-sampling work has been moved to sound thread
@@ -269,7 +289,7 @@ void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_sample
     memcpy(&m_buffer[indexW & INDEX_MASK], samples, num_samples * 4);
   }
 
-  m_indexW.fetch_add(num_samples * 2);
+  m_indexW.fetch_add(num_samples * 2, std::memory_order_release);
 }
 
 void Mixer::PushSamples(const short* samples, unsigned int num_samples)
@@ -379,11 +399,12 @@ void Mixer::SetGBAVolume(int device_number, unsigned int lvolume, unsigned int r
   m_gba_mixers[device_number].SetVolume(lvolume, rvolume);
 }
 
-void Mixer::StartLogDTKAudio(const std::string& filename)
+void Mixer::StartLogDTKAudio(const std::string& filename, AudioCommon::AudioDumpFormat format)
 {
   if (!m_log_dtk_audio)
   {
-    bool success = m_wave_writer_dtk.Start(filename, m_streaming_mixer.GetInputSampleRateDivisor());
+    bool success =
+        m_wave_writer_dtk.Start(filename, m_streaming_mixer.GetInputSampleRateDivisor(), format);
     if (success)
     {
       m_log_dtk_audio = true;
@@ -407,7 +428,8 @@ void Mixer::StopLogDTKAudio()
   if (m_log_dtk_audio)
   {
     m_log_dtk_audio = false;
-    m_wave_writer_dtk.Stop();
+    if (!m_wave_writer_dtk.Stop())
+      PanicAlertFmtT("Failed to write the DTK audio dump: {0}", m_wave_writer_dtk.GetError());
     NOTICE_LOG_FMT(AUDIO, "Stopping DTK Audio logging");
   }
   else
@@ -416,11 +438,12 @@ void Mixer::StopLogDTKAudio()
   }
 }
 
-void Mixer::StartLogDSPAudio(const std::string& filename)
+void Mixer::StartLogDSPAudio(const std::string& filename, AudioCommon::AudioDumpFormat format)
 {
   if (!m_log_dsp_audio)
   {
-    bool success = m_wave_writer_dsp.Start(filename, m_dma_mixer.GetInputSampleRateDivisor());
+    bool success =
+        m_wave_writer_dsp.Start(filename, m_dma_mixer.GetInputSampleRateDivisor(), format);
     if (success)
     {
       m_log_dsp_audio = true;
@@ -444,7 +467,8 @@ void Mixer::StopLogDSPAudio()
   if (m_log_dsp_audio)
   {
     m_log_dsp_audio = false;
-    m_wave_writer_dsp.Stop();
+    if (!m_wave_writer_dsp.Stop())
+      PanicAlertFmtT("Failed to write the DSP audio dump: {0}", m_wave_writer_dsp.GetError());
     NOTICE_LOG_FMT(AUDIO, "Stopping DSP Audio logging");
   }
   else
@@ -458,6 +482,7 @@ void Mixer::RefreshConfig()
   m_config_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
   m_config_timing_variance = Config::Get(Config::MAIN_TIMING_VARIANCE);
   m_config_audio_stretch = Config::Get(Config::MAIN_AUDIO_STRETCH);
+  m_config_adaptive_latency = Config::Get(Config::MAIN_AUDIO_ADAPTIVE_LATENCY);
 }
 
 void Mixer::MixerFifo::DoState(PointerWrap& p)
@@ -7,6 +7,7 @@
 #include <atomic>
 
 #include "AudioCommon/AudioStretcher.h"
+#include "AudioCommon/LatencyController.h"
 #include "AudioCommon/SurroundDecoder.h"
 #include "AudioCommon/WaveFile.h"
 #include "Common/CommonTypes.h"
@@ -44,10 +45,10 @@ public:
   void SetWiimoteSpeakerVolume(unsigned int lvolume, unsigned int rvolume);
   void SetGBAVolume(int device_number, unsigned int lvolume, unsigned int rvolume);
 
-  void StartLogDTKAudio(const std::string& filename);
+  void StartLogDTKAudio(const std::string& filename, AudioCommon::AudioDumpFormat format);
   void StopLogDTKAudio();
 
-  void StartLogDSPAudio(const std::string& filename);
+  void StartLogDSPAudio(const std::string& filename, AudioCommon::AudioDumpFormat format);
   void StopLogDSPAudio();
 
   // 54000000 doesn't work here as it doesn't evenly divide with 32000, but 108000000 does
@@ -109,7 +110,10 @@ private:
   bool m_is_stretching = false;
   AudioCommon::AudioStretcher m_stretcher;
   AudioCommon::SurroundDecoder m_surround_decoder;
+  AudioCommon::LatencyController m_latency_controller;
   std::array<short, MAX_SAMPLES * 2> m_scratch_buffer{};
+  // Frames copied out of a MixerFifo for resampling. Only used by MixerFifo::Mix.
+  std::array<s16, MAX_SAMPLES * 2> m_resample_buffer{};
 
   WaveFileWriter m_wave_writer_dtk;
   WaveFileWriter m_wave_writer_dsp;
@@ -120,6 +124,7 @@ private:
   float m_config_emulation_speed;
   int m_config_timing_variance;
   bool m_config_audio_stretch;
+  bool m_config_adaptive_latency;
 
   Config::ConfigChangedCallbackID m_config_changed_callback_id;
 };
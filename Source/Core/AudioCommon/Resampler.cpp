@@ -0,0 +1,200 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AudioCommon/Resampler.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
+#include "Common/CommonTypes.h"
+
+#if defined(_M_X86_64)
+#define USE_SSE
+#elif defined(_M_ARM_64)
+#define USE_NEON
+#endif
+
+namespace AudioCommon
+{
+namespace
+{
+// Interpolates between two samples. The result always fits, as it lies between s1 << 16 and
+// s2 << 16, and so do both products.
+s32 InterpolateSample(s16 s1, s16 s2, u32 frac)
+{
+  return (s1 * static_cast<s32>(0x10000 - frac) + s2 * static_cast<s32>(frac)) >> 16;
+}
+
+s16 MixSample(s16 output, s32 sample, s32 volume)
+{
+  return static_cast<s16>(std::clamp(((sample * volume) >> 8) + output, -32767, 32767));
+}
+
+void ResampleAndMixFrame(s16* output, const s16* input, u32 frac, s32 volume_0, s32 volume_1)
+{
+  output[0] = MixSample(output[0], InterpolateSample(input[0], input[2], frac), volume_0);
+  output[1] = MixSample(output[1], InterpolateSample(input[1], input[3], frac), volume_1);
+}
+
+#if defined(USE_SSE) || defined(USE_NEON)
+// Number of frames that the SIMD loops handle per iteration.
+constexpr u32 BLOCK_FRAMES = 4;
+
+// Gathers the current and next frames, and the fractional positions, of one block.
+struct FrameBlock
+{
+  std::array<u32, BLOCK_FRAMES> current;
+  std::array<u32, BLOCK_FRAMES> next;
+  std::array<u32, BLOCK_FRAMES> frac;
+};
+
+FrameBlock GatherFrames(const s16* input, u64& pos, u32 ratio)
+{
+  FrameBlock block;
+  for (u32 i = 0; i < BLOCK_FRAMES; ++i)
+  {
+    const s16* frame = input + (pos >> 16) * 2;
+    std::memcpy(&block.current[i], frame, sizeof(u32));
+    std::memcpy(&block.next[i], frame + 2, sizeof(u32));
+    block.frac[i] = static_cast<u32>(pos & 0xFFFF);
+    pos += ratio;
+  }
+  return block;
+}
+#endif
+
+#if defined(USE_SSE)
+__m128i LoadBlock(const std::array<u32, BLOCK_FRAMES>& values)
+{
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values.data()));
+}
+
+// SSE2 has no 32-bit multiply, but the low half of the unsigned product is the same for signed
+// operands.
+__m128i MultiplyLow32(__m128i a, __m128i b)
+{
+  const __m128i even = _mm_mul_epu32(a, b);
+  const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+__m128i SignExtendLow16(__m128i v)
+{
+  return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+}
+
+__m128i SignExtendHigh16(__m128i v)
+{
+  return _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+}
+
+// Computes (s1 << 16) + (s2 - s1) * frac, which is the same as InterpolateSample before the
+// shift. The products may wrap around, but the sum is the same as the exact result.
+__m128i Interpolate(__m128i s1, __m128i s2, __m128i frac)
+{
+  const __m128i sum = _mm_add_epi32(_mm_slli_epi32(s1, 16),
+                                    MultiplyLow32(_mm_sub_epi32(s2, s1), frac));
+  return _mm_srai_epi32(sum, 16);
+}
+#elif defined(USE_NEON)
+int32x4_t Interpolate(int32x4_t s1, int32x4_t s2, int32x4_t frac)
+{
+  const int32x4_t sum = vaddq_s32(vshlq_n_s32(s1, 16), vmulq_s32(vsubq_s32(s2, s1), frac));
+  return vshrq_n_s32(sum, 16);
+}
+#endif
+}  // namespace
+
+u32 GetResampleOutputCount(u32 input_frames, u32 frac, u32 ratio, u32 max_count)
+{
+  if (input_frames < 2)
+    return 0;
+
+  // Count the output frames whose position is before the last input frame.
+  const u64 end = static_cast<u64>(input_frames - 1) << 16;
+  if (end <= frac)
+    return 0;
+  if (ratio == 0)
+    return max_count;
+
+  const u64 count = (end - frac + ratio - 1) / ratio;
+  return static_cast<u32>(std::min<u64>(count, max_count));
+}
+
+void ResampleAndMix(s16* output, const s16* input, u32 count, u32 frac, u32 ratio, s32 volume_0,
+                    s32 volume_1)
+{
+  u64 pos = frac;
+  u32 i = 0;
+
+#if defined(USE_SSE)
+  const __m128i volumes = _mm_setr_epi32(volume_0, volume_1, volume_0, volume_1);
+  const __m128i min_sample = _mm_set1_epi16(-32767);
+  for (; i + BLOCK_FRAMES <= count; i += BLOCK_FRAMES)
+  {
+    const FrameBlock block = GatherFrames(input, pos, ratio);
+    const __m128i current = LoadBlock(block.current);
+    const __m128i next = LoadBlock(block.next);
+    const __m128i frac_v = LoadBlock(block.frac);
+
+    // Both channels of a frame use the same fractional position.
+    const __m128i frac_low = _mm_unpacklo_epi32(frac_v, frac_v);
+    const __m128i frac_high = _mm_unpackhi_epi32(frac_v, frac_v);
+
+    __m128i low = Interpolate(SignExtendLow16(current), SignExtendLow16(next), frac_low);
+    __m128i high = Interpolate(SignExtendHigh16(current), SignExtendHigh16(next), frac_high);
+    low = _mm_srai_epi32(MultiplyLow32(low, volumes), 8);
+    high = _mm_srai_epi32(MultiplyLow32(high, volumes), 8);
+
+    __m128i* out = reinterpret_cast<__m128i*>(output + i * 2);
+    const __m128i mixed = _mm_loadu_si128(out);
+    low = _mm_add_epi32(low, SignExtendLow16(mixed));
+    high = _mm_add_epi32(high, SignExtendHigh16(mixed));
+    _mm_storeu_si128(out, _mm_max_epi16(_mm_packs_epi32(low, high), min_sample));
+  }
+#elif defined(USE_NEON)
+  const int32x4_t volumes = {volume_0, volume_1, volume_0, volume_1};
+  const int16x8_t min_sample = vdupq_n_s16(-32767);
+  for (; i + BLOCK_FRAMES <= count; i += BLOCK_FRAMES)
+  {
+    const FrameBlock block = GatherFrames(input, pos, ratio);
+    const int16x8_t current = vreinterpretq_s16_u32(vld1q_u32(block.current.data()));
+    const int16x8_t next = vreinterpretq_s16_u32(vld1q_u32(block.next.data()));
+    const uint32x4_t frac_v = vld1q_u32(block.frac.data());
+
+    // Both channels of a frame use the same fractional position.
+    const uint32x4x2_t frac_zip = vzipq_u32(frac_v, frac_v);
+    const int32x4_t frac_low = vreinterpretq_s32_u32(frac_zip.val[0]);
+    const int32x4_t frac_high = vreinterpretq_s32_u32(frac_zip.val[1]);
+
+    int32x4_t low = Interpolate(vmovl_s16(vget_low_s16(current)),
+                                vmovl_s16(vget_low_s16(next)), frac_low);
+    int32x4_t high = Interpolate(vmovl_s16(vget_high_s16(current)),
+                                 vmovl_s16(vget_high_s16(next)), frac_high);
+    low = vshrq_n_s32(vmulq_s32(low, volumes), 8);
+    high = vshrq_n_s32(vmulq_s32(high, volumes), 8);
+
+    s16* out = output + i * 2;
+    const int16x8_t mixed = vld1q_s16(out);
+    low = vaddq_s32(low, vmovl_s16(vget_low_s16(mixed)));
+    high = vaddq_s32(high, vmovl_s16(vget_high_s16(mixed)));
+    vst1q_s16(out, vmaxq_s16(vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)), min_sample));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    ResampleAndMixFrame(output + i * 2, input + (pos >> 16) * 2, static_cast<u32>(pos & 0xFFFF),
+                        volume_0, volume_1);
+    pos += ratio;
+  }
+}
+}  // namespace AudioCommon
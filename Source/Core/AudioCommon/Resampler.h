@@ -0,0 +1,27 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Linear interpolation resampling used by the mixer. The routines work on whole blocks of
+// interleaved stereo frames and use SIMD where available.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace AudioCommon
+{
+// Returns how many output frames (up to <max_count>) can be generated from <input_frames> input
+// frames. The interpolation always needs the frame after the current one, so the last input frame
+// is never the current one.
+//
+// <frac> is the fractional position in the first input frame, and <ratio> the input to output
+// ratio, both as 16.16 fixed point numbers.
+u32 GetResampleOutputCount(u32 input_frames, u32 frac, u32 ratio, u32 max_count);
+
+// Resamples <input> to <count> output frames, scales channel 0 and channel 1 by volume_0 / 256
+// and volume_1 / 256 and adds the result to the frames in <output>, clamping to [-32767, 32767].
+//
+// <input> must contain at least the frames that GetResampleOutputCount counted.
+void ResampleAndMix(s16* output, const s16* input, u32 count, u32 frac, u32 ratio, s32 volume_0,
+                    s32 volume_1);
+}  // namespace AudioCommon
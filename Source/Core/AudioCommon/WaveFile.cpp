@@ -4,6 +4,7 @@
 #include "AudioCommon/WaveFile.h"
 #include "AudioCommon/Mixer.h"
 
+#include <algorithm>
 #include <string>
 
 #include <fmt/format.h>
@@ -15,11 +16,10 @@
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/Thread.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 
-constexpr size_t WaveFileWriter::BUFFER_SIZE;
-
 WaveFileWriter::WaveFileWriter()
 {
 }
@@ -29,12 +29,14 @@ WaveFileWriter::~WaveFileWriter()
   Stop();
 }
 
-bool WaveFileWriter::Start(const std::string& filename, u32 sample_rate_divisor)
+bool WaveFileWriter::Start(const std::string& filename, u32 sample_rate_divisor,
+                           AudioCommon::AudioDumpFormat dump_format)
 {
   // Ask to delete file
+  overwrite_existing = Config::Get(Config::MAIN_DUMP_AUDIO_SILENT);
   if (File::Exists(filename))
   {
-    if (Config::Get(Config::MAIN_DUMP_AUDIO_SILENT) ||
+    if (overwrite_existing ||
         AskYesNoFmtT("Delete the existing file '{0}'?", filename))
     {
       File::Delete(filename);
@@ -53,84 +55,164 @@ bool WaveFileWriter::Start(const std::string& filename, u32 sample_rate_divisor)
     return false;
   }
 
-  file.Open(filename, "wb");
-  if (!file)
+  format = dump_format;
+  encoder = AudioCommon::CreateAudioDumpEncoder(format);
+  error.clear();
+  write_failed.Clear();
+  if (!OpenFile(filename, sample_rate_divisor))
   {
-    PanicAlertFmtT(
-        "The file {0} could not be opened for writing. Please check if it's already opened "
-        "by another program.",
-        filename);
+    PanicAlertFmt("{}", error);
     return false;
   }
 
-  audio_size = 0;
-
   if (basename.empty())
     SplitPath(filename, nullptr, &basename, nullptr);
 
-  current_sample_rate_divisor = sample_rate_divisor;
+  if (blocks.empty())
+    blocks.resize(NUM_BLOCKS);
+  dropped_frames = 0;
+  worker_running.Set();
+  worker = std::thread(&WaveFileWriter::WorkerThread, this);
 
-  // -----------------
-  // Write file header
-  // -----------------
-  Write4("RIFF");
-  Write(100 * 1000 * 1000);  // write big value in case the file gets truncated
-  Write4("WAVE");
-  Write4("fmt ");
+  return true;
+}
 
-  Write(16);          // size of fmt block
-  Write(0x00020001);  // two channels, uncompressed
+bool WaveFileWriter::Stop()
+{
+  if (worker.joinable())
+  {
+    worker_running.Clear();
+    work_available.Set();
+    worker.join();
+  }
 
-  const u32 sample_rate = Mixer::FIXED_SAMPLE_RATE_DIVIDEND / sample_rate_divisor;
-  Write(sample_rate);
-  Write(sample_rate * 2 * 2);  // two channels, 16bit
+  // The worker is gone now, so anything it didn't get to, including the block that wasn't full
+  // yet, can be written from here.
+  if (!blocks.empty())
+  {
+    WritePendingBlocks();
+    Block& partial_block = blocks[write_index.load(std::memory_order_relaxed) & (NUM_BLOCKS - 1)];
+    WriteBlock(partial_block);
+    partial_block.frame_count = 0;
+  }
+  CloseFile();
 
-  Write(0x00100004);
-  Write4("data");
-  Write(100 * 1000 * 1000 - 32);
+  if (dropped_frames != 0)
+  {
+    WARN_LOG_FMT(AUDIO, "WaveFileWriter - dropped {} frames because writing fell behind.",
+                 dropped_frames);
+    dropped_frames = 0;
+  }
 
-  // We are now at offset 44
-  if (file.Tell() != 44)
-    PanicAlertFmt("Wrong offset: {}", file.Tell());
+  if (!write_failed.IsSet())
+    return true;
 
-  return true;
+  ERROR_LOG_FMT(AUDIO, "WaveFileWriter - {}", error);
+  write_failed.Clear();
+  return false;
 }
 
-void WaveFileWriter::Stop()
+bool WaveFileWriter::OpenFile(const std::string& filename, u32 sample_rate_divisor)
 {
-  file.Seek(4, File::SeekOrigin::Begin);
-  Write(audio_size + 36);
+  file.Open(filename, "wb");
+  if (!file)
+  {
+    error = Common::FmtFormatT(
+        "The file {0} could not be opened for writing. Please check if it's already opened "
+        "by another program.",
+        filename);
+    return false;
+  }
+
+  current_sample_rate_divisor = sample_rate_divisor;
+
+  const u32 sample_rate = Mixer::FIXED_SAMPLE_RATE_DIVIDEND / sample_rate_divisor;
+  if (!encoder->Start(file, sample_rate))
+  {
+    error = fmt::format("Failed to write the header of {}", filename);
+    file.Close();
+    return false;
+  }
+
+  return true;
+}
 
-  file.Seek(40, File::SeekOrigin::Begin);
-  Write(audio_size);
+void WaveFileWriter::CloseFile()
+{
+  if (!file)
+    return;
 
+  encoder->Finish(file);
   file.Close();
 }
 
-void WaveFileWriter::Write(u32 value)
+void WaveFileWriter::WorkerThread()
 {
-  file.WriteArray(&value, 1);
+  Common::SetCurrentThreadName("Audio Dump Writer");
+
+  while (worker_running.IsSet())
+  {
+    work_available.Wait();
+    WritePendingBlocks();
+  }
+}
+
+void WaveFileWriter::WritePendingBlocks()
+{
+  const u32 end = write_index.load(std::memory_order_acquire);
+  for (u32 index = read_index.load(std::memory_order_relaxed); index != end; ++index)
+  {
+    Block& block = blocks[index & (NUM_BLOCKS - 1)];
+    WriteBlock(block);
+    block.frame_count = 0;
+    read_index.store(index + 1, std::memory_order_release);
+  }
 }
 
-void WaveFileWriter::Write4(const char* ptr)
+void WaveFileWriter::WriteBlock(const Block& block)
 {
-  file.WriteBytes(ptr, 4);
+  if (block.frame_count == 0 || write_failed.IsSet())
+    return;
+
+  if (block.sample_rate_divisor != current_sample_rate_divisor)
+  {
+    CloseFile();
+    file_index++;
+    const std::string filename =
+        fmt::format("{}{}{}.{}", File::GetUserPath(D_DUMPAUDIO_IDX), basename, file_index,
+                    AudioCommon::GetAudioDumpFileExtension(format));
+
+    // This runs on the worker thread, so the user can't be asked whether to delete the file.
+    if (!overwrite_existing && File::Exists(filename))
+    {
+      error = Common::FmtFormatT(
+          "The file {0} already exists. Audio dumping was stopped instead of overwriting it.",
+          filename);
+      write_failed.Set();
+      return;
+    }
+
+    if (!OpenFile(filename, block.sample_rate_divisor))
+    {
+      write_failed.Set();
+      return;
+    }
+  }
+
+  encoder->Encode(file, block.samples.data(), block.frame_count);
 }
 
 void WaveFileWriter::AddStereoSamplesBE(const short* sample_data, u32 count,
                                         u32 sample_rate_divisor, int l_volume, int r_volume)
 {
-  if (!file)
+  if (!worker.joinable())
   {
     ERROR_LOG_FMT(AUDIO, "WaveFileWriter - file not open.");
     return;
   }
 
-  if (count * 2 > BUFFER_SIZE)
-  {
-    ERROR_LOG_FMT(AUDIO, "WaveFileWriter - buffer too small (count = {}).", count);
+  if (write_failed.IsSet())
     return;
-  }
 
   if (skip_silence)
   {
@@ -146,27 +228,46 @@ void WaveFileWriter::AddStereoSamplesBE(const short* sample_data, u32 count,
       return;
   }
 
-  for (u32 i = 0; i < count; i++)
+  bool handed_over = false;
+  u32 index = write_index.load(std::memory_order_relaxed);
+  for (u32 i = 0; i < count;)
   {
-    // Flip the audio channels from RL to LR
-    conv_buffer[2 * i] = Common::swap16((u16)sample_data[2 * i + 1]);
-    conv_buffer[2 * i + 1] = Common::swap16((u16)sample_data[2 * i]);
+    if (index - read_index.load(std::memory_order_acquire) >= NUM_BLOCKS)
+    {
+      dropped_frames += count - i;
+      break;
+    }
 
-    // Apply volume (volume ranges from 0 to 256)
-    conv_buffer[2 * i] = conv_buffer[2 * i] * l_volume / 256;
-    conv_buffer[2 * i + 1] = conv_buffer[2 * i + 1] * r_volume / 256;
-  }
+    Block& block = blocks[index & (NUM_BLOCKS - 1)];
+    if (block.frame_count != 0 && block.sample_rate_divisor != sample_rate_divisor)
+    {
+      write_index.store(++index, std::memory_order_release);
+      handed_over = true;
+      continue;
+    }
+    block.sample_rate_divisor = sample_rate_divisor;
 
-  if (sample_rate_divisor != current_sample_rate_divisor)
-  {
-    Stop();
-    file_index++;
-    const std::string filename =
-        fmt::format("{}{}{}.wav", File::GetUserPath(D_DUMPAUDIO_IDX), basename, file_index);
-    Start(filename, sample_rate_divisor);
-    current_sample_rate_divisor = sample_rate_divisor;
+    const u32 frames = std::min(count - i, BLOCK_FRAMES - block.frame_count);
+    s16* conv_buffer = &block.samples[block.frame_count * 2];
+    for (u32 j = 0; j < frames; j++, i++)
+    {
+      // Flip the audio channels from RL to LR
+      const s16 left = Common::swap16((u16)sample_data[2 * i + 1]);
+      const s16 right = Common::swap16((u16)sample_data[2 * i]);
+
+      // Apply volume (volume ranges from 0 to 256)
+      conv_buffer[2 * j] = left * l_volume / 256;
+      conv_buffer[2 * j + 1] = right * r_volume / 256;
+    }
+    block.frame_count += frames;
+
+    if (block.frame_count == BLOCK_FRAMES)
+    {
+      write_index.store(++index, std::memory_order_release);
+      handed_over = true;
+    }
   }
 
-  file.WriteBytes(conv_buffer.data(), count * 4);
-  audio_size += count * 4;
+  if (handed_over)
+    work_available.Set();
 }
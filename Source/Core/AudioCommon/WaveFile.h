@@ -5,18 +5,27 @@
 // Class: WaveFileWriter
 // Description: Simple utility class to make it easy to write long 16-bit stereo
 // audio streams to disk.
-// Use Start() to start recording to a file, and AddStereoSamples to add wave data.
-// The float variant will convert from -1.0-1.0 range and clamp.
-// Alternatively, AddSamplesBE for big endian wave data.
+// Use Start() to start recording to a file, and AddStereoSamplesBE to add big endian wave data.
+// The samples are encoded and written to disk on a worker thread, so that a slow disk or
+// encoder doesn't hold up emulation. If the worker falls too far behind, samples are dropped.
+// Errors are never shown from the worker thread. Start() and Stop() report them to the caller.
 // If Stop is not called when it destructs, the destructor will call Stop().
 // ---------------------------------------------------------------------------------
 
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "AudioCommon/AudioDumpEncoder.h"
+#include "AudioCommon/Enums.h"
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 #include "Common/IOFile.h"
 
 class WaveFileWriter
@@ -30,28 +39,64 @@ public:
   WaveFileWriter(WaveFileWriter&&) = delete;
   WaveFileWriter& operator=(WaveFileWriter&&) = delete;
 
-  bool Start(const std::string& filename, u32 sample_rate_divisor);
-  void Stop();
+  bool Start(const std::string& filename, u32 sample_rate_divisor,
+             AudioCommon::AudioDumpFormat format = AudioCommon::AudioDumpFormat::WAV);
+  // Returns false if writing the dump failed after Start() returned, see GetError().
+  bool Stop();
+  const std::string& GetError() const { return error; }
 
   void SetSkipSilence(bool skip) { skip_silence = skip; }
   // big endian
   void AddStereoSamplesBE(const short* sample_data, u32 count, u32 sample_rate_divisor,
                           int l_volume, int r_volume);
-  u32 GetAudioSize() const { return audio_size; }
 
 private:
-  static constexpr size_t BUFFER_SIZE = 32 * 1024;
+  // Samples are handed from the thread calling AddStereoSamplesBE to the worker in blocks, through
+  // a fixed-size single-producer/single-consumer ring. A block only holds samples of one sample
+  // rate, since a new sample rate also starts a new file.
+  static constexpr u32 BLOCK_FRAMES = 4096;
+  // How many blocks may be waiting for the worker before new samples are dropped (~11 s at 48 kHz).
+  static constexpr u32 NUM_BLOCKS = 128;
+  static_assert((NUM_BLOCKS & (NUM_BLOCKS - 1)) == 0, "NUM_BLOCKS must be a power of two");
 
-  void Write(u32 value);
-  void Write4(const char* ptr);
+  struct Block
+  {
+    u32 sample_rate_divisor = 0;
+    u32 frame_count = 0;
+    std::array<s16, BLOCK_FRAMES * 2> samples;
+  };
+
+  bool OpenFile(const std::string& filename, u32 sample_rate_divisor);
+  void CloseFile();
+  void WorkerThread();
+  void WritePendingBlocks();
+  void WriteBlock(const Block& block);
 
   File::IOFile file;
+  std::unique_ptr<AudioCommon::AudioDumpEncoder> encoder;
+  AudioCommon::AudioDumpFormat format = AudioCommon::AudioDumpFormat::WAV;
   std::string basename;
   u32 file_index = 0;
-  u32 audio_size = 0;
+  // Whether the files for later sample rates may replace existing files. Set by Start().
+  bool overwrite_existing = false;
+  u32 current_sample_rate_divisor = 0;
+
+  // Allocated by the first Start(). The block at write_index is filled by AddStereoSamplesBE and
+  // handed to the worker by incrementing write_index. The worker writes out the blocks from
+  // read_index up to write_index, and increments read_index once a block can be reused.
+  std::vector<Block> blocks;
+  std::atomic<u32> write_index{0};
+  std::atomic<u32> read_index{0};
+  u64 dropped_frames = 0;
+
+  // Set by the worker if a file can't be opened. No more samples are written after that, and the
+  // error is returned to the caller through Stop() and GetError().
+  Common::Flag write_failed;
+  std::string error;
 
-  u32 current_sample_rate_divisor;
-  std::array<short, BUFFER_SIZE> conv_buffer{};
+  std::thread worker;
+  Common::Event work_available;
+  Common::Flag worker_running;
 
   bool skip_silence = false;
 };
@@ -37,6 +37,8 @@ struct CPUInfo
   bool bFMA = false;
   bool bFMA4 = false;
   bool bAES = false;
+  // 256-bit VAES, only set if AVX2 is usable as well
+  bool bVAES = false;
   bool bMOVBE = false;
   // This flag indicates that the hardware supports some mode
   // in which denormal inputs _and_ outputs are automatically set to (signed) zero.
@@ -30,6 +30,17 @@
 
 namespace Common::AES
 {
+bool Context::CryptMultiple(const u8* const* ivs, const u8* const* bufs_in, u8* const* bufs_out,
+                            size_t len, size_t count) const
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (!Crypt(ivs ? ivs[i] : nullptr, nullptr, bufs_in[i], bufs_out[i], len))
+      return false;
+  }
+  return true;
+}
+
 // For x64 and arm64, it's very unlikely a user's cpu does not support the accelerated version,
 // fallback is just in case.
 template <Mode AesMode>
@@ -205,6 +216,113 @@ public:
       _mm_storeu_si128(&((__m128i*)buf_out)[d], block[d]);
   }
 
+  // Same as DecryptPipelined, but each VAES instruction handles two consecutive blocks.
+  template <size_t Depth>
+  ATTRIBUTE_TARGET("vaes,avx2")
+  inline void DecryptPipelinedVAES(__m128i* iv, const u8* buf_in, u8* buf_out) const
+  {
+    __m256i keys[NUM_ROUND_KEYS];
+    for (size_t i = 0; i < NUM_ROUND_KEYS; i++)
+      keys[i] = _mm256_broadcastsi128_si256(round_keys[i]);
+
+    __m256i block[Depth];
+    for (size_t d = 0; d < Depth; d++)
+      block[d] = _mm256_xor_si256(_mm256_loadu_si256(&((const __m256i*)buf_in)[d]), keys[0]);
+
+    for (size_t i = 1; i < Nr; ++i)
+      for (size_t d = 0; d < Depth; d++)
+        block[d] = _mm256_aesdec_epi128(block[d], keys[i]);
+    for (size_t d = 0; d < Depth; d++)
+      block[d] = _mm256_aesdeclast_epi128(block[d], keys[Nr]);
+
+    // The IVs of a pair of blocks are the previous pair shifted by one block
+    const __m128i* in_blocks = (const __m128i*)buf_in;
+    block[0] = _mm256_xor_si256(block[0], _mm256_set_m128i(_mm_loadu_si128(&in_blocks[0]), *iv));
+    for (size_t d = 1; d < Depth; d++)
+    {
+      const __m256i prev = _mm256_loadu_si256((const __m256i*)&in_blocks[d * 2 - 1]);
+      block[d] = _mm256_xor_si256(block[d], prev);
+    }
+    *iv = _mm_loadu_si128(&in_blocks[Depth * 2 - 1]);
+
+    for (size_t d = 0; d < Depth; d++)
+      _mm256_storeu_si256(&((__m256i*)buf_out)[d], block[d]);
+  }
+
+  // CBC encryption of a single stream can't be pipelined, so this encrypts the same block of
+  // several independent streams instead.
+  template <size_t NumStreams>
+  ATTRIBUTE_TARGET("aes")
+  inline void EncryptInterleaved(const u8* const* ivs, const u8* const* bufs_in,
+                                 u8* const* bufs_out, size_t len) const
+  {
+    __m128i block[NumStreams];
+    for (size_t d = 0; d < NumStreams; d++)
+      block[d] = ivs ? _mm_loadu_si128((const __m128i*)ivs[d]) : _mm_setzero_si128();
+
+    for (size_t offset = 0; offset < len; offset += BLOCK_SIZE)
+    {
+      for (size_t d = 0; d < NumStreams; d++)
+      {
+        const __m128i in = _mm_loadu_si128((const __m128i*)(bufs_in[d] + offset));
+        block[d] = _mm_xor_si128(_mm_xor_si128(in, block[d]), round_keys[0]);
+      }
+
+      for (size_t i = 1; i < Nr; ++i)
+        for (size_t d = 0; d < NumStreams; d++)
+          block[d] = _mm_aesenc_si128(block[d], round_keys[i]);
+      for (size_t d = 0; d < NumStreams; d++)
+        block[d] = _mm_aesenclast_si128(block[d], round_keys[Nr]);
+
+      for (size_t d = 0; d < NumStreams; d++)
+        _mm_storeu_si128((__m128i*)(bufs_out[d] + offset), block[d]);
+    }
+  }
+
+  ATTRIBUTE_TARGET("avx")
+  static inline __m256i LoadPair(const u8* lo, const u8* hi)
+  {
+    return _mm256_set_m128i(_mm_loadu_si128((const __m128i*)hi),
+                            _mm_loadu_si128((const __m128i*)lo));
+  }
+
+  // Same as EncryptInterleaved, but each VAES instruction handles a pair of streams.
+  template <size_t NumPairs>
+  ATTRIBUTE_TARGET("vaes,avx2")
+  inline void EncryptInterleavedVAES(const u8* const* ivs, const u8* const* bufs_in,
+                                     u8* const* bufs_out, size_t len) const
+  {
+    __m256i keys[NUM_ROUND_KEYS];
+    for (size_t i = 0; i < NUM_ROUND_KEYS; i++)
+      keys[i] = _mm256_broadcastsi128_si256(round_keys[i]);
+
+    __m256i block[NumPairs];
+    for (size_t p = 0; p < NumPairs; p++)
+      block[p] = ivs ? LoadPair(ivs[p * 2], ivs[p * 2 + 1]) : _mm256_setzero_si256();
+
+    for (size_t offset = 0; offset < len; offset += BLOCK_SIZE)
+    {
+      for (size_t p = 0; p < NumPairs; p++)
+      {
+        const __m256i in = LoadPair(bufs_in[p * 2] + offset, bufs_in[p * 2 + 1] + offset);
+        block[p] = _mm256_xor_si256(_mm256_xor_si256(in, block[p]), keys[0]);
+      }
+
+      for (size_t i = 1; i < Nr; ++i)
+        for (size_t p = 0; p < NumPairs; p++)
+          block[p] = _mm256_aesenc_epi128(block[p], keys[i]);
+      for (size_t p = 0; p < NumPairs; p++)
+        block[p] = _mm256_aesenclast_epi128(block[p], keys[Nr]);
+
+      for (size_t p = 0; p < NumPairs; p++)
+      {
+        _mm_storeu_si128((__m128i*)(bufs_out[p * 2] + offset), _mm256_castsi256_si128(block[p]));
+        _mm_storeu_si128((__m128i*)(bufs_out[p * 2 + 1] + offset),
+                         _mm256_extracti128_si256(block[p], 1));
+      }
+    }
+  }
+
   virtual bool Crypt(const u8* iv, u8* iv_out, const u8* buf_in, u8* buf_out,
                      size_t len) const override
   {
@@ -224,6 +342,19 @@ public:
       // zen3/VAES(VEX.128).
       //  It seems like VAES(VEX.256) should be faster?
       // TODO Choose value at runtime based on some criteria?
+      if (cpu_info.bVAES)
+      {
+        constexpr size_t VAES_DEPTH = 8;
+        constexpr size_t VAES_CHUNK_LEN = VAES_DEPTH * 2 * BLOCK_SIZE;
+        while (len >= VAES_CHUNK_LEN)
+        {
+          DecryptPipelinedVAES<VAES_DEPTH>(&iv_block, buf_in, buf_out);
+          buf_in += VAES_CHUNK_LEN;
+          buf_out += VAES_CHUNK_LEN;
+          len -= VAES_CHUNK_LEN;
+        }
+      }
+
       constexpr size_t BLOCK_DEPTH = 10;
       constexpr size_t CHUNK_LEN = BLOCK_DEPTH * BLOCK_SIZE;
       while (len >= CHUNK_LEN)
@@ -249,6 +380,45 @@ public:
     return true;
   }
 
+  virtual bool CryptMultiple(const u8* const* ivs, const u8* const* bufs_in, u8* const* bufs_out,
+                             size_t len, size_t count) const override
+  {
+    if (len % BLOCK_SIZE)
+      return false;
+
+    // Decryption is already pipelined within each buffer by Crypt
+    if constexpr (AesMode == Mode::Encrypt)
+    {
+      const auto advance = [&](size_t n) {
+        if (ivs)
+          ivs += n;
+        bufs_in += n;
+        bufs_out += n;
+        count -= n;
+      };
+
+      if (cpu_info.bVAES)
+      {
+        constexpr size_t VAES_PAIRS = 4;
+        while (count >= VAES_PAIRS * 2)
+        {
+          EncryptInterleavedVAES<VAES_PAIRS>(ivs, bufs_in, bufs_out, len);
+          advance(VAES_PAIRS * 2);
+        }
+      }
+
+      // aesenc has a latency of about 4 cycles and a throughput of 1-2 per cycle
+      constexpr size_t STREAMS = 4;
+      while (count >= STREAMS)
+      {
+        EncryptInterleaved<STREAMS>(ivs, bufs_in, bufs_out, len);
+        advance(STREAMS);
+      }
+    }
+
+    return Context::CryptMultiple(ivs, bufs_in, bufs_out, len, count);
+  }
+
 private:
   // Ensures alignment specifiers are respected.
   struct XmmReg
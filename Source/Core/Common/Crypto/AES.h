@@ -41,6 +41,12 @@ public:
   {
     return Crypt(nullptr, nullptr, buf_in, buf_out, len);
   }
+
+  // Processes count independent buffers of len bytes, each with its own IV (if ivs is null, all
+  // IVs are zero). CBC encryption is serial within a buffer, so the accelerated implementations
+  // interleave several buffers to keep the AES units busy.
+  virtual bool CryptMultiple(const u8* const* ivs, const u8* const* bufs_in, u8* const* bufs_out,
+                             size_t len, size_t count) const;
 };
 
 std::unique_ptr<Context> CreateContextEncrypt(const u8* key);
@@ -153,16 +153,44 @@ private:
 #ifdef _M_X86_64
 
 // Uses the dedicated SHA1 instructions. Normal SSE(AVX*) would be needed for parallel
-// multi-message processing. While Dolphin could gain from such implementation, it requires the
-// calling code to be modified and/or making the SHA1 implementation asynchronous so it can
-// optimistically batch.
+// multi-message processing within one instruction, but the SHA instructions have enough latency
+// that interleaving the rounds of independent messages (see CalculateDigests) already helps.
 class ContextX64SHA1 final : public BlockContext
 {
 public:
-  ContextX64SHA1()
+  ContextX64SHA1() : state(InitialState()) {}
+
+  // Hashes NumStreams messages of length len in lockstep.
+  template <size_t NumStreams>
+  static void CalculateDigests(const u8* const* msgs, size_t len, Digest* digests)
   {
-    state[0] = _mm_set_epi32(H[0], H[1], H[2], H[3]);
-    state[1] = _mm_set_epi32(H[4], 0, 0, 0);
+    std::array<State, NumStreams> states;
+    states.fill(InitialState());
+
+    std::array<const u8*, NumStreams> blocks;
+    size_t pos = 0;
+    for (; len - pos >= BLOCK_LEN; pos += BLOCK_LEN)
+    {
+      for (size_t d = 0; d < NumStreams; d++)
+        blocks[d] = msgs[d] + pos;
+      ProcessBlocks<NumStreams>(&states, blocks.data());
+    }
+
+    // All messages have the same length, so they all need the same amount of padding
+    alignas(64) std::array<std::array<u8, BLOCK_LEN * 2>, NumStreams> tails;
+    size_t tail_blocks = 0;
+    for (size_t d = 0; d < NumStreams; d++)
+      tail_blocks = PadFinalBlocks(msgs[d] + pos, len - pos, len, tails[d].data());
+
+    for (size_t i = 0; i < tail_blocks; i++)
+    {
+      for (size_t d = 0; d < NumStreams; d++)
+        blocks[d] = tails[d].data() + i * BLOCK_LEN;
+      ProcessBlocks<NumStreams>(&states, blocks.data());
+    }
+
+    for (size_t d = 0; d < NumStreams; d++)
+      digests[d] = GetDigest(states[d]);
   }
 
 private:
@@ -180,6 +208,34 @@ private:
     operator __m128i() const { return data; }
   };
   using WorkBlock = CyclicArray<XmmReg, 4>;
+  // 0: abcd, 1: e
+  using State = std::array<XmmReg, 2>;
+
+  static State InitialState()
+  {
+    State initial;
+    initial[0] = _mm_set_epi32(H[0], H[1], H[2], H[3]);
+    initial[1] = _mm_set_epi32(H[4], 0, 0, 0);
+    return initial;
+  }
+
+  // Writes the remaining len bytes of a message of msg_len bytes plus the padding to out, which
+  // must have room for two blocks. Returns the number of blocks written.
+  static size_t PadFinalBlocks(const u8* msg, size_t len, size_t msg_len, u8* out)
+  {
+    constexpr size_t MSG_LEN_SIZE = sizeof(u64);
+    const size_t num_blocks = len + 1 + MSG_LEN_SIZE > BLOCK_LEN ? 2 : 1;
+    const size_t total_len = num_blocks * BLOCK_LEN;
+
+    std::memcpy(out, msg, len);
+    out[len] = 0x80;
+    std::memset(out + len + 1, 0, total_len - MSG_LEN_SIZE - len - 1);
+
+    Common::BigEndianValue<u64> msg_bitlen(msg_len * 8);
+    std::memcpy(out + total_len - MSG_LEN_SIZE, &msg_bitlen, sizeof(msg_bitlen));
+
+    return num_blocks;
+  }
 
   ATTRIBUTE_TARGET("ssse3")
   static inline __m128i byterev_16B(__m128i x)
@@ -201,63 +257,110 @@ private:
     return wx;
   }
 
+  // Performs rounds 4*I to 4*I+3 for every stream. The two halves of abcde alternate between
+  // being the input and the output, so I also selects which one is written.
+  template <size_t NumStreams, size_t I>
   ATTRIBUTE_TARGET("sha")
-  virtual void ProcessBlock(const u8* msg) override
+  static inline void FourRounds(std::array<State, NumStreams>* abcde,
+                                std::array<WorkBlock, NumStreams>* w)
+  {
+    constexpr size_t src = I % 2;
+    constexpr size_t dst = 1 - src;
+    constexpr int func = I / 5;
+
+    for (size_t d = 0; d < NumStreams; d++)
+    {
+      auto& s = (*abcde)[d];
+      if constexpr (I == 0)
+      {
+        // E0 += MSG0, special case of "nexte", can do normal add
+        s[dst] = _mm_sha1rnds4_epu32(s[src], _mm_add_epi32(s[dst], (*w)[d][0]), func);
+      }
+      else if constexpr (I < 4)
+      {
+        s[dst] = _mm_sha1rnds4_epu32(s[src], _mm_sha1nexte_epu32(s[dst], (*w)[d][I]), func);
+      }
+      else
+      {
+        s[dst] = _mm_sha1rnds4_epu32(
+            s[src], _mm_sha1nexte_epu32(s[dst], MsgSchedule<I>(&(*w)[d])), func);
+      }
+    }
+  }
+
+  template <size_t NumStreams>
+  ATTRIBUTE_TARGET("sha")
+  static void ProcessBlocks(std::array<State, NumStreams>* states, const u8* const* msgs)
   {
     // There are 80 rounds with 4 bytes per round, giving 0x140 byte work space, but we can keep
     // active state in just 0x40 bytes.
     // see FIPS 180-4 6.1.3 Alternate Method for Computing a SHA-1 Message Digest
-    WorkBlock w;
-    auto msg_block = (const __m128i*)msg;
-    for (size_t i = 0; i < w.size(); i++)
-      w[i] = byterev_16B(_mm_loadu_si128(&msg_block[i]));
+    std::array<WorkBlock, NumStreams> w;
+    for (size_t d = 0; d < NumStreams; d++)
+    {
+      auto msg_block = (const __m128i*)msgs[d];
+      for (size_t i = 0; i < w[d].size(); i++)
+        w[d][i] = byterev_16B(_mm_loadu_si128(&msg_block[i]));
+    }
 
-    // 0: abcd, 1: e
-    auto abcde = state;
+    auto abcde = *states;
 
     // Not sure of a (non-ugly) way to have constant-evaluated for-loop, so just rely on inlining.
     // Problem is that sha1rnds4 requires imm8 arg, and first/last rounds have different behavior.
 
     // clang-format off
-    // E0 += MSG0, special case of "nexte", can do normal add
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_add_epi32(abcde[1], w[0]), 0);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], w[1]), 0);
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_sha1nexte_epu32(abcde[1], w[2]), 0);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], w[3]), 0);
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_sha1nexte_epu32(abcde[1], MsgSchedule<4>(&w)), 0);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], MsgSchedule<5>(&w)), 1);
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_sha1nexte_epu32(abcde[1], MsgSchedule<6>(&w)), 1);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], MsgSchedule<7>(&w)), 1);
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_sha1nexte_epu32(abcde[1], MsgSchedule<8>(&w)), 1);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], MsgSchedule<9>(&w)), 1);
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_sha1nexte_epu32(abcde[1], MsgSchedule<10>(&w)), 2);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], MsgSchedule<11>(&w)), 2);
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_sha1nexte_epu32(abcde[1], MsgSchedule<12>(&w)), 2);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], MsgSchedule<13>(&w)), 2);
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_sha1nexte_epu32(abcde[1], MsgSchedule<14>(&w)), 2);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], MsgSchedule<15>(&w)), 3);
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_sha1nexte_epu32(abcde[1], MsgSchedule<16>(&w)), 3);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], MsgSchedule<17>(&w)), 3);
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_sha1nexte_epu32(abcde[1], MsgSchedule<18>(&w)), 3);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], MsgSchedule<19>(&w)), 3);
-    // state += abcde
-    state[1] = _mm_sha1nexte_epu32(abcde[1], state[1]);
-    state[0] = _mm_add_epi32(abcde[0], state[0]);
+    FourRounds<NumStreams, 0>(&abcde, &w);
+    FourRounds<NumStreams, 1>(&abcde, &w);
+    FourRounds<NumStreams, 2>(&abcde, &w);
+    FourRounds<NumStreams, 3>(&abcde, &w);
+    FourRounds<NumStreams, 4>(&abcde, &w);
+    FourRounds<NumStreams, 5>(&abcde, &w);
+    FourRounds<NumStreams, 6>(&abcde, &w);
+    FourRounds<NumStreams, 7>(&abcde, &w);
+    FourRounds<NumStreams, 8>(&abcde, &w);
+    FourRounds<NumStreams, 9>(&abcde, &w);
+    FourRounds<NumStreams, 10>(&abcde, &w);
+    FourRounds<NumStreams, 11>(&abcde, &w);
+    FourRounds<NumStreams, 12>(&abcde, &w);
+    FourRounds<NumStreams, 13>(&abcde, &w);
+    FourRounds<NumStreams, 14>(&abcde, &w);
+    FourRounds<NumStreams, 15>(&abcde, &w);
+    FourRounds<NumStreams, 16>(&abcde, &w);
+    FourRounds<NumStreams, 17>(&abcde, &w);
+    FourRounds<NumStreams, 18>(&abcde, &w);
+    FourRounds<NumStreams, 19>(&abcde, &w);
     // clang-format on
+
+    // state += abcde
+    for (size_t d = 0; d < NumStreams; d++)
+    {
+      auto& state = (*states)[d];
+      state[1] = _mm_sha1nexte_epu32(abcde[d][1], state[1]);
+      state[0] = _mm_add_epi32(abcde[d][0], state[0]);
+    }
   }
 
-  virtual Digest GetDigest() override
+  virtual void ProcessBlock(const u8* msg) override
+  {
+    std::array<State, 1> states{state};
+    ProcessBlocks<1>(&states, &msg);
+    state = states[0];
+  }
+
+  static Digest GetDigest(const State& digest_state)
   {
     Digest digest;
-    _mm_storeu_si128((__m128i*)&digest[0], byterev_16B(state[0]));
-    u32 hi = _mm_cvtsi128_si32(byterev_16B(state[1]));
+    _mm_storeu_si128((__m128i*)&digest[0], byterev_16B(digest_state[0]));
+    u32 hi = _mm_cvtsi128_si32(byterev_16B(digest_state[1]));
     std::memcpy(&digest[sizeof(__m128i)], &hi, sizeof(hi));
     return digest;
   }
 
+  virtual Digest GetDigest() override { return GetDigest(state); }
+
   virtual bool HwAccelerated() const override { return true; }
 
-  std::array<XmmReg, 2> state{};
+  State state;
 };
 
 #endif
@@ -385,4 +488,27 @@ Digest CalculateDigest(const u8* msg, size_t len)
   ctx->Update(msg, len);
   return ctx->Finish();
 }
+
+void CalculateDigests(const u8* const* msgs, size_t len, Digest* digests, size_t count)
+{
+#ifdef _M_X86_64
+  if (cpu_info.bSHA1 && cpu_info.bSSSE3)
+  {
+    // Two streams fill all 16 xmm registers; more than that only adds spills.
+    constexpr size_t NUM_STREAMS = 2;
+    for (; count >= NUM_STREAMS; count -= NUM_STREAMS)
+    {
+      ContextX64SHA1::CalculateDigests<NUM_STREAMS>(msgs, len, digests);
+      msgs += NUM_STREAMS;
+      digests += NUM_STREAMS;
+    }
+    if (count)
+      ContextX64SHA1::CalculateDigests<1>(msgs, len, digests);
+    return;
+  }
+#endif
+
+  for (size_t i = 0; i < count; i++)
+    digests[i] = CalculateDigest(msgs[i], len);
+}
 }  // namespace Common::SHA1
@@ -32,6 +32,11 @@ std::unique_ptr<Context> CreateContext();
 
 Digest CalculateDigest(const u8* msg, size_t len);
 
+// Hashes count independent messages which all have the same length. Every round of SHA-1 depends
+// on the previous one, so a single message can't keep the hardware busy; with the SHA extensions,
+// several messages are processed in lockstep to hide that latency.
+void CalculateDigests(const u8* const* msgs, size_t len, Digest* digests, size_t count);
+
 template <typename T>
 inline Digest CalculateDigest(const std::vector<T>& msg)
 {
@@ -0,0 +1,156 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/Thread.h"
+
+// Like WorkQueueThread, but with several threads that take items from one shared queue.
+// Whichever thread is free next picks up the next item, so slow items don't hold up the others.
+
+namespace Common
+{
+template <typename T>
+class WorkQueueThreadPool
+{
+public:
+  WorkQueueThreadPool() = default;
+  WorkQueueThreadPool(const std::string_view name, size_t thread_count,
+                      std::function<void(T)> function)
+  {
+    Reset(name, thread_count, std::move(function));
+  }
+  ~WorkQueueThreadPool() { Shutdown(); }
+
+  WorkQueueThreadPool(const WorkQueueThreadPool&) = delete;
+  WorkQueueThreadPool& operator=(const WorkQueueThreadPool&) = delete;
+
+  // A thread count suitable for work that is spread over all cores
+  static size_t GetDefaultThreadCount()
+  {
+    return std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 8);
+  }
+
+  // Shuts the current threads down (if any) and starts thread_count new ones with the given
+  // function. The threads are named "<name> <index>".
+  void Reset(const std::string_view name, size_t thread_count, std::function<void(T)> function)
+  {
+    Shutdown();
+    std::lock_guard lg(m_lock);
+    m_shutdown = false;
+    m_function = std::move(function);
+    for (size_t i = 0; i < std::max<size_t>(thread_count, 1); ++i)
+    {
+      m_threads.emplace_back(&WorkQueueThreadPool::ThreadLoop, this,
+                             fmt::format("{} {}", name, i + 1));
+    }
+  }
+
+  // Adds an item to the work queue
+  template <typename... Args>
+  void EmplaceItem(Args&&... args)
+  {
+    std::lock_guard lg(m_lock);
+    if (m_shutdown)
+      return;
+
+    m_items.emplace(std::forward<Args>(args)...);
+    m_worker_cond_var.notify_one();
+  }
+
+  // Adds an item to the work queue
+  void Push(T&& item)
+  {
+    std::lock_guard lg(m_lock);
+    if (m_shutdown)
+      return;
+
+    m_items.push(std::move(item));
+    m_worker_cond_var.notify_one();
+  }
+
+  // Adds an item to the work queue
+  void Push(const T& item)
+  {
+    std::lock_guard lg(m_lock);
+    if (m_shutdown)
+      return;
+
+    m_items.push(item);
+    m_worker_cond_var.notify_one();
+  }
+
+  // Tells the workers to shut down once the queue is empty, and blocks until they have exited.
+  void Shutdown()
+  {
+    {
+      std::lock_guard lg(m_lock);
+      if (m_shutdown || m_threads.empty())
+        return;
+
+      m_shutdown = true;
+      m_worker_cond_var.notify_all();
+    }
+
+    for (std::thread& thread : m_threads)
+      thread.join();
+    m_threads.clear();
+  }
+
+  // Blocks until all items in the queue have been processed
+  void WaitForCompletion()
+  {
+    std::unique_lock lg(m_lock);
+    m_wait_cond_var.wait(lg, [&] { return m_items.empty() && m_busy_threads == 0; });
+  }
+
+private:
+  void ThreadLoop(const std::string thread_name)
+  {
+    Common::SetCurrentThreadName(thread_name.c_str());
+
+    std::unique_lock lg(m_lock);
+    while (true)
+    {
+      m_worker_cond_var.wait(lg, [&] { return !m_items.empty() || m_shutdown; });
+      if (m_items.empty())
+        return;
+
+      T item{std::move(m_items.front())};
+      m_items.pop();
+      ++m_busy_threads;
+      lg.unlock();
+
+      m_function(std::move(item));
+
+      lg.lock();
+      --m_busy_threads;
+      if (m_items.empty() && m_busy_threads == 0)
+        m_wait_cond_var.notify_all();
+    }
+  }
+
+  std::function<void(T)> m_function;
+  std::vector<std::thread> m_threads;
+  std::mutex m_lock;
+  std::queue<T> m_items;
+  std::condition_variable m_wait_cond_var;
+  std::condition_variable m_worker_cond_var;
+  size_t m_busy_threads = 0;
+  bool m_shutdown = false;
+};
+
+}  // namespace Common
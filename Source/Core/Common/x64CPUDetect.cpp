@@ -204,6 +204,8 @@ void CPUInfo::Detect()
         bBMI2 = true;
       if ((info.ebx >> 29) & 1)
         bSHA1 = bSHA2 = true;
+      if (bAVX && bAES && ((info.ebx >> 5) & 1) && ((info.ecx >> 9) & 1))
+        bVAES = true;
     }
   }
 
@@ -268,6 +270,8 @@ std::string CPUInfo::Summarize()
     sum.push_back("MOVBE");
   if (bAES)
     sum.push_back("AES");
+  if (bVAES)
+    sum.push_back("VAES");
   if (bCRC32)
     sum.push_back("CRC32");
   if (bSHA1)
@@ -170,6 +170,11 @@ public:
   static bool FindMapFile(std::string* existing_map_file, std::string* writable_map_file);
   static bool LoadMapFromFilename(const Core::CPUThreadGuard& guard);
 
+  // Sets up the registers the way the IPL leaves them, for running code without booting it.
+  static void SetupMSR(PowerPC::PowerPCState& ppc_state);
+  static void SetupHID(PowerPC::PowerPCState& ppc_state, bool is_wii);
+  static void SetupBAT(Core::System& system, bool is_wii);
+
 private:
   static bool DVDRead(Core::System& system, const DiscIO::VolumeDisc& disc, u64 dvd_offset,
                       u32 output_address, u32 length, const DiscIO::Partition& partition);
@@ -182,9 +187,6 @@ private:
   static bool Boot_WiiWAD(Core::System& system, const DiscIO::VolumeWAD& wad);
   static bool BootNANDTitle(Core::System& system, u64 title_id);
 
-  static void SetupMSR(PowerPC::PowerPCState& ppc_state);
-  static void SetupHID(PowerPC::PowerPCState& ppc_state, bool is_wii);
-  static void SetupBAT(Core::System& system, bool is_wii);
   static bool RunApploader(Core::System& system, const Core::CPUThreadGuard& guard, bool is_wii,
                            const DiscIO::VolumeDisc& volume,
                            const std::vector<DiscIO::Riivolution::Patch>& riivolution_patches);
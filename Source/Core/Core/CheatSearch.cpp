@@ -3,6 +3,9 @@
 
 #include "Core/CheatSearch.h"
 
+#include <algorithm>
+#include <bit>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -11,11 +14,16 @@
 #include <variant>
 #include <vector>
 
+#include <fmt/format.h>
+
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/BitUtils.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
+#include "Common/WorkQueueThreadPool.h"
 
+#include "Core/CheatSearchCompare.h"
 #include "Core/Config/AchievementSettings.h"
 #include "Core/Core.h"
 #include "Core/HW/Memmap.h"
@@ -398,6 +406,7 @@ void Cheats::CheatSearchSession<T>::ResetResults()
 {
   m_first_search_done = false;
   m_search_results.clear();
+  m_compact_results.reset();
 }
 
 template <typename T>
@@ -448,6 +457,401 @@ MakeCompareFunctionForLastValue(Cheats::CompareType op)
   }
 }
 
+// Results are only stored individually once fewer than this many remain.
+constexpr size_t COMPACT_RESULTS_THRESHOLD = 1 << 20;
+
+// Compact results keep a copy of the searched memory, so they aren't used for ranges that are
+// larger than this in total.
+constexpr u64 MAX_COMPACT_SNAPSHOT_SIZE = 256 * 1024 * 1024;
+
+constexpr size_t PAGES_PER_COPY_JOB = 256;
+constexpr size_t WORDS_PER_COMPARE_JOB = 16384;
+
+// A compact scan starts one pool for all of its ranges and steps.
+using ScanPool = Common::WorkQueueThreadPool<std::function<void()>>;
+
+// Runs job(i) for every i in [0, count) on the pool and waits for all of them.
+static void RunScanJobs(ScanPool& pool, size_t count, const std::function<void(size_t)>& job)
+{
+  for (size_t i = 0; i < count; ++i)
+    pool.Push([&job, i] { job(i); });
+  pool.WaitForCompletion();
+}
+
+template <typename T>
+static T ReadBigEndian(const u8* data)
+{
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return Common::FromBigEndian(value);
+}
+
+template <typename T>
+static std::optional<Cheats::CompactSearchResults>
+CreateCompactResults(const std::vector<Cheats::MemoryRange>& memory_ranges, bool aligned)
+{
+  const u32 data_size = sizeof(T);
+  Cheats::CompactSearchResults results;
+  results.m_stride = aligned ? data_size : 1;
+
+  u64 total_size = 0;
+  for (const Cheats::MemoryRange& range : memory_ranges)
+  {
+    if (range.m_length < data_size)
+      continue;
+
+    const u32 start_address = aligned ? Common::AlignUp(range.m_start, data_size) : range.m_start;
+    if (start_address < range.m_start)
+      return std::nullopt;
+    const u64 aligned_length = range.m_length - (start_address - range.m_start);
+
+    if (aligned_length < data_size)
+      continue;
+
+    const u64 length = aligned_length - (data_size - 1);
+    const u64 value_count = (length + results.m_stride - 1) / results.m_stride;
+    const u64 snapshot_size = (value_count - 1) * results.m_stride + data_size;
+
+    // Ranges that wrap around the address space are left to the regular search.
+    total_size += snapshot_size;
+    if (total_size > MAX_COMPACT_SNAPSHOT_SIZE || start_address + snapshot_size > u64{1} << 32)
+      return std::nullopt;
+
+    Cheats::CompactSearchRange& compact_range = results.m_ranges.emplace_back();
+    compact_range.m_start = start_address;
+    compact_range.m_value_count = value_count;
+  }
+
+  return results;
+}
+
+template <typename T>
+static size_t GetSnapshotSize(const Cheats::CompactSearchRange& range, u32 stride)
+{
+  return (range.m_value_count - 1) * stride + sizeof(T);
+}
+
+static size_t GetPageIndex(const Cheats::CompactSearchRange& range, u64 address)
+{
+  return (address >> PowerPC::HW_PAGE_INDEX_SHIFT) -
+         (range.m_start >> PowerPC::HW_PAGE_INDEX_SHIFT);
+}
+
+// Returns which of the values in the given word of the bitmap have the byte at the given offset in
+// a readable page.
+static u64 GetPageMask(const Cheats::CompactSearchRange& range, u32 stride,
+                       const std::vector<u8>& page_readable, size_t word, u32 byte_offset)
+{
+  const size_t first_value = word * 64;
+  const size_t value_count = std::min<size_t>(range.m_value_count - first_value, 64);
+  const u64 in_range = value_count == 64 ? ~u64{0} : (u64{1} << value_count) - 1;
+
+  const u64 first_address = range.m_start + u64{first_value} * stride + byte_offset;
+  const u64 last_address = first_address + u64{value_count - 1} * stride;
+  const size_t first_page = GetPageIndex(range, first_address);
+  const size_t last_page = GetPageIndex(range, last_address);
+
+  u64 mask = page_readable[first_page] ? ~u64{0} : 0;
+  if (first_page != last_page)
+  {
+    // 64 values are at most 512 bytes apart, so they can't span more than two pages.
+    const u64 next_page_address = (first_address | PowerPC::HW_PAGE_MASK) + 1;
+    const u64 values_in_first_page = (next_page_address - first_address + stride - 1) / stride;
+    const u64 first_page_mask = (u64{1} << values_in_first_page) - 1;
+    mask = (mask & first_page_mask) | (page_readable[last_page] ? ~first_page_mask : 0);
+  }
+
+  return mask & in_range;
+}
+
+// Returns which of the values in the given word of the bitmap are entirely in readable pages.
+// Unaligned values can start in a readable page and end in one that isn't.
+template <typename T>
+static u64 GetReadableMask(const Cheats::CompactSearchRange& range, u32 stride,
+                           const std::vector<u8>& page_readable, size_t word)
+{
+  return GetPageMask(range, stride, page_readable, word, 0) &
+         GetPageMask(range, stride, page_readable, word, sizeof(T) - 1);
+}
+
+// Copies the range into a new snapshot, then filters the results by comparing against it.
+// Returns the number of results that are in readable pages.
+template <typename T>
+static size_t ScanCompactRange(const Core::CPUThreadGuard& guard, ScanPool& pool,
+                               Cheats::CompactSearchRange& range, u32 stride,
+                               PowerPC::RequestedAddressSpace address_space, bool translate,
+                               bool first_search, Cheats::FilterType filter_type,
+                               Cheats::CompareType compare_type, const std::optional<T>& value)
+{
+  auto& system = guard.GetSystem();
+  auto& memory = system.GetMemory();
+  auto& mmu = system.GetMMU();
+
+  const size_t snapshot_size = GetSnapshotSize<T>(range, stride);
+  const u64 end_address = u64{range.m_start} + snapshot_size;
+  const size_t page_count = GetPageIndex(range, end_address - 1) + 1;
+  const u64 first_page_address = range.m_start & ~u64{PowerPC::HW_PAGE_MASK};
+
+  // Looking up the pages has to happen on this thread, since it depends on the MMU state.
+  std::vector<u8> snapshot(snapshot_size);
+  std::vector<u8> page_readable(page_count);
+  std::vector<const u8*> page_pointers(page_count);
+  for (size_t page = 0; page < page_count; ++page)
+  {
+    const u64 page_address = first_page_address + page * PowerPC::HW_PAGE_SIZE;
+    if (!PowerPC::MMU::HostIsRAMAddress(guard, static_cast<u32>(page_address), address_space))
+      continue;
+
+    page_readable[page] = 1;
+    const std::optional<u32> physical_address =
+        translate ? mmu.GetTranslatedAddress(static_cast<u32>(page_address)) :
+                    static_cast<u32>(page_address);
+    if (physical_address && (*physical_address >> 28) <= 1)
+    {
+      page_pointers[page] = memory.GetPointerForRange(*physical_address, PowerPC::HW_PAGE_SIZE);
+      continue;
+    }
+
+    // The locked L1 cache and fake VMEM are rare enough that reading them slowly is fine.
+    const u64 begin = std::max<u64>(page_address, range.m_start);
+    const u64 end = std::min<u64>(page_address + PowerPC::HW_PAGE_SIZE, end_address);
+    for (u64 address = begin; address < end; ++address)
+    {
+      const auto byte =
+          PowerPC::MMU::HostTryReadU8(guard, static_cast<u32>(address), address_space);
+      if (byte)
+        snapshot[address - range.m_start] = byte->value;
+    }
+  }
+
+  const size_t copy_job_count = (page_count + PAGES_PER_COPY_JOB - 1) / PAGES_PER_COPY_JOB;
+  RunScanJobs(pool, copy_job_count, [&](size_t job) {
+    const size_t end_page = std::min(page_count, (job + 1) * PAGES_PER_COPY_JOB);
+    for (size_t page = job * PAGES_PER_COPY_JOB; page < end_page; ++page)
+    {
+      if (!page_pointers[page])
+        continue;
+
+      const u64 page_address = first_page_address + page * PowerPC::HW_PAGE_SIZE;
+      const u64 begin = std::max<u64>(page_address, range.m_start);
+      const u64 end = std::min<u64>(page_address + PowerPC::HW_PAGE_SIZE, end_address);
+      std::memcpy(&snapshot[begin - range.m_start], page_pointers[page] + (begin - page_address),
+                  end - begin);
+    }
+  });
+
+  const size_t word_count = (range.m_value_count + 63) / 64;
+  if (first_search)
+    range.m_results.resize(word_count);
+
+  const size_t job_count = (word_count + WORDS_PER_COMPARE_JOB - 1) / WORDS_PER_COMPARE_JOB;
+  std::vector<size_t> job_valid_counts(job_count);
+  RunScanJobs(pool, job_count, [&](size_t job) {
+    const size_t first_word = job * WORDS_PER_COMPARE_JOB;
+    const size_t end_word = std::min(word_count, first_word + WORDS_PER_COMPARE_JOB);
+    const size_t first_value = first_word * 64;
+    const size_t value_count = std::min<size_t>(range.m_value_count, end_word * 64) - first_value;
+    const size_t offset = first_value * stride;
+
+    std::vector<u64> matches(end_word - first_word, ~u64{0});
+    if (filter_type == Cheats::FilterType::CompareAgainstSpecificValue)
+    {
+      Cheats::CompareValues<T>(&snapshot[offset], value_count, stride, compare_type, *value,
+                               matches.data());
+    }
+    else if (filter_type == Cheats::FilterType::CompareAgainstLastValue)
+    {
+      Cheats::CompareValues<T>(&snapshot[offset], &range.m_snapshot[offset], value_count, stride,
+                               compare_type, matches.data());
+    }
+
+    size_t valid_count = 0;
+    for (size_t word = first_word; word < end_word; ++word)
+    {
+      const u64 readable = GetReadableMask<T>(range, stride, page_readable, word);
+      u64 results = matches[word - first_word] & readable;
+      if (!first_search)
+      {
+        // Like in NextSearch, results that were or are inaccessible are kept regardless of their
+        // value, to avoid getting stuck in an invalid state.
+        const u64 was_readable = GetReadableMask<T>(range, stride, range.m_page_readable, word);
+        results = range.m_results[word] & (matches[word - first_word] | ~readable | ~was_readable);
+      }
+
+      range.m_results[word] = results;
+      valid_count += std::popcount(results & readable);
+    }
+    job_valid_counts[job] = valid_count;
+  });
+
+  range.m_results_before_word.resize(word_count);
+  u32 result_count = 0;
+  for (size_t word = 0; word < word_count; ++word)
+  {
+    range.m_results_before_word[word] = result_count;
+    result_count += std::popcount(range.m_results[word]);
+  }
+  range.m_result_count = result_count;
+  range.m_snapshot = std::move(snapshot);
+  range.m_page_readable = std::move(page_readable);
+
+  size_t valid_count = 0;
+  for (const size_t count : job_valid_counts)
+    valid_count += count;
+  return valid_count;
+}
+
+template <typename T>
+static Cheats::SearchErrorCode
+RunCompactScan(const Core::CPUThreadGuard& guard, Cheats::CompactSearchResults& results,
+               PowerPC::RequestedAddressSpace address_space, bool first_search,
+               Cheats::FilterType filter_type, Cheats::CompareType compare_type,
+               const std::optional<T>& value)
+{
+  Cheats::SearchErrorCode error_code = Cheats::SearchErrorCode::Success;
+  Core::RunAsCPUThread([&] {
+    const Core::State core_state = Core::GetState();
+    if (core_state != Core::State::Running && core_state != Core::State::Paused)
+    {
+      error_code = Cheats::SearchErrorCode::NoEmulationActive;
+      return;
+    }
+
+    const auto& ppc_state = guard.GetSystem().GetPPCState();
+    if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
+    {
+      error_code = Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
+      return;
+    }
+
+    // This matches the translated flag that HostTryReadUX returns.
+    const bool translate = address_space == PowerPC::RequestedAddressSpace::Virtual ||
+                           (address_space == PowerPC::RequestedAddressSpace::Effective &&
+                            ppc_state.msr.DR);
+    results.m_value_state = translate ? Cheats::SearchResultValueState::ValueFromVirtualMemory :
+                                        Cheats::SearchResultValueState::ValueFromPhysicalMemory;
+    results.m_result_count = 0;
+    results.m_valid_count = 0;
+    ScanPool pool("Cheat Search", ScanPool::GetDefaultThreadCount(),
+                  [](std::function<void()> job) { job(); });
+    for (Cheats::CompactSearchRange& range : results.m_ranges)
+    {
+      results.m_valid_count +=
+          ScanCompactRange<T>(guard, pool, range, results.m_stride, address_space, translate,
+                              first_search, filter_type, compare_type, value);
+      results.m_result_count += range.m_result_count;
+    }
+  });
+  return error_code;
+}
+
+template <typename T>
+static Cheats::SearchResult<T> GetCompactResult(const Cheats::CompactSearchResults& results,
+                                                const Cheats::CompactSearchRange& range,
+                                                size_t value_index)
+{
+  const size_t offset = value_index * results.m_stride;
+  Cheats::SearchResult<T> result;
+  result.m_address = static_cast<u32>(range.m_start + offset);
+  result.m_value = ReadBigEndian<T>(&range.m_snapshot[offset]);
+  const u64 last_address = u64{result.m_address} + sizeof(T) - 1;
+  const bool readable = range.m_page_readable[GetPageIndex(range, result.m_address)] &&
+                        range.m_page_readable[GetPageIndex(range, last_address)];
+  result.m_value_state =
+      readable ? results.m_value_state : Cheats::SearchResultValueState::AddressNotAccessible;
+  return result;
+}
+
+template <typename T>
+static Cheats::SearchResult<T> GetCompactResult(const Cheats::CompactSearchResults& results,
+                                                size_t index)
+{
+  for (const Cheats::CompactSearchRange& range : results.m_ranges)
+  {
+    if (index >= range.m_result_count)
+    {
+      index -= range.m_result_count;
+      continue;
+    }
+
+    // The last word that has at most index results before it contains the result.
+    const auto& before = range.m_results_before_word;
+    const size_t word = std::upper_bound(before.begin(), before.end(), index) - before.begin() - 1;
+    u64 bits = range.m_results[word];
+    for (size_t i = before[word]; i < index; ++i)
+      bits &= bits - 1;
+    return GetCompactResult<T>(results, range, word * 64 + std::countr_zero(bits));
+  }
+
+  ASSERT(false);
+  return {};
+}
+
+// Converts the results with indices in [begin_index, end_index) to individual results.
+template <typename T>
+static std::vector<Cheats::SearchResult<T>>
+MaterializeResults(const Cheats::CompactSearchResults& results, size_t begin_index,
+                   size_t end_index)
+{
+  end_index = std::min(end_index, results.m_result_count);
+  if (begin_index >= end_index)
+    return {};
+
+  std::vector<Cheats::SearchResult<T>> materialized;
+  materialized.reserve(end_index - begin_index);
+
+  size_t index = 0;
+  for (const Cheats::CompactSearchRange& range : results.m_ranges)
+  {
+    if (index + range.m_result_count <= begin_index)
+    {
+      index += range.m_result_count;
+      continue;
+    }
+
+    for (size_t word = 0; word < range.m_results.size() && index < end_index; ++word)
+    {
+      for (u64 bits = range.m_results[word]; bits != 0 && index < end_index; bits &= bits - 1)
+      {
+        if (index++ >= begin_index)
+        {
+          materialized.push_back(
+              GetCompactResult<T>(results, range, word * 64 + std::countr_zero(bits)));
+        }
+      }
+    }
+  }
+
+  return materialized;
+}
+
+template <typename T>
+Cheats::SearchErrorCode
+Cheats::CheatSearchSession<T>::RunCompactSearch(const Core::CPUThreadGuard& guard)
+{
+  if (m_filter_type == FilterType::CompareAgainstSpecificValue && !m_value)
+    return Cheats::SearchErrorCode::InvalidParameters;
+  if (m_filter_type == FilterType::CompareAgainstLastValue && !m_first_search_done)
+    return Cheats::SearchErrorCode::InvalidParameters;
+
+  const Cheats::SearchErrorCode error_code =
+      RunCompactScan<T>(guard, *m_compact_results, m_address_space, !m_first_search_done,
+                        m_filter_type, m_compare_type, m_value);
+  if (error_code != Cheats::SearchErrorCode::Success)
+    return error_code;
+
+  m_first_search_done = true;
+  m_search_results.clear();
+  if (m_compact_results->m_result_count < COMPACT_RESULTS_THRESHOLD)
+  {
+    m_search_results =
+        MaterializeResults<T>(*m_compact_results, 0, m_compact_results->m_result_count);
+    m_compact_results.reset();
+  }
+
+  return Cheats::SearchErrorCode::Success;
+}
+
 template <typename T>
 Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch(const Core::CPUThreadGuard& guard)
 {
@@ -455,6 +859,13 @@ Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch(const Core::CPU
   if (Config::Get(Config::RA_HARDCORE_ENABLED))
     return Cheats::SearchErrorCode::DisabledInHardcoreMode;
 #endif  // USE_RETRO_ACHIEVEMENTS
+  // Large first searches, and the searches following them, scan whole pages at once and keep
+  // compact results until few enough remain.
+  if (!m_first_search_done)
+    m_compact_results = CreateCompactResults<T>(m_memory_ranges, m_aligned);
+  if (m_compact_results)
+    return RunCompactSearch(guard);
+
   Common::Result<SearchErrorCode, std::vector<SearchResult<T>>> result =
       Cheats::SearchErrorCode::InvalidParameters;
   if (m_filter_type == FilterType::CompareAgainstSpecificValue)
@@ -551,12 +962,17 @@ bool Cheats::CheatSearchSession<T>::IsFloatingType() const
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetResultCount() const
 {
+  if (m_compact_results)
+    return m_compact_results->m_result_count;
   return m_search_results.size();
 }
 
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetValidValueCount() const
 {
+  if (m_compact_results)
+    return m_compact_results->m_valid_count;
+
   const auto& results = m_search_results;
   size_t count = 0;
   for (const auto& r : results)
@@ -570,19 +986,23 @@ size_t Cheats::CheatSearchSession<T>::GetValidValueCount() const
 template <typename T>
 u32 Cheats::CheatSearchSession<T>::GetResultAddress(size_t index) const
 {
+  if (m_compact_results)
+    return GetCompactResult<T>(*m_compact_results, index).m_address;
   return m_search_results[index].m_address;
 }
 
 template <typename T>
 T Cheats::CheatSearchSession<T>::GetResultValue(size_t index) const
 {
+  if (m_compact_results)
+    return GetCompactResult<T>(*m_compact_results, index).m_value;
   return m_search_results[index].m_value;
 }
 
 template <typename T>
 Cheats::SearchValue Cheats::CheatSearchSession<T>::GetResultValueAsSearchValue(size_t index) const
 {
-  return Cheats::SearchValue{m_search_results[index].m_value};
+  return Cheats::SearchValue{GetResultValue(index)};
 }
 
 template <typename T>
@@ -591,23 +1011,26 @@ std::string Cheats::CheatSearchSession<T>::GetResultValueAsString(size_t index,
   if (GetResultValueState(index) == Cheats::SearchResultValueState::AddressNotAccessible)
     return "(inaccessible)";
 
+  const T value = GetResultValue(index);
   if (hex)
   {
     if constexpr (std::is_same_v<T, float>)
-      return fmt::format("0x{0:08x}", Common::BitCast<u32>(m_search_results[index].m_value));
+      return fmt::format("0x{0:08x}", Common::BitCast<u32>(value));
     else if constexpr (std::is_same_v<T, double>)
-      return fmt::format("0x{0:016x}", Common::BitCast<u64>(m_search_results[index].m_value));
+      return fmt::format("0x{0:016x}", Common::BitCast<u64>(value));
     else
-      return fmt::format("0x{0:0{1}x}", m_search_results[index].m_value, sizeof(T) * 2);
+      return fmt::format("0x{0:0{1}x}", value, sizeof(T) * 2);
   }
 
-  return fmt::format("{}", m_search_results[index].m_value);
+  return fmt::format("{}", value);
 }
 
 template <typename T>
 Cheats::SearchResultValueState
 Cheats::CheatSearchSession<T>::GetResultValueState(size_t index) const
 {
+  if (m_compact_results)
+    return GetCompactResult<T>(*m_compact_results, index).m_value_state;
   return m_search_results[index].m_value_state;
 }
 
@@ -627,13 +1050,20 @@ template <typename T>
 std::unique_ptr<Cheats::CheatSearchSessionBase>
 Cheats::CheatSearchSession<T>::ClonePartial(const size_t begin_index, const size_t end_index) const
 {
-  if (begin_index == 0 && end_index >= m_search_results.size())
+  if (begin_index == 0 && end_index >= GetResultCount())
     return Clone();
 
   auto c =
       std::make_unique<Cheats::CheatSearchSession<T>>(m_memory_ranges, m_address_space, m_aligned);
-  c->m_search_results.assign(m_search_results.begin() + begin_index,
-                             m_search_results.begin() + end_index);
+  if (m_compact_results)
+  {
+    c->m_search_results = MaterializeResults<T>(*m_compact_results, begin_index, end_index);
+  }
+  else
+  {
+    c->m_search_results.assign(m_search_results.begin() + begin_index,
+                               m_search_results.begin() + end_index);
+  }
   c->m_compare_type = this->m_compare_type;
   c->m_filter_type = this->m_filter_type;
   c->m_value = this->m_value;
@@ -86,6 +86,42 @@ struct MemoryRange
   MemoryRange(u32 start, u64 length) : m_start(start), m_length(length) {}
 };
 
+// The results of a search over one memory range, stored as a bitmap of which values still
+// match. Value i is the one at m_start + i * stride.
+struct CompactSearchRange
+{
+  u32 m_start = 0;
+  size_t m_value_count = 0;
+  size_t m_result_count = 0;
+
+  // Bit i % 64 of m_results[i / 64] is set if value i is a result.
+  std::vector<u64> m_results;
+
+  // The number of results in m_results before each word, for looking up results by index.
+  std::vector<u32> m_results_before_word;
+
+  // The memory contents as of the last search, starting at m_start.
+  std::vector<u8> m_snapshot;
+
+  // Whether each 4 KiB page was readable in the last search, starting at the page that contains
+  // m_start.
+  std::vector<u8> m_page_readable;
+};
+
+// Search results for when too many remain to store them individually. Only a bitmap and a copy of
+// the searched memory is kept, and the values are read from the copy when needed.
+struct CompactSearchResults
+{
+  std::vector<CompactSearchRange> m_ranges;
+  u32 m_stride = 1;
+
+  // The value state of all results that are in readable pages.
+  SearchResultValueState m_value_state = SearchResultValueState::ValueFromPhysicalMemory;
+
+  size_t m_result_count = 0;
+  size_t m_valid_count = 0;
+};
+
 enum class SearchErrorCode
 {
   Success,
@@ -219,7 +255,12 @@ public:
                                                        size_t end_index) const override;
 
 private:
+  SearchErrorCode RunCompactSearch(const Core::CPUThreadGuard& guard);
+
+  // Only one of these holds the results of the last search. The compact results are used as long
+  // as there are many results left.
   std::vector<SearchResult<T>> m_search_results;
+  std::optional<CompactSearchResults> m_compact_results;
   std::vector<MemoryRange> m_memory_ranges;
   PowerPC::RequestedAddressSpace m_address_space;
   CompareType m_compare_type = CompareType::Equal;
@@ -0,0 +1,463 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/CheatSearchCompare.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include "Common/Assert.h"
+#include "Common/BitUtils.h"
+#include "Common/Swap.h"
+
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#define USE_SSE
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#define USE_NEON
+#endif
+
+namespace
+{
+using Cheats::CompareType;
+
+constexpr size_t BITS_PER_WORD = 64;
+
+template <typename T>
+T ReadBigEndian(const u8* data)
+{
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return Common::FromBigEndian(value);
+}
+
+template <CompareType op, typename T>
+bool Compare(T a, T b)
+{
+  if constexpr (op == CompareType::Equal)
+    return a == b;
+  else if constexpr (op == CompareType::NotEqual)
+    return a != b;
+  else if constexpr (op == CompareType::Less)
+    return a < b;
+  else if constexpr (op == CompareType::LessOrEqual)
+    return a <= b;
+  else if constexpr (op == CompareType::Greater)
+    return a > b;
+  else
+    return a >= b;
+}
+
+// 64-bit values and doubles only fill two lanes, so they stay on the scalar path.
+template <typename T>
+constexpr bool HAS_VECTOR_PATH =
+    std::is_same_v<T, float> || (std::is_integral_v<T> && sizeof(T) <= 4);
+
+#if defined(USE_SSE)
+using Vector = __m128i;
+
+// SSE2 only has signed integer comparisons, so unsigned values get their sign bit flipped.
+template <typename T>
+Vector SignBias()
+{
+  if constexpr (sizeof(T) == 1)
+    return _mm_set1_epi8(static_cast<char>(0x80));
+  else if constexpr (sizeof(T) == 2)
+    return _mm_set1_epi16(static_cast<short>(0x8000));
+  else
+    return _mm_set1_epi32(static_cast<int>(0x80000000));
+}
+
+template <typename T>
+Vector LoadLanes(const u8* data)
+{
+  Vector v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  if constexpr (sizeof(T) >= 2)
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+  if constexpr (sizeof(T) == 4)
+    v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1);
+  if constexpr (std::is_unsigned_v<T>)
+    v = _mm_xor_si128(v, SignBias<T>());
+  return v;
+}
+
+template <typename T>
+Vector Broadcast(T value)
+{
+  Vector v;
+  if constexpr (std::is_same_v<T, float>)
+    v = _mm_castps_si128(_mm_set1_ps(value));
+  else if constexpr (sizeof(T) == 1)
+    v = _mm_set1_epi8(static_cast<char>(value));
+  else if constexpr (sizeof(T) == 2)
+    v = _mm_set1_epi16(static_cast<short>(value));
+  else
+    v = _mm_set1_epi32(static_cast<int>(value));
+  if constexpr (std::is_unsigned_v<T>)
+    v = _mm_xor_si128(v, SignBias<T>());
+  return v;
+}
+
+template <size_t size>
+Vector CompareEqual(Vector a, Vector b)
+{
+  if constexpr (size == 1)
+    return _mm_cmpeq_epi8(a, b);
+  else if constexpr (size == 2)
+    return _mm_cmpeq_epi16(a, b);
+  else
+    return _mm_cmpeq_epi32(a, b);
+}
+
+template <size_t size>
+Vector CompareGreater(Vector a, Vector b)
+{
+  if constexpr (size == 1)
+    return _mm_cmpgt_epi8(a, b);
+  else if constexpr (size == 2)
+    return _mm_cmpgt_epi16(a, b);
+  else
+    return _mm_cmpgt_epi32(a, b);
+}
+
+// Returns one bit per lane, lowest lane first.
+template <typename T, CompareType op>
+u32 CompareVectors(Vector a, Vector b)
+{
+  if constexpr (std::is_same_v<T, float>)
+  {
+    const __m128 x = _mm_castsi128_ps(a);
+    const __m128 y = _mm_castsi128_ps(b);
+    __m128 mask;
+    if constexpr (op == CompareType::Equal)
+      mask = _mm_cmpeq_ps(x, y);
+    else if constexpr (op == CompareType::NotEqual)
+      mask = _mm_cmpneq_ps(x, y);
+    else if constexpr (op == CompareType::Less)
+      mask = _mm_cmplt_ps(x, y);
+    else if constexpr (op == CompareType::LessOrEqual)
+      mask = _mm_cmple_ps(x, y);
+    else if constexpr (op == CompareType::Greater)
+      mask = _mm_cmpgt_ps(x, y);
+    else
+      mask = _mm_cmpge_ps(x, y);
+    return static_cast<u32>(_mm_movemask_ps(mask));
+  }
+  else
+  {
+    Vector mask;
+    if constexpr (op == CompareType::Equal || op == CompareType::NotEqual)
+      mask = CompareEqual<sizeof(T)>(a, b);
+    else if constexpr (op == CompareType::Less || op == CompareType::GreaterOrEqual)
+      mask = CompareGreater<sizeof(T)>(b, a);
+    else
+      mask = CompareGreater<sizeof(T)>(a, b);
+
+    if constexpr (op == CompareType::NotEqual || op == CompareType::LessOrEqual ||
+                  op == CompareType::GreaterOrEqual)
+    {
+      mask = _mm_xor_si128(mask, _mm_set1_epi32(-1));
+    }
+
+    if constexpr (sizeof(T) == 1)
+      return static_cast<u32>(_mm_movemask_epi8(mask));
+    else if constexpr (sizeof(T) == 2)
+      return static_cast<u32>(_mm_movemask_epi8(_mm_packs_epi16(mask, _mm_setzero_si128())));
+    else
+      return static_cast<u32>(_mm_movemask_ps(_mm_castsi128_ps(mask)));
+  }
+}
+#elif defined(USE_NEON)
+using Vector = uint8x16_t;
+
+template <typename T>
+Vector LoadLanes(const u8* data)
+{
+  const Vector v = vld1q_u8(data);
+  if constexpr (sizeof(T) == 1)
+    return v;
+  else if constexpr (sizeof(T) == 2)
+    return vrev16q_u8(v);
+  else
+    return vrev32q_u8(v);
+}
+
+template <typename T>
+Vector Broadcast(T value)
+{
+  if constexpr (sizeof(T) == 1)
+    return vdupq_n_u8(Common::BitCast<u8>(value));
+  else if constexpr (sizeof(T) == 2)
+    return vreinterpretq_u8_u16(vdupq_n_u16(Common::BitCast<u16>(value)));
+  else
+    return vreinterpretq_u8_u32(vdupq_n_u32(Common::BitCast<u32>(value)));
+}
+
+template <typename T>
+auto AsLanes(Vector v)
+{
+  if constexpr (std::is_same_v<T, u8>)
+    return v;
+  else if constexpr (std::is_same_v<T, s8>)
+    return vreinterpretq_s8_u8(v);
+  else if constexpr (std::is_same_v<T, u16>)
+    return vreinterpretq_u16_u8(v);
+  else if constexpr (std::is_same_v<T, s16>)
+    return vreinterpretq_s16_u8(v);
+  else if constexpr (std::is_same_v<T, u32>)
+    return vreinterpretq_u32_u8(v);
+  else if constexpr (std::is_same_v<T, s32>)
+    return vreinterpretq_s32_u8(v);
+  else
+    return vreinterpretq_f32_u8(v);
+}
+
+Vector CompareEqual(uint8x16_t a, uint8x16_t b)
+{
+  return vceqq_u8(a, b);
+}
+Vector CompareEqual(int8x16_t a, int8x16_t b)
+{
+  return vceqq_s8(a, b);
+}
+Vector CompareEqual(uint16x8_t a, uint16x8_t b)
+{
+  return vreinterpretq_u8_u16(vceqq_u16(a, b));
+}
+Vector CompareEqual(int16x8_t a, int16x8_t b)
+{
+  return vreinterpretq_u8_u16(vceqq_s16(a, b));
+}
+Vector CompareEqual(uint32x4_t a, uint32x4_t b)
+{
+  return vreinterpretq_u8_u32(vceqq_u32(a, b));
+}
+Vector CompareEqual(int32x4_t a, int32x4_t b)
+{
+  return vreinterpretq_u8_u32(vceqq_s32(a, b));
+}
+
+Vector CompareGreater(uint8x16_t a, uint8x16_t b)
+{
+  return vcgtq_u8(a, b);
+}
+Vector CompareGreater(int8x16_t a, int8x16_t b)
+{
+  return vcgtq_s8(a, b);
+}
+Vector CompareGreater(uint16x8_t a, uint16x8_t b)
+{
+  return vreinterpretq_u8_u16(vcgtq_u16(a, b));
+}
+Vector CompareGreater(int16x8_t a, int16x8_t b)
+{
+  return vreinterpretq_u8_u16(vcgtq_s16(a, b));
+}
+Vector CompareGreater(uint32x4_t a, uint32x4_t b)
+{
+  return vreinterpretq_u8_u32(vcgtq_u32(a, b));
+}
+Vector CompareGreater(int32x4_t a, int32x4_t b)
+{
+  return vreinterpretq_u8_u32(vcgtq_s32(a, b));
+}
+
+// Returns one bit per lane, lowest lane first.
+template <size_t size>
+u32 MoveMask(Vector mask)
+{
+  if constexpr (size == 1)
+  {
+    static constexpr u8 bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x16_t masked = vandq_u8(mask, vld1q_u8(bits));
+    return vaddv_u8(vget_low_u8(masked)) | (u32{vaddv_u8(vget_high_u8(masked))} << 8);
+  }
+  else if constexpr (size == 2)
+  {
+    static constexpr u8 bits[8] = {1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x8_t narrowed = vmovn_u16(vreinterpretq_u16_u8(mask));
+    return vaddv_u8(vand_u8(narrowed, vld1_u8(bits)));
+  }
+  else
+  {
+    static constexpr u16 bits[4] = {1, 2, 4, 8};
+    const uint16x4_t narrowed = vmovn_u32(vreinterpretq_u32_u8(mask));
+    return vaddv_u16(vand_u16(narrowed, vld1_u16(bits)));
+  }
+}
+
+template <typename T, CompareType op>
+u32 CompareVectors(Vector a, Vector b)
+{
+  const auto x = AsLanes<T>(a);
+  const auto y = AsLanes<T>(b);
+  Vector mask;
+  if constexpr (std::is_same_v<T, float>)
+  {
+    // Inverting another comparison would give the wrong result for NaNs.
+    if constexpr (op == CompareType::Equal)
+      mask = vreinterpretq_u8_u32(vceqq_f32(x, y));
+    else if constexpr (op == CompareType::NotEqual)
+      mask = vmvnq_u8(vreinterpretq_u8_u32(vceqq_f32(x, y)));
+    else if constexpr (op == CompareType::Less)
+      mask = vreinterpretq_u8_u32(vcltq_f32(x, y));
+    else if constexpr (op == CompareType::LessOrEqual)
+      mask = vreinterpretq_u8_u32(vcleq_f32(x, y));
+    else if constexpr (op == CompareType::Greater)
+      mask = vreinterpretq_u8_u32(vcgtq_f32(x, y));
+    else
+      mask = vreinterpretq_u8_u32(vcgeq_f32(x, y));
+  }
+  else
+  {
+    if constexpr (op == CompareType::Equal || op == CompareType::NotEqual)
+      mask = CompareEqual(x, y);
+    else if constexpr (op == CompareType::Less || op == CompareType::GreaterOrEqual)
+      mask = CompareGreater(y, x);
+    else
+      mask = CompareGreater(x, y);
+
+    if constexpr (op == CompareType::NotEqual || op == CompareType::LessOrEqual ||
+                  op == CompareType::GreaterOrEqual)
+    {
+      mask = vmvnq_u8(mask);
+    }
+  }
+  return MoveMask<sizeof(T)>(mask);
+}
+#endif
+
+template <typename T>
+struct ConstantOperand
+{
+  explicit ConstantOperand(T value_) : value(value_)
+  {
+#if defined(USE_SSE) || defined(USE_NEON)
+    if constexpr (HAS_VECTOR_PATH<T>)
+      vector = Broadcast(value);
+#endif
+  }
+
+  T GetValue(size_t) const { return value; }
+#if defined(USE_SSE) || defined(USE_NEON)
+  Vector GetVector(size_t) const { return vector; }
+
+  Vector vector{};
+#endif
+  T value;
+};
+
+template <typename T>
+struct SnapshotOperand
+{
+  explicit SnapshotOperand(const u8* data_) : data(data_) {}
+
+  T GetValue(size_t offset) const { return ReadBigEndian<T>(data + offset); }
+#if defined(USE_SSE) || defined(USE_NEON)
+  Vector GetVector(size_t offset) const { return LoadLanes<T>(data + offset); }
+#endif
+
+  const u8* data;
+};
+
+template <typename T, CompareType op, typename Operand>
+void CompareWithOperand(const u8* data, size_t count, size_t stride, const Operand& operand,
+                        u64* matches)
+{
+  size_t i = 0;
+
+#if defined(USE_SSE) || defined(USE_NEON)
+  if constexpr (HAS_VECTOR_PATH<T>)
+  {
+    // A whole word of matches at a time, from densely packed values.
+    constexpr size_t LANES = 16 / sizeof(T);
+    if (stride == sizeof(T))
+    {
+      for (; i + BITS_PER_WORD <= count; i += BITS_PER_WORD)
+      {
+        u64 word = 0;
+        for (size_t lane = 0; lane < BITS_PER_WORD; lane += LANES)
+        {
+          const size_t offset = (i + lane) * sizeof(T);
+          const u32 bits =
+              CompareVectors<T, op>(LoadLanes<T>(data + offset), operand.GetVector(offset));
+          word |= u64{bits} << lane;
+        }
+        matches[i / BITS_PER_WORD] = word;
+      }
+    }
+  }
+#endif
+
+  for (; i < count; i += BITS_PER_WORD)
+  {
+    const size_t end = std::min(count, i + BITS_PER_WORD);
+    u64 word = 0;
+    for (size_t j = i; j < end; ++j)
+    {
+      const size_t offset = j * stride;
+      if (Compare<op>(ReadBigEndian<T>(data + offset), operand.GetValue(offset)))
+        word |= u64{1} << (j - i);
+    }
+    matches[i / BITS_PER_WORD] = word;
+  }
+}
+
+template <typename T, typename Operand>
+void Dispatch(const u8* data, size_t count, size_t stride, CompareType op, const Operand& operand,
+              u64* matches)
+{
+  switch (op)
+  {
+  case CompareType::Equal:
+    return CompareWithOperand<T, CompareType::Equal>(data, count, stride, operand, matches);
+  case CompareType::NotEqual:
+    return CompareWithOperand<T, CompareType::NotEqual>(data, count, stride, operand, matches);
+  case CompareType::Less:
+    return CompareWithOperand<T, CompareType::Less>(data, count, stride, operand, matches);
+  case CompareType::LessOrEqual:
+    return CompareWithOperand<T, CompareType::LessOrEqual>(data, count, stride, operand, matches);
+  case CompareType::Greater:
+    return CompareWithOperand<T, CompareType::Greater>(data, count, stride, operand, matches);
+  case CompareType::GreaterOrEqual:
+    return CompareWithOperand<T, CompareType::GreaterOrEqual>(data, count, stride, operand,
+                                                              matches);
+  default:
+    DEBUG_ASSERT(false);
+    return;
+  }
+}
+}  // namespace
+
+template <typename T>
+void Cheats::CompareValues(const u8* data, size_t count, size_t stride, CompareType op, T value,
+                           u64* matches)
+{
+  Dispatch<T>(data, count, stride, op, ConstantOperand<T>(value), matches);
+}
+
+template <typename T>
+void Cheats::CompareValues(const u8* data, const u8* old_data, size_t count, size_t stride,
+                           CompareType op, u64* matches)
+{
+  Dispatch<T>(data, count, stride, op, SnapshotOperand<T>(old_data), matches);
+}
+
+#define INSTANTIATE_COMPARE_VALUES(T)                                                              \
+  template void Cheats::CompareValues<T>(const u8*, size_t, size_t, CompareType, T, u64*);         \
+  template void Cheats::CompareValues<T>(const u8*, const u8*, size_t, size_t, CompareType, u64*);
+
+INSTANTIATE_COMPARE_VALUES(u8)
+INSTANTIATE_COMPARE_VALUES(u16)
+INSTANTIATE_COMPARE_VALUES(u32)
+INSTANTIATE_COMPARE_VALUES(u64)
+INSTANTIATE_COMPARE_VALUES(s8)
+INSTANTIATE_COMPARE_VALUES(s16)
+INSTANTIATE_COMPARE_VALUES(s32)
+INSTANTIATE_COMPARE_VALUES(s64)
+INSTANTIATE_COMPARE_VALUES(float)
+INSTANTIATE_COMPARE_VALUES(double)
+
+#undef INSTANTIATE_COMPARE_VALUES
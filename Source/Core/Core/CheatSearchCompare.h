@@ -0,0 +1,24 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+
+#include "Common/CommonTypes.h"
+#include "Core/CheatSearch.h"
+
+namespace Cheats
+{
+// Compares count big endian values of type T against value. The i-th value starts at
+// data + i * stride. Bit i % 64 of matches[i / 64] is set if the comparison holds, and the unused
+// bits of the last word are cleared.
+template <typename T>
+void CompareValues(const u8* data, size_t count, size_t stride, CompareType op, T value,
+                   u64* matches);
+
+// Same as above, but compares each value against the one at the same offset in old_data.
+template <typename T>
+void CompareValues(const u8* data, const u8* old_data, size_t count, size_t stride,
+                   CompareType op, u64* matches);
+}  // namespace Cheats
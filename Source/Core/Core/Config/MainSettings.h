@@ -29,6 +29,7 @@ enum class CPUCore;
 
 namespace AudioCommon
 {
+enum class AudioDumpFormat;
 enum class DPL2Quality;
 }
 
@@ -74,6 +75,8 @@ extern const Info<AudioCommon::DPL2Quality> MAIN_DPL2_QUALITY;
 extern const Info<int> MAIN_AUDIO_LATENCY;
 extern const Info<bool> MAIN_AUDIO_STRETCH;
 extern const Info<int> MAIN_AUDIO_STRETCH_LATENCY;
+// Lets the mixer pick its buffer size from the measured backend timing instead of TimingVariance.
+extern const Info<bool> MAIN_AUDIO_ADAPTIVE_LATENCY;
 extern const Info<std::string> MAIN_MEMCARD_A_PATH;
 extern const Info<std::string> MAIN_MEMCARD_B_PATH;
 const Info<std::string>& GetInfoForMemcardPath(ExpansionInterface::Slot slot);
@@ -159,8 +162,13 @@ extern const Info<bool> MAIN_WII_WIILINK_ENABLE;
 extern const Info<bool> MAIN_DSP_THREAD;
 extern const Info<bool> MAIN_DSP_CAPTURE_LOG;
 extern const Info<bool> MAIN_DSP_JIT;
+// Logs how many cycles each DSP ucode spends in idle loops. Only supported by the x64 recompiler.
+extern const Info<bool> MAIN_DSP_PROFILE_IDLE_LOOPS;
+// Number of extra threads that DSP HLE processes voices on. 0 processes them serially.
+extern const Info<int> MAIN_DSP_HLE_VOICE_THREADS;
 extern const Info<bool> MAIN_DUMP_AUDIO;
 extern const Info<bool> MAIN_DUMP_AUDIO_SILENT;
+extern const Info<AudioCommon::AudioDumpFormat> MAIN_DUMP_AUDIO_FORMAT;
 extern const Info<bool> MAIN_DUMP_UCODE;
 extern const Info<std::string> MAIN_AUDIO_BACKEND;
 extern const Info<int> MAIN_AUDIO_VOLUME;
@@ -198,6 +206,7 @@ extern const Info<bool> MAIN_SHOW_FRAME_COUNT;
 extern const Info<std::string> MAIN_WIRELESS_MAC;
 extern const Info<std::string> MAIN_GDB_SOCKET;
 extern const Info<int> MAIN_GDB_PORT;
+extern const Info<std::string> MAIN_MEMORY_WATCHER_SHARED_MEMORY;
 extern const Info<int> MAIN_ISO_PATH_COUNT;
 extern const Info<std::string> MAIN_SKYLANDERS_PATH;
 std::vector<std::string> GetIsoPaths();
@@ -20,6 +20,7 @@
 #include "Core/CPUThreadConfigCallback.h"
 #include "Core/Config/AchievementSettings.h"
 #include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
@@ -33,10 +34,6 @@
 namespace CoreTiming
 {
 // Sort by time, unless the times are the same, in which case sort by the order added to the queue
-static bool operator>(const Event& left, const Event& right)
-{
-  return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
-}
 static bool operator<(const Event& left, const Event& right)
 {
   return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
@@ -48,6 +45,138 @@ static void EmptyTimedCallback(Core::System& system, u64 userdata, s64 cyclesLat
 {
 }
 
+bool EventQueue::IsBefore(const HeapEntry& a, const HeapEntry& b)
+{
+  return std::tie(a.time, a.fifo_order) < std::tie(b.time, b.fifo_order);
+}
+
+void EventQueue::Place(u32 heap_index, const HeapEntry& entry)
+{
+  m_heap[heap_index] = entry;
+  m_slots[entry.slot].heap_index = heap_index;
+}
+
+void EventQueue::SiftUp(u32 heap_index)
+{
+  const HeapEntry entry = m_heap[heap_index];
+  while (heap_index > 0)
+  {
+    const u32 parent = (heap_index - 1) / 2;
+    if (!IsBefore(entry, m_heap[parent]))
+      break;
+    Place(heap_index, m_heap[parent]);
+    heap_index = parent;
+  }
+  Place(heap_index, entry);
+}
+
+void EventQueue::SiftDown(u32 heap_index)
+{
+  const HeapEntry entry = m_heap[heap_index];
+  const u32 size = static_cast<u32>(m_heap.size());
+  while (true)
+  {
+    u32 child = heap_index * 2 + 1;
+    if (child >= size)
+      break;
+    if (child + 1 < size && IsBefore(m_heap[child + 1], m_heap[child]))
+      ++child;
+    if (!IsBefore(m_heap[child], entry))
+      break;
+    Place(heap_index, m_heap[child]);
+    heap_index = child;
+  }
+  Place(heap_index, entry);
+}
+
+void EventQueue::Push(const Event& event)
+{
+  u32 slot_index;
+  if (!m_free_slots.empty())
+  {
+    slot_index = m_free_slots.back();
+    m_free_slots.pop_back();
+  }
+  else
+  {
+    slot_index = static_cast<u32>(m_slots.size());
+    m_slots.emplace_back();
+  }
+
+  Slot& slot = m_slots[slot_index];
+  slot.event = event;
+  slot.previous_of_type = INVALID_INDEX;
+  slot.next_of_type = event.type->first_event;
+  if (slot.next_of_type != INVALID_INDEX)
+    m_slots[slot.next_of_type].previous_of_type = slot_index;
+  event.type->first_event = slot_index;
+
+  m_heap.push_back(HeapEntry{event.time, event.fifo_order, slot_index});
+  SiftUp(static_cast<u32>(m_heap.size() - 1));
+}
+
+Event EventQueue::Pop()
+{
+  Event event = Top();
+  RemoveAt(0);
+  return event;
+}
+
+void EventQueue::RemoveAt(u32 heap_index)
+{
+  const u32 slot_index = m_heap[heap_index].slot;
+  const Slot& slot = m_slots[slot_index];
+  if (slot.previous_of_type != INVALID_INDEX)
+    m_slots[slot.previous_of_type].next_of_type = slot.next_of_type;
+  else
+    slot.event.type->first_event = slot.next_of_type;
+  if (slot.next_of_type != INVALID_INDEX)
+    m_slots[slot.next_of_type].previous_of_type = slot.previous_of_type;
+  m_free_slots.push_back(slot_index);
+
+  const HeapEntry last = m_heap.back();
+  m_heap.pop_back();
+  if (heap_index == m_heap.size())
+    return;
+
+  Place(heap_index, last);
+  if (heap_index > 0 && IsBefore(last, m_heap[(heap_index - 1) / 2]))
+    SiftUp(heap_index);
+  else
+    SiftDown(heap_index);
+}
+
+void EventQueue::RemoveAll(EventType* event_type)
+{
+  while (event_type->first_event != INVALID_INDEX)
+    RemoveAt(m_slots[event_type->first_event].heap_index);
+}
+
+void EventQueue::Clear()
+{
+  for (const HeapEntry& entry : m_heap)
+    m_slots[entry.slot].event.type->first_event = INVALID_INDEX;
+  m_heap.clear();
+  m_slots.clear();
+  m_free_slots.clear();
+}
+
+std::vector<Event> EventQueue::GetEvents() const
+{
+  std::vector<Event> events;
+  events.reserve(m_heap.size());
+  for (const HeapEntry& entry : m_heap)
+    events.push_back(m_slots[entry.slot].event);
+  return events;
+}
+
+void EventQueue::SetEvents(const std::vector<Event>& events)
+{
+  Clear();
+  for (const Event& event : events)
+    Push(event);
+}
+
 CoreTimingManager::CoreTimingManager(Core::System& system) : m_system(system)
 {
 }
@@ -86,7 +215,7 @@ EventType* CoreTimingManager::RegisterEvent(const std::string& name, TimedCallba
 
 void CoreTimingManager::UnregisterAllEvents()
 {
-  ASSERT_MSG(POWERPC, m_event_queue.empty(), "Cannot unregister events with events pending");
+  ASSERT_MSG(POWERPC, m_event_queue.Empty(), "Cannot unregister events with events pending");
   m_event_types.clear();
 }
 
@@ -102,6 +231,7 @@ void CoreTimingManager::Init()
   m_globals.slice_length = MAX_SLICE_LENGTH;
   m_globals.global_timer = 0;
   m_idled_cycles = 0;
+  m_idle_loops.clear();
 
   // The time between CoreTiming being intialized and the first call to Advance() is considered
   // the slice boundary between slice -1 and slice 0. Dispatcher loops must call Advance() before
@@ -118,6 +248,12 @@ void CoreTimingManager::Init()
 
 void CoreTimingManager::Shutdown()
 {
+  if (!m_idle_loops.empty())
+  {
+    INFO_LOG_FMT(POWERPC, "Idle loops in {}:\n{}", SConfig::GetInstance().GetGameID(),
+                 GetIdleLoopSummary());
+  }
+
   std::lock_guard lk(m_ts_write_lock);
   MoveEvents();
   ClearPendingEvents();
@@ -169,7 +305,10 @@ void CoreTimingManager::DoState(PointerWrap& p)
   p.DoMarker("CoreTimingData");
 
   MoveEvents();
-  p.DoEachElement(m_event_queue, [this](PointerWrap& pw, Event& ev) {
+  std::vector<Event> events;
+  if (!p.IsReadMode())
+    events = m_event_queue.GetEvents();
+  p.DoEachElement(events, [this](PointerWrap& pw, Event& ev) {
     pw.Do(ev.time);
     pw.Do(ev.fifo_order);
 
@@ -205,9 +344,7 @@ void CoreTimingManager::DoState(PointerWrap& p)
   if (p.IsReadMode())
   {
     // When loading from a save state, we must assume the Event order is random and meaningless.
-    // The exact layout of the heap in memory is implementation defined, therefore it is platform
-    // and library version specific.
-    std::make_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    m_event_queue.SetEvents(events);
 
     // The stave state has changed the time, so our previous Throttle targets are invalid.
     // Especially when global_time goes down; So we create a fake throttle update.
@@ -235,7 +372,7 @@ u64 CoreTimingManager::GetIdleTicks() const
 
 void CoreTimingManager::ClearPendingEvents()
 {
-  m_event_queue.clear();
+  m_event_queue.Clear();
 }
 
 void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
@@ -264,8 +401,7 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
     if (!m_is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    m_event_queue.emplace_back(Event{timeout, m_event_fifo_id++, userdata, event_type});
-    std::push_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    m_event_queue.Push(Event{timeout, m_event_fifo_id++, userdata, event_type});
   }
   else
   {
@@ -284,15 +420,7 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
 
 void CoreTimingManager::RemoveEvent(EventType* event_type)
 {
-  auto itr = std::remove_if(m_event_queue.begin(), m_event_queue.end(),
-                            [&](const Event& e) { return e.type == event_type; });
-
-  // Removing random items breaks the invariant so we have to re-establish it.
-  if (itr != m_event_queue.end())
-  {
-    m_event_queue.erase(itr, m_event_queue.end());
-    std::make_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
-  }
+  m_event_queue.RemoveAll(event_type);
 }
 
 void CoreTimingManager::RemoveAllEvents(EventType* event_type)
@@ -319,8 +447,7 @@ void CoreTimingManager::MoveEvents()
   for (Event ev; m_ts_queue.Pop(ev);)
   {
     ev.fifo_order = m_event_fifo_id++;
-    m_event_queue.emplace_back(std::move(ev));
-    std::push_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    m_event_queue.Push(ev);
   }
 }
 
@@ -333,6 +460,9 @@ void CoreTimingManager::Advance()
   auto& power_pc = m_system.GetPowerPC();
   auto& ppc_state = power_pc.GetPPCState();
 
+  // Sample before any events or exceptions run, so the sample shows the code that was running.
+  power_pc.GetSamplingProfiler().CheckSample();
+
   int cyclesExecuted = m_globals.slice_length - DowncountToCycles(ppc_state.downcount);
   m_globals.global_timer += cyclesExecuted;
   m_last_oc_factor = m_config_oc_factor;
@@ -341,11 +471,9 @@ void CoreTimingManager::Advance()
 
   m_is_global_timer_sane = true;
 
-  while (!m_event_queue.empty() && m_event_queue.front().time <= m_globals.global_timer)
+  while (!m_event_queue.Empty() && m_event_queue.Top().time <= m_globals.global_timer)
   {
-    Event evt = std::move(m_event_queue.front());
-    std::pop_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
-    m_event_queue.pop_back();
+    const Event evt = m_event_queue.Pop();
 
     Throttle(evt.time);
     evt.type->callback(m_system, evt.userdata, m_globals.global_timer - evt.time);
@@ -354,10 +482,10 @@ void CoreTimingManager::Advance()
   m_is_global_timer_sane = false;
 
   // Still events left (scheduled in the future)
-  if (!m_event_queue.empty())
+  if (!m_event_queue.Empty())
   {
     m_globals.slice_length = static_cast<int>(
-        std::min<s64>(m_event_queue.front().time - m_globals.global_timer, MAX_SLICE_LENGTH));
+        std::min<s64>(m_event_queue.Top().time - m_globals.global_timer, MAX_SLICE_LENGTH));
   }
 
   ppc_state.downcount = CyclesToDowncount(m_globals.slice_length);
@@ -442,7 +570,7 @@ bool CoreTimingManager::UseSyncOnSkipIdle() const
 
 void CoreTimingManager::LogPendingEvents() const
 {
-  auto clone = m_event_queue;
+  auto clone = m_event_queue.GetEvents();
   std::sort(clone.begin(), clone.end());
   for (const Event& ev : clone)
   {
@@ -457,11 +585,13 @@ void CoreTimingManager::AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clo
   m_throttle_clock_per_sec = new_ppc_clock;
   m_throttle_min_clock_per_sleep = new_ppc_clock / 1200;
 
-  for (Event& ev : m_event_queue)
+  std::vector<Event> events = m_event_queue.GetEvents();
+  for (Event& ev : events)
   {
     const s64 ticks = (ev.time - m_globals.global_timer) * new_ppc_clock / old_ppc_clock;
     ev.time = m_globals.global_timer + ticks;
   }
+  m_event_queue.SetEvents(events);
 }
 
 void CoreTimingManager::Idle()
@@ -480,12 +610,52 @@ void CoreTimingManager::Idle()
   ppc_state.downcount = 0;
 }
 
+void CoreTimingManager::IdleLoop(u32 loop_address)
+{
+  const s64 idled_cycles = m_idled_cycles;
+  Idle();
+
+  IdleLoopStats& stats = m_idle_loops.try_emplace(loop_address, IdleLoopStats{loop_address})
+                             .first->second;
+  ++stats.times_idled;
+  stats.cycles_skipped += m_idled_cycles - idled_cycles;
+}
+
+void CoreTimingManager::RecordIdleLoopDetection(u32 loop_address)
+{
+  ++m_idle_loops.try_emplace(loop_address, IdleLoopStats{loop_address}).first->second.detections;
+}
+
+std::vector<IdleLoopStats> CoreTimingManager::GetIdleLoopStats() const
+{
+  std::vector<IdleLoopStats> stats;
+  stats.reserve(m_idle_loops.size());
+  for (const auto& [address, loop] : m_idle_loops)
+    stats.push_back(loop);
+
+  std::sort(stats.begin(), stats.end(), [](const IdleLoopStats& a, const IdleLoopStats& b) {
+    return a.cycles_skipped > b.cycles_skipped;
+  });
+  return stats;
+}
+
+std::string CoreTimingManager::GetIdleLoopSummary() const
+{
+  std::string text;
+  for (const IdleLoopStats& loop : GetIdleLoopStats())
+  {
+    text += fmt::format("{:08x} : detected {} times, idled {} times, {} cycles skipped\n",
+                        loop.address, loop.detections, loop.times_idled, loop.cycles_skipped);
+  }
+  return text;
+}
+
 std::string CoreTimingManager::GetScheduledEventsSummary() const
 {
   std::string text = "Scheduled events\n";
   text.reserve(1000);
 
-  auto clone = m_event_queue;
+  auto clone = m_event_queue.GetEvents();
   std::sort(clone.begin(), clone.end());
   for (const Event& ev : clone)
   {
@@ -539,9 +709,9 @@ void GlobalAdvance()
   Core::System::GetInstance().GetCoreTiming().Advance();
 }
 
-void GlobalIdle()
+void GlobalIdle(u32 loop_address)
 {
-  Core::System::GetInstance().GetCoreTiming().Idle();
+  Core::System::GetInstance().GetCoreTiming().IdleLoop(loop_address);
 }
 
 }  // namespace CoreTiming
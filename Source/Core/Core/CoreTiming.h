@@ -50,6 +50,8 @@ struct EventType
 {
   TimedCallback callback;
   const std::string* name;
+  // The most recently scheduled pending event of this type, used by EventQueue.
+  u32 first_event = UINT32_MAX;
 };
 
 struct Event
@@ -60,6 +62,66 @@ struct Event
   EventType* type;
 };
 
+// The pending events, as a min-heap ordered by time and then by the order they were added in. The
+// heap entries point to slots holding the events, which also link all of the events of a type
+// together so that they can be removed without searching the whole queue.
+class EventQueue
+{
+public:
+  bool Empty() const { return m_heap.empty(); }
+  size_t Size() const { return m_heap.size(); }
+  const Event& Top() const { return m_slots[m_heap.front().slot].event; }
+
+  void Push(const Event& event);
+  Event Pop();
+  void RemoveAll(EventType* event_type);
+  void Clear();
+
+  // Returns the events in an unspecified order.
+  std::vector<Event> GetEvents() const;
+  void SetEvents(const std::vector<Event>& events);
+
+private:
+  static constexpr u32 INVALID_INDEX = UINT32_MAX;
+
+  // The ordering keys are copied into the heap so that sifting doesn't need to look at the slots.
+  struct HeapEntry
+  {
+    s64 time;
+    u64 fifo_order;
+    u32 slot;
+  };
+
+  struct Slot
+  {
+    Event event;
+    u32 heap_index;
+    u32 previous_of_type;
+    u32 next_of_type;
+  };
+
+  static bool IsBefore(const HeapEntry& a, const HeapEntry& b);
+  void Place(u32 heap_index, const HeapEntry& entry);
+  void SiftUp(u32 heap_index);
+  void SiftDown(u32 heap_index);
+  void RemoveAt(u32 heap_index);
+
+  std::vector<HeapEntry> m_heap;
+  std::vector<Slot> m_slots;
+  std::vector<u32> m_free_slots;
+};
+
+// An idle loop found by the PPC analyzer, and how much time was skipped by idling in it.
+struct IdleLoopStats
+{
+  // The address that the loop branches back to.
+  u32 address;
+  // How many times a JIT compiled a block containing the loop.
+  u32 detections = 0;
+  u64 times_idled = 0;
+  s64 cycles_skipped = 0;
+};
+
 enum class FromThread
 {
   CPU,
@@ -71,7 +133,7 @@ enum class FromThread
 
 // helpers until the JIT is updated to use the instance
 void GlobalAdvance();
-void GlobalIdle();
+void GlobalIdle(u32 loop_address);
 
 class CoreTimingManager
 {
@@ -119,6 +181,13 @@ public:
 
   // Pretend that the main CPU has executed enough cycles to reach the next event.
   void Idle();
+  // Same as Idle(), but called from a detected idle loop, which is recorded in the statistics.
+  void IdleLoop(u32 loop_address);
+
+  // Idle loop statistics for the running title. These must only be accessed from the CPU thread.
+  void RecordIdleLoopDetection(u32 loop_address);
+  std::vector<IdleLoopStats> GetIdleLoopStats() const;
+  std::string GetIdleLoopSummary() const;
 
   // Clear all pending events. This should ONLY be done on exit or state load.
   void ClearPendingEvents();
@@ -163,11 +232,9 @@ private:
   std::unordered_map<std::string, EventType> m_event_types;
 
   // STATE_TO_SAVE
-  // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-  // We don't use std::priority_queue because we need to be able to serialize, unserialize and
-  // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
-  // by the standard adaptor class.
-  std::vector<Event> m_event_queue;
+  // Since events are ordered by when they were added if they are scheduled for the same time, the
+  // order they run in doesn't depend on the layout of the queue, which isn't saved.
+  EventQueue m_event_queue;
   u64 m_event_fifo_id = 0;
   std::mutex m_ts_write_lock;
   Common::SPSCQueue<Event, false> m_ts_queue;
@@ -183,6 +250,9 @@ private:
 
   EventType* m_ev_lost = nullptr;
 
+  // Not saved in savestates, since they are statistics about the session rather than the title.
+  std::unordered_map<u32, IdleLoopStats> m_idle_loops;
+
   CPUThreadConfigCallback::ConfigChangedCallbackID m_registered_config_callback_id;
   float m_config_oc_factor = 0.0f;
   float m_config_oc_inv_factor = 0.0f;
@@ -60,6 +60,67 @@ constexpr u16 idle_skip_sigs[NUM_IDLE_SIGS][MAX_IDLE_SIG_SIZE + 1] = {
      0, 0},
 };
 
+// Polling loops longer than this (in words, including the branch) are not considered idle loops.
+constexpr u16 MAX_IDLE_LOOP_SIZE = 8;
+
+// Registers whose value only changes because of something happening outside of the DSP.
+static bool IsPolledRegister(u16 address)
+{
+  switch (address)
+  {
+  case 0xff00 | DSP_DSCR:
+  case 0xff00 | DSP_DMBH:
+  case 0xff00 | DSP_DMBL:
+  case 0xff00 | DSP_CMBH:
+  case 0xff00 | DSP_CMBL:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Whether the instruction at addr can be part of a polling loop. Such a loop may only load polled
+// registers into the accumulators or AX registers and set flags, so every iteration leaves the
+// DSP in the same state as long as the polled register doesn't change.
+static bool IsPollingInstruction(const SDSP& dsp, u16 addr, bool* reads_polled_register)
+{
+  const UDSPInstruction inst = dsp.ReadIMEM(addr);
+  const DSPOPCTemplate* opcode = GetOpTemplate(inst);
+  if (!opcode)
+    return false;
+
+  // The extension part could store to memory or modify address registers
+  if (opcode->extended && GetExtOpTemplate(inst)->opcode != 0x0000)
+    return false;
+
+  switch (opcode->opcode)
+  {
+  case 0x00c0:  // LR
+    // $D must be one of $AX0.L to $AC1.M
+    if ((inst & 0x1f) < 0x18 || !IsPolledRegister(dsp.ReadIMEM(static_cast<u16>(addr + 1))))
+      return false;
+    *reads_polled_register = true;
+    return true;
+  case 0x2000:  // LRS
+    // Like the idle skip signatures, assume $CR is 0xff, which is what every known ucode uses
+    if (!IsPolledRegister(0xff00 | (inst & 0xff)))
+      return false;
+    *reads_polled_register = true;
+    return true;
+  case 0x0000:  // NOP
+  case 0x8000:  // NX
+  case 0x0280:  // CMPI
+  case 0x0600:  // CMPIS
+  case 0x02a0:  // ANDF
+  case 0x02c0:  // ANDCF
+  case 0x8600:  // TSTAXH
+  case 0xb100:  // TST
+    return true;
+  default:
+    return false;
+  }
+}
+
 Analyzer::Analyzer() = default;
 Analyzer::~Analyzer() = default;
 
@@ -83,6 +144,7 @@ void Analyzer::AnalyzeRange(const SDSP& dsp, u16 start_addr, u16 end_addr)
 
   // Next, we'll scan for potential idle skips.
   FindIdleSkips(dsp, start_addr, end_addr);
+  FindIdleLoops(dsp, start_addr, end_addr);
 
   INFO_LOG_FMT(DSPLLE, "Finished analysis.");
 }
@@ -170,4 +232,39 @@ void Analyzer::FindIdleSkips(const SDSP& dsp, u16 start_addr, u16 end_addr)
     }
   }
 }
+
+void Analyzer::FindIdleLoops(const SDSP& dsp, u16 start_addr, u16 end_addr)
+{
+  for (u16 addr = start_addr; addr < end_addr; addr++)
+  {
+    if (!IsStartOfInstruction(addr))
+      continue;
+
+    // Look for a conditional JMP back to a point shortly before it
+    const UDSPInstruction inst = dsp.ReadIMEM(addr);
+    if ((inst & 0xfff0) != 0x0290 || inst == 0x029f)
+      continue;
+
+    const u16 loop_start = dsp.ReadIMEM(static_cast<u16>(addr + 1));
+    if (loop_start > addr || addr - loop_start >= MAX_IDLE_LOOP_SIZE || IsIdleSkip(loop_start))
+      continue;
+
+    bool is_idle_loop = true;
+    bool reads_polled_register = false;
+    for (u16 i = loop_start; i < addr; i += GetOpTemplate(dsp.ReadIMEM(i))->size)
+    {
+      if (!IsStartOfInstruction(i) || !IsPollingInstruction(dsp, i, &reads_polled_register))
+      {
+        is_idle_loop = false;
+        break;
+      }
+    }
+
+    if (is_idle_loop && reads_polled_register)
+    {
+      INFO_LOG_FMT(DSPLLE, "Idle loop found at {:04x}-{:04x}", loop_start, addr + 1);
+      m_code_flags[loop_start] |= CODE_IDLE_SKIP;
+    }
+  }
+}
 }  // namespace DSP
@@ -301,6 +301,10 @@ struct DSPInitOptions
   };
   CoreType core_type = CoreType::JIT64;
 
+  // Whether the recompiler counts the cycles each ucode skips in idle loops.
+  // Default: false.
+  bool profile_idle_loops = false;
+
   // Optional capture logger used to log internal DSP data transfers.
   // Default: dummy implementation, does nothing.
   DSPCaptureLogger* capture_logger;
@@ -408,6 +412,7 @@ struct SDSP
 
   // Sets the calculated IRAM CRC for debugging purposes.
   void SetIRAMCRC(u32 crc) { m_iram_crc = crc; }
+  u32 GetIRAMCRC() const { return m_iram_crc; }
 
   // Saves and loads any necessary state.
   void DoState(PointerWrap& p);
@@ -11,10 +11,11 @@ namespace DSP::JIT
 {
 DSPEmitter::~DSPEmitter() = default;
 
-std::unique_ptr<DSPEmitter> CreateDSPEmitter([[maybe_unused]] DSPCore& dsp)
+std::unique_ptr<DSPEmitter> CreateDSPEmitter([[maybe_unused]] DSPCore& dsp,
+                                             [[maybe_unused]] bool profile_idle_loops)
 {
 #if defined(_M_X86_64)
-  return std::make_unique<x64::DSPEmitter>(dsp);
+  return std::make_unique<x64::DSPEmitter>(dsp, profile_idle_loops);
 #else
   return std::make_unique<DSPEmitterNull>();
 #endif
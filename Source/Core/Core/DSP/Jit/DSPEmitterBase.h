@@ -35,5 +35,5 @@ public:
   void DoState(PointerWrap&) override {}
 };
 
-std::unique_ptr<DSPEmitter> CreateDSPEmitter(DSPCore& dsp);
+std::unique_ptr<DSPEmitter> CreateDSPEmitter(DSPCore& dsp, bool profile_idle_loops);
 }  // namespace DSP::JIT
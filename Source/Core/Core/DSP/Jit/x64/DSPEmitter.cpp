@@ -29,9 +29,10 @@ constexpr size_t COMPILED_CODE_SIZE = 2097152;
 constexpr size_t MAX_BLOCK_SIZE = 250;
 constexpr u16 DSP_IDLE_SKIP_CYCLES = 0x1000;
 
-DSPEmitter::DSPEmitter(DSPCore& dsp)
+DSPEmitter::DSPEmitter(DSPCore& dsp, bool profile_idle_loops)
     : m_compile_status_register{SR_INT_ENABLE | SR_EXT_INT_ENABLE}, m_blocks(MAX_BLOCKS),
-      m_block_size(MAX_BLOCKS), m_block_links(MAX_BLOCKS), m_dsp_core{dsp}
+      m_block_size(MAX_BLOCKS), m_block_links(MAX_BLOCKS),
+      m_profile_idle_loops{profile_idle_loops}, m_dsp_core{dsp}
 {
   x64::InitInstructionTables();
   AllocCodeSpace(COMPILED_CODE_SIZE);
@@ -45,6 +46,7 @@ DSPEmitter::DSPEmitter(DSPCore& dsp)
 
 DSPEmitter::~DSPEmitter()
 {
+  UpdateIdleLoopProfile();
   FreeCodeSpace();
 }
 
@@ -71,8 +73,31 @@ void DSPEmitter::DoState(PointerWrap& p)
   p.Do(m_cycles_left);
 }
 
+void DSPEmitter::UpdateIdleLoopProfile()
+{
+  if (!m_profile_idle_loops)
+    return;
+
+  if (m_cycles_executed != 0)
+  {
+    IdleLoopProfile& profile = m_idle_loop_profiles[m_profiled_iram_crc];
+    profile.cycles += m_cycles_executed;
+    profile.skipped_cycles += m_idle_skipped_cycles;
+
+    INFO_LOG_FMT(DSPLLE, "ucode {:08x}: {} of {} cycles ({:.1f}%) were skipped in idle loops",
+                 m_profiled_iram_crc, profile.skipped_cycles, profile.cycles,
+                 100.0 * profile.skipped_cycles / profile.cycles);
+  }
+
+  m_cycles_executed = 0;
+  m_idle_skipped_cycles = 0;
+  m_profiled_iram_crc = m_dsp_core.DSPState().GetIRAMCRC();
+}
+
 void DSPEmitter::ClearIRAM()
 {
+  UpdateIdleLoopProfile();
+
   for (size_t i = 0; i < DSP_IRAM_SIZE; i++)
   {
     m_blocks[i] = (DSPCompiledCode)m_stub_entry_point;
@@ -282,14 +307,7 @@ void DSPEmitter::Compile(u16 start_addr)
       DSPJitRegCache c(m_gpr);
       HandleLoop();
       m_gpr.SaveRegs();
-      if (!Host::OnThread() && analyzer.IsIdleSkip(start_addr))
-      {
-        MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-      }
-      else
-      {
-        MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-      }
+      WriteBlockCycles(!Host::OnThread() && analyzer.IsIdleSkip(start_addr));
       JMP(m_return_dispatcher, Jump::Near);
       m_gpr.LoadRegs(false);
       m_gpr.FlushRegs(c, false);
@@ -318,14 +336,7 @@ void DSPEmitter::Compile(u16 start_addr)
         DSPJitRegCache c(m_gpr);
         // don't update g_dsp.pc -- the branch insn already did
         m_gpr.SaveRegs();
-        if (!Host::OnThread() && analyzer.IsIdleSkip(start_addr))
-        {
-          MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-        }
-        else
-        {
-          MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-        }
+        WriteBlockCycles(!Host::OnThread() && analyzer.IsIdleSkip(start_addr));
         JMP(m_return_dispatcher, Jump::Near);
         m_gpr.LoadRegs(false);
         m_gpr.FlushRegs(c, false);
@@ -344,6 +355,11 @@ void DSPEmitter::Compile(u16 start_addr)
   if (fixup_pc)
   {
     MOV(16, M_SDSP_pc(), Imm16(m_compile_pc));
+
+    // The block was cut off by its size limit or by an upcoming idle loop, so execution simply
+    // continues with the next block. Jump there directly rather than through the dispatcher.
+    if (!analyzer.IsIdleSkip(start_addr))
+      WriteBlockLink(m_compile_pc, true);
   }
 
   m_blocks[start_addr] = (DSPCompiledCode)entryPoint;
@@ -381,15 +397,29 @@ void DSPEmitter::Compile(u16 start_addr)
   }
 
   m_gpr.SaveRegs();
-  if (!Host::OnThread() && analyzer.IsIdleSkip(start_addr))
+  WriteBlockCycles(!Host::OnThread() && analyzer.IsIdleSkip(start_addr));
+  JMP(m_return_dispatcher, Jump::Near);
+}
+
+// Sets EAX to the number of cycles the current block is accounted for. Blocks that start with an
+// idle loop give up a large slice at once; when profiling, the cycles they didn't actually run are
+// counted for the ucode profile.
+void DSPEmitter::WriteBlockCycles(bool idle_skip)
+{
+  const u16 block_size = m_block_size[m_start_address];
+  if (idle_skip)
   {
+    if (m_profile_idle_loops)
+    {
+      MOV(64, R(RCX), ImmPtr(&m_idle_skipped_cycles));
+      ADD(64, MatR(RCX), Imm32(DSP_IDLE_SKIP_CYCLES - block_size));
+    }
     MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
   }
   else
   {
-    MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
+    MOV(16, R(EAX), Imm16(block_size));
   }
-  JMP(m_return_dispatcher, Jump::Near);
 }
 
 void DSPEmitter::CompileCurrent(DSPEmitter& emitter)
@@ -453,6 +483,14 @@ void DSPEmitter::CompileDispatcher()
 
   m_return_dispatcher = GetCodePtr();
 
+  // Count the cycles for the idle loop profile
+  if (m_profile_idle_loops)
+  {
+    MOVZX(32, 16, EDX, R(EAX));
+    MOV(64, R(RCX), ImmPtr(&m_cycles_executed));
+    ADD(64, MatR(RCX), R(RDX));
+  }
+
   // Decrement cyclesLeft
   MOV(64, R(RCX), ImmPtr(&m_cycles_left));
   SUB(16, MatR(RCX), R(EAX));
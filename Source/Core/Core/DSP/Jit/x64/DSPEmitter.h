@@ -6,6 +6,7 @@
 #include <array>
 #include <cstddef>
 #include <list>
+#include <map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -27,7 +28,7 @@ namespace JIT::x64
 class DSPEmitter final : public JIT::DSPEmitter, public Gen::X64CodeBlock
 {
 public:
-  explicit DSPEmitter(DSPCore& dsp);
+  explicit DSPEmitter(DSPCore& dsp, bool profile_idle_loops = false);
   ~DSPEmitter() override;
 
   u16 RunCycles(u16 cycles) override;
@@ -212,7 +213,11 @@ private:
   void FallBackToInterpreter(UDSPInstruction inst);
 
   void WriteBranchExit();
-  void WriteBlockLink(u16 dest);
+  void WriteBlockLink(u16 dest, bool fall_through = false);
+  void WriteBlockCycles(bool idle_skip);
+
+  // Logs and stores the idle loop statistics of the ucode that is being replaced.
+  void UpdateIdleLoopProfile();
 
   void ReJitConditional(UDSPInstruction opc, void (DSPEmitter::*conditional_fn)(UDSPInstruction));
   void r_jcc(UDSPInstruction opc);
@@ -325,6 +330,21 @@ private:
 
   u16 m_cycles_left = 0;
 
+  struct IdleLoopProfile
+  {
+    u64 cycles = 0;
+    u64 skipped_cycles = 0;
+  };
+
+  // Counted by the dispatcher and by blocks that start with an idle loop respectively, but only
+  // if m_profile_idle_loops is set.
+  const bool m_profile_idle_loops;
+  u64 m_cycles_executed = 0;
+  u64 m_idle_skipped_cycles = 0;
+  // Per ucode (by IRAM CRC) totals, updated whenever new code is loaded.
+  std::map<u32, IdleLoopProfile> m_idle_loop_profiles;
+  u32 m_profiled_iram_crc = 0;
+
   // The index of the last stored ext value (compile time).
   int m_store_index = -1;
   int m_store_index2 = -1;
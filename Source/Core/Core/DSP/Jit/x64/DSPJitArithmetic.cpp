@@ -1162,6 +1162,7 @@ void DSPEmitter::lsl16(const UDSPInstruction opc)
   //	Update_SR_Register64(dsp_get_long_acc(areg));
   if (FlagsNeeded())
   {
+    get_long_acc(areg);
     Update_SR_Register64();
   }
 }
@@ -1233,6 +1234,7 @@ void DSPEmitter::lsl(const UDSPInstruction opc)
   //	Update_SR_Register64(dsp_get_long_acc(rreg));
   if (FlagsNeeded())
   {
+    get_long_acc(rreg);
     Update_SR_Register64();
   }
 }
@@ -1255,7 +1257,12 @@ void DSPEmitter::lsr(const UDSPInstruction opc)
   else
     shift = 0x40 - (opc & 0x3f);
 
-  if (shift)
+  if (shift >= 40)
+  {
+    // Everything is shifted out. x86 would mask the shift count below.
+    XOR(32, R(EAX), R(EAX));
+  }
+  else if (shift)
   {
     //	acc &= 0x000000FFFFFFFFFFULL; 	// Lop off the extraneous sign extension our 64-bit fake
     // accum causes
@@ -1269,6 +1276,7 @@ void DSPEmitter::lsr(const UDSPInstruction opc)
   //	Update_SR_Register64(dsp_get_long_acc(rreg));
   if (FlagsNeeded())
   {
+    get_long_acc(rreg);
     Update_SR_Register64();
   }
 }
@@ -1291,6 +1299,7 @@ void DSPEmitter::asl(const UDSPInstruction opc)
   //	Update_SR_Register64(dsp_get_long_acc(rreg));
   if (FlagsNeeded())
   {
+    get_long_acc(rreg);
     Update_SR_Register64();
   }
 }
@@ -1384,6 +1393,7 @@ void DSPEmitter::lsrn(const UDSPInstruction opc)
   //	Update_SR_Register64(dsp_get_long_acc(0));
   if (FlagsNeeded())
   {
+    get_long_acc(0, RDX);
     Update_SR_Register64(RDX, RCX);
   }
 }
@@ -1441,6 +1451,7 @@ void DSPEmitter::asrn(const UDSPInstruction opc)
   SetJumpTarget(zero);
   if (FlagsNeeded())
   {
+    get_long_acc(0, RDX);
     Update_SR_Register64(RDX, RCX);
   }
 }
@@ -1504,6 +1515,7 @@ void DSPEmitter::lsrnrx(const UDSPInstruction opc)
   SetJumpTarget(zero);
   if (FlagsNeeded())
   {
+    get_long_acc(dreg, RDX);
     Update_SR_Register64(RDX, RCX);
   }
 }
@@ -1561,6 +1573,7 @@ void DSPEmitter::asrnrx(const UDSPInstruction opc)
   //	Update_SR_Register64(dsp_get_long_acc(dreg));
   if (FlagsNeeded())
   {
+    get_long_acc(dreg, RDX);
     Update_SR_Register64(RDX, RCX);
   }
 }
@@ -1619,6 +1632,7 @@ void DSPEmitter::lsrnr(const UDSPInstruction opc)
   //	Update_SR_Register64(dsp_get_long_acc(dreg));
   if (FlagsNeeded())
   {
+    get_long_acc(dreg, RDX);
     Update_SR_Register64(RDX, RCX);
   }
 }
@@ -1674,6 +1688,7 @@ void DSPEmitter::asrnr(const UDSPInstruction opc)
   //	Update_SR_Register64(dsp_get_long_acc(dreg));
   if (FlagsNeeded())
   {
+    get_long_acc(dreg, RDX);
     Update_SR_Register64(RDX, RCX);
   }
 }
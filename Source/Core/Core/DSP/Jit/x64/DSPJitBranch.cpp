@@ -101,23 +101,19 @@ void DSPEmitter::WriteBranchExit()
 {
   DSPJitRegCache c(m_gpr);
   m_gpr.SaveRegs();
-  if (m_dsp_core.DSPState().GetAnalyzer().IsIdleSkip(m_start_address))
-  {
-    MOV(16, R(EAX), Imm16(0x1000));
-  }
-  else
-  {
-    MOV(16, R(EAX), Imm16(m_block_size[m_start_address]));
-  }
+  WriteBlockCycles(m_dsp_core.DSPState().GetAnalyzer().IsIdleSkip(m_start_address));
   JMP(m_return_dispatcher, Jump::Near);
   m_gpr.LoadRegs(false);
   m_gpr.FlushRegs(c, false);
 }
 
-void DSPEmitter::WriteBlockLink(u16 dest)
+void DSPEmitter::WriteBlockLink(u16 dest, bool fall_through)
 {
+  // When falling through, m_compile_pc already points past the last instruction of the block.
+  const u16 last_address = fall_through ? m_compile_pc - 1 : m_compile_pc;
+
   // Jump directly to the called block if it has already been compiled.
-  if (!(dest >= m_start_address && dest <= m_compile_pc))
+  if (!(dest >= m_start_address && dest <= last_address))
   {
     if (m_block_links[dest] != nullptr)
     {
@@ -130,6 +126,11 @@ void DSPEmitter::WriteBlockLink(u16 dest)
 
       SUB(16, R(ECX), Imm16(m_block_size[m_start_address]));
       MOV(16, MatR(RAX), R(ECX));
+      if (m_profile_idle_loops)
+      {
+        MOV(64, R(RAX), ImmPtr(&m_cycles_executed));
+        ADD(64, MatR(RAX), Imm32(m_block_size[m_start_address]));
+      }
       JMP(m_block_links[dest], Jump::Near);
       SetJumpTarget(notEnoughCycles);
     }
@@ -145,11 +146,10 @@ void DSPEmitter::WriteBlockLink(u16 dest)
 void DSPEmitter::r_jcc(const UDSPInstruction opc)
 {
   const u16 dest = m_dsp_core.DSPState().ReadIMEM(m_compile_pc + 1);
-  const DSPOPCTemplate* opcode = GetOpTemplate(opc);
 
-  // If the block is unconditional, attempt to link block
-  if (opcode->uncond_branch)
-    WriteBlockLink(dest);
+  // The destination is static whether or not the branch is conditional, so link the block. For
+  // conditional branches this only affects the taken path.
+  WriteBlockLink(dest);
   MOV(16, M_SDSP_pc(), Imm16(dest));
   WriteBranchExit();
 }
@@ -192,11 +192,10 @@ void DSPEmitter::r_call(const UDSPInstruction opc)
   MOV(16, R(DX), Imm16(m_compile_pc + 2));
   dsp_reg_store_stack(StackRegister::Call);
   const u16 dest = m_dsp_core.DSPState().ReadIMEM(m_compile_pc + 1);
-  const DSPOPCTemplate* opcode = GetOpTemplate(opc);
 
-  // If the block is unconditional, attempt to link block
-  if (opcode->uncond_branch)
-    WriteBlockLink(dest);
+  // The destination is static whether or not the branch is conditional, so link the block. For
+  // conditional branches this only affects the taken path.
+  WriteBlockLink(dest);
   MOV(16, M_SDSP_pc(), Imm16(dest));
   WriteBranchExit();
 }
@@ -279,7 +278,7 @@ void DSPEmitter::r_rti(const UDSPInstruction opc)
 {
   //	g_dsp.r[DSP_REG_SR] = dsp_reg_load_stack(StackRegister::Data);
   dsp_reg_load_stack(StackRegister::Data);
-  dsp_op_write_reg(DSP_REG_SR, RDX);
+  m_gpr.WriteReg(DSP_REG_SR, R(RDX));
   //	g_dsp.pc = dsp_reg_load_stack(StackRegister::Call);
   dsp_reg_load_stack(StackRegister::Call);
   MOV(16, M_SDSP_pc(), R(DX));
@@ -271,10 +271,18 @@ void DSPEmitter::addpaxz(const UDSPInstruction opc)
   if (FlagsNeeded())
   {
     get_long_prod(RDX);
+    set_long_acc(dreg, RAX);
+    get_long_acc(dreg, RAX);
     MOV(64, R(RCX), R(RAX));
-    set_long_acc(dreg, RCX);
     // TODO: Why does this not set the overflow bit?  (And thus, why can't it use UpdateSR64Add?)
-    Update_SR_Register64(EAX, tmp1);
+    Update_SR_Register64(RCX, tmp1);
+    // if (isCarryAdd(oldprod, res)) g_dsp.r[DSP_REG_SR] |= SR_CARRY;
+    const OpArg sr_reg = m_gpr.GetReg(DSP_REG_SR);
+    CMP(64, R(RDX), R(RAX));
+    FixupBranch no_carry = J_CC(CC_BE);
+    OR(16, sr_reg, Imm16(SR_CARRY));
+    SetJumpTarget(no_carry);
+    m_gpr.PutReg(DSP_REG_SR);
   }
   else
   {
@@ -350,6 +358,7 @@ void DSPEmitter::mulac(const UDSPInstruction opc)
   //	Update_SR_Register64(dsp_get_long_acc(rreg));
   if (FlagsNeeded())
   {
+    get_long_acc(rreg);
     Update_SR_Register64();
   }
 }
@@ -375,6 +384,7 @@ void DSPEmitter::mulmv(const UDSPInstruction opc)
   //	Update_SR_Register64(dsp_get_long_acc(rreg));
   if (FlagsNeeded())
   {
+    get_long_acc(rreg);
     Update_SR_Register64();
   }
 }
@@ -399,6 +409,7 @@ void DSPEmitter::mulmvz(const UDSPInstruction opc)
   //	Update_SR_Register64(dsp_get_long_acc(rreg));
   if (FlagsNeeded())
   {
+    get_long_acc(rreg, RDX);
     Update_SR_Register64(RDX, RCX);
   }
 }
@@ -456,6 +467,7 @@ void DSPEmitter::mulxac(const UDSPInstruction opc)
   //	Update_SR_Register64(dsp_get_long_acc(rreg));
   if (FlagsNeeded())
   {
+    get_long_acc(rreg, tmp1);
     Update_SR_Register64(tmp1);
   }
   m_gpr.PutXReg(tmp1);
@@ -491,6 +503,7 @@ void DSPEmitter::mulxmv(const UDSPInstruction opc)
   //	Update_SR_Register64(dsp_get_long_acc(rreg));
   if (FlagsNeeded())
   {
+    get_long_acc(rreg, tmp1);
     Update_SR_Register64(tmp1);
   }
   m_gpr.PutXReg(tmp1);
@@ -527,6 +540,7 @@ void DSPEmitter::mulxmvz(const UDSPInstruction opc)
   //	Update_SR_Register64(dsp_get_long_acc(rreg));
   if (FlagsNeeded())
   {
+    get_long_acc(rreg, tmp1);
     Update_SR_Register64(tmp1);
   }
   m_gpr.PutXReg(tmp1);
@@ -586,6 +600,7 @@ void DSPEmitter::mulcac(const UDSPInstruction opc)
   //	Update_SR_Register64(dsp_get_long_acc(rreg));
   if (FlagsNeeded())
   {
+    get_long_acc(rreg);
     Update_SR_Register64();
   }
 }
@@ -620,6 +635,7 @@ void DSPEmitter::mulcmv(const UDSPInstruction opc)
   //	Update_SR_Register64(dsp_get_long_acc(rreg));
   if (FlagsNeeded())
   {
+    get_long_acc(rreg);
     Update_SR_Register64();
   }
 }
@@ -655,6 +671,7 @@ void DSPEmitter::mulcmvz(const UDSPInstruction opc)
   //	Update_SR_Register64(dsp_get_long_acc(rreg));
   if (FlagsNeeded())
   {
+    get_long_acc(rreg);
     Update_SR_Register64();
   }
 }
@@ -820,29 +820,6 @@ void DSPJitRegCache::PutReg(int reg, bool dirty)
       }
     }
     break;
-  case DSP_REG_SR:
-    if (dirty)
-    {
-      if (oparg.IsSimpleReg())
-      {
-        // register is already shifted correctly
-        // (if at all)
-
-        // Clear SR_100, which always reads back as 0
-        m_emitter.AND(16, R(oparg.GetSimpleReg()), Gen::Imm16(~SR_100));
-      }
-      else if (oparg.IsImm())
-      {
-        // TODO: Immediates?
-        ASSERT(false);
-      }
-      else
-      {
-        // Clear SR_100, which always reads back as 0
-        m_emitter.AND(16, m_regs[reg].loc, Gen::Imm16(~SR_100));
-      }
-    }
-    break;
   default:
     break;
   }
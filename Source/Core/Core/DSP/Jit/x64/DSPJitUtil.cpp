@@ -117,6 +117,16 @@ void DSPEmitter::dsp_op_write_reg(int reg, Gen::X64Reg host_sreg)
     dsp_reg_store_stack(static_cast<StackRegister>(reg - DSP_REG_ST0), host_sreg);
     break;
 
+  case DSP_REG_SR:
+  {
+    // Clear SR_100, which always reads back as 0
+    m_gpr.WriteReg(reg, R(host_sreg));
+    const OpArg sr_reg = m_gpr.GetReg(DSP_REG_SR);
+    AND(16, sr_reg, Imm16(~SR_100));
+    m_gpr.PutReg(DSP_REG_SR);
+    break;
+  }
+
   default:
     m_gpr.WriteReg(reg, R(host_sreg));
     break;
@@ -135,6 +145,11 @@ void DSPEmitter::dsp_op_write_reg_imm(int reg, u16 val)
     dsp_reg_store_stack_imm(static_cast<StackRegister>(reg - DSP_REG_ST0), val);
     break;
 
+  case DSP_REG_SR:
+    // Clear SR_100, which always reads back as 0
+    m_gpr.WriteReg(reg, Imm16(val & ~SR_100));
+    break;
+
   default:
     m_gpr.WriteReg(reg, Imm16(val));
     break;
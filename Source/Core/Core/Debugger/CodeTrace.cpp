@@ -10,6 +10,7 @@
 #include "Common/Event.h"
 #include "Core/Core.h"
 #include "Core/Debugger/PPCDebugInterface.h"
+#include "Core/Debugger/TraceFile.h"
 #include "Core/HW/CPU.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
@@ -226,6 +227,37 @@ AutoStepResults CodeTrace::AutoStepping(const Core::CPUThreadGuard& guard, bool
   return results;
 }
 
+std::optional<u64> CodeTrace::RecordTrace(const Core::CPUThreadGuard& guard,
+                                          const std::string& path, u64 instruction_count)
+{
+  std::unique_ptr<TraceFile::Writer> writer = TraceFile::Writer::Create(path);
+  if (!writer)
+    return std::nullopt;
+
+  // Unlike AutoStepping, this keeps the current core, so that traces of the JIT and the
+  // interpreter can be compared. Single stepping makes the JIT compile one instruction at a time,
+  // so this only compares instructions on their own (see the comment in the header).
+  auto& system = guard.GetSystem();
+  auto& power_pc = system.GetPowerPC();
+  auto& ppc_state = system.GetPPCState();
+  power_pc.GetBreakPoints().ClearAllTemporary();
+
+  TraceFile::Recorder recorder(std::move(writer));
+  for (u64 i = 0; i < instruction_count; ++i)
+  {
+    if (i != 0 && power_pc.GetBreakPoints().IsAddressBreakPoint(ppc_state.pc))
+      break;
+
+    recorder.BeforeStep(guard);
+    power_pc.SingleStep();
+    recorder.AfterStep(guard);
+  }
+
+  if (!recorder.Close())
+    return std::nullopt;
+  return recorder.GetRecordCount();
+}
+
 HitType CodeTrace::TraceLogic(const TraceOutput& current_instr, bool first_hit)
 {
   // Tracks the original value that is in the targeted register or memory through loads, stores,
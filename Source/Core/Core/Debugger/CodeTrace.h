@@ -71,6 +71,17 @@ public:
   AutoStepResults AutoStepping(const Core::CPUThreadGuard& guard, bool continue_previous = false,
                                AutoStop stop_on = AutoStop::Always);
 
+  // Steps the current CPU core and writes each instruction to a TraceFile, stopping after
+  // instruction_count instructions or at a breakpoint. Returns how many were recorded, or nothing
+  // if the file couldn't be written.
+  //
+  // While stepping, the JITs compile every instruction as a block of its own, without block
+  // linking or the optimizations that span several instructions (such as branch merging and
+  // carry merging). A trace of a JIT can therefore miss miscompilations that only happen in
+  // longer blocks. PowerPC::LockstepTester checks whole blocks against the interpreter instead.
+  std::optional<u64> RecordTrace(const Core::CPUThreadGuard& guard, const std::string& path,
+                                 u64 instruction_count);
+
 private:
   InstructionAttributes GetInstructionAttributes(const TraceOutput& line) const;
   TraceOutput SaveCurrentInstruction(const Core::CPUThreadGuard& guard) const;
@@ -0,0 +1,565 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/Debugger/TraceFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <zstd.h>
+
+#include "Common/Logging/Log.h"
+#include "Core/Core.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+namespace TraceFile
+{
+namespace
+{
+// How much encoded data is compressed into each frame.
+constexpr size_t CHUNK_SIZE = 1024 * 1024;
+
+enum RecordFlags : u8
+{
+  RECORD_FLAG_MEMORY = 1 << 0,
+  RECORD_FLAG_STORE = 1 << 1,
+};
+
+// pc, instruction, flags and the three change counts
+constexpr size_t RECORD_HEADER_SIZE = 12;
+constexpr size_t GPR_CHANGE_SIZE = 5;
+constexpr size_t FPR_CHANGE_SIZE = 17;
+constexpr size_t SPECIAL_REGISTER_CHANGE_SIZE = 5;
+constexpr size_t MEMORY_ACCESS_SIZE = 13;
+
+template <typename T>
+void Append(std::vector<u8>* buffer, T value)
+{
+  const size_t position = buffer->size();
+  buffer->resize(position + sizeof(T));
+  std::memcpy(buffer->data() + position, &value, sizeof(T));
+}
+
+template <typename T>
+T Extract(const u8** data)
+{
+  T value;
+  std::memcpy(&value, *data, sizeof(T));
+  *data += sizeof(T);
+  return value;
+}
+
+u32 GetQuantizedSize(const PowerPC::PowerPCState& ppc_state, u32 gqr, bool is_store,
+                     bool single)
+{
+  const UGQR quantization(GQR(ppc_state, gqr));
+  u32 element_size;
+  switch (is_store ? quantization.st_type : quantization.ld_type)
+  {
+  case QUANTIZE_U8:
+  case QUANTIZE_S8:
+    element_size = 1;
+    break;
+  case QUANTIZE_U16:
+  case QUANTIZE_S16:
+    element_size = 2;
+    break;
+  default:
+    element_size = 4;
+    break;
+  }
+  return single ? element_size : element_size * 2;
+}
+}  // namespace
+
+const char* GetSpecialRegisterName(SpecialRegister reg)
+{
+  static constexpr std::array<const char*, NUM_SPECIAL_REGISTERS> names{
+      "lr", "ctr", "cr", "xer", "msr", "fpscr", "srr0", "srr1",
+  };
+  return names[static_cast<u8>(reg)];
+}
+
+void Record::Clear()
+{
+  gprs.clear();
+  fprs.clear();
+  special_registers.clear();
+  memory.reset();
+}
+
+RegisterState RegisterState::Capture(const PowerPC::PowerPCState& ppc_state)
+{
+  RegisterState state;
+  std::copy(std::begin(ppc_state.gpr), std::end(ppc_state.gpr), state.gprs.begin());
+  for (size_t i = 0; i < state.fprs.size(); ++i)
+    state.fprs[i] = {ppc_state.ps[i].PS0AsU64(), ppc_state.ps[i].PS1AsU64()};
+
+  state.special_registers = {
+      LR(ppc_state),     CTR(ppc_state),      ppc_state.cr.Get(), ppc_state.GetXER().Hex,
+      ppc_state.msr.Hex, ppc_state.fpscr.Hex, SRR0(ppc_state),    SRR1(ppc_state),
+  };
+  return state;
+}
+
+void RegisterState::Apply(const Record& record)
+{
+  for (const GPRChange& change : record.gprs)
+    gprs[change.index] = change.value;
+  for (const FPRChange& change : record.fprs)
+    fprs[change.index] = {change.ps0, change.ps1};
+  for (const SpecialRegisterChange& change : record.special_registers)
+    special_registers[static_cast<u8>(change.reg)] = change.value;
+}
+
+std::optional<MemoryAccess> GetMemoryAccess(const PowerPC::PowerPCState& ppc_state,
+                                            u32 instruction)
+{
+  const UGeckoInstruction inst(instruction);
+  const u32 base = inst.RA == 0 ? 0 : ppc_state.gpr[inst.RA];
+  const u32 displacement = base + static_cast<u32>(inst.SIMM_16);
+  const u32 indexed = base + ppc_state.gpr[inst.RB];
+
+  const auto access = [](u32 address, u32 size, bool is_store) {
+    return MemoryAccess{address, static_cast<u8>(size), is_store, 0};
+  };
+
+  switch (inst.OPCD)
+  {
+  case 4:  // psq_lx, psq_stx, psq_lux, psq_stux
+  {
+    const bool is_store = inst.SUBOP6 == 7 || inst.SUBOP6 == 39;
+    if (inst.SUBOP6 != 6 && inst.SUBOP6 != 7 && inst.SUBOP6 != 38 && inst.SUBOP6 != 39)
+      return std::nullopt;
+    return access(indexed, GetQuantizedSize(ppc_state, inst.Ix, is_store, inst.Wx), is_store);
+  }
+  case 32:  // lwz
+  case 33:  // lwzu
+  case 46:  // lmw
+  case 48:  // lfs
+  case 49:  // lfsu
+    return access(displacement, 4, false);
+  case 34:  // lbz
+  case 35:  // lbzu
+    return access(displacement, 1, false);
+  case 36:  // stw
+  case 37:  // stwu
+  case 47:  // stmw
+  case 52:  // stfs
+  case 53:  // stfsu
+    return access(displacement, 4, true);
+  case 38:  // stb
+  case 39:  // stbu
+    return access(displacement, 1, true);
+  case 40:  // lhz
+  case 41:  // lhzu
+  case 42:  // lha
+  case 43:  // lhau
+    return access(displacement, 2, false);
+  case 44:  // sth
+  case 45:  // sthu
+    return access(displacement, 2, true);
+  case 50:  // lfd
+  case 51:  // lfdu
+    return access(displacement, 8, false);
+  case 54:  // stfd
+  case 55:  // stfdu
+    return access(displacement, 8, true);
+  case 56:  // psq_l
+  case 57:  // psq_lu
+  case 60:  // psq_st
+  case 61:  // psq_stu
+  {
+    const bool is_store = inst.OPCD >= 60;
+    return access(base + static_cast<u32>(inst.SIMM_12),
+                  GetQuantizedSize(ppc_state, inst.I, is_store, inst.W), is_store);
+  }
+  case 31:
+    switch (inst.SUBOP10)
+    {
+    case 20:   // lwarx
+    case 23:   // lwzx
+    case 55:   // lwzux
+    case 534:  // lwbrx
+    case 535:  // lfsx
+    case 567:  // lfsux
+      return access(indexed, 4, false);
+    case 87:   // lbzx
+    case 119:  // lbzux
+      return access(indexed, 1, false);
+    case 279:  // lhzx
+    case 311:  // lhzux
+    case 343:  // lhax
+    case 375:  // lhaux
+    case 790:  // lhbrx
+      return access(indexed, 2, false);
+    case 599:  // lfdx
+    case 631:  // lfdux
+      return access(indexed, 8, false);
+    case 150:  // stwcx.
+    case 151:  // stwx
+    case 183:  // stwux
+    case 662:  // stwbrx
+    case 663:  // stfsx
+    case 695:  // stfsux
+    case 983:  // stfiwx
+      return access(indexed, 4, true);
+    case 215:  // stbx
+    case 247:  // stbux
+      return access(indexed, 1, true);
+    case 407:  // sthx
+    case 439:  // sthux
+    case 918:  // sthbrx
+      return access(indexed, 2, true);
+    case 727:  // stfdx
+    case 759:  // stfdux
+      return access(indexed, 8, true);
+    default:
+      return std::nullopt;
+    }
+  default:
+    return std::nullopt;
+  }
+}
+
+std::unique_ptr<Writer> Writer::Create(const std::string& path, int compression_level)
+{
+  File::IOFile file(path, "wb");
+  const FileHeader header{FILE_MAGIC, FILE_VERSION};
+  if (!file || !file.WriteArray(&header, 1))
+  {
+    ERROR_LOG_FMT(POWERPC, "Failed to create the trace file {}", path);
+    return nullptr;
+  }
+
+  ZSTD_CCtx* cctx = ZSTD_createCCtx();
+  if (!cctx || ZSTD_isError(ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel,
+                                                   compression_level)))
+  {
+    ZSTD_freeCCtx(cctx);
+    return nullptr;
+  }
+
+  return std::unique_ptr<Writer>(new Writer(std::move(file), cctx));
+}
+
+Writer::Writer(File::IOFile file, ZSTD_CCtx_s* cctx)
+    : m_file(std::move(file)), m_cctx(cctx), m_compressed_buffer(ZSTD_compressBound(CHUNK_SIZE))
+{
+  m_buffer.reserve(CHUNK_SIZE);
+  m_compress_thread.Reset("Trace Compression",
+                          [this](std::vector<u8> chunk) { CompressChunk(std::move(chunk)); });
+}
+
+Writer::~Writer()
+{
+  Close();
+  ZSTD_freeCCtx(m_cctx);
+}
+
+void Writer::Write(const Record& record)
+{
+  u8 flags = 0;
+  if (record.memory)
+    flags |= RECORD_FLAG_MEMORY | (record.memory->is_store ? RECORD_FLAG_STORE : 0);
+
+  Append(&m_buffer, record.pc);
+  Append(&m_buffer, record.instruction);
+  Append(&m_buffer, flags);
+  Append(&m_buffer, static_cast<u8>(record.gprs.size()));
+  Append(&m_buffer, static_cast<u8>(record.fprs.size()));
+  Append(&m_buffer, static_cast<u8>(record.special_registers.size()));
+  for (const GPRChange& change : record.gprs)
+  {
+    Append(&m_buffer, change.index);
+    Append(&m_buffer, change.value);
+  }
+  for (const FPRChange& change : record.fprs)
+  {
+    Append(&m_buffer, change.index);
+    Append(&m_buffer, change.ps0);
+    Append(&m_buffer, change.ps1);
+  }
+  for (const SpecialRegisterChange& change : record.special_registers)
+  {
+    Append(&m_buffer, static_cast<u8>(change.reg));
+    Append(&m_buffer, change.value);
+  }
+  if (record.memory)
+  {
+    Append(&m_buffer, record.memory->address);
+    Append(&m_buffer, record.memory->size);
+    Append(&m_buffer, record.memory->value);
+  }
+
+  ++m_record_count;
+
+  if (m_buffer.size() >= CHUNK_SIZE)
+  {
+    m_compress_thread.Push(std::move(m_buffer));
+    m_buffer = {};
+    m_buffer.reserve(CHUNK_SIZE);
+  }
+}
+
+void Writer::CompressChunk(std::vector<u8> chunk)
+{
+  if (m_failed)
+    return;
+
+  // A record can end past CHUNK_SIZE, so the chunk can be slightly bigger than that.
+  const size_t bound = ZSTD_compressBound(chunk.size());
+  if (m_compressed_buffer.size() < bound)
+    m_compressed_buffer.resize(bound);
+
+  const size_t compressed_size = ZSTD_compress2(m_cctx, m_compressed_buffer.data(),
+                                                m_compressed_buffer.size(), chunk.data(),
+                                                chunk.size());
+  if (ZSTD_isError(compressed_size) ||
+      !m_file.WriteBytes(m_compressed_buffer.data(), compressed_size))
+  {
+    ERROR_LOG_FMT(POWERPC, "Failed to write to the trace file");
+    m_failed = true;
+  }
+}
+
+bool Writer::Close()
+{
+  if (!m_file)
+    return !m_failed;
+
+  if (!m_buffer.empty())
+  {
+    m_compress_thread.Push(std::move(m_buffer));
+    m_buffer = {};
+  }
+  m_compress_thread.Shutdown();
+
+  if (!m_file.Close())
+    m_failed = true;
+  return !m_failed;
+}
+
+std::unique_ptr<Reader> Reader::Open(const std::string& path)
+{
+  File::IOFile file(path, "rb");
+  FileHeader header;
+  if (!file || !file.ReadArray(&header, 1) || header.magic != FILE_MAGIC ||
+      header.version != FILE_VERSION)
+  {
+    return nullptr;
+  }
+
+  ZSTD_DCtx* dctx = ZSTD_createDCtx();
+  if (!dctx)
+    return nullptr;
+
+  return std::unique_ptr<Reader>(new Reader(std::move(file), dctx));
+}
+
+Reader::Reader(File::IOFile file, ZSTD_DCtx_s* dctx)
+    : m_file(std::move(file)), m_dctx(dctx), m_input(ZSTD_DStreamInSize()),
+      m_output(ZSTD_DStreamOutSize())
+{
+}
+
+Reader::~Reader()
+{
+  ZSTD_freeDCtx(m_dctx);
+}
+
+bool Reader::Fill(size_t size)
+{
+  if (m_output_size - m_output_position >= size)
+    return true;
+
+  std::memmove(m_output.data(), m_output.data() + m_output_position,
+               m_output_size - m_output_position);
+  m_output_size -= m_output_position;
+  m_output_position = 0;
+
+  while (m_output_size < size)
+  {
+    ZSTD_inBuffer in{m_input.data(), m_input_size, m_input_position};
+    ZSTD_outBuffer out{m_output.data(), m_output.size(), m_output_size};
+    const size_t result = ZSTD_decompressStream(m_dctx, &out, &in);
+    if (ZSTD_isError(result))
+    {
+      m_error = true;
+      return false;
+    }
+
+    const bool progress = out.pos != m_output_size || in.pos != m_input_position;
+    m_output_size = out.pos;
+    m_input_position = in.pos;
+    if (result == 0)
+      m_frame_done = true;
+    else if (progress)
+      m_frame_done = false;
+
+    if (progress)
+      continue;
+
+    if (m_input_position != m_input_size)
+    {
+      m_error = true;
+      return false;
+    }
+
+    size_t read_size = 0;
+    m_file.ReadArray(m_input.data(), m_input.size(), &read_size);
+    if (read_size == 0)
+    {
+      // Running out in the middle of a frame or a record means the trace was cut off.
+      if (!m_frame_done || m_output_size != 0)
+        m_error = true;
+      return false;
+    }
+    m_input_size = read_size;
+    m_input_position = 0;
+  }
+
+  return true;
+}
+
+bool Reader::Read(Record* record)
+{
+  if (m_error || !Fill(RECORD_HEADER_SIZE))
+    return false;
+
+  const u8* header = m_output.data() + m_output_position;
+  record->Clear();
+  record->pc = Extract<u32>(&header);
+  record->instruction = Extract<u32>(&header);
+  const u8 flags = Extract<u8>(&header);
+  const u8 gpr_count = Extract<u8>(&header);
+  const u8 fpr_count = Extract<u8>(&header);
+  const u8 special_register_count = Extract<u8>(&header);
+  if (gpr_count > 32 || fpr_count > 32 || special_register_count > NUM_SPECIAL_REGISTERS)
+  {
+    m_error = true;
+    return false;
+  }
+
+  const size_t size = RECORD_HEADER_SIZE + gpr_count * GPR_CHANGE_SIZE +
+                      fpr_count * FPR_CHANGE_SIZE +
+                      special_register_count * SPECIAL_REGISTER_CHANGE_SIZE +
+                      ((flags & RECORD_FLAG_MEMORY) != 0 ? MEMORY_ACCESS_SIZE : 0);
+  if (!Fill(size))
+  {
+    m_error = true;
+    return false;
+  }
+
+  const u8* data = m_output.data() + m_output_position + RECORD_HEADER_SIZE;
+  m_output_position += size;
+
+  for (u8 i = 0; i < gpr_count; ++i)
+  {
+    const u8 index = Extract<u8>(&data);
+    const u32 value = Extract<u32>(&data);
+    record->gprs.push_back({index, value});
+  }
+  for (u8 i = 0; i < fpr_count; ++i)
+  {
+    const u8 index = Extract<u8>(&data);
+    const u64 ps0 = Extract<u64>(&data);
+    const u64 ps1 = Extract<u64>(&data);
+    record->fprs.push_back({index, ps0, ps1});
+  }
+  for (u8 i = 0; i < special_register_count; ++i)
+  {
+    const u8 reg = Extract<u8>(&data);
+    const u32 value = Extract<u32>(&data);
+    record->special_registers.push_back({static_cast<SpecialRegister>(reg), value});
+  }
+  if ((flags & RECORD_FLAG_MEMORY) != 0)
+  {
+    MemoryAccess& memory = record->memory.emplace();
+    memory.address = Extract<u32>(&data);
+    memory.size = Extract<u8>(&data);
+    memory.is_store = (flags & RECORD_FLAG_STORE) != 0;
+    memory.value = Extract<u64>(&data);
+  }
+
+  const bool valid =
+      std::all_of(record->gprs.begin(), record->gprs.end(),
+                  [](const GPRChange& change) { return change.index < 32; }) &&
+      std::all_of(record->fprs.begin(), record->fprs.end(),
+                  [](const FPRChange& change) { return change.index < 32; }) &&
+      std::all_of(record->special_registers.begin(), record->special_registers.end(),
+                  [](const SpecialRegisterChange& change) {
+                    return static_cast<u8>(change.reg) < NUM_SPECIAL_REGISTERS;
+                  });
+  if (!valid)
+    m_error = true;
+  return valid;
+}
+
+Recorder::Recorder(std::unique_ptr<Writer> writer) : m_writer(std::move(writer))
+{
+}
+
+void Recorder::BeforeStep(const Core::CPUThreadGuard& guard)
+{
+  const auto& ppc_state = guard.GetSystem().GetPPCState();
+
+  m_record.Clear();
+  m_record.pc = ppc_state.pc;
+  m_record.instruction = PowerPC::MMU::HostRead_Instruction(guard, ppc_state.pc);
+  m_record.memory = GetMemoryAccess(ppc_state, m_record.instruction);
+}
+
+void Recorder::AfterStep(const Core::CPUThreadGuard& guard)
+{
+  const auto& ppc_state = guard.GetSystem().GetPPCState();
+  const RegisterState state = RegisterState::Capture(ppc_state);
+
+  for (u8 i = 0; i < state.gprs.size(); ++i)
+  {
+    if (!m_has_state || state.gprs[i] != m_state.gprs[i])
+      m_record.gprs.push_back({i, state.gprs[i]});
+  }
+  for (u8 i = 0; i < state.fprs.size(); ++i)
+  {
+    if (!m_has_state || state.fprs[i] != m_state.fprs[i])
+      m_record.fprs.push_back({i, state.fprs[i][0], state.fprs[i][1]});
+  }
+  for (u8 i = 0; i < state.special_registers.size(); ++i)
+  {
+    if (!m_has_state || state.special_registers[i] != m_state.special_registers[i])
+    {
+      m_record.special_registers.push_back(
+          {static_cast<SpecialRegister>(i), state.special_registers[i]});
+    }
+  }
+
+  if (m_record.memory && PowerPC::MMU::HostIsRAMAddress(guard, m_record.memory->address))
+  {
+    const u32 address = m_record.memory->address;
+    switch (m_record.memory->size)
+    {
+    case 1:
+      m_record.memory->value = PowerPC::MMU::HostRead_U8(guard, address);
+      break;
+    case 2:
+      m_record.memory->value = PowerPC::MMU::HostRead_U16(guard, address);
+      break;
+    case 4:
+      m_record.memory->value = PowerPC::MMU::HostRead_U32(guard, address);
+      break;
+    default:
+      m_record.memory->value = PowerPC::MMU::HostRead_U64(guard, address);
+      break;
+    }
+  }
+
+  m_writer->Write(m_record);
+  m_state = state;
+  m_has_state = true;
+}
+}  // namespace TraceFile
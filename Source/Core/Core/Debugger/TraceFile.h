@@ -0,0 +1,205 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// A compact binary format for instruction traces, meant for traces of millions of instructions,
+// such as for finding where two CPU cores diverge.
+//
+// The file starts with a FileHeader, followed by Zstandard frames that decompress to one record
+// per executed instruction. A record holds the PC, the instruction, the registers the instruction
+// changed, and the memory access it made, if any. The first record of a trace holds every
+// register, so the full register state after any instruction can be rebuilt from the records.
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/WorkQueueThread.h"
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+
+namespace Core
+{
+class CPUThreadGuard;
+}
+
+namespace PowerPC
+{
+struct PowerPCState;
+}
+
+namespace TraceFile
+{
+constexpr u32 FILE_MAGIC = 0x43525444;  // "DTRC"
+constexpr u32 FILE_VERSION = 1;
+
+struct FileHeader
+{
+  u32 magic;
+  u32 version;
+};
+static_assert(sizeof(FileHeader) == 8);
+
+enum class SpecialRegister : u8
+{
+  LR,
+  CTR,
+  CR,
+  XER,
+  MSR,
+  FPSCR,
+  SRR0,
+  SRR1,
+};
+constexpr u32 NUM_SPECIAL_REGISTERS = 8;
+
+const char* GetSpecialRegisterName(SpecialRegister reg);
+
+struct GPRChange
+{
+  u8 index;
+  u32 value;
+};
+
+struct FPRChange
+{
+  u8 index;
+  u64 ps0;
+  u64 ps1;
+};
+
+struct SpecialRegisterChange
+{
+  SpecialRegister reg;
+  u32 value;
+};
+
+struct MemoryAccess
+{
+  u32 address;
+  u8 size;
+  bool is_store;
+  // The memory contents after the instruction ran, or 0 if the address isn't in RAM.
+  u64 value;
+
+  bool operator==(const MemoryAccess& other) const = default;
+};
+
+struct Record
+{
+  u32 pc = 0;
+  u32 instruction = 0;
+  std::vector<GPRChange> gprs;
+  std::vector<FPRChange> fprs;
+  std::vector<SpecialRegisterChange> special_registers;
+  std::optional<MemoryAccess> memory;
+
+  void Clear();
+};
+
+struct RegisterState
+{
+  std::array<u32, 32> gprs{};
+  std::array<std::array<u64, 2>, 32> fprs{};
+  std::array<u32, NUM_SPECIAL_REGISTERS> special_registers{};
+
+  static RegisterState Capture(const PowerPC::PowerPCState& ppc_state);
+  void Apply(const Record& record);
+
+  bool operator==(const RegisterState& other) const = default;
+};
+
+// Encodes records on the calling thread, and compresses and writes them on a worker thread.
+class Writer
+{
+public:
+  static constexpr int DEFAULT_COMPRESSION_LEVEL = 3;
+
+  static std::unique_ptr<Writer> Create(const std::string& path,
+                                        int compression_level = DEFAULT_COMPRESSION_LEVEL);
+  Writer(const Writer&) = delete;
+  Writer& operator=(const Writer&) = delete;
+  ~Writer();
+
+  void Write(const Record& record);
+  u64 GetRecordCount() const { return m_record_count; }
+
+  // Writes out the remaining records and closes the file. Returns false if anything failed.
+  bool Close();
+
+private:
+  Writer(File::IOFile file, ZSTD_CCtx_s* cctx);
+
+  void CompressChunk(std::vector<u8> chunk);
+
+  File::IOFile m_file;
+  ZSTD_CCtx_s* m_cctx;
+  std::vector<u8> m_compressed_buffer;
+  std::vector<u8> m_buffer;
+  u64 m_record_count = 0;
+  std::atomic<bool> m_failed = false;
+  Common::WorkQueueThread<std::vector<u8>> m_compress_thread;
+};
+
+class Reader
+{
+public:
+  static std::unique_ptr<Reader> Open(const std::string& path);
+  Reader(const Reader&) = delete;
+  Reader& operator=(const Reader&) = delete;
+  ~Reader();
+
+  // Returns false at the end of the trace, or if the trace is corrupt.
+  bool Read(Record* record);
+  bool HasError() const { return m_error; }
+
+private:
+  Reader(File::IOFile file, ZSTD_DCtx_s* dctx);
+
+  bool Fill(size_t size);
+
+  File::IOFile m_file;
+  ZSTD_DCtx_s* m_dctx;
+  std::vector<u8> m_input;
+  size_t m_input_position = 0;
+  size_t m_input_size = 0;
+  std::vector<u8> m_output;
+  size_t m_output_position = 0;
+  size_t m_output_size = 0;
+  bool m_frame_done = true;
+  bool m_error = false;
+};
+
+// Records the instructions run by a CPU core that is being stepped one instruction at a time.
+class Recorder
+{
+public:
+  explicit Recorder(std::unique_ptr<Writer> writer);
+
+  // These must be called on the CPU thread around each instruction.
+  void BeforeStep(const Core::CPUThreadGuard& guard);
+  void AfterStep(const Core::CPUThreadGuard& guard);
+
+  u64 GetRecordCount() const { return m_writer->GetRecordCount(); }
+  bool Close() { return m_writer->Close(); }
+
+private:
+  std::unique_ptr<Writer> m_writer;
+  Record m_record;
+  RegisterState m_state;
+  bool m_has_state = false;
+};
+
+// Works out which memory access an instruction is going to make. Only the loads and stores with
+// a single access are handled, which leaves out lmw/stmw past the first word, the string
+// instructions and the cache instructions.
+std::optional<MemoryAccess> GetMemoryAccess(const PowerPC::PowerPCState& ppc_state,
+                                            u32 instruction);
+}  // namespace TraceFile
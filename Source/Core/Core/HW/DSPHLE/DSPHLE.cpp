@@ -3,9 +3,12 @@
 
 #include "Core/HW/DSPHLE/DSPHLE.h"
 
+#include <algorithm>
+
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
@@ -33,6 +36,9 @@ bool DSPHLE::Initialize(bool wii, bool dsp_thread)
 
   m_dsp_state.Reset();
 
+  const int voice_threads = Config::Get(Config::MAIN_DSP_HLE_VOICE_THREADS);
+  m_voice_workers.SetWorkerCount(static_cast<size_t>(std::max(voice_threads, 0)));
+
   return true;
 }
 
@@ -43,6 +49,7 @@ void DSPHLE::DSP_StopSoundStream()
 void DSPHLE::Shutdown()
 {
   m_ucode = nullptr;
+  m_voice_workers.SetWorkerCount(0);
 }
 
 void DSPHLE::DSP_Update(int cycles)
@@ -9,6 +9,7 @@
 #include "Core/DSPEmulator.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/MailHandler.h"
+#include "Core/HW/DSPHLE/VoiceWorkers.h"
 
 class PointerWrap;
 
@@ -39,6 +40,7 @@ public:
   u32 DSP_UpdateRate() override;
 
   CMailHandler& AccessMailHandler() { return m_mail_handler; }
+  VoiceWorkers& GetVoiceWorkers() { return m_voice_workers; }
   void SetUCode(u32 crc);
   void SwapUCode(u32 crc);
 
@@ -67,5 +69,6 @@ private:
   DSP::UDSPControl m_dsp_control;
   u64 m_control_reg_init_code_clear_time = 0;
   CMailHandler m_mail_handler;
+  VoiceWorkers m_voice_workers;
 };
 }  // namespace DSP::HLE
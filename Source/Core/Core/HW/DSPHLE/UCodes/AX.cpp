@@ -7,6 +7,7 @@
 #include <array>
 #include <cstring>
 #include <iterator>
+#include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -404,16 +405,13 @@ void AXUCode::ProcessPBList(u32 pb_addr)
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
-  AXPB pb;
-
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
-                          m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
-                          m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround}};
-
-    ReadPB(pb_addr, pb, m_crc);
+  const AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
+                              m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
+                              m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround}};
+  const s16* coeffs = m_coeffs_checksum ? m_coeffs.data() : nullptr;
 
+  // Processes 5ms of a PB. This may run on several threads at once.
+  const auto process_pb = [&](AXPB& pb, AXBuffers pb_buffers) {
     u32 updates_addr = HILO_TO_32(pb.updates.data);
     u16* updates = (u16*)HLEMemory_Get_Pointer(updates_addr);
 
@@ -421,17 +419,56 @@ void AXUCode::ProcessPBList(u32 pb_addr)
     {
       ApplyUpdatesForMs(curr_ms, pb, pb.updates.num_updates, updates);
 
-      ProcessVoice(pb, buffers, spms, ConvertMixerControl(pb.mixer_control),
-                   m_coeffs_checksum ? m_coeffs.data() : nullptr);
+      ProcessVoice(pb, pb_buffers, spms, ConvertMixerControl(pb.mixer_control), coeffs);
 
       // Forward the buffers
-      for (auto& ptr : buffers.ptrs)
+      for (auto& ptr : pb_buffers.ptrs)
         ptr += spms;
     }
+  };
+
+  VoiceWorkers& workers = m_dsphle->GetVoiceWorkers();
+  if (!workers.IsParallel())
+  {
+    AXPB pb;
+
+    while (pb_addr)
+    {
+      ReadPB(pb_addr, pb, m_crc);
+      ReportUnimplementedFeatures(pb);
+
+      process_pb(pb, buffers);
+
+      WritePB(pb_addr, pb, m_crc);
+      pb_addr = HILO_TO_32(pb.next_pb);
+    }
+    return;
+  }
 
-    WritePB(pb_addr, pb, m_crc);
-    pb_addr = HILO_TO_32(pb.next_pb);
+  // Read the whole list first. The updates can change the address of the next PB, so they are
+  // applied to a copy of each PB to find it.
+  std::vector<u32> pb_addrs;
+  std::vector<AXPB> pbs;
+  while (pb_addr)
+  {
+    AXPB& pb = pbs.emplace_back();
+    ReadPB(pb_addr, pb, m_crc);
+    ReportUnimplementedFeatures(pb);
+    pb_addrs.push_back(pb_addr);
+
+    AXPB updated_pb = pb;
+    u16* updates = (u16*)HLEMemory_Get_Pointer(HILO_TO_32(pb.updates.data));
+    for (int curr_ms = 0; curr_ms < 5; ++curr_ms)
+      ApplyUpdatesForMs(curr_ms, updated_pb, updated_pb.updates.num_updates, updates);
+    pb_addr = HILO_TO_32(updated_pb.next_pb);
   }
+
+  std::array<u32, AX_BUFFER_COUNT> buffer_sizes;
+  buffer_sizes.fill(spms * 5);
+  ProcessPBsInParallel(workers, pbs, buffers, buffer_sizes, process_pb);
+
+  for (size_t i = 0; i < pbs.size(); ++i)
+    WritePB(pb_addrs[i], pbs[i], m_crc);
 }
 
 void AXUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr)
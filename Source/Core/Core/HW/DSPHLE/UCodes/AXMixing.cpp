@@ -0,0 +1,359 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/UCodes/AXMixing.h"
+
+#include <algorithm>
+#include <array>
+
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
+#include "Common/CommonTypes.h"
+#include "Common/MathUtil.h"
+#include "Core/HW/DSPHLE/UCodes/AXStructs.h"
+
+#if defined(_M_X86_64)
+#define USE_SSE
+#elif defined(_M_ARM_64)
+#define USE_NEON
+#endif
+
+namespace DSP::HLE
+{
+namespace
+{
+// Moves the position forward by one output sample. Returns the number of input samples that
+// had to be read to get there.
+u32 AdvancePosition(u32& curr_pos, u32 ratio)
+{
+  curr_pos += ratio;
+  const u32 read = curr_pos >> 16;
+  curr_pos &= 0xFFFF;
+  return read;
+}
+
+// Returns the offset of the polyphase filter for the fractional part of the position.
+u32 GetPolyphasePhase(u32 curr_pos)
+{
+  return ((curr_pos & 0xFFFF) >> 9) << 2;
+}
+
+s16 PolyphaseSample(const s16* window, const s16* c)
+{
+  const s64 t0 = window[0];
+  const s64 t1 = window[1];
+  const s64 t2 = window[2];
+  const s64 t3 = window[3];
+
+  const s64 samp = (t0 * c[0] + t1 * c[1] + t2 * c[2] + t3 * c[3]) >> 15;
+  return MathUtil::SaturatingCast<s16>(samp);
+}
+
+s16 ScaleSample(s16 sample, s32 volume)
+{
+  return static_cast<s16>(std::clamp((s32(sample) * volume) >> 15, -32767, 32767));  // -32768 ?
+}
+
+#if defined(USE_SSE)
+// Computes four output samples. <offsets> are the positions of the filter windows in <input>,
+// <phases> the positions of the filters in <coeffs>.
+void PolyphaseSamples4(const s16* input, const u32* offsets, const s16* coeffs, const u32* phases,
+                       s16* output)
+{
+  const auto load = [](const s16* ptr) {
+    return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(ptr));
+  };
+  const __m128i windows01 = _mm_unpacklo_epi64(load(input + offsets[0]), load(input + offsets[1]));
+  const __m128i windows23 = _mm_unpacklo_epi64(load(input + offsets[2]), load(input + offsets[3]));
+  const __m128i filters01 = _mm_unpacklo_epi64(load(coeffs + phases[0]), load(coeffs + phases[1]));
+  const __m128i filters23 = _mm_unpacklo_epi64(load(coeffs + phases[2]), load(coeffs + phases[3]));
+
+  // Every output sample is the sum of two pairs of products. Separate the first and the second
+  // pairs of the four samples.
+  const __m128 pairs01 = _mm_castsi128_ps(_mm_madd_epi16(windows01, filters01));
+  const __m128 pairs23 = _mm_castsi128_ps(_mm_madd_epi16(windows23, filters23));
+  const __m128i first = _mm_castps_si128(_mm_shuffle_ps(pairs01, pairs23, _MM_SHUFFLE(2, 0, 2, 0)));
+  const __m128i second =
+      _mm_castps_si128(_mm_shuffle_ps(pairs01, pairs23, _MM_SHUFFLE(3, 1, 3, 1)));
+
+  // The sum of both pairs needs 33 bits, so shift the pairs separately and add the carry out of
+  // their low bits. A pair only overflows if all of its operands are -32768, which wraps 2^31
+  // around to INT_MIN.
+  const __m128i int_min = _mm_set1_epi32(static_cast<int>(0x80000000));
+  const __m128i overflow_fixup = _mm_set1_epi32(0x20000);
+  const __m128i low_mask = _mm_set1_epi32(0x7FFF);
+  const auto shift = [&](__m128i pairs) {
+    const __m128i fixup = _mm_and_si128(_mm_cmpeq_epi32(pairs, int_min), overflow_fixup);
+    return _mm_add_epi32(_mm_srai_epi32(pairs, 15), fixup);
+  };
+  const __m128i carry = _mm_srli_epi32(
+      _mm_add_epi32(_mm_and_si128(first, low_mask), _mm_and_si128(second, low_mask)), 15);
+  const __m128i sum = _mm_add_epi32(_mm_add_epi32(shift(first), shift(second)), carry);
+
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(output), _mm_packs_epi32(sum, sum));
+}
+
+// Returns (samples * volumes) >> 15 for eight samples, clamped to [-32767, 32767].
+__m128i ScaleSamples8(__m128i samples, __m128i volumes, bool unsigned_volume)
+{
+  // There is no unsigned * signed multiplication, so the top bit of unsigned volumes is
+  // handled separately: (s * v) >> 15 == s * (v >> 15) + ((s * (v & 0x7FFF)) >> 15)
+  const __m128i factors =
+      unsigned_volume ? _mm_and_si128(volumes, _mm_set1_epi16(0x7FFF)) : volumes;
+  const __m128i products_lo = _mm_mullo_epi16(samples, factors);
+  const __m128i products_hi = _mm_mulhi_epi16(samples, factors);
+  __m128i result_lo = _mm_srai_epi32(_mm_unpacklo_epi16(products_lo, products_hi), 15);
+  __m128i result_hi = _mm_srai_epi32(_mm_unpackhi_epi16(products_lo, products_hi), 15);
+  if (unsigned_volume)
+  {
+    const __m128i extra = _mm_and_si128(samples, _mm_srai_epi16(volumes, 15));
+    result_lo = _mm_add_epi32(result_lo, _mm_srai_epi32(_mm_unpacklo_epi16(extra, extra), 16));
+    result_hi = _mm_add_epi32(result_hi, _mm_srai_epi32(_mm_unpackhi_epi16(extra, extra), 16));
+  }
+  return _mm_max_epi16(_mm_packs_epi32(result_lo, result_hi), _mm_set1_epi16(-32767));
+}
+
+// Returns the volumes for the next eight samples of a ramp.
+__m128i RampVolumes8(u16 volume, u16 volume_delta)
+{
+  alignas(16) std::array<u16, 8> volumes;
+  for (u32 i = 0; i < volumes.size(); ++i)
+    volumes[i] = static_cast<u16>(volume + i * volume_delta);
+  return _mm_load_si128(reinterpret_cast<const __m128i*>(volumes.data()));
+}
+#elif defined(USE_NEON)
+void PolyphaseSamples4(const s16* input, const u32* offsets, const s16* coeffs, const u32* phases,
+                       s16* output)
+{
+  for (u32 i = 0; i < 4; ++i)
+  {
+    const int32x4_t products =
+        vmull_s16(vld1_s16(input + offsets[i]), vld1_s16(coeffs + phases[i]));
+    const s64 sum = vaddvq_s64(vpaddlq_s32(products));
+    output[i] = MathUtil::SaturatingCast<s16>(sum >> 15);
+  }
+}
+
+int16x8_t ScaleSamples8(int16x8_t samples, uint16x8_t volumes, bool unsigned_volume)
+{
+  int32x4_t result_lo;
+  int32x4_t result_hi;
+  if (unsigned_volume)
+  {
+    // The products of s16 and u16 still fit into 32 bits.
+    result_lo = vmulq_s32(vmovl_s16(vget_low_s16(samples)),
+                          vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(volumes))));
+    result_hi = vmulq_s32(vmovl_high_s16(samples), vreinterpretq_s32_u32(vmovl_high_u16(volumes)));
+  }
+  else
+  {
+    const int16x8_t signed_volumes = vreinterpretq_s16_u16(volumes);
+    result_lo = vmull_s16(vget_low_s16(samples), vget_low_s16(signed_volumes));
+    result_hi = vmull_high_s16(samples, signed_volumes);
+  }
+  const int16x8_t result =
+      vcombine_s16(vqmovn_s32(vshrq_n_s32(result_lo, 15)), vqmovn_s32(vshrq_n_s32(result_hi, 15)));
+  return vmaxq_s16(result, vdupq_n_s16(-32767));
+}
+
+uint16x8_t RampVolumes8(u16 volume, u16 volume_delta)
+{
+  std::array<u16, 8> volumes;
+  for (u32 i = 0; i < volumes.size(); ++i)
+    volumes[i] = static_cast<u16>(volume + i * volume_delta);
+  return vld1q_u16(volumes.data());
+}
+#endif
+}  // namespace
+
+u32 GetResampleInputCount(u32 count, u32 curr_pos, u32 ratio, int srctype)
+{
+  if (srctype != SRCTYPE_LINEAR && srctype != SRCTYPE_POLYPHASE)
+    return count;
+
+  u32 read_samples_count = 0;
+  for (u32 i = 0; i < count; ++i)
+    read_samples_count += AdvancePosition(curr_pos, ratio);
+  return read_samples_count;
+}
+
+u32 ResampleAudio(const s16* input, s16* output, u32 count, s16* last_samples, u32 curr_pos,
+                  u32 ratio, int srctype, const s16* coeffs)
+{
+  // input + read_samples_count always points to the oldest of the four most recent samples.
+  u32 read_samples_count = 0;
+
+  // If DSP DROM coefficients are available, support polyphase resampling.
+  if (coeffs && srctype == SRCTYPE_POLYPHASE)
+  {
+    u32 i = 0;
+#if defined(USE_SSE) || defined(USE_NEON)
+    for (; i + 4 <= count; i += 4)
+    {
+      std::array<u32, 4> offsets;
+      std::array<u32, 4> phases;
+      for (u32 j = 0; j < 4; ++j)
+      {
+        read_samples_count += AdvancePosition(curr_pos, ratio);
+        offsets[j] = read_samples_count;
+        phases[j] = GetPolyphasePhase(curr_pos);
+      }
+      PolyphaseSamples4(input, offsets.data(), coeffs, phases.data(), output + i);
+    }
+#endif
+    for (; i < count; ++i)
+    {
+      read_samples_count += AdvancePosition(curr_pos, ratio);
+      output[i] = PolyphaseSample(input + read_samples_count, coeffs + GetPolyphasePhase(curr_pos));
+    }
+  }
+  else if (srctype == SRCTYPE_LINEAR || srctype == SRCTYPE_POLYPHASE)
+  {
+    for (u32 i = 0; i < count; ++i)
+    {
+      read_samples_count += AdvancePosition(curr_pos, ratio);
+
+      // Get our current fractional position, used to know how much of
+      // curr0 and how much of curr1 the output sample should be.
+      const u16 curr_frac = curr_pos & 0xFFFF;
+      const u16 inv_curr_frac = -curr_frac;
+
+      // Interpolate! If curr_frac is 0, we can simply take the last
+      // sample without any multiplying.
+      const s32 s0 = input[read_samples_count];
+      if (curr_frac)
+      {
+        const s32 s1 = input[read_samples_count + 1];
+        output[i] = static_cast<s16>(((s0 * inv_curr_frac) + (s1 * curr_frac)) >> 16);
+      }
+      else
+      {
+        output[i] = static_cast<s16>(s0);
+      }
+    }
+  }
+  else  // SRCTYPE_NEAREST
+  {
+    // No sample rate conversion here: simply copy the input samples to the output buffer.
+    std::copy_n(input + RESAMPLE_HISTORY_SIZE, count, output);
+    read_samples_count = count;
+  }
+
+  // Update the four last_samples values.
+  std::copy_n(input + read_samples_count, RESAMPLE_HISTORY_SIZE, last_samples);
+
+  return curr_pos;
+}
+
+s16 ApplyVolumeEnvelope(s16* samples, u32 count, s16 volume, s16 volume_delta,
+                        bool unsigned_volume)
+{
+  u16 curr_volume = static_cast<u16>(volume);
+  u32 i = 0;
+
+#if defined(USE_SSE)
+  if (count >= 8)
+  {
+    __m128i volumes = RampVolumes8(curr_volume, volume_delta);
+    const __m128i step = _mm_set1_epi16(static_cast<s16>(volume_delta * 8));
+    for (; i + 8 <= count; i += 8)
+    {
+      __m128i* const ptr = reinterpret_cast<__m128i*>(samples + i);
+      _mm_storeu_si128(ptr, ScaleSamples8(_mm_loadu_si128(ptr), volumes, unsigned_volume));
+      volumes = _mm_add_epi16(volumes, step);
+    }
+    curr_volume = static_cast<u16>(curr_volume + i * volume_delta);
+  }
+#elif defined(USE_NEON)
+  if (count >= 8)
+  {
+    uint16x8_t volumes = RampVolumes8(curr_volume, volume_delta);
+    const uint16x8_t step = vdupq_n_u16(static_cast<u16>(volume_delta * 8));
+    for (; i + 8 <= count; i += 8)
+    {
+      vst1q_s16(samples + i, ScaleSamples8(vld1q_s16(samples + i), volumes, unsigned_volume));
+      volumes = vaddq_u16(volumes, step);
+    }
+    curr_volume = static_cast<u16>(curr_volume + i * volume_delta);
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    const s32 v = unsigned_volume ? s32(curr_volume) : s32(s16(curr_volume));
+    samples[i] = ScaleSample(samples[i], v);
+    curr_volume += volume_delta;
+  }
+
+  return static_cast<s16>(curr_volume);
+}
+
+void MixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bool ramp)
+{
+  u16& volume = vd->volume;
+  u16 volume_delta = vd->volume_delta;
+
+  // If volume ramping is disabled, set volume_delta to 0. That way, the
+  // mixing loop can avoid testing if volume ramping is enabled at each step,
+  // and just add volume_delta.
+  if (!ramp)
+    volume_delta = 0;
+
+  u32 i = 0;
+
+#if defined(USE_SSE)
+  if (count >= 8)
+  {
+    __m128i volumes = RampVolumes8(volume, volume_delta);
+    const __m128i step = _mm_set1_epi16(static_cast<s16>(volume_delta * 8));
+    __m128i scaled = _mm_setzero_si128();
+    for (; i + 8 <= count; i += 8)
+    {
+      scaled = ScaleSamples8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)), volumes,
+                             true);
+      volumes = _mm_add_epi16(volumes, step);
+
+      __m128i* const out_lo = reinterpret_cast<__m128i*>(out + i);
+      __m128i* const out_hi = reinterpret_cast<__m128i*>(out + i + 4);
+      const __m128i scaled_lo = _mm_srai_epi32(_mm_unpacklo_epi16(scaled, scaled), 16);
+      const __m128i scaled_hi = _mm_srai_epi32(_mm_unpackhi_epi16(scaled, scaled), 16);
+      _mm_storeu_si128(out_lo, _mm_add_epi32(_mm_loadu_si128(out_lo), scaled_lo));
+      _mm_storeu_si128(out_hi, _mm_add_epi32(_mm_loadu_si128(out_hi), scaled_hi));
+    }
+    volume = static_cast<u16>(volume + i * volume_delta);
+    *dpop = static_cast<s16>(_mm_extract_epi16(scaled, 7));
+  }
+#elif defined(USE_NEON)
+  if (count >= 8)
+  {
+    uint16x8_t volumes = RampVolumes8(volume, volume_delta);
+    const uint16x8_t step = vdupq_n_u16(static_cast<u16>(volume_delta * 8));
+    int16x8_t scaled = vdupq_n_s16(0);
+    for (; i + 8 <= count; i += 8)
+    {
+      scaled = ScaleSamples8(vld1q_s16(input + i), volumes, true);
+      volumes = vaddq_u16(volumes, step);
+
+      vst1q_s32(out + i, vaddw_s16(vld1q_s32(out + i), vget_low_s16(scaled)));
+      vst1q_s32(out + i + 4, vaddw_high_s16(vld1q_s32(out + i + 4), scaled));
+    }
+    volume = static_cast<u16>(volume + i * volume_delta);
+    *dpop = vgetq_lane_s16(scaled, 7);
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    const s16 sample = ScaleSample(input[i], volume);
+
+    out[i] += sample;
+    volume += volume_delta;
+
+    *dpop = sample;
+  }
+}
+}  // namespace DSP::HLE
@@ -0,0 +1,57 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Sample rate conversion and mixing routines shared by AX GC and AX Wii. They work on whole
+// blocks of samples and use SIMD where available, but their results are bit-exact with the
+// straightforward per-sample implementations.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace DSP::HLE
+{
+struct VolumeData;
+
+// Number of history samples that ResampleAudio expects in front of the new input samples.
+constexpr u32 RESAMPLE_HISTORY_SIZE = 4;
+
+// Returns how many new input samples ResampleAudio consumes in order to produce <count> output
+// samples with the given position and ratio.
+u32 GetResampleInputCount(u32 count, u32 curr_pos, u32 ratio, int srctype);
+
+// Resamples the input samples to <count> samples at the wanted sample rate (computed from the
+// ratio, see below).
+//
+// <input> must contain the RESAMPLE_HISTORY_SIZE samples from <last_samples>, followed by the
+// GetResampleInputCount() new input samples. <last_samples> is updated with the last four input
+// samples.
+//
+// If srctype is SRCTYPE_POLYPHASE, coefficients need to be provided as well
+// (or the srctype will automatically be changed to LINEAR).
+//
+// Returns the current position after resampling (including fractional part).
+//
+// The input to output ratio is set in <ratio>, which is a floating point num
+// stored as a 32b integer:
+//  * Upper 16 bits of the ratio are the integer part
+//  * Lower 16 bits are the decimal part
+//
+// <curr_pos> is a 32b integer structured in the same way as the ratio: the
+// upper 16 bits are the integer part of the current position in the input
+// stream, and the lower 16 bits are the decimal part.
+//
+// We start getting samples not from sample 0, but 0.<curr_pos_frac>. This
+// avoids discontinuities in the audio stream, especially with very low ratios
+// which interpolate a lot of values between two "real" samples.
+u32 ResampleAudio(const s16* input, s16* output, u32 count, s16* last_samples, u32 curr_pos,
+                  u32 ratio, int srctype, const s16* coeffs);
+
+// Applies a volume ramp to the samples. The volume is interpreted as a signed value on GameCube
+// and as an unsigned value on Wii. Returns the volume after the last sample.
+s16 ApplyVolumeEnvelope(s16* samples, u32 count, s16 volume, s16 volume_delta,
+                        bool unsigned_volume);
+
+// Add samples to an output buffer, with optional volume ramping.
+void MixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bool ramp);
+}  // namespace DSP::HLE
@@ -12,15 +12,18 @@
 #endif
 
 #include <algorithm>
-#include <functional>
+#include <array>
 #include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Core/DSP/DSPAccelerator.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/UCodes/AX.h"
+#include "Core/HW/DSPHLE/UCodes/AXMixing.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
+#include "Core/HW/DSPHLE/VoiceWorkers.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
 
@@ -29,9 +32,11 @@ namespace DSP::HLE
 #ifdef AX_GC
 #define PB_TYPE AXPB
 #define MAX_SAMPLES_PER_FRAME 32
+#define AX_BUFFER_COUNT 9
 #else
 #define PB_TYPE AXPBWii
 #define MAX_SAMPLES_PER_FRAME 96
+#define AX_BUFFER_COUNT 20
 #endif
 
 // Use an inline namespace to prevent stupid compilers and debuggers from merging
@@ -80,11 +85,7 @@ union AXBuffers
 #endif
   };
 
-#ifdef AX_GC
-  int* ptrs[9];
-#else
-  int* ptrs[20];
-#endif
+  int* ptrs[AX_BUFFER_COUNT];
 };
 
 // Determines if this version of the UCode has a PBLowPassFilter in its AXPB layout.
@@ -152,8 +153,9 @@ void WritePB(u32 addr, const PB_TYPE& pb, u32 crc)
   }
 }
 
-// Simulated accelerator state.
-static PB_TYPE* acc_pb;
+// Simulated accelerator state. Voices can be processed on several threads at once, so every
+// thread has its own.
+static thread_local PB_TYPE* acc_pb;
 
 class HLEAccelerator final : public Accelerator
 {
@@ -197,7 +199,8 @@ protected:
   }
 };
 
-static std::unique_ptr<Accelerator> s_accelerator = std::make_unique<HLEAccelerator>();
+static thread_local std::unique_ptr<Accelerator> s_accelerator =
+    std::make_unique<HLEAccelerator>();
 
 // Sets up the simulated accelerator.
 void AcceleratorSetup(PB_TYPE* pb)
@@ -220,138 +223,6 @@ u16 AcceleratorGetSample()
   return s_accelerator->Read(acc_pb->adpcm.coefs);
 }
 
-// Reads samples from the input callback, resamples them to <count> samples at
-// the wanted sample rate (computed from the ratio, see below).
-//
-// If srctype is SRCTYPE_POLYPHASE, coefficients need to be provided as well
-// (or the srctype will automatically be changed to LINEAR).
-//
-// Returns the current position after resampling (including fractional part).
-//
-// The input to output ratio is set in <ratio>, which is a floating point num
-// stored as a 32b integer:
-//  * Upper 16 bits of the ratio are the integer part
-//  * Lower 16 bits are the decimal part
-//
-// <curr_pos> is a 32b integer structured in the same way as the ratio: the
-// upper 16 bits are the integer part of the current position in the input
-// stream, and the lower 16 bits are the decimal part.
-//
-// We start getting samples not from sample 0, but 0.<curr_pos_frac>. This
-// avoids discontinuities in the audio stream, especially with very low ratios
-// which interpolate a lot of values between two "real" samples.
-u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count, s16* last_samples,
-                  u32 curr_pos, u32 ratio, int srctype, const s16* coeffs)
-{
-  int read_samples_count = 0;
-
-  // If DSP DROM coefficients are available, support polyphase resampling.
-  if (coeffs && srctype == SRCTYPE_POLYPHASE)
-  {
-    s16 temp[4];
-    u32 idx = 0;
-
-    temp[idx++ & 3] = last_samples[0];
-    temp[idx++ & 3] = last_samples[1];
-    temp[idx++ & 3] = last_samples[2];
-    temp[idx++ & 3] = last_samples[3];
-
-    for (u32 i = 0; i < count; ++i)
-    {
-      curr_pos += ratio;
-      while (curr_pos >= 0x10000)
-      {
-        temp[idx++ & 3] = input_callback(read_samples_count++);
-        curr_pos -= 0x10000;
-      }
-
-      u16 curr_pos_frac = ((curr_pos & 0xFFFF) >> 9) << 2;
-      const s16* c = &coeffs[curr_pos_frac];
-
-      s64 t0 = temp[idx++ & 3];
-      s64 t1 = temp[idx++ & 3];
-      s64 t2 = temp[idx++ & 3];
-      s64 t3 = temp[idx++ & 3];
-
-      s64 samp = (t0 * c[0] + t1 * c[1] + t2 * c[2] + t3 * c[3]) >> 15;
-
-      output[i] = MathUtil::SaturatingCast<s16>(samp);
-    }
-
-    last_samples[3] = temp[--idx & 3];
-    last_samples[2] = temp[--idx & 3];
-    last_samples[1] = temp[--idx & 3];
-    last_samples[0] = temp[--idx & 3];
-  }
-  else if (srctype == SRCTYPE_LINEAR || srctype == SRCTYPE_POLYPHASE)
-  {
-    // This is the circular buffer containing samples to use for the
-    // interpolation. It is initialized with the values from the PB, and it
-    // will be stored back to the PB at the end.
-    s16 temp[4];
-    u32 idx = 0;
-
-    temp[idx++ & 3] = last_samples[0];
-    temp[idx++ & 3] = last_samples[1];
-    temp[idx++ & 3] = last_samples[2];
-    temp[idx++ & 3] = last_samples[3];
-
-    for (u32 i = 0; i < count; ++i)
-    {
-      curr_pos += ratio;
-
-      // While our current position is >= 1.0, push new samples to the
-      // circular buffer.
-      while (curr_pos >= 0x10000)
-      {
-        temp[idx++ & 3] = input_callback(read_samples_count++);
-        curr_pos -= 0x10000;
-      }
-
-      // Get our current fractional position, used to know how much of
-      // curr0 and how much of curr1 the output sample should be.
-      u16 curr_frac = curr_pos & 0xFFFF;
-      u16 inv_curr_frac = -curr_frac;
-
-      // Interpolate! If curr_frac is 0, we can simply take the last
-      // sample without any multiplying.
-      s16 sample;
-      if (curr_frac)
-      {
-        s32 s0 = temp[idx++ & 3];
-        s32 s1 = temp[idx++ & 3];
-
-        sample = ((s0 * inv_curr_frac) + (s1 * curr_frac)) >> 16;
-        idx += 2;
-      }
-      else
-      {
-        sample = temp[idx++ & 3];
-        idx += 3;
-      }
-
-      output[i] = sample;
-    }
-
-    // Update the four last_samples values.
-    last_samples[3] = temp[--idx & 3];
-    last_samples[2] = temp[--idx & 3];
-    last_samples[1] = temp[--idx & 3];
-    last_samples[0] = temp[--idx & 3];
-  }
-  else  // SRCTYPE_NEAREST
-  {
-    // No sample rate conversion here: simply read samples from the
-    // accelerator to the output buffer.
-    for (u32 i = 0; i < count; ++i)
-      output[i] = input_callback(i);
-
-    memcpy(last_samples, output + count - 4, 4 * sizeof(u16));
-  }
-
-  return curr_pos;
-}
-
 // Read <count> input samples from ARAM, decoding and converting rate
 // if required.
 void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
@@ -360,9 +231,27 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
 
   if (coeffs)
     coeffs += pb.coef_select * 0x200;
-  u32 curr_pos =
-      ResampleAudio([](u32) { return AcceleratorGetSample(); }, samples, count, pb.src.last_samples,
-                    pb.src.cur_addr_frac, HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
+
+  const u32 ratio = HILO_TO_32(pb.src.ratio);
+  const u32 input_count = GetResampleInputCount(count, pb.src.cur_addr_frac, ratio, pb.src_type);
+
+  // Decode all input samples at once and resample them afterwards. Only voices with unusually
+  // high ratios need more room than the stack buffer provides.
+  std::array<s16, RESAMPLE_HISTORY_SIZE + MAX_SAMPLES_PER_FRAME * 4> input_buffer;
+  std::vector<s16> large_input_buffer;
+  s16* input = input_buffer.data();
+  if (RESAMPLE_HISTORY_SIZE + input_count > input_buffer.size())
+  {
+    large_input_buffer.resize(RESAMPLE_HISTORY_SIZE + input_count);
+    input = large_input_buffer.data();
+  }
+
+  std::copy_n(pb.src.last_samples, RESAMPLE_HISTORY_SIZE, input);
+  for (u32 i = 0; i < input_count; ++i)
+    input[RESAMPLE_HISTORY_SIZE + i] = AcceleratorGetSample();
+
+  const u32 curr_pos = ResampleAudio(input, samples, count, pb.src.last_samples,
+                                     pb.src.cur_addr_frac, ratio, pb.src_type, coeffs);
   pb.src.cur_addr_frac = (curr_pos & 0xFFFF);
 
   // Update current position, YN1, YN2 and pred scale in the PB.
@@ -373,32 +262,6 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
   pb.adpcm.pred_scale = s_accelerator->GetPredScale();
 }
 
-// Add samples to an output buffer, with optional volume ramping.
-void MixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bool ramp)
-{
-  u16& volume = vd->volume;
-  u16 volume_delta = vd->volume_delta;
-
-  // If volume ramping is disabled, set volume_delta to 0. That way, the
-  // mixing loop can avoid testing if volume ramping is enabled at each step,
-  // and just add volume_delta.
-  if (!ramp)
-    volume_delta = 0;
-
-  for (u32 i = 0; i < count; ++i)
-  {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
-
-    out[i] += (s16)sample;
-    volume += volume_delta;
-
-    *dpop = (s16)sample;
-  }
-}
-
 // Execute a low pass filter on the samples using one history value. Returns
 // the new history value.
 s16 LowPassFilter(s16* samples, u32 count, s16 yn1, u16 a0, u16 b0)
@@ -422,19 +285,15 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
   GetInputSamples(pb, samples, count, coeffs);
 
   // Apply a global volume ramp using the volume envelope parameters.
-  for (u32 i = 0; i < count; ++i)
-  {
 #ifdef AX_GC
-    // signed on GameCube
-    const s32 volume = (s16)pb.vol_env.cur_volume;
+  // signed on GameCube
+  constexpr bool unsigned_volume = false;
 #else
-    // unsigned on Wii
-    const s32 volume = (u16)pb.vol_env.cur_volume;
+  // unsigned on Wii
+  constexpr bool unsigned_volume = true;
 #endif
-    const s32 sample = ((s32)samples[i] * volume) >> 15;
-    samples[i] = std::clamp(sample, -32767, 32767);  // -32768 ?
-    pb.vol_env.cur_volume += pb.vol_env.cur_volume_delta;
-  }
+  pb.vol_env.cur_volume = ApplyVolumeEnvelope(samples, count, pb.vol_env.cur_volume,
+                                              pb.vol_env.cur_volume_delta, unsigned_volume);
 
   // Optionally, execute a low pass filter
   if (pb.lpf.enabled)
@@ -517,12 +376,8 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
 #undef MIX_ON
 #undef RAMP_ON
 
-  // Optionally, phase shift left or right channel to simulate 3D sound.
-  if (pb.initial_time_delay.on)
-  {
-    // TODO
-    DolphinAnalytics::Instance().ReportGameQuirk(GameQuirk::USES_AX_INITIAL_TIME_DELAY);
-  }
+  // TODO: Optionally, phase shift left or right channel to simulate 3D sound.
+  // See ReportUnimplementedFeatures.
 
 #ifdef AX_WII
   // Wiimote mixing.
@@ -534,9 +389,13 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
     // Interpolate at most 18 samples from the 96 samples we read before.
     s16 wm_samples[18];
 
+    std::array<s16, RESAMPLE_HISTORY_SIZE + MAX_SAMPLES_PER_FRAME> wm_input;
+    std::copy_n(pb.remote_src.last_samples, RESAMPLE_HISTORY_SIZE, wm_input.begin());
+    std::copy_n(samples, count, wm_input.begin() + RESAMPLE_HISTORY_SIZE);
+
     // We use ratio 0x55555 == (5 * 65536 + 21845) / 65536 == 5.3333 which
     // is the nearest we can get to 96/18
-    u32 curr_pos = ResampleAudio([&samples](u32 i) { return samples[i]; }, wm_samples, wm_count,
+    u32 curr_pos = ResampleAudio(wm_input.data(), wm_samples, wm_count,
                                  pb.remote_src.last_samples, pb.remote_src.cur_addr_frac, 0x55555,
                                  SRCTYPE_POLYPHASE, coeffs);
     pb.remote_src.cur_addr_frac = curr_pos & 0xFFFF;
@@ -575,6 +434,63 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
 #endif
 }
 
+// Reports the PB features that ProcessVoice doesn't emulate yet. Unlike ProcessVoice, this must
+// only be called from the DSP thread.
+void ReportUnimplementedFeatures(const PB_TYPE& pb)
+{
+  if (pb.running == 1 && pb.initial_time_delay.on)
+    DolphinAnalytics::Instance().ReportGameQuirk(GameQuirk::USES_AX_INITIAL_TIME_DELAY);
+}
+
+// Calls process(pb, buffers) for all PBs, spread across the HLE voice worker threads.
+//
+// Voices only ever add to the mixing buffers. The calling thread mixes into the real buffers,
+// while the other threads mix into zeroed buffers of their own, which are added to the real ones
+// at the end. Integer addition gives the same result in any order, so the output is identical to
+// processing all voices one after another.
+template <typename Function>
+void ProcessPBsInParallel(VoiceWorkers& workers, std::vector<PB_TYPE>& pbs,
+                          const AXBuffers& buffers,
+                          const std::array<u32, AX_BUFFER_COUNT>& buffer_sizes,
+                          const Function& process)
+{
+  u32 total_size = 0;
+  for (const u32 size : buffer_sizes)
+    total_size += size;
+
+  std::vector<std::vector<int>> thread_samples(workers.GetThreadCount());
+  workers.Run(pbs.size(), [&](size_t thread, size_t begin, size_t end) {
+    AXBuffers thread_buffers = buffers;
+    if (thread != 0)
+    {
+      std::vector<int>& samples = thread_samples[thread];
+      samples.assign(total_size, 0);
+      int* ptr = samples.data();
+      for (u32 i = 0; i < AX_BUFFER_COUNT; ++i)
+      {
+        thread_buffers.ptrs[i] = ptr;
+        ptr += buffer_sizes[i];
+      }
+    }
+
+    for (size_t i = begin; i < end; ++i)
+      process(pbs[i], thread_buffers);
+  });
+
+  for (const std::vector<int>& samples : thread_samples)
+  {
+    if (samples.empty())
+      continue;
+
+    const int* ptr = samples.data();
+    for (u32 i = 0; i < AX_BUFFER_COUNT; ++i)
+    {
+      for (u32 j = 0; j < buffer_sizes[i]; ++j)
+        buffers.ptrs[i][j] += *ptr++;
+    }
+  }
+}
+
 }  // namespace
 }  // inline namespace AXGC/AXWii
 }  // namespace DSP::HLE
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -414,20 +415,22 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
-  AXPBWii pb;
-
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
-                          m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
-                          m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
-                          m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
-                          m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
-                          m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
-                          m_samples_wm3,       m_samples_aux3}};
-
-    ReadPB(pb_addr, pb, m_crc);
-
+  // The Wii remote buffers come after the main and aux buffers, and only get 6 samples per
+  // millisecond.
+  constexpr size_t first_wm_buffer = offsetof(AXBuffers, wm_main0) / sizeof(int*);
+  constexpr u32 wm_spms = 6;
+
+  const AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
+                              m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
+                              m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
+                              m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
+                              m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
+                              m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
+                              m_samples_wm3,       m_samples_aux3}};
+  const s16* coeffs = m_coeffs_checksum ? m_coeffs.data() : nullptr;
+
+  // Processes 3ms of a PB. This may run on several threads at once.
+  const auto process_pb = [&](AXPBWii& pb, AXBuffers pb_buffers) {
     u16 num_updates[3];
     u16 updates[1024];
     u32 updates_addr;
@@ -436,24 +439,69 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
       for (int curr_ms = 0; curr_ms < 3; ++curr_ms)
       {
         ApplyUpdatesForMs(curr_ms, pb, num_updates, updates);
-        ProcessVoice(pb, buffers, spms, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
-                     m_coeffs_checksum ? m_coeffs.data() : nullptr);
+        ProcessVoice(pb, pb_buffers, spms, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
+                     coeffs);
 
         // Forward the buffers
-        for (auto& ptr : buffers.ptrs)
-          ptr += spms;
+        for (size_t i = 0; i < std::size(pb_buffers.ptrs); ++i)
+          pb_buffers.ptrs[i] += i < first_wm_buffer ? spms : wm_spms;
       }
       ReinjectUpdatesFields(pb, num_updates, updates_addr);
     }
     else
     {
-      ProcessVoice(pb, buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
-                   m_coeffs_checksum ? m_coeffs.data() : nullptr);
+      ProcessVoice(pb, pb_buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)), coeffs);
     }
+  };
 
-    WritePB(pb_addr, pb, m_crc);
-    pb_addr = HILO_TO_32(pb.next_pb);
+  VoiceWorkers& workers = m_dsphle->GetVoiceWorkers();
+  if (!workers.IsParallel())
+  {
+    AXPBWii pb;
+
+    while (pb_addr)
+    {
+      ReadPB(pb_addr, pb, m_crc);
+      ReportUnimplementedFeatures(pb);
+
+      process_pb(pb, buffers);
+
+      WritePB(pb_addr, pb, m_crc);
+      pb_addr = HILO_TO_32(pb.next_pb);
+    }
+    return;
   }
+
+  // Read the whole list first. The updates can change the address of the next PB, so they are
+  // applied to a copy of each PB to find it.
+  std::vector<u32> pb_addrs;
+  std::vector<AXPBWii> pbs;
+  while (pb_addr)
+  {
+    AXPBWii& pb = pbs.emplace_back();
+    ReadPB(pb_addr, pb, m_crc);
+    ReportUnimplementedFeatures(pb);
+    pb_addrs.push_back(pb_addr);
+
+    AXPBWii updated_pb = pb;
+    u16 num_updates[3];
+    u16 updates[1024];
+    u32 updates_addr;
+    if (ExtractUpdatesFields(updated_pb, num_updates, updates, &updates_addr))
+    {
+      for (int curr_ms = 0; curr_ms < 3; ++curr_ms)
+        ApplyUpdatesForMs(curr_ms, updated_pb, num_updates, updates);
+    }
+    pb_addr = HILO_TO_32(updated_pb.next_pb);
+  }
+
+  std::array<u32, AX_BUFFER_COUNT> buffer_sizes;
+  std::fill(buffer_sizes.begin(), buffer_sizes.begin() + first_wm_buffer, spms * 3);
+  std::fill(buffer_sizes.begin() + first_wm_buffer, buffer_sizes.end(), wm_spms * 3);
+  ProcessPBsInParallel(workers, pbs, buffers, buffer_sizes, process_pb);
+
+  for (size_t i = 0; i < pbs.size(); ++i)
+    WritePB(pb_addrs[i], pbs[i], m_crc);
 }
 
 void AXWiiUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr, u16 volume)
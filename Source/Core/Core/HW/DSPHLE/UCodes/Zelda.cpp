@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <array>
 #include <map>
+#include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -17,6 +18,7 @@
 #include "Core/HW/DSPHLE/MailHandler.h"
 #include "Core/HW/DSPHLE/UCodes/GBA.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
+#include "Core/HW/DSPHLE/VoiceWorkers.h"
 #include "Core/System.h"
 
 namespace DSP::HLE
@@ -630,22 +632,33 @@ void ZeldaUCode::RenderAudio()
     if (m_rendering_curr_voice == 0)
       m_renderer.PrepareFrame();
 
+    // Collect all voices that can be rendered until the next sync, so that they can be
+    // processed in parallel.
+    std::vector<u16> voice_ids;
+    bool waiting_for_sync = false;
     while (m_rendering_curr_voice < m_rendering_voices_per_frame)
     {
       // If we are not meant to render this voice yet, go back to message
       // processing.
       if (m_rendering_curr_voice >= m_sync_max_voice_id)
-        return;
+      {
+        waiting_for_sync = true;
+        break;
+      }
 
       // Test the sync flag for this voice, skip it if not set.
       u16 flags = m_sync_voice_skip_flags[m_rendering_curr_voice >> 4];
       u8 bit = 0xF - (m_rendering_curr_voice & 0xF);
       if (flags & (1 << bit))
-        m_renderer.AddVoice(m_rendering_curr_voice);
+        voice_ids.push_back(m_rendering_curr_voice);
 
       m_rendering_curr_voice++;
     }
 
+    m_renderer.AddVoices(voice_ids, m_dsphle->GetVoiceWorkers());
+    if (waiting_for_sync)
+      return;
+
     if (!(m_flags & LIGHT_PROTOCOL))
       SendCommandAck(CommandAck::STANDARD, 0xFF00 | m_rendering_curr_frame);
 
@@ -1165,16 +1178,69 @@ ZeldaAudioRenderer::MixingBuffer* ZeldaAudioRenderer::BufferForID(u16 buffer_id)
   }
 }
 
-void ZeldaAudioRenderer::AddVoice(u16 voice_id)
+struct ZeldaAudioRenderer::PreparedVoice
 {
   VPB vpb;
-  FetchVPB(voice_id, &vpb);
+  MixingBuffer input_samples;
+  bool samples_loaded = false;
+};
+
+void ZeldaAudioRenderer::AddVoice(u16 voice_id)
+{
+  PreparedVoice voice;
+  FetchVPB(voice_id, &voice.vpb);
+  RenderVoice(voice_id, &voice);
+}
+
+void ZeldaAudioRenderer::AddVoices(const std::vector<u16>& voice_ids, VoiceWorkers& workers)
+{
+  if (!workers.IsParallel() || voice_ids.size() < 2)
+  {
+    for (u16 voice_id : voice_ids)
+      AddVoice(voice_id);
+    return;
+  }
+
+  // Fetching the VPBs and loading the input samples is independent for every voice, so that part
+  // runs on the worker threads. The voices are then mixed in order, exactly like AddVoice would.
+  std::vector<PreparedVoice> voices(voice_ids.size());
+  workers.Run(voice_ids.size(), [&](size_t, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+    {
+      PreparedVoice& voice = voices[i];
+      FetchVPB(voice_ids[i], &voice.vpb);
+
+      const VPB& vpb = voice.vpb;
+      if (!vpb.enabled || vpb.done)
+        continue;
+
+      // The variable step pattern reads back a mixing buffer, which the previous voices may
+      // still have to be mixed into.
+      if (!vpb.use_constant_sample &&
+          vpb.samples_source_type == VPB::SRC_CONST_PATTERN_0_VARIABLE_STEP)
+      {
+        continue;
+      }
+
+      LoadInputSamples(&voice.input_samples, &voice.vpb);
+      voice.samples_loaded = true;
+    }
+  });
+
+  for (size_t i = 0; i < voice_ids.size(); ++i)
+    RenderVoice(voice_ids[i], &voices[i]);
+}
+
+void ZeldaAudioRenderer::RenderVoice(u16 voice_id, PreparedVoice* voice)
+{
+  VPB& vpb = voice->vpb;
 
   if (!vpb.enabled || vpb.done)
     return;
 
-  MixingBuffer input_samples;
-  LoadInputSamples(&input_samples, &vpb);
+  MixingBuffer& input_samples = voice->input_samples;
+  if (!voice->samples_loaded)
+    LoadInputSamples(&input_samples, &vpb);
 
   // TODO: In place effects.
 
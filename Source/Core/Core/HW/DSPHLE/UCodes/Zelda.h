@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <array>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
@@ -12,12 +13,16 @@
 namespace DSP::HLE
 {
 class DSPHLE;
+class VoiceWorkers;
 
 class ZeldaAudioRenderer
 {
 public:
   void PrepareFrame();
   void AddVoice(u16 voice_id);
+  // Same as calling AddVoice for each voice in order, but spreads some of the work across the
+  // voice worker threads.
+  void AddVoices(const std::vector<u16>& voice_ids, VoiceWorkers& workers);
   void FinalizeFrame();
 
   void SetFlags(u32 flags) { m_flags = flags; }
@@ -35,6 +40,11 @@ public:
 
 private:
   struct VPB;
+  struct PreparedVoice;
+
+  // Mixes a voice whose VPB has already been fetched, loading its input samples first unless
+  // that has been done already.
+  void RenderVoice(u16 voice_id, PreparedVoice* voice);
 
   // See Zelda.cpp for the list of possible flags.
   u32 m_flags;
@@ -0,0 +1,50 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/VoiceWorkers.h"
+
+#include <fmt/format.h>
+
+namespace DSP::HLE
+{
+VoiceWorkers::VoiceWorkers() = default;
+
+VoiceWorkers::~VoiceWorkers() = default;
+
+void VoiceWorkers::SetWorkerCount(size_t count)
+{
+  if (count == m_workers.size())
+    return;
+
+  m_workers.clear();
+  m_workers.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    m_workers.push_back(std::make_unique<Common::WorkQueueThread<Job>>(
+        fmt::format("DSP HLE Voices {}", i + 1),
+        [](Job job) { (*job.function)(job.thread, job.begin, job.end); }));
+  }
+}
+
+void VoiceWorkers::Run(size_t count, const RangeFunction& function)
+{
+  const size_t thread_count = GetThreadCount();
+  const auto range_begin = [count, thread_count](size_t thread) {
+    return count * thread / thread_count;
+  };
+
+  for (size_t i = 0; i < m_workers.size(); ++i)
+  {
+    const size_t thread = i + 1;
+    const size_t begin = range_begin(thread);
+    const size_t end = range_begin(thread + 1);
+    if (begin != end)
+      m_workers[i]->Push(Job{&function, thread, begin, end});
+  }
+
+  function(0, 0, range_begin(1));
+
+  for (auto& worker : m_workers)
+    worker->WaitForCompletion();
+}
+}  // namespace DSP::HLE
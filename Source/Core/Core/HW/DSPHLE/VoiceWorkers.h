@@ -0,0 +1,53 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Common/WorkQueueThread.h"
+
+namespace DSP::HLE
+{
+// A small pool of threads which the HLE ucodes use to process independent voices in parallel.
+//
+// Work is always split into contiguous ranges in the same way for a given thread count, so that
+// callers can combine the per-thread results in a fixed order.
+class VoiceWorkers
+{
+public:
+  VoiceWorkers();
+  ~VoiceWorkers();
+
+  VoiceWorkers(const VoiceWorkers&) = delete;
+  VoiceWorkers& operator=(const VoiceWorkers&) = delete;
+
+  // Starts the given number of worker threads, in addition to the thread that calls Run.
+  // Zero disables parallel processing.
+  void SetWorkerCount(size_t count);
+
+  // Number of threads, including the calling thread, that Run splits work across.
+  size_t GetThreadCount() const { return m_workers.size() + 1; }
+  bool IsParallel() const { return !m_workers.empty(); }
+
+  // Splits [0, count) into GetThreadCount() contiguous ranges and calls
+  // function(thread, begin, end) for each of them. Thread 0 is the calling thread, and gets the
+  // first range. Returns once all ranges have been processed.
+  using RangeFunction = std::function<void(size_t thread, size_t begin, size_t end)>;
+  void Run(size_t count, const RangeFunction& function);
+
+private:
+  struct Job
+  {
+    const RangeFunction* function;
+    size_t thread;
+    size_t begin;
+    size_t end;
+  };
+
+  std::vector<std::unique_ptr<Common::WorkQueueThread<Job>>> m_workers;
+};
+}  // namespace DSP::HLE
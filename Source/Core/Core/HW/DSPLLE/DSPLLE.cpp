@@ -124,6 +124,7 @@ static bool FillDSPInitOptions(DSPInitOptions* opts)
   if (Config::Get(Config::MAIN_DSP_JIT))
     opts->core_type = DSPInitOptions::CoreType::JIT64;
 #endif
+  opts->profile_idle_loops = Config::Get(Config::MAIN_DSP_PROFILE_IDLE_LOOPS);
 
   if (Config::Get(Config::MAIN_DSP_CAPTURE_LOG))
   {
@@ -14,10 +14,18 @@
 #include <memory>
 #include <tuple>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "Common/Align.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
@@ -41,6 +49,17 @@
 
 namespace Memory
 {
+static size_t GetHostPageSize()
+{
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwPageSize;
+#else
+  return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
 MemoryManager::MemoryManager(Core::System& system) : m_system(system)
 {
 }
@@ -245,7 +264,9 @@ void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
 
   for (u32 i = 0; i < dbat_table.size(); ++i)
   {
-    if (dbat_table[i] & PowerPC::BAT_PHYSICAL_BIT)
+    // Pages that overlap memchecks are only mapped into the fastmem arena, where MMU protects the
+    // watched parts of them.
+    if (dbat_table[i] & (PowerPC::BAT_PHYSICAL_BIT | PowerPC::BAT_MEMCHECK_BIT))
     {
       u32 logical_address = i << PowerPC::BAT_INDEX_SHIFT;
       // TODO: Merge adjacent mappings to make this faster.
@@ -282,14 +303,45 @@ void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
             m_logical_mapped_entries.push_back({mapped_pointer, mapped_size});
           }
 
-          m_logical_page_mappings[i] =
-              *physical_region.out_pointer + intersection_start - mapping_address;
+          if (dbat_table[i] & PowerPC::BAT_PHYSICAL_BIT)
+          {
+            m_logical_page_mappings[i] =
+                *physical_region.out_pointer + intersection_start - mapping_address;
+          }
         }
       }
     }
   }
 }
 
+void MemoryManager::ProtectLogicalMemory(u32 logical_address, u32 size, bool allow_reads)
+{
+  if (!m_is_fastmem_arena_initialized)
+    return;
+
+  static const size_t page_size = GetHostPageSize();
+  u8* const start = m_logical_base + Common::AlignDown<size_t>(logical_address, page_size);
+  u8* const end =
+      m_logical_base + Common::AlignUp<size_t>(size_t{logical_address} + size, page_size);
+
+  // Only touch what is actually mapped, since changing the protection of the reserved parts of the
+  // arena could make them accessible.
+  for (const LogicalMemoryView& entry : m_logical_mapped_entries)
+  {
+    u8* const entry_start = static_cast<u8*>(entry.mapped_pointer);
+    u8* const protect_start = std::max(start, entry_start);
+    u8* const protect_end = std::min(end, entry_start + entry.mapped_size);
+    if (protect_start >= protect_end)
+      continue;
+
+    const size_t protect_size = protect_end - protect_start;
+    if (allow_reads)
+      Common::WriteProtectMemory(protect_start, protect_size);
+    else
+      Common::ReadProtectMemory(protect_start, protect_size);
+  }
+}
+
 void MemoryManager::DoState(PointerWrap& p)
 {
   const u32 current_ram_size = GetRamSize();
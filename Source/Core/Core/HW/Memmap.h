@@ -99,6 +99,9 @@ public:
   void DoState(PointerWrap& p);
 
   void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
+  // Makes the host pages of the logical fastmem arena that contain the given range fault on
+  // writes, and also on reads unless allow_reads is set. Lasts until the next UpdateLogicalMemory.
+  void ProtectLogicalMemory(u32 logical_address, u32 size, bool allow_reads);
 
   void Clear();
 
@@ -4,32 +4,52 @@
 #include "Core/MemoryWatcher.h"
 
 #include <cstring>
+#include <fcntl.h>
 #include <fstream>
-#include <iostream>
+#include <iterator>
 #include <sstream>
+#include <sys/mman.h>
 #include <unistd.h>
 
+#include <fmt/format.h>
+
+#include "Common/Align.h"
 #include "Common/FileUtil.h"
-#include "Core/HW/SystemTimers.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/PowerPC/MMU.h"
 
+static_assert(std::atomic<u32>::is_always_lock_free && std::atomic<u64>::is_always_lock_free,
+              "The shared memory output needs atomics that work across processes");
+
+// Enough for a few seconds of hundreds of watches changing every frame.
+constexpr u32 SHARED_MEMORY_RECORD_CAPACITY = 65536;
+
 MemoryWatcher::MemoryWatcher()
 {
   m_running = false;
   if (!LoadAddresses(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX)))
     return;
-  if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
+
+  const std::string shared_memory_name = Config::Get(Config::MAIN_MEMORY_WATCHER_SHARED_MEMORY);
+  if (!shared_memory_name.empty())
+  {
+    if (!OpenSharedMemory(shared_memory_name))
+      return;
+  }
+  else if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
+  {
     return;
+  }
   m_running = true;
 }
 
 MemoryWatcher::~MemoryWatcher()
 {
-  if (!m_running)
-    return;
-
+  CloseSharedMemory();
+  if (m_fd >= 0)
+    close(m_fd);
   m_running = false;
-  close(m_fd);
 }
 
 bool MemoryWatcher::LoadAddresses(const std::string& path)
@@ -39,23 +59,46 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
   if (!locations)
     return false;
 
+  // (parent, offset) -> node
+  std::map<std::pair<u32, u32>, u32> node_lookup;
   std::string line;
   while (std::getline(locations, line))
-    ParseLine(line);
+    ParseLine(line, &node_lookup);
 
-  return !m_values.empty();
+  m_node_values.resize(m_plan.size());
+  m_node_stopped.resize(m_plan.size());
+  return !m_watches.empty();
 }
 
-void MemoryWatcher::ParseLine(const std::string& line)
+void MemoryWatcher::ParseLine(const std::string& line,
+                              std::map<std::pair<u32, u32>, u32>* node_lookup)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
+  for (const Watch& watch : m_watches)
+  {
+    if (watch.address == line)
+      return;
+  }
 
   std::istringstream offsets(line);
   offsets >> std::hex;
+  u32 node = NO_PARENT;
   u32 offset;
   while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+  {
+    const auto [it, inserted] =
+        node_lookup->try_emplace({node, offset}, static_cast<u32>(m_plan.size()));
+    if (inserted)
+    {
+      if (node != NO_PARENT)
+        m_plan[node].has_children = true;
+      m_plan.push_back({node, offset});
+    }
+    node = it->second;
+  }
+
+  // Lines without any addresses would always read as 0.
+  if (node != NO_PARENT)
+    m_watches.push_back({line, node});
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -67,38 +110,115 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line)
+bool MemoryWatcher::OpenSharedMemory(const std::string& name)
 {
-  u32 value = 0;
-  for (u32 offset : m_addresses[line])
+  m_shared_memory_name = name.front() == '/' ? name : '/' + name;
+
+  const u32 watch_count = static_cast<u32>(m_watches.size());
+  const u32 values_offset = Common::AlignUp<u32>(sizeof(SharedMemoryHeader), 64);
+  const u32 records_offset =
+      Common::AlignUp<u32>(values_offset + watch_count * sizeof(std::atomic<u32>), 64);
+  const size_t size =
+      records_offset + size_t{SHARED_MEMORY_RECORD_CAPACITY} * sizeof(SharedMemoryRecord);
+
+  m_shared_memory_fd = shm_open(m_shared_memory_name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (m_shared_memory_fd < 0)
   {
-    value = PowerPC::MMU::HostRead_U32(guard, value + offset);
-    if (!PowerPC::MMU::HostIsRAMAddress(guard, value))
-      break;
+    ERROR_LOG_FMT(CORE, "MemoryWatcher: shm_open({}) failed: {}", m_shared_memory_name,
+                  strerror(errno));
+    return false;
+  }
+
+  if (ftruncate(m_shared_memory_fd, size) < 0)
+  {
+    ERROR_LOG_FMT(CORE, "MemoryWatcher: ftruncate failed: {}", strerror(errno));
+    CloseSharedMemory();
+    return false;
   }
-  return value;
+
+  void* const memory =
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_shared_memory_fd, 0);
+  if (memory == MAP_FAILED)
+  {
+    ERROR_LOG_FMT(CORE, "MemoryWatcher: mmap failed: {}", strerror(errno));
+    CloseSharedMemory();
+    return false;
+  }
+  m_shared_memory = memory;
+  m_shared_memory_size = size;
+
+  // The object was just truncated, so everything starts out zeroed.
+  u8* const base = static_cast<u8*>(memory);
+  m_header = reinterpret_cast<SharedMemoryHeader*>(base);
+  m_shared_values = reinterpret_cast<std::atomic<u32>*>(base + values_offset);
+  m_records = reinterpret_cast<SharedMemoryRecord*>(base + records_offset);
+
+  m_header->version = SHARED_MEMORY_VERSION;
+  m_header->watch_count = watch_count;
+  m_header->record_capacity = SHARED_MEMORY_RECORD_CAPACITY;
+  m_header->values_offset = values_offset;
+  m_header->records_offset = records_offset;
+  m_header->magic.store(SHARED_MEMORY_MAGIC, std::memory_order_release);
+
+  INFO_LOG_FMT(CORE, "MemoryWatcher: Writing {} watches to shared memory {}", watch_count,
+               m_shared_memory_name);
+  return true;
 }
 
-std::string MemoryWatcher::ComposeMessages(const Core::CPUThreadGuard& guard)
+void MemoryWatcher::CloseSharedMemory()
 {
-  std::ostringstream message_stream;
-  message_stream << std::hex;
+  if (m_shared_memory)
+  {
+    munmap(m_shared_memory, m_shared_memory_size);
+    m_shared_memory = nullptr;
+    m_header = nullptr;
+    m_shared_values = nullptr;
+    m_records = nullptr;
+  }
 
-  for (auto& entry : m_values)
+  if (m_shared_memory_fd >= 0)
   {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
+    close(m_shared_memory_fd);
+    shm_unlink(m_shared_memory_name.c_str());
+    m_shared_memory_fd = -1;
+  }
+}
 
-    u32 new_value = ChasePointer(guard, address);
-    if (new_value != current_value)
+void MemoryWatcher::RunPlan(const Core::CPUThreadGuard& guard)
+{
+  for (size_t i = 0; i < m_plan.size(); ++i)
+  {
+    const PlanNode& node = m_plan[i];
+    u32 base = 0;
+    if (node.parent != NO_PARENT)
     {
-      // Update the value
-      current_value = new_value;
-      message_stream << address << '\n' << new_value << '\n';
+      // Once a chain hits something that isn't a RAM address, that is its final value.
+      if (m_node_stopped[node.parent])
+      {
+        m_node_values[i] = m_node_values[node.parent];
+        m_node_stopped[i] = true;
+        continue;
+      }
+      base = m_node_values[node.parent];
     }
+
+    const u32 value = PowerPC::MMU::HostRead_U32(guard, base + node.offset);
+    m_node_values[i] = value;
+    m_node_stopped[i] = node.has_children && !PowerPC::MMU::HostIsRAMAddress(guard, value);
   }
+}
+
+void MemoryWatcher::WriteRecord(u32 watch_index, u32 value)
+{
+  m_shared_values[watch_index].store(value, std::memory_order_relaxed);
 
-  return message_stream.str();
+  SharedMemoryRecord& record = m_records[m_records_written % SHARED_MEMORY_RECORD_CAPACITY];
+  record.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  record.frame = m_frame;
+  record.watch_index = watch_index;
+  record.value = value;
+  record.sequence.store(++m_records_written, std::memory_order_release);
 }
 
 void MemoryWatcher::Step(const Core::CPUThreadGuard& guard)
@@ -106,7 +226,32 @@ void MemoryWatcher::Step(const Core::CPUThreadGuard& guard)
   if (!m_running)
     return;
 
-  std::string message = ComposeMessages(guard);
-  sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
-         sizeof(m_addr));
+  RunPlan(guard);
+  ++m_frame;
+
+  m_message.clear();
+  for (size_t i = 0; i < m_watches.size(); ++i)
+  {
+    Watch& watch = m_watches[i];
+    const u32 new_value = m_node_values[watch.node];
+    if (new_value == watch.value)
+      continue;
+
+    watch.value = new_value;
+    if (m_header)
+      WriteRecord(static_cast<u32>(i), new_value);
+    else
+      fmt::format_to(std::back_inserter(m_message), "{}\n{:x}\n", watch.address, new_value);
+  }
+
+  if (m_header)
+  {
+    m_header->records_written.store(m_records_written, std::memory_order_release);
+    m_header->frame.store(m_frame, std::memory_order_release);
+  }
+  else if (!m_message.empty())
+  {
+    sendto(m_fd, m_message.c_str(), m_message.size() + 1, 0,
+           reinterpret_cast<sockaddr*>(&m_addr), sizeof(m_addr));
+  }
 }
@@ -5,10 +5,12 @@
 
 #include "Common/CommonTypes.h"
 
+#include <atomic>
 #include <map>
 #include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
+#include <utility>
 #include <vector>
 
 namespace Core
@@ -24,28 +26,96 @@ class CPUThreadGuard;
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
 // The output to the socket is two lines. The first is the address from the
 // input file, and the second is the new value in hex.
+//
+// If MAIN_MEMORY_WATCHER_SHARED_MEMORY is set, changes are instead written as binary records to a
+// POSIX shared memory object with that name, so that readers don't need a syscall per update. It
+// starts with a SharedMemoryHeader, followed by the current value of every watch and a ring of
+// SharedMemoryRecords. See docs/MemoryWatcher.md for the layout and how to read it.
 class MemoryWatcher final
 {
 public:
+  static constexpr u32 SHARED_MEMORY_MAGIC = 0x524D5744;  // "DWMR"
+  static constexpr u32 SHARED_MEMORY_VERSION = 1;
+
+  struct SharedMemoryHeader
+  {
+    // Set to SHARED_MEMORY_MAGIC once everything else has been initialized.
+    std::atomic<u32> magic;
+    u32 version;
+    u32 watch_count;
+    u32 record_capacity;
+    // Offsets from the start of the shared memory. The values are an array of watch_count
+    // std::atomic<u32>, in the order that the addresses first appear in the input file.
+    u32 values_offset;
+    u32 records_offset;
+    // The number of frames that have been processed.
+    std::atomic<u64> frame;
+    // The total number of records written. Record n is stored at index n % record_capacity.
+    std::atomic<u64> records_written;
+  };
+
+  struct SharedMemoryRecord
+  {
+    // n + 1 for record n, or 0 while it is being written. Readers should check that this is the
+    // same before and after copying the other fields.
+    std::atomic<u64> sequence;
+    u64 frame;
+    u32 watch_index;
+    u32 value;
+  };
+
   MemoryWatcher();
   ~MemoryWatcher();
   void Step(const Core::CPUThreadGuard& guard);
 
 private:
+  // One pointer dereference. Chains that start with the same offsets share nodes, and a node
+  // always comes after its parent.
+  struct PlanNode
+  {
+    u32 parent;
+    u32 offset;
+    bool has_children = false;
+  };
+
+  struct Watch
+  {
+    // The line from the input file.
+    std::string address;
+    u32 node;
+    u32 value = 0;
+  };
+
+  static constexpr u32 NO_PARENT = UINT32_MAX;
+
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
+  bool OpenSharedMemory(const std::string& name);
+  void CloseSharedMemory();
 
-  void ParseLine(const std::string& line);
-  u32 ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line);
-  std::string ComposeMessages(const Core::CPUThreadGuard& guard);
+  void ParseLine(const std::string& line, std::map<std::pair<u32, u32>, u32>* node_lookup);
+  void RunPlan(const Core::CPUThreadGuard& guard);
+  void WriteRecord(u32 watch_index, u32 value);
 
   bool m_running = false;
 
-  int m_fd;
+  int m_fd = -1;
   sockaddr_un m_addr{};
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  std::vector<PlanNode> m_plan;
+  std::vector<u32> m_node_values;
+  // Whether pointer chasing stopped at or before each node, because of a non-RAM address.
+  std::vector<u8> m_node_stopped;
+  std::vector<Watch> m_watches;
+  std::string m_message;
+  u64 m_frame = 0;
+
+  std::string m_shared_memory_name;
+  int m_shared_memory_fd = -1;
+  void* m_shared_memory = nullptr;
+  size_t m_shared_memory_size = 0;
+  SharedMemoryHeader* m_header = nullptr;
+  std::atomic<u32>* m_shared_values = nullptr;
+  SharedMemoryRecord* m_records = nullptr;
+  u64 m_records_written = 0;
 };
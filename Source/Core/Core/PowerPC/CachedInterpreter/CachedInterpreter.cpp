@@ -3,6 +3,9 @@
 
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 
+#include <bit>
+#include <iterator>
+
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Core/ConfigManager.h"
@@ -16,63 +19,12 @@
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 
-struct CachedInterpreter::Instruction
-{
-  using CommonCallback = void (*)(UGeckoInstruction);
-  using ConditionalCallback = bool (*)(u32);
-  using InterpreterCallback = void (*)(Interpreter&, UGeckoInstruction);
-  using CachedInterpreterCallback = void (*)(CachedInterpreter&, UGeckoInstruction);
-  using ConditionalCachedInterpreterCallback = bool (*)(CachedInterpreter&, u32);
-
-  Instruction() {}
-  Instruction(const CommonCallback c, UGeckoInstruction i)
-      : common_callback(c), data(i.hex), type(Type::Common)
-  {
-  }
-
-  Instruction(const ConditionalCallback c, u32 d)
-      : conditional_callback(c), data(d), type(Type::Conditional)
-  {
-  }
-
-  Instruction(const InterpreterCallback c, UGeckoInstruction i)
-      : interpreter_callback(c), data(i.hex), type(Type::Interpreter)
-  {
-  }
-
-  Instruction(const CachedInterpreterCallback c, UGeckoInstruction i)
-      : cached_interpreter_callback(c), data(i.hex), type(Type::CachedInterpreter)
-  {
-  }
-
-  Instruction(const ConditionalCachedInterpreterCallback c, u32 d)
-      : conditional_cached_interpreter_callback(c), data(d),
-        type(Type::ConditionalCachedInterpreter)
-  {
-  }
-
-  enum class Type
-  {
-    Abort,
-    Common,
-    Conditional,
-    Interpreter,
-    CachedInterpreter,
-    ConditionalCachedInterpreter,
-  };
-
-  union
-  {
-    const CommonCallback common_callback = nullptr;
-    const ConditionalCallback conditional_callback;
-    const InterpreterCallback interpreter_callback;
-    const CachedInterpreterCallback cached_interpreter_callback;
-    const ConditionalCachedInterpreterCallback conditional_cached_interpreter_callback;
-  };
-
-  u32 data = 0;
-  Type type = Type::Abort;
-};
+// With GCC and Clang, every handler jumps straight to the next one through a table of label
+// addresses. That gives each handler its own indirect branch, which the host predicts much better
+// than the single shared one of a switch.
+#if defined(__GNUC__)
+#define CACHED_INTERPRETER_COMPUTED_GOTO
+#endif
 
 CachedInterpreter::CachedInterpreter(Core::System& system) : JitBase(system)
 {
@@ -114,41 +66,148 @@ void CachedInterpreter::ExecuteOneBlock()
     return;
   }
 
+  using Type = Instruction::Type;
   const Instruction* code = reinterpret_cast<const Instruction*>(normal_entry);
   auto& interpreter = m_system.GetInterpreter();
-
-  for (; code->type != Instruction::Type::Abort; ++code)
+  auto& ppc_state = m_ppc_state;
+
+#ifdef CACHED_INTERPRETER_COMPUTED_GOTO
+  static const void* const handlers[] = {
+      &&Abort_label,
+      &&Interpreter_label,
+      &&WritePC_label,
+      &&WriteBrokenBlockNPC_label,
+      &&EndBlock_label,
+      &&CheckFPU_label,
+      &&CheckDSI_label,
+      &&CheckProgramException_label,
+      &&CheckBreakpoint_label,
+      &&CheckIdle_label,
+      &&LoadImmediate_label,
+      &&AddImmediate_label,
+      &&OrImmediate_label,
+      &&XorImmediate_label,
+      &&RotateAndMask_label,
+      &&Move_label,
+  };
+  static_assert(std::size(handlers) == static_cast<size_t>(Type::NumTypes));
+
+  // The switch is only used to enter the first handler.
+#define HANDLER(name)                                                                              \
+  case Type::name:                                                                                 \
+  name##_label:
+#define NEXT()                                                                                     \
+  ++code;                                                                                          \
+  goto* handlers[static_cast<size_t>(code->type)]
+#else
+#define HANDLER(name)                                                                              \
+  case Type::name:
+#define NEXT()                                                                                     \
+  ++code;                                                                                          \
+  continue
+#endif
+
+  while (true)
   {
     switch (code->type)
     {
-    case Instruction::Type::Common:
-      code->common_callback(UGeckoInstruction(code->data));
-      break;
-
-    case Instruction::Type::Conditional:
-      if (code->conditional_callback(code->data))
-        return;
-      break;
-
-    case Instruction::Type::Interpreter:
+    HANDLER(Abort)
+    {
+      return;
+    }
+    HANDLER(Interpreter)
+    {
       code->interpreter_callback(interpreter, UGeckoInstruction(code->data));
-      break;
-
-    case Instruction::Type::CachedInterpreter:
-      code->cached_interpreter_callback(*this, UGeckoInstruction(code->data));
-      break;
-
-    case Instruction::Type::ConditionalCachedInterpreter:
-      if (code->conditional_cached_interpreter_callback(*this, code->data))
+      NEXT();
+    }
+    HANDLER(WritePC)
+    {
+      ppc_state.pc = code->data;
+      ppc_state.npc = code->data + 4;
+      NEXT();
+    }
+    HANDLER(WriteBrokenBlockNPC)
+    {
+      ppc_state.npc = code->data;
+      NEXT();
+    }
+    HANDLER(EndBlock)
+    {
+      ppc_state.pc = ppc_state.npc;
+      ppc_state.downcount -= code->data;
+      PowerPC::UpdatePerformanceMonitor(code->data, code->counts.load_store,
+                                        code->counts.floating_point, ppc_state);
+      NEXT();
+    }
+    HANDLER(CheckFPU)
+    {
+      if (CheckFPU(*this, code->data))
         return;
-      break;
-
+      NEXT();
+    }
+    HANDLER(CheckDSI)
+    {
+      if (CheckDSI(*this, code->data))
+        return;
+      NEXT();
+    }
+    HANDLER(CheckProgramException)
+    {
+      if (CheckProgramException(*this, code->data))
+        return;
+      NEXT();
+    }
+    HANDLER(CheckBreakpoint)
+    {
+      if (CheckBreakpoint(*this, code->data))
+        return;
+      NEXT();
+    }
+    HANDLER(CheckIdle)
+    {
+      CheckIdle(*this, code->data);
+      NEXT();
+    }
+    HANDLER(LoadImmediate)
+    {
+      ppc_state.gpr[code->dst] = code->data;
+      NEXT();
+    }
+    HANDLER(AddImmediate)
+    {
+      ppc_state.gpr[code->dst] = ppc_state.gpr[code->src] + code->data;
+      NEXT();
+    }
+    HANDLER(OrImmediate)
+    {
+      ppc_state.gpr[code->dst] = ppc_state.gpr[code->src] | code->data;
+      NEXT();
+    }
+    HANDLER(XorImmediate)
+    {
+      ppc_state.gpr[code->dst] = ppc_state.gpr[code->src] ^ code->data;
+      NEXT();
+    }
+    HANDLER(RotateAndMask)
+    {
+      ppc_state.gpr[code->dst] = std::rotl(ppc_state.gpr[code->src], code->shift) & code->data;
+      NEXT();
+    }
+    HANDLER(Move)
+    {
+      ppc_state.gpr[code->dst] = ppc_state.gpr[code->src];
+      NEXT();
+    }
     default:
       ERROR_LOG_FMT(POWERPC, "Unknown CachedInterpreter Instruction: {}",
                     static_cast<int>(code->type));
+      ++code;
       break;
     }
   }
+
+#undef HANDLER
+#undef NEXT
 }
 
 void CachedInterpreter::Run()
@@ -177,39 +236,6 @@ void CachedInterpreter::SingleStep()
   ExecuteOneBlock();
 }
 
-void CachedInterpreter::EndBlock(CachedInterpreter& cached_interpreter, UGeckoInstruction data)
-{
-  auto& ppc_state = cached_interpreter.m_ppc_state;
-  ppc_state.pc = ppc_state.npc;
-  ppc_state.downcount -= data.hex;
-  PowerPC::UpdatePerformanceMonitor(data.hex, 0, 0, ppc_state);
-}
-
-void CachedInterpreter::UpdateNumLoadStoreInstructions(CachedInterpreter& cached_interpreter,
-                                                       UGeckoInstruction data)
-{
-  PowerPC::UpdatePerformanceMonitor(0, data.hex, 0, cached_interpreter.m_ppc_state);
-}
-
-void CachedInterpreter::UpdateNumFloatingPointInstructions(CachedInterpreter& cached_interpreter,
-                                                           UGeckoInstruction data)
-{
-  PowerPC::UpdatePerformanceMonitor(0, 0, data.hex, cached_interpreter.m_ppc_state);
-}
-
-void CachedInterpreter::WritePC(CachedInterpreter& cached_interpreter, UGeckoInstruction data)
-{
-  auto& ppc_state = cached_interpreter.m_ppc_state;
-  ppc_state.pc = data.hex;
-  ppc_state.npc = data.hex + 4;
-}
-
-void CachedInterpreter::WriteBrokenBlockNPC(CachedInterpreter& cached_interpreter,
-                                            UGeckoInstruction data)
-{
-  cached_interpreter.m_ppc_state.npc = data.hex;
-}
-
 bool CachedInterpreter::CheckFPU(CachedInterpreter& cached_interpreter, u32 data)
 {
   auto& ppc_state = cached_interpreter.m_ppc_state;
@@ -258,13 +284,12 @@ bool CachedInterpreter::CheckBreakpoint(CachedInterpreter& cached_interpreter, u
   return false;
 }
 
-bool CachedInterpreter::CheckIdle(CachedInterpreter& cached_interpreter, u32 idle_pc)
+void CachedInterpreter::CheckIdle(CachedInterpreter& cached_interpreter, u32 idle_pc)
 {
   if (cached_interpreter.m_ppc_state.npc == idle_pc)
   {
-    cached_interpreter.m_system.GetCoreTiming().Idle();
+    cached_interpreter.m_system.GetCoreTiming().IdleLoop(idle_pc);
   }
-  return false;
 }
 
 bool CachedInterpreter::HandleFunctionHooking(u32 address)
@@ -275,17 +300,108 @@ bool CachedInterpreter::HandleFunctionHooking(u32 address)
   if (!result)
     return false;
 
-  m_code.emplace_back(WritePC, address);
+  m_code.emplace_back(Instruction::Type::WritePC, address);
   m_code.emplace_back(Interpreter::HLEFunction, result.hook_index);
 
   if (result.type != HLE::HookType::Replace)
     return false;
 
-  m_code.emplace_back(EndBlock, js.downcountAmount);
+  m_code.emplace_back(Instruction::Type::EndBlock, js.downcountAmount);
   m_code.emplace_back();
   return true;
 }
 
+void CachedInterpreter::EmitInstruction(UGeckoInstruction inst)
+{
+  using Type = Instruction::Type;
+
+  // Integer instructions that only read and write GPRs get their own handlers, so that they
+  // don't need to go through an interpreter function and decode their operands every time.
+  switch (inst.OPCD)
+  {
+  case 14:  // addi
+    if (inst.RA == 0)
+      m_code.push_back(Instruction(Type::LoadImmediate, inst.RD, 0, u32(inst.SIMM_16)));
+    else
+      EmitImmediateOp(Type::AddImmediate, inst.RD, inst.RA, u32(inst.SIMM_16));
+    return;
+  case 15:  // addis
+    if (inst.RA == 0)
+      m_code.push_back(Instruction(Type::LoadImmediate, inst.RD, 0, u32(inst.SIMM_16 << 16)));
+    else
+      EmitImmediateOp(Type::AddImmediate, inst.RD, inst.RA, u32(inst.SIMM_16 << 16));
+    return;
+  case 21:  // rlwinmx
+    if (inst.Rc)
+      break;
+    m_code.push_back(Instruction(Type::RotateAndMask, inst.RA, inst.RS,
+                                 MakeRotationMask(inst.MB, inst.ME), inst.SH));
+    return;
+  case 24:  // ori
+    EmitImmediateOp(Type::OrImmediate, inst.RA, inst.RS, inst.UIMM);
+    return;
+  case 25:  // oris
+    EmitImmediateOp(Type::OrImmediate, inst.RA, inst.RS, u32{inst.UIMM} << 16);
+    return;
+  case 26:  // xori
+    EmitImmediateOp(Type::XorImmediate, inst.RA, inst.RS, inst.UIMM);
+    return;
+  case 27:  // xoris
+    EmitImmediateOp(Type::XorImmediate, inst.RA, inst.RS, u32{inst.UIMM} << 16);
+    return;
+  case 31:
+    // mr, which is or with both sources the same.
+    if (inst.SUBOP10 != 444 || inst.Rc || inst.RS != inst.RB)
+      break;
+    if (inst.RA != inst.RS)
+      m_code.push_back(Instruction(Type::Move, inst.RA, inst.RS, 0));
+    return;
+  default:
+    break;
+  }
+
+  m_code.emplace_back(Interpreter::GetInterpreterOp(inst), inst);
+}
+
+void CachedInterpreter::EmitImmediateOp(Instruction::Type type, u32 dst, u32 src, u32 imm)
+{
+  using Type = Instruction::Type;
+
+  // If the source was just set to a constant, so is the result. This fuses the lis + addi and
+  // lis + ori pairs that are used to build 32-bit constants and addresses into a single load.
+  // Anything that has to run in between, like a breakpoint check, also ends up in between here.
+  if (GetCodePtr() != js.curBlock->normalEntry && m_code.back().type == Type::LoadImmediate &&
+      m_code.back().dst == src)
+  {
+    u32 value = m_code.back().data;
+    if (type == Type::AddImmediate)
+      value += imm;
+    else if (type == Type::OrImmediate)
+      value |= imm;
+    else
+      value ^= imm;
+
+    if (dst == src)
+      m_code.back().data = value;
+    else
+      m_code.emplace_back(Type::LoadImmediate, dst, 0, value);
+    return;
+  }
+
+  // ori 0, 0, 0 is the canonical nop.
+  if (type != Type::AddImmediate && imm == 0 && dst == src)
+    return;
+
+  m_code.emplace_back(type, dst, src, imm);
+}
+
+void CachedInterpreter::EmitEndBlock()
+{
+  // Ending the block and updating all of the performance counters is a single handler.
+  Instruction& end_block = m_code.emplace_back(Instruction::Type::EndBlock, js.downcountAmount);
+  end_block.counts = {js.numLoadStoreInst, js.numFloatingPointInst};
+}
+
 void CachedInterpreter::Jit(u32 address)
 {
   if (m_code.size() >= CODE_SIZE / sizeof(Instruction) - 0x1000 ||
@@ -306,6 +422,8 @@ void CachedInterpreter::Jit(u32 address)
     return;
   }
 
+  RecordIdleLoopDetections();
+
   JitBlock* b = m_block_cache.AllocateBlock(m_ppc_state.pc);
 
   js.blockStart = m_ppc_state.pc;
@@ -343,38 +461,32 @@ void CachedInterpreter::Jit(u32 address)
       const bool idle_loop = op.branchIsIdleLoop;
 
       if (breakpoint || check_fpu || endblock || memcheck || check_program_exception)
-        m_code.emplace_back(WritePC, op.address);
+        m_code.emplace_back(Instruction::Type::WritePC, op.address);
 
       if (breakpoint)
-        m_code.emplace_back(CheckBreakpoint, js.downcountAmount);
+        m_code.emplace_back(Instruction::Type::CheckBreakpoint, js.downcountAmount);
 
       if (check_fpu)
       {
-        m_code.emplace_back(CheckFPU, js.downcountAmount);
+        m_code.emplace_back(Instruction::Type::CheckFPU, js.downcountAmount);
         js.firstFPInstructionFound = true;
       }
 
-      m_code.emplace_back(Interpreter::GetInterpreterOp(op.inst), op.inst);
+      EmitInstruction(op.inst);
       if (memcheck)
-        m_code.emplace_back(CheckDSI, js.downcountAmount);
+        m_code.emplace_back(Instruction::Type::CheckDSI, js.downcountAmount);
       if (check_program_exception)
-        m_code.emplace_back(CheckProgramException, js.downcountAmount);
+        m_code.emplace_back(Instruction::Type::CheckProgramException, js.downcountAmount);
       if (idle_loop)
-        m_code.emplace_back(CheckIdle, js.blockStart);
+        m_code.emplace_back(Instruction::Type::CheckIdle, op.branchTo);
       if (endblock)
-      {
-        m_code.emplace_back(EndBlock, js.downcountAmount);
-        m_code.emplace_back(UpdateNumLoadStoreInstructions, js.numLoadStoreInst);
-        m_code.emplace_back(UpdateNumFloatingPointInstructions, js.numFloatingPointInst);
-      }
+        EmitEndBlock();
     }
   }
   if (code_block.m_broken)
   {
-    m_code.emplace_back(WriteBrokenBlockNPC, nextPC);
-    m_code.emplace_back(EndBlock, js.downcountAmount);
-    m_code.emplace_back(UpdateNumLoadStoreInstructions, js.numLoadStoreInst);
-    m_code.emplace_back(UpdateNumFloatingPointInstructions, js.numFloatingPointInst);
+    m_code.emplace_back(Instruction::Type::WriteBrokenBlockNPC, nextPC);
+    EmitEndBlock();
   }
   m_code.emplace_back();
 
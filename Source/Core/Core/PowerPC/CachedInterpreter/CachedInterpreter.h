@@ -10,6 +10,8 @@
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 
+class Interpreter;
+
 class CachedInterpreter : public JitBase
 {
 public:
@@ -31,30 +33,87 @@ public:
 
   void Jit(u32 address) override;
 
+  // Runs the block at the current PC, or compiles it if it isn't in the cache yet. Unlike
+  // SingleStep, this doesn't start a new timing slice.
+  void ExecuteOneBlock();
+
   JitBaseBlockCache* GetBlockCache() override { return &m_block_cache; }
   const char* GetName() const override { return "Cached Interpreter"; }
   const CommonAsmRoutinesBase* GetAsmRoutines() override { return nullptr; }
 
 private:
-  struct Instruction;
+  // One entry of the threaded code. Blocks are runs of these that end with Type::Abort.
+  struct Instruction
+  {
+    using InterpreterCallback = void (*)(Interpreter&, UGeckoInstruction);
+
+    // The order has to match the handler table in ExecuteOneBlock.
+    enum class Type : u8
+    {
+      Abort,
+      Interpreter,
+      WritePC,
+      WriteBrokenBlockNPC,
+      EndBlock,
+      CheckFPU,
+      CheckDSI,
+      CheckProgramException,
+      CheckBreakpoint,
+      CheckIdle,
+      // Integer instructions that don't touch anything but GPRs, with their operands pre-decoded.
+      LoadImmediate,
+      AddImmediate,
+      OrImmediate,
+      XorImmediate,
+      RotateAndMask,
+      Move,
+      NumTypes,
+    };
+
+    struct PerformanceCounts
+    {
+      u32 load_store;
+      u32 floating_point;
+    };
+
+    Instruction() = default;
+    Instruction(Type t, u32 d) : type(t), data(d) {}
+    Instruction(InterpreterCallback c, UGeckoInstruction i)
+        : type(Type::Interpreter), data(i.hex), interpreter_callback(c)
+    {
+    }
+    Instruction(Type t, u32 dst_reg, u32 src_reg, u32 d, u32 sh = 0)
+        : type(t), dst(static_cast<u8>(dst_reg)), src(static_cast<u8>(src_reg)),
+          shift(static_cast<u8>(sh)), data(d)
+    {
+    }
+
+    Type type = Type::Abort;
+    u8 dst = 0;
+    u8 src = 0;
+    u8 shift = 0;
+    // The instruction for Type::Interpreter, an immediate or mask for the integer types, the
+    // downcount for the checks and EndBlock, or an address.
+    u32 data = 0;
+    union
+    {
+      InterpreterCallback interpreter_callback;
+      PerformanceCounts counts{};
+    };
+  };
 
   u8* GetCodePtr();
-  void ExecuteOneBlock();
 
   bool HandleFunctionHooking(u32 address);
+  void EmitInstruction(UGeckoInstruction inst);
+  void EmitImmediateOp(Instruction::Type type, u32 dst, u32 src, u32 imm);
+  void EmitEndBlock();
 
-  static void EndBlock(CachedInterpreter& cached_interpreter, UGeckoInstruction data);
-  static void UpdateNumLoadStoreInstructions(CachedInterpreter& cached_interpreter,
-                                             UGeckoInstruction data);
-  static void UpdateNumFloatingPointInstructions(CachedInterpreter& cached_interpreter,
-                                                 UGeckoInstruction data);
-  static void WritePC(CachedInterpreter& cached_interpreter, UGeckoInstruction data);
-  static void WriteBrokenBlockNPC(CachedInterpreter& cached_interpreter, UGeckoInstruction data);
   static bool CheckFPU(CachedInterpreter& cached_interpreter, u32 data);
   static bool CheckDSI(CachedInterpreter& cached_interpreter, u32 data);
   static bool CheckProgramException(CachedInterpreter& cached_interpreter, u32 data);
   static bool CheckBreakpoint(CachedInterpreter& cached_interpreter, u32 data);
-  static bool CheckIdle(CachedInterpreter& cached_interpreter, u32 idle_pc);
+  static void CheckIdle(CachedInterpreter& cached_interpreter, u32 idle_pc);
 
   BlockCache m_block_cache{*this};
   std::vector<Instruction> m_code;
@@ -4,6 +4,8 @@
 #include "Core/PowerPC/Expression.h"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstdlib>
 #include <fmt/format.h>
 #include <optional>
@@ -76,15 +78,21 @@ void HostWrite(const Core::CPUThreadGuard& guard, u64 var, u32 address)
   PowerPC::MMU::HostWrite_U64(guard, var, address);
 }
 
+template <typename T, typename U = T>
+static double HostReadValue(const Core::CPUThreadGuard& guard, double address)
+{
+  return Common::BitCast<T>(HostRead<U>(guard, static_cast<u32>(address)));
+}
+
 template <typename T, typename U = T>
 static double HostReadFunc(expr_func* f, vec_expr_t* args, void* c)
 {
   if (vec_len(args) != 1)
     return 0;
-  const u32 address = static_cast<u32>(expr_eval(&vec_nth(args, 0)));
+  const double address = expr_eval(&vec_nth(args, 0));
 
   Core::CPUThreadGuard guard(Core::System::GetInstance());
-  return Common::BitCast<T>(HostRead<U>(guard, address));
+  return HostReadValue<T, U>(guard, address);
 }
 
 template <typename T, typename U = T>
@@ -100,12 +108,18 @@ static double HostWriteFunc(expr_func* f, vec_expr_t* args, void* c)
   return var;
 }
 
+template <typename T, typename U = T>
+static double CastValue(double value)
+{
+  return Common::BitCast<T>(static_cast<U>(value));
+}
+
 template <typename T, typename U = T>
 static double CastFunc(expr_func* f, vec_expr_t* args, void* c)
 {
   if (vec_len(args) != 1)
     return 0;
-  return Common::BitCast<T>(static_cast<U>(expr_eval(&vec_nth(args, 0))));
+  return CastValue<T, U>(expr_eval(&vec_nth(args, 0)));
 }
 
 static double CallstackFunc(expr_func* f, vec_expr_t* args, void* c)
@@ -254,6 +268,404 @@ Expression::Expression(std::string_view text, ExprPointer ex, ExprVarListPointer
 
     m_binds.emplace_back(bind);
   }
+
+  if (!Compile(*m_expr, 0))
+    m_program.clear();
+}
+
+bool Expression::Compile(const expr& e, u32 depth)
+{
+  if (depth >= MAX_STACK_DEPTH)
+    return false;
+
+  const auto compile_operands = [&](u32 count) {
+    for (u32 i = 0; i < count; ++i)
+    {
+      if (!Compile(e.param.op.args.buf[i], depth + i))
+        return false;
+    }
+    return true;
+  };
+  const auto compile_operation = [&](u32 count, Opcode opcode) {
+    if (!compile_operands(count))
+      return false;
+    m_program.push_back({opcode});
+    return true;
+  };
+  // Matches the short-circuiting of the expression library, which returns the operand that
+  // decided the result, or zero.
+  const auto compile_logical = [&](Opcode jump_opcode) {
+    if (!Compile(e.param.op.args.buf[0], depth))
+      return false;
+    const size_t jump = m_program.size();
+    m_program.push_back({jump_opcode});
+    if (!Compile(e.param.op.args.buf[1], depth))
+      return false;
+    m_program[jump].index = static_cast<u32>(m_program.size());
+    m_program.push_back({Opcode::NormalizeZero});
+    return true;
+  };
+
+  switch (e.type)
+  {
+  case OP_UNARY_MINUS:
+    return compile_operation(1, Opcode::Negate);
+  case OP_UNARY_LOGICAL_NOT:
+    return compile_operation(1, Opcode::LogicalNot);
+  case OP_UNARY_BITWISE_NOT:
+    return compile_operation(1, Opcode::BitwiseNot);
+  case OP_POWER:
+    return compile_operation(2, Opcode::Power);
+  case OP_MULTIPLY:
+    return compile_operation(2, Opcode::Multiply);
+  case OP_DIVIDE:
+    return compile_operation(2, Opcode::Divide);
+  case OP_REMAINDER:
+    return compile_operation(2, Opcode::Remainder);
+  case OP_PLUS:
+    return compile_operation(2, Opcode::Add);
+  case OP_MINUS:
+    return compile_operation(2, Opcode::Subtract);
+  case OP_SHL:
+    return compile_operation(2, Opcode::ShiftLeft);
+  case OP_SHR:
+    return compile_operation(2, Opcode::ShiftRight);
+  case OP_LT:
+    return compile_operation(2, Opcode::Less);
+  case OP_LE:
+    return compile_operation(2, Opcode::LessEqual);
+  case OP_GT:
+    return compile_operation(2, Opcode::Greater);
+  case OP_GE:
+    return compile_operation(2, Opcode::GreaterEqual);
+  case OP_EQ:
+    return compile_operation(2, Opcode::Equal);
+  case OP_NE:
+    return compile_operation(2, Opcode::NotEqual);
+  case OP_BITWISE_AND:
+    return compile_operation(2, Opcode::BitwiseAnd);
+  case OP_BITWISE_OR:
+    return compile_operation(2, Opcode::BitwiseOr);
+  case OP_BITWISE_XOR:
+    return compile_operation(2, Opcode::BitwiseXor);
+  case OP_LOGICAL_AND:
+    return compile_logical(Opcode::JumpIfZero);
+  case OP_LOGICAL_OR:
+    return compile_logical(Opcode::JumpIfTrue);
+  case OP_COMMA:
+    if (!Compile(e.param.op.args.buf[0], depth))
+      return false;
+    m_program.push_back({Opcode::Pop});
+    return Compile(e.param.op.args.buf[1], depth);
+  case OP_CONST:
+    m_program.push_back({Opcode::Constant, 0, e.param.num.value});
+    return true;
+  case OP_VAR:
+  {
+    auto bind = m_binds.begin();
+    for (auto* v = m_vars->head; v != nullptr; v = v->next, ++bind)
+    {
+      if (&v->value != e.param.var.value)
+        continue;
+
+      switch (bind->type)
+      {
+      case VarBindingType::Zero:
+        m_program.push_back({Opcode::Constant});
+        break;
+      case VarBindingType::GPR:
+        m_program.push_back({Opcode::LoadGPR, static_cast<u32>(bind->index)});
+        break;
+      case VarBindingType::FPR:
+        m_program.push_back({Opcode::LoadFPR, static_cast<u32>(bind->index)});
+        break;
+      case VarBindingType::SPR:
+        m_program.push_back({Opcode::LoadSPR, static_cast<u32>(bind->index)});
+        break;
+      case VarBindingType::PCtr:
+        m_program.push_back({Opcode::LoadPC});
+        break;
+      }
+      return true;
+    }
+    return false;
+  }
+  case OP_FUNC:
+  {
+    struct CompiledFunction
+    {
+      exprfn_t function;
+      Opcode opcode;
+    };
+    static constexpr std::array<CompiledFunction, 14> compiled_functions{{
+        {HostReadFunc<u8>, Opcode::ReadU8},
+        {HostReadFunc<s8, u8>, Opcode::ReadS8},
+        {HostReadFunc<u16>, Opcode::ReadU16},
+        {HostReadFunc<s16, u16>, Opcode::ReadS16},
+        {HostReadFunc<u32>, Opcode::ReadU32},
+        {HostReadFunc<s32, u32>, Opcode::ReadS32},
+        {HostReadFunc<float, u32>, Opcode::ReadF32},
+        {HostReadFunc<double, u64>, Opcode::ReadF64},
+        {CastFunc<u8>, Opcode::CastU8},
+        {CastFunc<s8, u8>, Opcode::CastS8},
+        {CastFunc<u16>, Opcode::CastU16},
+        {CastFunc<s16, u16>, Opcode::CastS16},
+        {CastFunc<u32>, Opcode::CastU32},
+        {CastFunc<s32, u32>, Opcode::CastS32},
+    }};
+
+    // Writes, and the functions that work with strings, are left to the expression library.
+    const auto it = std::find_if(
+        compiled_functions.begin(), compiled_functions.end(),
+        [&e](const CompiledFunction& f) { return f.function == e.param.func.f->f; });
+    if (it == compiled_functions.end())
+      return false;
+
+    const vec_expr_t& args = e.param.func.args;
+    if (vec_len(&args) != 1)
+    {
+      m_program.push_back({Opcode::Constant});
+      return true;
+    }
+    if (!Compile(args.buf[0], depth))
+      return false;
+    m_program.push_back({it->opcode});
+    return true;
+  }
+  case OP_ASSIGN:
+  case OP_STRING:
+    return false;
+  default:
+    m_program.push_back({Opcode::Constant, 0, NAN});
+    return true;
+  }
+}
+
+double Expression::Execute(Core::System& system) const
+{
+  const auto& ppc_state = system.GetPPCState();
+  std::optional<Core::CPUThreadGuard> guard;
+  std::array<double, MAX_STACK_DEPTH> stack;
+  u32 size = 0;
+
+  const auto pop = [&] { return stack[--size]; };
+  const auto top = [&]() -> double& { return stack[size - 1]; };
+  const auto read = [&](auto read_value) {
+    if (!guard)
+      guard.emplace(system);
+    top() = read_value(*guard, top());
+  };
+
+  for (size_t i = 0; i < m_program.size(); ++i)
+  {
+    const Instruction& instruction = m_program[i];
+    switch (instruction.opcode)
+    {
+    case Opcode::Constant:
+      stack[size++] = instruction.value;
+      break;
+    case Opcode::LoadGPR:
+      stack[size++] = static_cast<double>(ppc_state.gpr[instruction.index]);
+      break;
+    case Opcode::LoadFPR:
+      stack[size++] = ppc_state.ps[instruction.index].PS0AsDouble();
+      break;
+    case Opcode::LoadSPR:
+      stack[size++] = static_cast<double>(ppc_state.spr[instruction.index]);
+      break;
+    case Opcode::LoadPC:
+      stack[size++] = static_cast<double>(ppc_state.pc);
+      break;
+    case Opcode::Pop:
+      --size;
+      break;
+    case Opcode::Negate:
+      top() = -top();
+      break;
+    case Opcode::LogicalNot:
+      top() = !top();
+      break;
+    case Opcode::BitwiseNot:
+      top() = ~to_int(top());
+      break;
+    case Opcode::Power:
+    {
+      const double b = pop();
+      top() = std::pow(top(), b);
+      break;
+    }
+    case Opcode::Multiply:
+    {
+      const double b = pop();
+      top() = top() * b;
+      break;
+    }
+    case Opcode::Divide:
+    {
+      const double b = pop();
+      top() = top() / b;
+      break;
+    }
+    case Opcode::Remainder:
+    {
+      const double b = pop();
+      top() = std::fmod(top(), b);
+      break;
+    }
+    case Opcode::Add:
+    {
+      const double b = pop();
+      top() = top() + b;
+      break;
+    }
+    case Opcode::Subtract:
+    {
+      const double b = pop();
+      top() = top() - b;
+      break;
+    }
+    case Opcode::ShiftLeft:
+    {
+      const double b = pop();
+      top() = to_int(top()) << to_int(b);
+      break;
+    }
+    case Opcode::ShiftRight:
+    {
+      const double b = pop();
+      top() = to_int(top()) >> to_int(b);
+      break;
+    }
+    case Opcode::Less:
+    {
+      const double b = pop();
+      top() = top() < b;
+      break;
+    }
+    case Opcode::LessEqual:
+    {
+      const double b = pop();
+      top() = top() <= b;
+      break;
+    }
+    case Opcode::Greater:
+    {
+      const double b = pop();
+      top() = top() > b;
+      break;
+    }
+    case Opcode::GreaterEqual:
+    {
+      const double b = pop();
+      top() = top() >= b;
+      break;
+    }
+    case Opcode::Equal:
+    {
+      const double b = pop();
+      top() = top() == b;
+      break;
+    }
+    case Opcode::NotEqual:
+    {
+      const double b = pop();
+      top() = top() != b;
+      break;
+    }
+    case Opcode::BitwiseAnd:
+    {
+      const double b = pop();
+      top() = to_int(top()) & to_int(b);
+      break;
+    }
+    case Opcode::BitwiseOr:
+    {
+      const double b = pop();
+      top() = to_int(top()) | to_int(b);
+      break;
+    }
+    case Opcode::BitwiseXor:
+    {
+      const double b = pop();
+      top() = to_int(top()) ^ to_int(b);
+      break;
+    }
+    case Opcode::JumpIfZero:
+      if (top() == 0)
+      {
+        top() = 0;
+        i = instruction.index - 1;
+      }
+      else
+      {
+        --size;
+      }
+      break;
+    case Opcode::JumpIfTrue:
+      if (top() != 0 && !std::isnan(top()))
+        i = instruction.index - 1;
+      else
+        --size;
+      break;
+    case Opcode::NormalizeZero:
+      if (top() == 0)
+        top() = 0;
+      break;
+    case Opcode::ReadU8:
+      read(HostReadValue<u8>);
+      break;
+    case Opcode::ReadS8:
+      read(HostReadValue<s8, u8>);
+      break;
+    case Opcode::ReadU16:
+      read(HostReadValue<u16>);
+      break;
+    case Opcode::ReadS16:
+      read(HostReadValue<s16, u16>);
+      break;
+    case Opcode::ReadU32:
+      read(HostReadValue<u32>);
+      break;
+    case Opcode::ReadS32:
+      read(HostReadValue<s32, u32>);
+      break;
+    case Opcode::ReadF32:
+      read(HostReadValue<float, u32>);
+      break;
+    case Opcode::ReadF64:
+      read(HostReadValue<double, u64>);
+      break;
+    case Opcode::CastU8:
+      top() = CastValue<u8>(top());
+      break;
+    case Opcode::CastS8:
+      top() = CastValue<s8, u8>(top());
+      break;
+    case Opcode::CastU16:
+      top() = CastValue<u16>(top());
+      break;
+    case Opcode::CastS16:
+      top() = CastValue<s16, u16>(top());
+      break;
+    case Opcode::CastU32:
+      top() = CastValue<u32>(top());
+      break;
+    case Opcode::CastS32:
+      top() = CastValue<s32, u32>(top());
+      break;
+    }
+  }
+
+  return stack[0];
+}
+
+bool Expression::HasNaNVariable(Core::System& system) const
+{
+  // Only the floating point registers can hold a NaN.
+  const auto& ppc_state = system.GetPPCState();
+  return std::any_of(m_binds.begin(), m_binds.end(), [&ppc_state](const VarBinding& bind) {
+    return bind.type == VarBindingType::FPR && std::isnan(ppc_state.ps[bind.index].PS0AsDouble());
+  });
 }
 
 std::optional<Expression> Expression::TryParse(std::string_view text)
@@ -268,6 +680,17 @@ std::optional<Expression> Expression::TryParse(std::string_view text)
 
 double Expression::Evaluate(Core::System& system) const
 {
+  if (IsCompiled())
+  {
+    const double result = Execute(system);
+    if (result != 0.0 || std::isnan(result) || HasNaNVariable(system))
+    {
+      SynchronizeBindings(system, SynchronizeDirection::From);
+      Reporting(result);
+    }
+    return result;
+  }
+
   SynchronizeBindings(system, SynchronizeDirection::From);
 
   double result = expr_eval(m_expr.get());
@@ -320,15 +743,15 @@ void Expression::SynchronizeBindings(Core::System& system, SynchronizeDirection
 void Expression::Reporting(const double result) const
 {
   bool is_nan = std::isnan(result);
-  std::string message;
+  for (auto* v = m_vars->head; v != nullptr && !is_nan; v = v->next)
+    is_nan = std::isnan(v->value);
 
-  for (auto* v = m_vars->head; v != nullptr; v = v->next)
-  {
-    if (std::isnan(v->value))
-      is_nan = true;
+  if (result == 0.0 && !is_nan)
+    return;
 
+  std::string message;
+  for (auto* v = m_vars->head; v != nullptr; v = v->next)
     fmt::format_to(std::back_inserter(message), "  {}={}", v->name, v->value);
-  }
 
   if (is_nan)
   {
@@ -336,8 +759,7 @@ void Expression::Reporting(const double result) const
     Core::DisplayMessage("Breakpoint condition has encountered a NaN.", 2000);
   }
 
-  if (result != 0.0 || is_nan)
-    NOTICE_LOG_FMT(MEMMAP, "Breakpoint condition returned: {}. Vars:{}", result, message);
+  NOTICE_LOG_FMT(MEMMAP, "Breakpoint condition returned: {}. Vars:{}", result, message);
 }
 
 std::string Expression::GetText() const
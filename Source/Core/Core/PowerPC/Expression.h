@@ -9,6 +9,8 @@
 #include <string_view>
 #include <vector>
 
+#include "Common/CommonTypes.h"
+
 struct expr;
 struct expr_var_list;
 
@@ -41,6 +43,11 @@ public:
 
   std::string GetText() const;
 
+  // Conditions that only read registers and memory are compiled to a small bytecode program when
+  // they are parsed. They are evaluated without going through the expression library, and the
+  // variables are only gathered for the log when the condition is true.
+  bool IsCompiled() const { return !m_program.empty(); }
+
 private:
   enum class SynchronizeDirection
   {
@@ -63,8 +70,71 @@ private:
     int index = -1;
   };
 
+  enum class Opcode : u8
+  {
+    Constant,
+    LoadGPR,
+    LoadFPR,
+    LoadSPR,
+    LoadPC,
+    Pop,
+    Negate,
+    LogicalNot,
+    BitwiseNot,
+    Power,
+    Multiply,
+    Divide,
+    Remainder,
+    Add,
+    Subtract,
+    ShiftLeft,
+    ShiftRight,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    Equal,
+    NotEqual,
+    BitwiseAnd,
+    BitwiseOr,
+    BitwiseXor,
+    // Leaves a zero on the stack and jumps if the top of the stack is zero, otherwise pops it.
+    JumpIfZero,
+    // Leaves the top of the stack and jumps if it is a number other than zero, otherwise pops it.
+    JumpIfTrue,
+    NormalizeZero,
+    ReadU8,
+    ReadS8,
+    ReadU16,
+    ReadS16,
+    ReadU32,
+    ReadS32,
+    ReadF32,
+    ReadF64,
+    CastU8,
+    CastS8,
+    CastU16,
+    CastS16,
+    CastU32,
+    CastS32,
+  };
+
+  struct Instruction
+  {
+    Opcode opcode;
+    // The register for loads, or the instruction to jump to.
+    u32 index = 0;
+    double value = 0.0;
+  };
+
+  static constexpr u32 MAX_STACK_DEPTH = 16;
+
   Expression(std::string_view text, ExprPointer ex, ExprVarListPointer vars);
 
+  bool Compile(const expr& e, u32 depth);
+  double Execute(Core::System& system) const;
+  bool HasNaNVariable(Core::System& system) const;
+
   void SynchronizeBindings(Core::System& system, SynchronizeDirection dir) const;
   void Reporting(const double result) const;
 
@@ -72,6 +142,7 @@ private:
   ExprPointer m_expr;
   ExprVarListPointer m_vars;
   std::vector<VarBinding> m_binds;
+  std::vector<Instruction> m_program;
 };
 
 inline bool EvaluateCondition(Core::System& system, const std::optional<Expression>& condition)
@@ -2096,7 +2096,8 @@ void Jit64::rlwinmx(UGeckoInstruction inst)
           AND(32, Ra, Imm32(mask));
         else
           AndWithMask(Ra, mask);
-        needs_sext = inst.MB == 0;
+        // A mask that wraps around (MB > ME) also keeps the sign bit.
+        needs_sext = (mask & 0x80000000) != 0;
         needs_test = false;
       }
     }
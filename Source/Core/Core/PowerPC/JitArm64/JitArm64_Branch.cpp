@@ -112,12 +112,7 @@ void JitArm64::bx(UGeckoInstruction inst)
       gpr.Unlock(WA);
 
     // make idle loops go faster
-    ARM64Reg WB = gpr.GetReg();
-    ARM64Reg XB = EncodeRegTo64(WB);
-
-    MOVP2R(XB, &CoreTiming::GlobalIdle);
-    BLR(XB);
-    gpr.Unlock(WB);
+    ABI_CallFunction(&CoreTiming::GlobalIdle, js.op->branchTo);
 
     WriteExceptionExit(js.op->branchTo);
     return;
@@ -169,10 +164,7 @@ void JitArm64::bcx(UGeckoInstruction inst)
   if (js.op->branchIsIdleLoop)
   {
     // make idle loops go faster
-    ARM64Reg XA = EncodeRegTo64(WA);
-
-    MOVP2R(XA, &CoreTiming::GlobalIdle);
-    BLR(XA);
+    ABI_CallFunction(&CoreTiming::GlobalIdle, js.op->branchTo);
 
     WriteExceptionExit(js.op->branchTo);
   }
@@ -284,10 +276,7 @@ void JitArm64::bclrx(UGeckoInstruction inst)
   if (js.op->branchIsIdleLoop)
   {
     // make idle loops go faster
-    ARM64Reg XA = EncodeRegTo64(WA);
-
-    MOVP2R(XA, &CoreTiming::GlobalIdle);
-    BLR(XA);
+    ABI_CallFunction(&CoreTiming::GlobalIdle, js.op->branchTo);
 
     WriteExceptionExit(js.op->branchTo);
   }
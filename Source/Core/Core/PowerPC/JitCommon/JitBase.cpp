@@ -285,3 +285,14 @@ bool JitBase::ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op
   else
     return false;
 }
+
+void JitBase::RecordIdleLoopDetections()
+{
+  auto& core_timing = m_system.GetCoreTiming();
+  for (u32 i = 0; i < code_block.m_num_instructions; ++i)
+  {
+    const PPCAnalyst::CodeOp& op = m_code_buffer[i];
+    if (op.branchIsIdleLoop && !op.skip)
+      core_timing.RecordIdleLoopDetection(op.branchTo);
+  }
+}
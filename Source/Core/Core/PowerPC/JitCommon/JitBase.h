@@ -177,6 +177,9 @@ protected:
 
   bool ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op);
 
+  // Counts the idle loops in the analyzed block for the idle loop statistics.
+  void RecordIdleLoopDetections();
+
 public:
   explicit JitBase(Core::System& system);
   JitBase(const JitBase&) = delete;
@@ -0,0 +1,399 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/LockstepTester.h"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <map>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/Assert.h"
+#include "Common/GekkoDisassembler.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/Debugger/TraceFile.h"
+#include "Core/HW/CPU.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
+#include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+namespace PowerPC
+{
+namespace
+{
+// The registers that are compared, flattened so that each one has an index.
+constexpr size_t FIRST_GPR = 0;
+constexpr size_t FIRST_FPR = FIRST_GPR + 32;
+constexpr size_t FIRST_SPECIAL_REGISTER = FIRST_FPR + 64;
+constexpr size_t FIRST_GQR = FIRST_SPECIAL_REGISTER + TraceFile::NUM_SPECIAL_REGISTERS;
+constexpr size_t NUM_REGISTERS = FIRST_GQR + 8;
+
+using Registers = std::array<u64, NUM_REGISTERS>;
+
+Registers CaptureRegisters(const PowerPCState& ppc_state, u32 cr_mask, u32 fpscr_mask)
+{
+  const TraceFile::RegisterState state = TraceFile::RegisterState::Capture(ppc_state);
+
+  Registers registers;
+  std::copy(state.gprs.begin(), state.gprs.end(), registers.begin() + FIRST_GPR);
+  for (size_t i = 0; i < state.fprs.size(); ++i)
+  {
+    registers[FIRST_FPR + i * 2] = state.fprs[i][0];
+    registers[FIRST_FPR + i * 2 + 1] = state.fprs[i][1];
+  }
+  std::copy(state.special_registers.begin(), state.special_registers.end(),
+            registers.begin() + FIRST_SPECIAL_REGISTER);
+  registers[FIRST_SPECIAL_REGISTER + static_cast<u8>(TraceFile::SpecialRegister::CR)] &= cr_mask;
+  registers[FIRST_SPECIAL_REGISTER + static_cast<u8>(TraceFile::SpecialRegister::FPSCR)] &=
+      fpscr_mask;
+  for (u32 i = 0; i < 8; ++i)
+    registers[FIRST_GQR + i] = GQR(ppc_state, i);
+  return registers;
+}
+
+std::string FormatRegister(size_t index, u64 value)
+{
+  if (index < FIRST_FPR)
+    return fmt::format("r{}: {:08x}", index - FIRST_GPR, value);
+  if (index < FIRST_SPECIAL_REGISTER)
+  {
+    return fmt::format("f{}.ps{}: {:016x}", (index - FIRST_FPR) / 2, (index - FIRST_FPR) % 2,
+                       value);
+  }
+  if (index < FIRST_GQR)
+  {
+    const auto reg = static_cast<TraceFile::SpecialRegister>(index - FIRST_SPECIAL_REGISTER);
+    return fmt::format("{}: {:08x}", TraceFile::GetSpecialRegisterName(reg), value);
+  }
+  return fmt::format("gqr{}: {:08x}", index - FIRST_GQR, value);
+}
+
+// Everything in PowerPCState that the interpreter can change by running ordinary code.
+struct Snapshot
+{
+  u32 pc;
+  u32 npc;
+  u8* gather_pipe_ptr;
+  std::array<u32, 32> gpr;
+  std::array<PairedSingle, 32> ps;
+  ConditionRegister cr;
+  u32 msr;
+  u32 fpscr;
+  CPUEmuFeatureFlags feature_flags;
+  u32 exceptions;
+  u8 xer_ca;
+  u8 xer_so_ov;
+  u16 xer_stringctrl;
+  std::array<u32, 16> sr;
+  std::array<u32, 1024> spr;
+  bool reserve;
+  u32 reserve_address;
+
+  static Snapshot Capture(const PowerPCState& ppc_state)
+  {
+    Snapshot snapshot{.pc = ppc_state.pc,
+                      .npc = ppc_state.npc,
+                      .gather_pipe_ptr = ppc_state.gather_pipe_ptr,
+                      .cr = ppc_state.cr,
+                      .msr = ppc_state.msr.Hex,
+                      .fpscr = ppc_state.fpscr.Hex,
+                      .feature_flags = ppc_state.feature_flags,
+                      .exceptions = ppc_state.Exceptions,
+                      .xer_ca = ppc_state.xer_ca,
+                      .xer_so_ov = ppc_state.xer_so_ov,
+                      .xer_stringctrl = ppc_state.xer_stringctrl,
+                      .reserve = ppc_state.reserve,
+                      .reserve_address = ppc_state.reserve_address};
+    std::copy(std::begin(ppc_state.gpr), std::end(ppc_state.gpr), snapshot.gpr.begin());
+    std::copy(std::begin(ppc_state.ps), std::end(ppc_state.ps), snapshot.ps.begin());
+    std::copy(std::begin(ppc_state.sr), std::end(ppc_state.sr), snapshot.sr.begin());
+    std::copy(std::begin(ppc_state.spr), std::end(ppc_state.spr), snapshot.spr.begin());
+    return snapshot;
+  }
+
+  void Restore(PowerPCState* ppc_state) const
+  {
+    ppc_state->pc = pc;
+    ppc_state->npc = npc;
+    ppc_state->gather_pipe_ptr = gather_pipe_ptr;
+    std::copy(gpr.begin(), gpr.end(), std::begin(ppc_state->gpr));
+    std::copy(ps.begin(), ps.end(), std::begin(ppc_state->ps));
+    ppc_state->cr = cr;
+    ppc_state->msr.Hex = msr;
+    ppc_state->fpscr.Hex = fpscr;
+    ppc_state->feature_flags = feature_flags;
+    ppc_state->Exceptions = exceptions;
+    ppc_state->xer_ca = xer_ca;
+    ppc_state->xer_so_ov = xer_so_ov;
+    ppc_state->xer_stringctrl = xer_stringctrl;
+    std::copy(sr.begin(), sr.end(), std::begin(ppc_state->sr));
+    std::copy(spr.begin(), spr.end(), std::begin(ppc_state->spr));
+    ppc_state->reserve = reserve;
+    ppc_state->reserve_address = reserve_address;
+  }
+};
+
+struct StoreRange
+{
+  u32 address;
+  u32 size;
+};
+
+// Works out which memory an instruction is going to store to, including the instructions that
+// store more than one value, which TraceFile::GetMemoryAccess leaves out.
+std::optional<StoreRange> GetStoreRange(const PowerPCState& ppc_state, u32 instruction)
+{
+  const UGeckoInstruction inst(instruction);
+  const u32 base = inst.RA == 0 ? 0 : ppc_state.gpr[inst.RA];
+
+  if (inst.OPCD == 47)  // stmw
+    return StoreRange{base + static_cast<u32>(inst.SIMM_16), static_cast<u32>((32 - inst.RS) * 4)};
+
+  if (inst.OPCD == 31)
+  {
+    switch (inst.SUBOP10)
+    {
+    case 661:  // stswx
+      return StoreRange{base + ppc_state.gpr[inst.RB], ppc_state.xer_stringctrl & 0x7fu};
+    case 725:  // stswi
+      return StoreRange{base, inst.NB == 0 ? 32 : inst.NB};
+    case 1014:  // dcbz
+      return StoreRange{(base + ppc_state.gpr[inst.RB]) & ~31u, 32};
+    default:
+      break;
+    }
+  }
+
+  const std::optional<TraceFile::MemoryAccess> access =
+      TraceFile::GetMemoryAccess(ppc_state, instruction);
+  if (!access || !access->is_store)
+    return std::nullopt;
+  return StoreRange{access->address, access->size};
+}
+
+struct Step
+{
+  u32 pc;
+  u32 instruction;
+  u32 next_pc;
+};
+
+struct StoredByte
+{
+  u32 address;
+  u8 value;
+  size_t step;
+};
+}  // namespace
+
+std::string LockstepDivergence::ToString() const
+{
+  std::string result = fmt::format(
+      "The block at {:08x} diverged from the interpreter, most likely at {:08x}: {}\n",
+      block_address, instruction_address,
+      Common::GekkoDisassembler::Disassemble(instruction, instruction_address));
+  result += "Differences (interpreter / JIT):\n";
+  result += differences;
+  result += "Guest code:\n";
+  result += guest_code;
+  fmt::format_to(std::back_inserter(result), "Host code at {:#x} ({} bytes):", host_address,
+                 host_code.size());
+  for (size_t i = 0; i < host_code.size(); ++i)
+  {
+    fmt::format_to(std::back_inserter(result), "{}{:02x}", i % 16 == 0 ? "\n  " : " ",
+                   host_code[i]);
+  }
+  result += '\n';
+  return result;
+}
+
+LockstepTester::LockstepTester(Core::System& system) : m_system(system)
+{
+  // A linked block jumps straight into the next block without going through the dispatcher, so
+  // the JIT would keep running past the block that the interpreter ran, such as around a loop.
+  m_block_linking_was_disabled = std::exchange(SConfig::GetInstance().bJITNoBlockLinking, true);
+  m_system.GetJitInterface().ClearCache();
+}
+
+LockstepTester::~LockstepTester()
+{
+  SConfig::GetInstance().bJITNoBlockLinking = m_block_linking_was_disabled;
+}
+
+bool LockstepTester::IsAvailable() const
+{
+  if (m_system.GetPowerPC().GetMode() != CoreMode::JIT)
+    return false;
+
+  const auto* jit = static_cast<const JitBase*>(m_system.GetJitInterface().GetCore());
+  return jit && jit->IsDebuggingEnabled() &&
+         m_system.GetCPU().GetState() != CPU::State::Running;
+}
+
+std::optional<LockstepDivergence> LockstepTester::RunBlock(const Core::CPUThreadGuard& guard)
+{
+  ASSERT(IsAvailable());
+
+  auto& power_pc = m_system.GetPowerPC();
+  auto& ppc_state = power_pc.GetPPCState();
+  auto& jit = *static_cast<JitBase*>(m_system.GetJitInterface().GetCore());
+
+  // The block is compiled up front, to know how many instructions it covers.
+  const u32 block_address = ppc_state.pc;
+  JitBlock* block =
+      jit.GetBlockCache()->GetBlockFromStartAddress(block_address, ppc_state.feature_flags);
+  if (!block)
+  {
+    jit.Jit(block_address);
+    block = jit.GetBlockCache()->GetBlockFromStartAddress(block_address, ppc_state.feature_flags);
+
+    // The code couldn't be fetched, and the JIT has already raised the exception for it.
+    if (!block)
+      return std::nullopt;
+  }
+
+  const u32 block_size = block->originalSize;
+  std::vector<u8> host_code(block->normalEntry, block->normalEntry + block->codeSize);
+  const u64 host_address = reinterpret_cast<u64>(block->normalEntry);
+
+  // Run the interpreter over the block, keeping the registers after each instruction and the
+  // memory contents before and after each store.
+  const Snapshot snapshot = Snapshot::Capture(ppc_state);
+  std::vector<Step> steps;
+  std::vector<Registers> registers{CaptureRegisters(ppc_state, m_cr_mask, m_fpscr_mask)};
+  std::vector<std::pair<u32, u8>> undo_log;
+  std::vector<StoredByte> stored_bytes;
+
+  auto& interpreter = m_system.GetInterpreter();
+  for (size_t i = 0; i < block_size; ++i)
+  {
+    const u32 pc = ppc_state.pc;
+    const u32 instruction = MMU::HostRead_Instruction(guard, pc);
+    std::optional<StoreRange> store = GetStoreRange(ppc_state, instruction);
+    if (store)
+    {
+      for (u32 offset = 0; offset < store->size; ++offset)
+      {
+        const u32 address = store->address + offset;
+        if (MMU::HostIsRAMAddress(guard, address))
+          undo_log.emplace_back(address, MMU::HostRead_U8(guard, address));
+      }
+    }
+
+    interpreter.SingleStepInner();
+    const bool exception = ppc_state.Exceptions != 0;
+    if (exception)
+    {
+      power_pc.CheckExceptions();
+      ppc_state.pc = ppc_state.npc;
+    }
+
+    if (store)
+    {
+      for (u32 offset = 0; offset < store->size; ++offset)
+      {
+        const u32 address = store->address + offset;
+        if (MMU::HostIsRAMAddress(guard, address))
+          stored_bytes.push_back({address, MMU::HostRead_U8(guard, address), i});
+      }
+    }
+    steps.push_back({pc, instruction, ppc_state.pc});
+    registers.push_back(CaptureRegisters(ppc_state, m_cr_mask, m_fpscr_mask));
+
+    // The JIT leaves the block for any exception.
+    if (exception)
+      break;
+  }
+
+  for (auto it = undo_log.rbegin(); it != undo_log.rend(); ++it)
+    MMU::HostWrite_U8(guard, it->second, it->first);
+  snapshot.Restore(&ppc_state);
+
+  power_pc.SingleStep();
+
+  // The JIT might have left the block early, such as for a conditional branch, so the result is
+  // compared after however many instructions get the interpreter to the same PC.
+  const u32 jit_pc = ppc_state.pc;
+  const auto end = std::find_if(steps.begin(), steps.end(),
+                                [jit_pc](const Step& step) { return step.next_pc == jit_pc; });
+  const bool same_pc = end != steps.end();
+  const size_t count = same_pc ? end - steps.begin() + 1 : steps.size();
+
+  ++m_block_count;
+  m_instruction_count += count;
+
+  std::string differences;
+  size_t suspect = count - 1;
+  if (!same_pc)
+  {
+    fmt::format_to(std::back_inserter(differences), "  pc: {:08x} / {:08x}\n",
+                   steps[count - 1].next_pc, jit_pc);
+  }
+
+  // The last instruction to write a register is the one that produced the value that differs.
+  const Registers& expected = registers[count];
+  const Registers actual = CaptureRegisters(ppc_state, m_cr_mask, m_fpscr_mask);
+  for (size_t i = 0; i < NUM_REGISTERS; ++i)
+  {
+    if (expected[i] == actual[i])
+      continue;
+
+    fmt::format_to(std::back_inserter(differences), "  {} / {}\n", FormatRegister(i, expected[i]),
+                   FormatRegister(i, actual[i]));
+    size_t writer = 0;
+    for (size_t step = count; step > 0; --step)
+    {
+      if (registers[step][i] != registers[step - 1][i])
+      {
+        writer = step - 1;
+        break;
+      }
+    }
+    suspect = std::min(suspect, writer);
+  }
+
+  std::map<u32, std::pair<u8, size_t>> expected_memory;
+  for (const StoredByte& stored : stored_bytes)
+  {
+    if (stored.step < count)
+      expected_memory[stored.address] = {stored.value, stored.step};
+  }
+  for (const auto& [address, value] : expected_memory)
+  {
+    const u8 actual_value = MMU::HostRead_U8(guard, address);
+    if (actual_value == value.first)
+      continue;
+
+    fmt::format_to(std::back_inserter(differences), "  [{:08x}]: {:02x} / {:02x}\n", address,
+                   value.first, actual_value);
+    suspect = std::min(suspect, value.second);
+  }
+
+  if (differences.empty())
+    return std::nullopt;
+
+  LockstepDivergence divergence;
+  divergence.block_address = block_address;
+  divergence.instruction_address = steps[suspect].pc;
+  divergence.instruction = steps[suspect].instruction;
+  for (size_t i = 0; i < count; ++i)
+  {
+    fmt::format_to(std::back_inserter(divergence.guest_code), "{} {:08x}: {:08x}  {}\n",
+                   i == suspect ? '>' : ' ', steps[i].pc, steps[i].instruction,
+                   Common::GekkoDisassembler::Disassemble(steps[i].instruction, steps[i].pc));
+  }
+  divergence.differences = std::move(differences);
+  divergence.host_code = std::move(host_code);
+  divergence.host_address = host_address;
+  return divergence;
+}
+}  // namespace PowerPC
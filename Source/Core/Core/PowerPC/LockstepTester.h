@@ -0,0 +1,91 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Core
+{
+class CPUThreadGuard;
+class System;
+}  // namespace Core
+
+namespace PowerPC
+{
+struct LockstepDivergence
+{
+  // The guest address of the JIT block that diverged.
+  u32 block_address = 0;
+  // The instruction that most likely caused the divergence. Of the last instructions to write
+  // each register or byte of memory that differs, this is the earliest one.
+  u32 instruction_address = 0;
+  u32 instruction = 0;
+
+  // The instructions that the interpreter ran for the block, disassembled, one per line.
+  std::string guest_code;
+  // One line for each register or byte of memory that differs, with the interpreter's value
+  // followed by the JIT's.
+  std::string differences;
+
+  // A copy of the host code of the block, which was at host_address.
+  std::vector<u8> host_code;
+  u64 host_address = 0;
+
+  // Formats everything above, with the host code as hex.
+  std::string ToString() const;
+};
+
+// Runs the JIT one block at a time, and checks each block against the interpreter.
+//
+// Before each block, the interpreter runs the same code from the same state, logging the memory it
+// stores to. The stores are then undone, the registers restored, and the JIT runs the block. The
+// JIT's registers and the stored memory are compared to what the interpreter left after the same
+// number of instructions.
+//
+// The JIT only returns after a single block when debugging is enabled, the CPU isn't running and
+// blocks aren't linked, so this is meant for headless use, such as tests, rather than for a game
+// that is running normally. Hardware accesses are made twice, and are only checked as far as the
+// registers go.
+class LockstepTester
+{
+public:
+  // Block linking is disabled for as long as the tester exists.
+  explicit LockstepTester(Core::System& system);
+  LockstepTester(const LockstepTester&) = delete;
+  LockstepTester(LockstepTester&&) = delete;
+  LockstepTester& operator=(const LockstepTester&) = delete;
+  LockstepTester& operator=(LockstepTester&&) = delete;
+  ~LockstepTester();
+
+  // Whether the current CPU core can be tested, which needs a JIT (or the cached interpreter)
+  // with debugging enabled, and the CPU thread not to be running.
+  bool IsAvailable() const;
+
+  // Runs the block at the current PC. The JIT's state is kept, even if it diverged.
+  std::optional<LockstepDivergence> RunBlock(const Core::CPUThreadGuard& guard);
+
+  // The FPSCR bits to compare. The JITs don't compute every FPSCR bit unless the accuracy
+  // options are enabled, so this allows ignoring the ones that are known to differ.
+  void SetFPSCRMask(u32 mask) { m_fpscr_mask = mask; }
+  // The CR bits to compare. The JITs set the SO bit of a CR field whenever the result that a
+  // compare or record form instruction writes to it is negative, instead of copying XER[SO], so
+  // this allows ignoring those bits.
+  void SetCRMask(u32 mask) { m_cr_mask = mask; }
+
+  u64 GetBlockCount() const { return m_block_count; }
+  u64 GetInstructionCount() const { return m_instruction_count; }
+
+private:
+  Core::System& m_system;
+  u32 m_cr_mask = 0xffffffff;
+  u32 m_fpscr_mask = 0xffffffff;
+  u64 m_block_count = 0;
+  u64 m_instruction_count = 0;
+  bool m_block_linking_was_disabled = false;
+};
+}  // namespace PowerPC
@@ -175,6 +175,16 @@ T MMU::ReadFromHardware(u32 em_address)
   if (!never_translate &&
       (IsOpcodeFlag(flag) ? m_ppc_state.msr.IR.Value() : m_ppc_state.msr.DR.Value()))
   {
+    if constexpr (!IsOpcodeFlag(flag))
+    {
+      if (const u8* host_page = LookupHostPage(em_address, false))
+      {
+        T value;
+        std::memcpy(&value, host_page + (em_address & HW_PAGE_MASK), sizeof(T));
+        return bswap(value);
+      }
+    }
+
     auto translated_addr = TranslateAddress<flag>(em_address);
     if (!translated_addr.Success())
     {
@@ -182,6 +192,8 @@ T MMU::ReadFromHardware(u32 em_address)
         GenerateDSIException(em_address, false);
       return 0;
     }
+    if (flag == XCheckTLBFlag::Read)
+      AddHostPage(em_address, translated_addr, false);
     em_address = translated_addr.address;
     wi = translated_addr.wi;
   }
@@ -288,6 +300,13 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
 
   if (!never_translate && m_ppc_state.msr.DR)
   {
+    if (u8* host_page = LookupHostPage(em_address, true))
+    {
+      const u32 swapped_data = Common::swap32(std::rotr(data, size * 8));
+      std::memcpy(host_page + (em_address & HW_PAGE_MASK), &swapped_data, size);
+      return;
+    }
+
     auto translated_addr = TranslateAddress<flag>(em_address);
     if (!translated_addr.Success())
     {
@@ -295,6 +314,8 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
         GenerateDSIException(em_address, true);
       return;
     }
+    if (flag == XCheckTLBFlag::Write)
+      AddHostPage(em_address, translated_addr, true);
     em_address = translated_addr.address;
     wi = translated_addr.wi;
   }
@@ -917,9 +938,6 @@ std::optional<ReadResult<std::string>> MMU::HostTryReadString(const Core::CPUThr
 
 bool MMU::IsOptimizableRAMAddress(const u32 address) const
 {
-  if (m_power_pc.GetMemChecks().HasAny())
-    return false;
-
   if (!m_ppc_state.msr.DR)
     return false;
 
@@ -929,7 +947,7 @@ bool MMU::IsOptimizableRAMAddress(const u32 address) const
   // TODO: This API needs to take an access size
   //
   // We store whether an access can be optimized to an unchecked access
-  // in dbat_table.
+  // in dbat_table. Pages that overlap memchecks can't be.
   u32 bat_result = m_dbat_table[address >> BAT_INDEX_SHIFT];
   return (bat_result & BAT_PHYSICAL_BIT) != 0;
 }
@@ -1217,7 +1235,7 @@ void MMU::TouchDCacheLine(u32 address, bool store)
 
 u32 MMU::IsOptimizableMMIOAccess(u32 address, u32 access_size) const
 {
-  if (m_power_pc.GetMemChecks().HasAny())
+  if (m_power_pc.GetMemChecks().OverlapsMemcheck(address, BAT_PAGE_SIZE))
     return 0;
 
   if (!m_ppc_state.msr.DR)
@@ -1243,7 +1261,7 @@ u32 MMU::IsOptimizableMMIOAccess(u32 address, u32 access_size) const
 
 bool MMU::IsOptimizableGatherPipeWrite(u32 address) const
 {
-  if (m_power_pc.GetMemChecks().HasAny())
+  if (m_power_pc.GetMemChecks().OverlapsMemcheck(address, BAT_PAGE_SIZE))
     return false;
 
   if (!m_ppc_state.msr.DR)
@@ -1416,6 +1434,65 @@ void MMU::InvalidateTLBEntry(u32 address)
 
   m_ppc_state.tlb[0][entry_index].Invalidate();
   m_ppc_state.tlb[1][entry_index].Invalidate();
+
+  // tlbie invalidates the whole congruence class, so do the same for the host pages.
+  for (HostPageCache& host_pages : m_host_pages)
+  {
+    for (size_t i = entry_index; i < HOST_PAGE_CACHE_SIZE; i += HW_PAGE_INDEX_MASK + 1)
+      host_pages[i] = {};
+  }
+}
+
+u8* MMU::LookupHostPage(u32 address, bool write)
+{
+  if (m_ppc_state.m_enable_dcache)
+    return nullptr;
+
+  const u32 tag = address >> HW_PAGE_INDEX_SHIFT;
+  const HostPageEntry& entry = m_host_pages[write][tag & (HOST_PAGE_CACHE_SIZE - 1)];
+  if (entry.tag != tag || entry.segment != m_ppc_state.sr[EffectiveAddress{address}.SR])
+    return nullptr;
+
+  return entry.host_page;
+}
+
+void MMU::AddHostPage(u32 address, const TranslateAddressResult& result, bool write)
+{
+  if (result.wi || m_ppc_state.m_enable_dcache)
+    return;
+
+  u8* const host_page = GetHostPagePointer(result.address & ~HW_PAGE_MASK);
+  if (!host_page)
+    return;
+
+  const u32 tag = address >> HW_PAGE_INDEX_SHIFT;
+  const u32 segment = m_ppc_state.sr[EffectiveAddress{address}.SR];
+  m_host_pages[write][tag & (HOST_PAGE_CACHE_SIZE - 1)] = {tag, segment, host_page};
+}
+
+u8* MMU::GetHostPagePointer(u32 physical_address) const
+{
+  // The same checks as the RAM, EXRAM and fake VMEM cases of ReadFromHardware and WriteToHardware.
+  // None of the ranges that are checked before those can overlap them.
+  if (m_memory.GetRAM() && (physical_address & 0xF8000000) == 0x00000000)
+    return m_memory.GetRAM() + (physical_address & m_memory.GetRamMask());
+
+  if (m_memory.GetEXRAM() && (physical_address >> 28) == 0x1 &&
+      (physical_address & 0x0FFFFFFF) < m_memory.GetExRamSizeReal())
+  {
+    return m_memory.GetEXRAM() + (physical_address & 0x0FFFFFFF);
+  }
+
+  if (m_memory.GetFakeVMEM() && ((physical_address & 0xFE000000) == 0x7E000000))
+    return m_memory.GetFakeVMEM() + (physical_address & m_memory.GetFakeVMemMask());
+
+  return nullptr;
+}
+
+void MMU::InvalidateHostPages()
+{
+  for (HostPageCache& host_pages : m_host_pages)
+    host_pages.fill({});
 }
 
 // Page Address Translation
@@ -1569,6 +1646,7 @@ void MMU::UpdateBATs(BatTable& bat_table, u32 base_spr)
         // BAT_MAPPED_BIT is whether the translation is valid
         // BAT_PHYSICAL_BIT is whether we can use the fastmem arena
         // BAT_WI_BIT is whether either W or I (of WIMG) is set
+        // BAT_MEMCHECK_BIT is whether only the fastmem arena can be used, because of memchecks
         u32 valid_bit = BAT_MAPPED_BIT;
 
         const bool wi = (batl.WIMG & 0b1100) != 0;
@@ -1600,10 +1678,15 @@ void MMU::UpdateBATs(BatTable& bat_table, u32 base_spr)
           }
         }
 
-        // Fast accesses don't support memchecks, so force slow accesses by removing fastmem
-        // mappings for all overlapping virtual pages.
-        if (m_power_pc.GetMemChecks().OverlapsMemcheck(virtual_address, BAT_PAGE_SIZE))
-          valid_bit &= ~BAT_PHYSICAL_BIT;
+        // Fast accesses don't support memchecks. The fastmem arena still maps overlapping
+        // virtual pages, but with the watched host pages protected, so that only accesses to those
+        // fault and get backpatched to slow accesses. Everything else that checks
+        // BAT_PHYSICAL_BIT has to use slow accesses for the whole page.
+        if ((valid_bit & BAT_PHYSICAL_BIT) &&
+            m_power_pc.GetMemChecks().OverlapsMemcheck(virtual_address, BAT_PAGE_SIZE))
+        {
+          valid_bit = (valid_bit & ~BAT_PHYSICAL_BIT) | BAT_MEMCHECK_BIT;
+        }
 
         // (BEPI | j) == (BEPI & ~BL) | (j & BL).
         bat_table[virtual_address >> BAT_INDEX_SHIFT] = physical_address | valid_bit;
@@ -1623,14 +1706,47 @@ void MMU::UpdateFakeMMUBat(BatTable& bat_table, u32 start_addr)
     u32 flags = BAT_MAPPED_BIT | BAT_PHYSICAL_BIT;
 
     if (m_power_pc.GetMemChecks().OverlapsMemcheck(e_address << BAT_INDEX_SHIFT, BAT_PAGE_SIZE))
-      flags &= ~BAT_PHYSICAL_BIT;
+      flags = (flags & ~BAT_PHYSICAL_BIT) | BAT_MEMCHECK_BIT;
 
     bat_table[e_address] = p_address | flags;
   }
 }
 
+void MMU::ProtectMemcheckPages()
+{
+  const auto& mem_checks = m_power_pc.GetMemChecks().GetMemChecks();
+  if (mem_checks.empty())
+    return;
+
+  // A page can be watched by several memchecks, so protect against writes first, so that
+  // protecting against reads afterwards can't be undone.
+  for (const bool reads : {false, true})
+  {
+    for (const TMemCheck& mc : mem_checks)
+    {
+      if (reads ? !mc.is_break_on_read : (mc.is_break_on_read || !mc.is_break_on_write))
+        continue;
+
+      u32 address = mc.start_address;
+      while (true)
+      {
+        const u32 page_end = address | (BAT_PAGE_SIZE - 1);
+        const u32 end = std::min(mc.end_address, page_end);
+        if (m_dbat_table[address >> BAT_INDEX_SHIFT] & BAT_MEMCHECK_BIT)
+          m_memory.ProtectLogicalMemory(address, end - address + 1, !reads);
+        if (end >= mc.end_address)
+          break;
+        address = end + 1;
+      }
+    }
+  }
+}
+
 void MMU::DBATUpdated()
 {
+  // This is also how the TLB gets reset and the memory layout changes, so start over.
+  InvalidateHostPages();
+
   m_dbat_table = {};
   UpdateBATs(m_dbat_table, SPR_DBAT0U);
   bool extended_bats = SConfig::GetInstance().bWii && HID4(m_ppc_state).SBE;
@@ -1645,6 +1761,7 @@ void MMU::DBATUpdated()
 
 #ifndef _ARCH_32
   m_memory.UpdateLogicalMemory(m_dbat_table);
+  ProtectMemcheckPages();
 #endif
 
   // IsOptimizable*Address and dcbz depends on the BAT mapping, so we need a flush here.
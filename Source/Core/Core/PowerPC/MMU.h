@@ -64,7 +64,8 @@ constexpr u32 BAT_PAGE_COUNT = 1 << (32 - BAT_INDEX_SHIFT);
 constexpr u32 BAT_MAPPED_BIT = 0x1;
 constexpr u32 BAT_PHYSICAL_BIT = 0x2;
 constexpr u32 BAT_WI_BIT = 0x4;
-constexpr u32 BAT_RESULT_MASK = UINT32_C(~0x7);
+constexpr u32 BAT_MEMCHECK_BIT = 0x8;
+constexpr u32 BAT_RESULT_MASK = UINT32_C(~0xF);
 using BatTable = std::array<u32, BAT_PAGE_COUNT>;  // 128 KB
 
 constexpr size_t HW_PAGE_SIZE = 4096;
@@ -291,6 +292,25 @@ private:
     explicit EffectiveAddress(u32 address) : Hex{address} {}
   };
 
+  // A direct mapped cache of recent data translations that end up in RAM, from effective page to
+  // host pointer, with separate entries for reads and writes. It lets the slow memory paths skip
+  // translation and the physical address checks. It is larger than the data TLB, which is fine
+  // since software has to use tlbie after changing a page table entry anyway. Entries are only
+  // added by accesses that have set the R bit, and the C bit for writes.
+  struct HostPageEntry
+  {
+    static constexpr u32 INVALID_TAG = 0xffffffff;
+
+    // The effective address >> HW_PAGE_INDEX_SHIFT.
+    u32 tag = INVALID_TAG;
+    // The segment register the translation was done with.
+    u32 segment = 0;
+    u8* host_page = nullptr;
+  };
+
+  static constexpr size_t HOST_PAGE_CACHE_SIZE = 4096;
+  using HostPageCache = std::array<HostPageEntry, HOST_PAGE_CACHE_SIZE>;
+
   template <const XCheckTLBFlag flag>
   TranslateAddressResult TranslateAddress(u32 address);
 
@@ -302,8 +322,14 @@ private:
 
   void Memcheck(u32 address, u64 var, bool write, size_t size);
 
+  u8* LookupHostPage(u32 address, bool write);
+  void AddHostPage(u32 address, const TranslateAddressResult& result, bool write);
+  u8* GetHostPagePointer(u32 physical_address) const;
+  void InvalidateHostPages();
+
   void UpdateBATs(BatTable& bat_table, u32 base_spr);
   void UpdateFakeMMUBat(BatTable& bat_table, u32 start_addr);
+  void ProtectMemcheckPages();
 
   template <XCheckTLBFlag flag, typename T, bool never_translate = false>
   T ReadFromHardware(u32 em_address);
@@ -326,6 +352,9 @@ private:
 
   BatTable m_ibat_table;
   BatTable m_dbat_table;
+
+  // Indexed by whether the access is a write.
+  std::array<HostPageCache, 2> m_host_pages;
 };
 
 void ClearDCacheLineFromJit(MMU& mmu, u32 address);
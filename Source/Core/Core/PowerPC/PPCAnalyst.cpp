@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <map>
+#include <optional>
 #include <queue>
 #include <string>
 #include <vector>
@@ -15,6 +16,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/WorkQueueThreadPool.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -44,6 +46,10 @@ namespace PPCAnalyst
 // 0 does not perform block merging
 constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
 
+// How many instructions a loop spanning several blocks can have, including a called function, for
+// it to be considered for idle skipping.
+constexpr u32 IDLE_LOOP_MAX_INSTRUCTIONS = 32;
+
 constexpr u32 INVALID_BRANCH_TARGET = 0xFFFFFFFF;
 
 static u32 EvaluateBranchTarget(UGeckoInstruction instr, u32 pc)
@@ -279,37 +285,52 @@ bool PPCAnalyzer::CanSwapAdjacentOps(const CodeOp& a, const CodeOp& b) const
 // called by another function. Therefore, let's scan the
 // entire space for bl operations and find what functions
 // get called.
+//
+// The scan is split into chunks that are searched in parallel, since it covers all of RAM. Only
+// the host read functions are used there, as the others update the caches. The functions are
+// then added in address order, the same as a serial scan would.
 static void FindFunctionsFromBranches(const Core::CPUThreadGuard& guard, u32 startAddr, u32 endAddr,
                                       Common::SymbolDB* func_db)
 {
-  auto& mmu = guard.GetSystem().GetMMU();
-  for (u32 addr = startAddr; addr < endAddr; addr += 4)
-  {
-    const PowerPC::TryReadInstResult read_result = mmu.TryReadInstruction(addr);
-    const UGeckoInstruction instr = read_result.hex;
-
-    if (read_result.valid && PPCTables::IsValidInstruction(instr, addr))
+  constexpr u32 CHUNK_SIZE = 0x10000;
+  const size_t chunk_count =
+      endAddr > startAddr ? (u64{endAddr} - startAddr + CHUNK_SIZE - 1) / CHUNK_SIZE : 0;
+  std::vector<std::vector<u32>> targets(chunk_count);
+
+  const auto scan_chunk = [&](size_t chunk) {
+    const u32 chunk_start = startAddr + static_cast<u32>(chunk * CHUNK_SIZE);
+    const u32 chunk_end = static_cast<u32>(std::min<u64>(u64{chunk_start} + CHUNK_SIZE, endAddr));
+    for (u32 addr = chunk_start; addr < chunk_end; addr += 4)
     {
-      switch (instr.OPCD)
-      {
-      case 18:  // branch instruction
+      const std::optional<PowerPC::ReadResult<u32>> read_result =
+          PowerPC::MMU::HostTryReadInstruction(guard, addr);
+      if (!read_result)
+        continue;
+
+      const UGeckoInstruction instr = read_result->value;
+      if (instr.OPCD == 18 && instr.LK && PPCTables::IsValidInstruction(instr, addr))  // bl
       {
-        if (instr.LK)  // bl
-        {
-          u32 target = SignExt26(instr.LI << 2);
-          if (!instr.AA)
-            target += addr;
-          if (PowerPC::MMU::HostIsRAMAddress(guard, target))
-          {
-            func_db->AddFunction(guard, target);
-          }
-        }
-      }
-      break;
-      default:
-        break;
+        u32 target = SignExt26(instr.LI << 2);
+        if (!instr.AA)
+          target += addr;
+        if (PowerPC::MMU::HostIsRAMAddress(guard, target))
+          targets[chunk].push_back(target);
       }
     }
+  };
+
+  Common::WorkQueueThreadPool<size_t> scan_pool(
+      "Function Scan",
+      std::min(chunk_count, Common::WorkQueueThreadPool<size_t>::GetDefaultThreadCount()),
+      scan_chunk);
+  for (size_t chunk = 0; chunk < chunk_count; ++chunk)
+    scan_pool.Push(chunk);
+  scan_pool.WaitForCompletion();
+
+  for (const std::vector<u32>& chunk_targets : targets)
+  {
+    for (const u32 target : chunk_targets)
+      func_db->AddFunction(guard, target);
   }
 }
 
@@ -739,10 +760,8 @@ bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instruct
   //   * It only reads from registers it wrote to earlier in the loop, or it
   //     does not write to these registers.
   //
-  // Would benefit a lot from basic inlining support - a lot of the most
-  // used busy loops are DSP register interactions, which are bl/cmp/bne
-  // (with the bl target a pure function that follows the above rules). We
-  // don't detect these at the moment.
+  // Loops that don't fit in a single block, like the bl/cmp/bne loops used for
+  // DSP register interactions, are handled by IsMultiBlockIdleLoop.
   std::bitset<32> write_disallowed_regs;
   std::bitset<32> written_regs;
   for (size_t i = 0; i <= instructions; ++i)
@@ -784,6 +803,109 @@ bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instruct
   return false;
 }
 
+bool PPCAnalyzer::IsMultiBlockIdleLoop(CodeBlock* block, const CodeOp& branch) const
+{
+  // Detects busy wait loops that IsBusyWaitLoop can't see because they span several blocks, for
+  // example because they call a small accessor function, or because they are entered in the middle.
+  // Starting from the branch target, the instructions are read from memory and followed (into a
+  // called function and back out of it) until they get back to the branch, with the same rules as
+  // IsBusyWaitLoop. Other conditional branches on the way must leave the loop. Inside the called
+  // function, where that can't be told from the branch target, they aren't allowed at all.
+  if (branch.branchTo == UINT32_MAX || branch.branchUsesCtr || branch.inst.LK ||
+      branch.branchTo > branch.address ||
+      branch.address - branch.branchTo >= IDLE_LOOP_MAX_INSTRUCTIONS * 4)
+  {
+    return false;
+  }
+
+  // SetInstructionStats needs somewhere to write block statistics to.
+  BlockStats stats{};
+  BlockRegStats gpa{}, fpa{};
+  CodeBlock scratch_block;
+  scratch_block.m_stats = &stats;
+  scratch_block.m_gpa = &gpa;
+  scratch_block.m_fpa = &fpa;
+
+  auto& mmu = Core::System::GetInstance().GetMMU();
+  std::vector<u32> physical_addresses;
+  BitSet32 write_disallowed_regs, written_regs;
+  BitSet8 write_disallowed_cr, written_cr;
+  u32 address = branch.branchTo;
+  u32 return_address = UINT32_MAX;
+  for (u32 i = 0; i < IDLE_LOOP_MAX_INSTRUCTIONS; ++i)
+  {
+    const PowerPC::TryReadInstResult result = mmu.TryReadInstruction(address);
+    if (!result.valid)
+      return false;
+    physical_addresses.push_back(result.physical_address);
+
+    CodeOp op;
+    op.inst = result.hex;
+    op.address = address;
+    op.opinfo = PPCTables::GetOpInfo(op.inst, address);
+    SetInstructionStats(&scratch_block, &op, op.opinfo);
+
+    write_disallowed_regs |= op.regsIn & ~written_regs;
+    write_disallowed_cr |= op.crIn & ~written_cr;
+    if (op.regsOut & write_disallowed_regs || op.crOut & write_disallowed_cr)
+      return false;
+    written_regs |= op.regsOut;
+    written_cr |= op.crOut;
+
+    if (address == branch.address)
+    {
+      // The loop also has to be recompiled if the parts outside of this block change.
+      block->m_physical_addresses.insert(physical_addresses.begin(), physical_addresses.end());
+      return true;
+    }
+
+    if (op.opinfo->type == OpType::Branch)
+    {
+      if (op.branchUsesCtr)
+        return false;
+
+      const bool unconditional =
+          (op.inst.BO & BO_DONT_DECREMENT_FLAG) && (op.inst.BO & BO_DONT_CHECK_CONDITION);
+      if (op.inst.OPCD == 18)  // bx
+      {
+        if (op.inst.LK)
+        {
+          // Only calls to leaf functions are followed.
+          if (return_address != UINT32_MAX)
+            return false;
+          return_address = address + 4;
+        }
+        address = op.branchTo;
+        continue;
+      }
+      if (op.inst.OPCD == 19 && op.inst.SUBOP10 == 16 && !op.inst.LK && unconditional &&
+          return_address != UINT32_MAX)  // blr
+      {
+        address = return_address;
+        return_address = UINT32_MAX;
+        continue;
+      }
+
+      // Anything else has to be a conditional branch that leaves the loop, or goes back to its
+      // start without having done anything that the full loop isn't allowed to do.
+      if (op.inst.OPCD != 16 || op.inst.LK || unconditional || return_address != UINT32_MAX)
+        return false;
+      if (op.branchTo != branch.branchTo && op.branchTo > branch.branchTo &&
+          op.branchTo <= branch.address)
+      {
+        return false;
+      }
+    }
+    else if (op.opinfo->type != OpType::Integer && op.opinfo->type != OpType::Load)
+    {
+      return false;
+    }
+
+    address += 4;
+  }
+  return false;
+}
+
 static bool CanCauseGatherPipeInterruptCheck(const CodeOp& op)
 {
   // eieio
@@ -941,8 +1063,10 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
       }
     }
 
-    code[i].branchIsIdleLoop =
-        code[i].branchTo == block->m_address && IsBusyWaitLoop(block, code, i);
+    if (code[i].branchTo == block->m_address)
+      code[i].branchIsIdleLoop = IsBusyWaitLoop(block, code, i);
+    else
+      code[i].branchIsIdleLoop = IsMultiBlockIdleLoop(block, code[i]);
 
     if (follow && numFollows < BRANCH_FOLLOWING_THRESHOLD)
     {
@@ -198,6 +198,7 @@ private:
   void ReorderInstructions(u32 instructions, CodeOp* code) const;
   void SetInstructionStats(CodeBlock* block, CodeOp* code, const GekkoOPInfo* opinfo) const;
   bool IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions) const;
+  bool IsMultiBlockIdleLoop(CodeBlock* block, const CodeOp& branch) const;
 
   // Options
   u32 m_options = 0;
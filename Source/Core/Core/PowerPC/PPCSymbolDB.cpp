@@ -4,6 +4,7 @@
 #include "Core/PowerPC/PPCSymbolDB.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <map>
 #include <sstream>
@@ -15,6 +16,7 @@
 #include <fmt/format.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/Hash.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
@@ -455,17 +457,12 @@ bool PPCSymbolDB::LoadMap(const Core::CPUThreadGuard& guard, const std::string&
   return true;
 }
 
-// Save symbol map similar to CodeWarrior's map file
-bool PPCSymbolDB::SaveSymbolMap(const std::string& filename) const
+static void WriteSymbolMap(File::IOFile& f, const Common::SymbolDB::XFuncMap& functions)
 {
-  File::IOFile f(filename, "w");
-  if (!f)
-    return false;
-
   std::vector<const Common::Symbol*> function_symbols;
   std::vector<const Common::Symbol*> data_symbols;
 
-  for (const auto& function : m_functions)
+  for (const auto& function : functions)
   {
     const Common::Symbol& symbol = function.second;
     if (symbol.type == Common::Symbol::Type::Function)
@@ -491,7 +488,72 @@ bool PPCSymbolDB::SaveSymbolMap(const std::string& filename) const
     f.WriteString(fmt::format("{0:08x} {1:08x} {2:08x} {3} {4}\n", symbol->address, symbol->size,
                               symbol->address, 0, symbol->name));
   }
+}
+
+// Save symbol map similar to CodeWarrior's map file
+bool PPCSymbolDB::SaveSymbolMap(const std::string& filename) const
+{
+  File::IOFile f(filename, "w");
+  if (!f)
+    return false;
+
+  WriteSymbolMap(f, m_functions);
+  return true;
+}
+
+// Identifies the code that the functions cover, using the checksums that are already computed for
+// them. LoadMap recomputes the checksums from memory, so this changes if any of the code does.
+static u32 ComputeCodeHash(const Common::SymbolDB::XFuncMap& functions)
+{
+  std::vector<u32> values;
+  for (const auto& [address, symbol] : functions)
+  {
+    if (symbol.type == Common::Symbol::Type::Function)
+      values.insert(values.end(), {address, symbol.size, symbol.hash});
+  }
+  return Common::ComputeCRC32(reinterpret_cast<const u8*>(values.data()),
+                              values.size() * sizeof(u32));
+}
+
+// LoadMap skips this, as it comes before the first section.
+constexpr std::string_view GENERATED_MAP_HEADER = "# Generated symbol map";
+
+bool PPCSymbolDB::SaveGeneratedMap(const std::string& filename, u32 source_hash) const
+{
+  File::IOFile f(filename, "w");
+  if (!f)
+    return false;
+
+  f.WriteString(fmt::format("{} {:08x} {:08x}\n", GENERATED_MAP_HEADER, source_hash,
+                            ComputeCodeHash(m_functions)));
+  WriteSymbolMap(f, m_functions);
+  return true;
+}
+
+bool PPCSymbolDB::LoadGeneratedMap(const Core::CPUThreadGuard& guard, const std::string& filename,
+                                   u32 source_hash)
+{
+  u32 code_hash;
+  {
+    File::IOFile f(filename, "r");
+    char line[64];
+    if (!f || !fgets(line, sizeof(line), f.GetHandle()))
+      return false;
+
+    const std::string prefix = fmt::format("{} {:08x} ", GENERATED_MAP_HEADER, source_hash);
+    if (!std::string_view{line}.starts_with(prefix))
+      return false;
+    code_hash = static_cast<u32>(std::strtoul(line + prefix.size(), nullptr, 16));
+  }
+
+  if (!LoadMap(guard, filename) || ComputeCodeHash(m_functions) != code_hash)
+  {
+    INFO_LOG_FMT(SYMBOLS, "The code has changed since {} was generated", filename);
+    Clear();
+    return false;
+  }
 
+  FillInCallers();
   return true;
 }
 
@@ -36,6 +36,14 @@ public:
   bool SaveSymbolMap(const std::string& filename) const;
   bool SaveCodeMap(const Core::CPUThreadGuard& guard, const std::string& filename) const;
 
+  // For caching symbol maps that were generated, such as by finding functions and applying a
+  // signature database. source_hash identifies whatever the map was generated from. The map is only
+  // loaded if it matches, and if the code of every function in it is unchanged. The symbol map
+  // should be empty before loading, and it is left empty if the cached map can't be used.
+  bool SaveGeneratedMap(const std::string& filename, u32 source_hash) const;
+  bool LoadGeneratedMap(const Core::CPUThreadGuard& guard, const std::string& filename,
+                        u32 source_hash);
+
   void PrintCalls(u32 funcAddr) const;
   void PrintCallers(u32 funcAddr) const;
   void LogFunctionCall(u32 addr);
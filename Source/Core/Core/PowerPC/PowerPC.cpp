@@ -86,7 +86,8 @@ std::ostream& operator<<(std::ostream& os, CPUCore core)
 }
 
 PowerPCManager::PowerPCManager(Core::System& system)
-    : m_breakpoints(system), m_memchecks(system), m_debug_interface(system), m_system(system)
+    : m_breakpoints(system), m_memchecks(system), m_debug_interface(system),
+      m_sampling_profiler(system), m_system(system)
 {
 }
 
@@ -325,6 +326,7 @@ void PowerPCManager::ScheduleInvalidateCacheThreadSafe(u32 address)
 
 void PowerPCManager::Shutdown()
 {
+  m_sampling_profiler.Stop();
   CPUThreadConfigCallback::RemoveConfigChangedCallback(m_registered_config_callback_id);
   InjectExternalCPUCore(nullptr);
   m_system.GetJitInterface().Shutdown();
@@ -19,6 +19,7 @@
 #include "Core/PowerPC/ConditionRegister.h"
 #include "Core/PowerPC/Gekko.h"
 #include "Core/PowerPC/PPCCache.h"
+#include "Core/PowerPC/SamplingProfiler.h"
 
 class CPUCoreBase;
 class PointerWrap;
@@ -296,6 +297,8 @@ public:
   const MemChecks& GetMemChecks() const { return m_memchecks; }
   PPCDebugInterface& GetDebugInterface() { return m_debug_interface; }
   const PPCDebugInterface& GetDebugInterface() const { return m_debug_interface; }
+  Profiler::SamplingProfiler& GetSamplingProfiler() { return m_sampling_profiler; }
+  const Profiler::SamplingProfiler& GetSamplingProfiler() const { return m_sampling_profiler; }
 
 private:
   void InitializeCPUCore(CPUCore cpu_core);
@@ -312,6 +315,7 @@ private:
   BreakPoints m_breakpoints;
   MemChecks m_memchecks;
   PPCDebugInterface m_debug_interface;
+  Profiler::SamplingProfiler m_sampling_profiler;
 
   CPUThreadConfigCallback::ConfigChangedCallbackID m_registered_config_callback_id;
 
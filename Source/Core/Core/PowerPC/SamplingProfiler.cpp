@@ -0,0 +1,195 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/SamplingProfiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+#include <fmt/format.h>
+
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/SymbolDB.h"
+#include "Common/Thread.h"
+#include "Core/Core.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+namespace Profiler
+{
+// Deep enough for any sensible guest call stack, while bounding the time spent walking a corrupt
+// back chain.
+constexpr u32 MAX_STACK_DEPTH = 64;
+
+SamplingProfiler::SamplingProfiler(Core::System& system) : m_system(system)
+{
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+  Stop();
+}
+
+void SamplingProfiler::Start(u32 samples_per_second)
+{
+  Stop();
+
+  {
+    std::lock_guard lk(m_samples_lock);
+    m_samples.clear();
+    m_sample_count = 0;
+    m_skipped_sample_count = 0;
+  }
+  m_pending_samples.store(0, std::memory_order_relaxed);
+  m_running.store(true, std::memory_order_relaxed);
+  if (samples_per_second != 0)
+  {
+    m_stop_event.Reset();
+    m_timer_thread = std::thread(&SamplingProfiler::TimerThread, this, samples_per_second);
+  }
+}
+
+void SamplingProfiler::Stop()
+{
+  if (!m_running.load(std::memory_order_relaxed))
+    return;
+
+  m_running.store(false, std::memory_order_relaxed);
+  if (m_timer_thread.joinable())
+  {
+    m_stop_event.Set();
+    m_timer_thread.join();
+  }
+  m_pending_samples.store(0, std::memory_order_relaxed);
+}
+
+void SamplingProfiler::RequestSample()
+{
+  if (m_running.load(std::memory_order_relaxed))
+    m_pending_samples.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SamplingProfiler::TimerThread(u32 samples_per_second)
+{
+  Common::SetCurrentThreadName("Guest Profiler");
+
+  const auto period = std::chrono::nanoseconds(std::chrono::seconds(1)) / samples_per_second;
+  auto next_sample = std::chrono::steady_clock::now() + period;
+  while (!m_stop_event.WaitFor(next_sample - std::chrono::steady_clock::now()))
+  {
+    RequestSample();
+    next_sample += period;
+  }
+}
+
+void SamplingProfiler::TakeSample()
+{
+  const u32 requested = m_pending_samples.exchange(0, std::memory_order_relaxed);
+  if (requested == 0)
+    return;
+
+  const auto& ppc_state = m_system.GetPPCState();
+  Core::CPUThreadGuard guard(m_system);
+
+  // Return addresses point at the instruction after the call, which can be the start of the next
+  // function, so the calls themselves are recorded.
+  std::vector<u32> stack;
+  stack.push_back(ppc_state.pc);
+  if (LR(ppc_state) != 0)
+    stack.push_back(LR(ppc_state) - 4);
+
+  u32 frame = ppc_state.gpr[1];
+  for (u32 depth = 0; depth < MAX_STACK_DEPTH; ++depth)
+  {
+    if (frame == 0 || !PowerPC::MMU::HostIsRAMAddress(guard, frame))
+      break;
+    frame = PowerPC::MMU::HostRead_U32(guard, frame);
+    if (frame == 0 || !PowerPC::MMU::HostIsRAMAddress(guard, frame + 4))
+      break;
+    const u32 return_address = PowerPC::MMU::HostRead_U32(guard, frame + 4);
+    if (return_address == 0)
+      break;
+    stack.push_back(return_address - 4);
+  }
+  std::reverse(stack.begin(), stack.end());
+
+  std::lock_guard lk(m_samples_lock);
+  ++m_samples[std::move(stack)];
+  ++m_sample_count;
+  m_skipped_sample_count += requested - 1;
+}
+
+u64 SamplingProfiler::GetSampleCount() const
+{
+  std::lock_guard lk(m_samples_lock);
+  return m_sample_count;
+}
+
+u64 SamplingProfiler::GetSkippedSampleCount() const
+{
+  std::lock_guard lk(m_samples_lock);
+  return m_skipped_sample_count;
+}
+
+std::string SamplingProfiler::GetCollapsedStacks() const
+{
+  const auto get_name = [](u32 address) {
+    const Common::Symbol* symbol = g_symbolDB.GetSymbolFromAddr(address);
+    if (!symbol)
+      return fmt::format("{:08x}", address);
+
+    // Semicolons separate the frames.
+    std::string name = symbol->name;
+    std::replace(name.begin(), name.end(), ';', ':');
+    return name;
+  };
+
+  // Different addresses within the same functions make up the same stack once symbolized. The LR
+  // also repeats the innermost saved return address in functions that have already called
+  // something, so repeated functions are collapsed, which also folds direct recursion.
+  std::map<std::string, u64> stacks;
+  {
+    std::lock_guard lk(m_samples_lock);
+    for (const auto& [addresses, count] : m_samples)
+    {
+      std::string line;
+      std::string previous_name;
+      for (const u32 address : addresses)
+      {
+        std::string name = get_name(address);
+        if (name == previous_name)
+          continue;
+        if (!line.empty())
+          line += ';';
+        line += name;
+        previous_name = std::move(name);
+      }
+      stacks[std::move(line)] += count;
+    }
+  }
+
+  std::string result;
+  for (const auto& [line, count] : stacks)
+    fmt::format_to(std::back_inserter(result), "{} {}\n", line, count);
+  return result;
+}
+
+bool SamplingProfiler::WriteCollapsedStacks(const std::string& filename) const
+{
+  File::IOFile f(filename, "w");
+  if (!f || !f.WriteString(GetCollapsedStacks()))
+  {
+    ERROR_LOG_FMT(POWERPC, "Failed to write the guest profile to {}", filename);
+    return false;
+  }
+
+  NOTICE_LOG_FMT(POWERPC, "Wrote {} guest profile samples to {} ({} skipped while the CPU thread "
+                          "was busy)",
+                 GetSampleCount(), filename, GetSkippedSampleCount());
+  return true;
+}
+}  // namespace Profiler
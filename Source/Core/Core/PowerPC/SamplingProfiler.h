@@ -0,0 +1,89 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+
+namespace Core
+{
+class System;
+}
+
+namespace Profiler
+{
+// Samples the guest call stack at a fixed rate of host time, without compiling any
+// instrumentation into the JIT blocks.
+//
+// A host thread only requests the samples. They are taken by the CPU thread at the start of the
+// next timing slice, where the registers have been written back to the PPC state, so sampling
+// doesn't change anything about how the guest runs. Samples that were requested while the CPU
+// thread was busy elsewhere (such as throttling) only count once, since the PC they find says
+// nothing about where the time went. The rest are counted as skipped.
+class SamplingProfiler
+{
+public:
+  static constexpr u32 DEFAULT_SAMPLE_RATE = 1000;
+
+  explicit SamplingProfiler(Core::System& system);
+  SamplingProfiler(const SamplingProfiler&) = delete;
+  SamplingProfiler(SamplingProfiler&&) = delete;
+  SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+  SamplingProfiler& operator=(SamplingProfiler&&) = delete;
+  ~SamplingProfiler();
+
+  // Clears the previous samples and starts sampling. With a rate of 0, samples are only taken
+  // when they are requested with RequestSample().
+  void Start(u32 samples_per_second = DEFAULT_SAMPLE_RATE);
+  // Stops sampling. The samples are kept until the next Start().
+  void Stop();
+  bool IsRunning() const { return m_running.load(std::memory_order_relaxed); }
+
+  // Makes the CPU thread take a sample at the start of the next timing slice. Can be called from
+  // any thread while sampling.
+  void RequestSample();
+
+  // Must be called from the CPU thread at the start of each timing slice.
+  void CheckSample()
+  {
+    if (m_pending_samples.load(std::memory_order_relaxed) != 0) [[unlikely]]
+      TakeSample();
+  }
+
+  u64 GetSampleCount() const;
+  // The number of requested samples that weren't taken, because an earlier request was still
+  // pending.
+  u64 GetSkippedSampleCount() const;
+
+  // Returns the samples as collapsed stacks, one "outermost;...;innermost count" line for each
+  // distinct call stack, which flamegraph.pl, inferno and speedscope all read. The functions are
+  // named using the symbols that are loaded at the time this is called.
+  std::string GetCollapsedStacks() const;
+  bool WriteCollapsedStacks(const std::string& filename) const;
+
+private:
+  void TimerThread(u32 samples_per_second);
+  void TakeSample();
+
+  Core::System& m_system;
+
+  std::atomic<bool> m_running = false;
+  std::thread m_timer_thread;
+  Common::Event m_stop_event;
+  std::atomic<u32> m_pending_samples = 0;
+
+  // The return addresses of each sampled call stack, from the outermost call to the sampled PC.
+  mutable std::mutex m_samples_lock;
+  std::map<std::vector<u32>, u64> m_samples;
+  u64 m_sample_count = 0;
+  u64 m_skipped_sample_count = 0;
+};
+}  // namespace Profiler
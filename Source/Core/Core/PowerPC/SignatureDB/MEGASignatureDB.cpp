@@ -3,10 +3,12 @@
 
 #include "Core/PowerPC/SignatureDB/MEGASignatureDB.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
 #include <fstream>
 #include <limits>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -14,6 +16,7 @@
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/WorkQueueThreadPool.h"
 
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
@@ -101,6 +104,11 @@ bool GetRefs(MEGASignature* sig, std::istringstream* iss)
   return true;
 }
 
+u64 GetIndexKey(u32 size, u32 first_instruction)
+{
+  return (u64{size} << 32) | first_instruction;
+}
+
 bool Compare(const Core::CPUThreadGuard& guard, u32 address, u32 size, const MEGASignature& sig)
 {
   if (size != sig.code.size() * sizeof(u32))
@@ -124,6 +132,7 @@ MEGASignatureDB::~MEGASignatureDB() = default;
 void MEGASignatureDB::Clear()
 {
   m_signatures.clear();
+  m_index.clear();
 }
 
 bool MEGASignatureDB::Load(const std::string& file_path)
@@ -142,6 +151,9 @@ bool MEGASignatureDB::Load(const std::string& file_path)
 
     if (GetCode(&sig, &iss) && GetName(&sig, &iss) && GetRefs(&sig, &iss))
     {
+      const u32 size = static_cast<u32>(sig.code.size() * sizeof(u32));
+      const u32 first_instruction = sig.code.empty() ? 0 : sig.code[0];
+      m_index[GetIndexKey(size, first_instruction)].push_back(m_signatures.size());
       m_signatures.push_back(std::move(sig));
     }
     else
@@ -158,21 +170,76 @@ bool MEGASignatureDB::Save(const std::string& file_path) const
   return false;
 }
 
-void MEGASignatureDB::Apply(const Core::CPUThreadGuard& guard, PPCSymbolDB* symbol_db) const
+const MEGASignature* MEGASignatureDB::FindMatch(const Core::CPUThreadGuard& guard, u32 address,
+                                                u32 size) const
 {
-  for (auto& it : symbol_db->AccessSymbols())
+  if (size != 0 && (!PowerPC::MMU::HostIsRAMAddress(guard, address) ||
+                    !PowerPC::MMU::HostIsRAMAddress(guard, address + size - 1)))
   {
-    auto& symbol = it.second;
-    for (const auto& sig : m_signatures)
+    return nullptr;
+  }
+
+  // Looks through one list of candidates for a match that comes before the best one so far.
+  std::optional<size_t> best;
+  const auto find_in = [&](u64 key) {
+    const auto candidates = m_index.find(key);
+    if (candidates == m_index.end())
+      return;
+
+    for (const size_t i : candidates->second)
     {
-      if (Compare(guard, symbol.address, symbol.size, sig))
+      if (best && i > *best)
+        return;
+      if (Compare(guard, address, size, m_signatures[i]))
       {
-        symbol.name = sig.name;
-        INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", sig.name, symbol.address,
-                     symbol.size);
-        break;
+        best = i;
+        return;
       }
     }
+  };
+
+  // The code of a signature never starts with a literal 0, as that is the wildcard, so only the
+  // signatures that start with a wildcard can match code that starts with 0.
+  const u32 first_instruction = size != 0 ? PowerPC::MMU::HostRead_U32(guard, address) : 0;
+  find_in(GetIndexKey(size, first_instruction));
+  if (first_instruction != 0)
+    find_in(GetIndexKey(size, 0));
+
+  return best ? &m_signatures[*best] : nullptr;
+}
+
+void MEGASignatureDB::Apply(const Core::CPUThreadGuard& guard, PPCSymbolDB* symbol_db) const
+{
+  std::vector<Common::Symbol*> symbols;
+  for (auto& it : symbol_db->AccessSymbols())
+    symbols.push_back(&it.second);
+
+  // Comparing the code is the slow part, so it's done in parallel, and the symbols are renamed
+  // afterwards in order.
+  constexpr size_t SYMBOLS_PER_JOB = 256;
+  std::vector<const MEGASignature*> matches(symbols.size());
+  const size_t job_count = (symbols.size() + SYMBOLS_PER_JOB - 1) / SYMBOLS_PER_JOB;
+  Common::WorkQueueThreadPool<size_t> match_pool(
+      "Signature Matching",
+      std::min(job_count, Common::WorkQueueThreadPool<size_t>::GetDefaultThreadCount()),
+      [&](size_t job) {
+        const size_t end = std::min(symbols.size(), (job + 1) * SYMBOLS_PER_JOB);
+        for (size_t i = job * SYMBOLS_PER_JOB; i < end; ++i)
+          matches[i] = FindMatch(guard, symbols[i]->address, symbols[i]->size);
+      });
+  for (size_t job = 0; job < job_count; ++job)
+    match_pool.Push(job);
+  match_pool.WaitForCompletion();
+
+  for (size_t i = 0; i < symbols.size(); ++i)
+  {
+    if (!matches[i])
+      continue;
+
+    auto& symbol = *symbols[i];
+    symbol.name = matches[i]->name;
+    INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", matches[i]->name, symbol.address,
+                 symbol.size);
   }
   symbol_db->Index();
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -58,5 +59,11 @@ public:
            const std::string& name) override;
 
 private:
+  const MEGASignature* FindMatch(const Core::CPUThreadGuard& guard, u32 address, u32 size) const;
+
   std::vector<MEGASignature> m_signatures;
+  // Indices into m_signatures, keyed by the size of the code and its first instruction, which is
+  // 0 for the signatures that start with a wildcard. Each list is in file order, since the first
+  // signature that matches is the one that is used.
+  std::unordered_map<u64, std::vector<size_t>> m_index;
 };
@@ -123,22 +123,28 @@ void HashSignatureDB::Clear()
 
 void HashSignatureDB::Apply(const Core::CPUThreadGuard& guard, PPCSymbolDB* symbol_db) const
 {
-  for (const auto& entry : m_database)
+  // Databases usually have far more entries than the game has functions, so each function is
+  // looked up in the database rather than the other way around.
+  for (auto& [address, function] : symbol_db->AccessSymbols())
   {
-    for (const auto& function : symbol_db->GetSymbolsFromHash(entry.first))
+    if (function.type != Common::Symbol::Type::Function)
+      continue;
+
+    const auto entry = m_database.find(function.hash);
+    if (entry == m_database.end())
+      continue;
+
+    // Found the function. Let's rename it according to the symbol file.
+    function.Rename(entry->second.name);
+    if (entry->second.size == function.size)
     {
-      // Found the function. Let's rename it according to the symbol file.
-      function->Rename(entry.second.name);
-      if (entry.second.size == static_cast<unsigned int>(function->size))
-      {
-        INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", entry.second.name,
-                     function->address, function->size);
-      }
-      else
-      {
-        ERROR_LOG_FMT(SYMBOLS, "Wrong size! Found {} at {:08x} (size: {:08x} instead of {:08x})!",
-                      entry.second.name, function->address, function->size, entry.second.size);
-      }
+      INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", entry->second.name,
+                   function.address, function.size);
+    }
+    else
+    {
+      ERROR_LOG_FMT(SYMBOLS, "Wrong size! Found {} at {:08x} (size: {:08x} instead of {:08x})!",
+                    entry->second.name, function.address, function.size, entry->second.size);
     }
   }
   symbol_db->Index();
@@ -0,0 +1,1007 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/DedupBlob.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <zstd.h>
+
+#include "Common/Assert.h"
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
+#include "Common/Crypto/SHA1.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/MsgHandler.h"
+#include "Common/Random.h"
+#include "Common/StringUtil.h"
+#include "Core/IOS/ES/Formats.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/MultithreadedCompressor.h"
+#include "DiscIO/VolumeDisc.h"
+#include "DiscIO/VolumeWii.h"
+#include "DiscIO/WiiEncryptionCache.h"
+
+namespace DiscIO
+{
+static std::string GetStorePath(const std::string& manifest_path, const std::string& file_name)
+{
+  std::string directory;
+  SplitPath(manifest_path, &directory, nullptr, nullptr);
+  return directory + file_name;
+}
+
+// How many bytes of chunk data a region needs
+static u64 GetStoredSize(const DedupRegionEntry& region)
+{
+  if (!region.encrypted)
+    return region.size;
+
+  return region.size / VolumeWii::BLOCK_TOTAL_SIZE * VolumeWii::BLOCK_DATA_SIZE;
+}
+
+static u32 GetChunkCount(const DedupRegionEntry& region, u32 chunk_size)
+{
+  return static_cast<u32>((GetStoredSize(region) + chunk_size - 1) / chunk_size);
+}
+
+static bool AreRegionsValid(const DedupImageHeader& header,
+                            const std::vector<DedupRegionEntry>& regions,
+                            const std::vector<DedupHashException>& hash_exceptions)
+{
+  u64 offset = 0;
+  for (const DedupRegionEntry& region : regions)
+  {
+    if (region.offset != offset || region.size == 0 || region.size > header.data_size - offset)
+      return false;
+
+    if (region.encrypted && region.size % VolumeWii::BLOCK_TOTAL_SIZE != 0)
+      return false;
+
+    if (static_cast<u64>(region.first_chunk) + GetChunkCount(region, header.chunk_size) >
+        header.num_chunks)
+    {
+      return false;
+    }
+
+    if (static_cast<u64>(region.first_hash_exception) + region.num_hash_exceptions >
+        hash_exceptions.size())
+    {
+      return false;
+    }
+
+    // The exceptions of a region are sorted by group so that they can be looked up quickly
+    const auto begin = hash_exceptions.begin() + region.first_hash_exception;
+    const auto end = begin + region.num_hash_exceptions;
+    const auto compare_group = [](const DedupHashException& a, const DedupHashException& b) {
+      return a.group < b.group;
+    };
+    if (!std::is_sorted(begin, end, compare_group) ||
+        std::any_of(begin, end, [](const DedupHashException& exception) {
+          return exception.offset > VolumeWii::GROUP_HEADER_SIZE - Common::SHA1::DIGEST_LEN;
+        }))
+    {
+      return false;
+    }
+
+    offset += region.size;
+  }
+
+  return offset == header.data_size;
+}
+
+DedupFileReader::DedupFileReader(File::IOFile file, File::IOFile store, const std::string& path,
+                                 const DedupImageHeader& header,
+                                 std::vector<DedupRegionEntry> regions,
+                                 std::vector<DedupHashException> hash_exceptions,
+                                 std::vector<DedupChunkEntry> chunks)
+    : m_file(std::move(file)), m_store(std::move(store)), m_path(path), m_header(header),
+      m_regions(std::move(regions)), m_hash_exceptions(std::move(hash_exceptions)),
+      m_chunks(std::move(chunks)), m_encryption_cache(this), m_dctx(ZSTD_createDCtx())
+{
+  std::vector<std::pair<u64, u32>> stored_chunks;
+  stored_chunks.reserve(m_chunks.size());
+  for (const DedupChunkEntry& chunk : m_chunks)
+    stored_chunks.emplace_back(chunk.offset, chunk.stored_size);
+  std::sort(stored_chunks.begin(), stored_chunks.end());
+  stored_chunks.erase(std::unique(stored_chunks.begin(), stored_chunks.end()),
+                      stored_chunks.end());
+  for (const auto& stored_chunk : stored_chunks)
+    m_raw_size += stored_chunk.second;
+
+  m_stored_buffer.resize(ZSTD_compressBound(m_header.chunk_size));
+  m_chunk_buffer.resize(m_header.chunk_size);
+}
+
+DedupFileReader::~DedupFileReader()
+{
+  ZSTD_freeDCtx(m_dctx);
+}
+
+std::unique_ptr<DedupFileReader> DedupFileReader::Create(File::IOFile file,
+                                                         const std::string& path)
+{
+  DedupImageHeader header;
+  if (!file.Seek(0, File::SeekOrigin::Begin) || !file.ReadArray(&header, 1) ||
+      header.magic != DEDUP_MAGIC)
+  {
+    return nullptr;
+  }
+
+  if (header.version != DEDUP_VERSION || header.chunk_size == 0)
+  {
+    ERROR_LOG_FMT(DISCIO, "Unsupported or corrupt deduplicated image \"{}\"", path);
+    return nullptr;
+  }
+
+  std::string store_file_name(header.store_file_name_size, '\0');
+  std::vector<DedupRegionEntry> regions(header.num_regions);
+  std::vector<DedupHashException> hash_exceptions(header.num_hash_exceptions);
+  std::vector<DedupChunkEntry> chunks(header.num_chunks);
+  if (!file.ReadBytes(store_file_name.data(), store_file_name.size()) ||
+      !file.ReadArray(regions.data(), regions.size()) ||
+      !file.ReadArray(hash_exceptions.data(), hash_exceptions.size()) ||
+      !file.ReadArray(chunks.data(), chunks.size()))
+  {
+    ERROR_LOG_FMT(DISCIO, "The deduplicated image \"{}\" is truncated", path);
+    return nullptr;
+  }
+
+  if (!AreRegionsValid(header, regions, hash_exceptions))
+  {
+    ERROR_LOG_FMT(DISCIO, "Unsupported or corrupt deduplicated image \"{}\"", path);
+    return nullptr;
+  }
+
+  const std::string store_path = GetStorePath(path, store_file_name);
+  File::IOFile store(store_path, "rb");
+  DedupStoreHeader store_header;
+  if (!store.ReadArray(&store_header, 1) || store_header.magic != DEDUP_STORE_MAGIC ||
+      store_header.store_id != header.store_id || store_header.chunk_size != header.chunk_size)
+  {
+    ERROR_LOG_FMT(DISCIO, "The chunk store \"{}\" used by \"{}\" is missing or does not match",
+                  store_path, path);
+    return nullptr;
+  }
+
+  return std::unique_ptr<DedupFileReader>(
+      new DedupFileReader(std::move(file), std::move(store), path, header, std::move(regions),
+                          std::move(hash_exceptions), std::move(chunks)));
+}
+
+std::unique_ptr<BlobReader> DedupFileReader::CopyReader() const
+{
+  return Create(m_file.Duplicate("rb"), m_path);
+}
+
+bool DedupFileReader::LoadChunk(u32 chunk_index)
+{
+  if (m_cached_chunk == chunk_index)
+    return true;
+
+  m_cached_chunk.reset();
+
+  const DedupChunkEntry& chunk = m_chunks[chunk_index];
+  if (chunk.stored_size > m_stored_buffer.size())
+    return false;
+
+  if (!m_store.Seek(chunk.offset, File::SeekOrigin::Begin) ||
+      !m_store.ReadBytes(m_stored_buffer.data(), chunk.stored_size))
+  {
+    ERROR_LOG_FMT(DISCIO, "Failed to read chunk {} of \"{}\"", chunk_index, m_path);
+    m_store.ClearError();
+    return false;
+  }
+
+  if (chunk.compressed)
+  {
+    const size_t result = ZSTD_decompressDCtx(m_dctx, m_chunk_buffer.data(), m_chunk_buffer.size(),
+                                              m_stored_buffer.data(), chunk.stored_size);
+    if (ZSTD_isError(result) || result != m_chunk_buffer.size())
+    {
+      ERROR_LOG_FMT(DISCIO, "Failed to decompress chunk {} of \"{}\"", chunk_index, m_path);
+      return false;
+    }
+  }
+  else
+  {
+    if (chunk.stored_size != m_chunk_buffer.size())
+      return false;
+    std::copy_n(m_stored_buffer.data(), chunk.stored_size, m_chunk_buffer.data());
+  }
+
+  m_cached_chunk = chunk_index;
+  return true;
+}
+
+bool DedupFileReader::ReadFromChunks(u32 first_chunk, u64 offset, u64 size, u8* out_ptr)
+{
+  const u32 chunk_size = m_header.chunk_size;
+  while (size > 0)
+  {
+    const u64 chunk_index = first_chunk + offset / chunk_size;
+    const u64 offset_in_chunk = offset % chunk_size;
+    const u64 bytes_to_copy = std::min(chunk_size - offset_in_chunk, size);
+
+    if (!LoadChunk(static_cast<u32>(chunk_index)))
+      return false;
+
+    std::copy_n(m_chunk_buffer.data() + offset_in_chunk, bytes_to_copy, out_ptr);
+
+    offset += bytes_to_copy;
+    size -= bytes_to_copy;
+    out_ptr += bytes_to_copy;
+  }
+
+  return true;
+}
+
+bool DedupFileReader::Read(u64 offset, u64 size, u8* out_ptr)
+{
+  if (offset + size > m_header.data_size)
+    return false;
+
+  if (size == 0)
+    return true;
+
+  auto it = std::prev(std::upper_bound(
+      m_regions.begin(), m_regions.end(), offset,
+      [](u64 value, const DedupRegionEntry& region) { return value < region.offset; }));
+
+  for (; size > 0; ++it)
+  {
+    const DedupRegionEntry& region = *it;
+    const u64 offset_in_region = offset - region.offset;
+    const u64 bytes_to_read = std::min(region.size - offset_in_region, size);
+
+    if (region.encrypted)
+    {
+      if (!m_encryption_cache.EncryptGroups(
+              offset_in_region, bytes_to_read, out_ptr, region.offset, GetStoredSize(region),
+              region.key,
+              [this, &region](VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP],
+                              u64 group_offset) {
+                ApplyHashExceptions(region, group_offset / VolumeWii::GROUP_TOTAL_SIZE,
+                                    hash_blocks);
+              }))
+      {
+        return false;
+      }
+    }
+    else if (!ReadFromChunks(region.first_chunk, offset_in_region, bytes_to_read, out_ptr))
+    {
+      return false;
+    }
+
+    offset += bytes_to_read;
+    size -= bytes_to_read;
+    out_ptr += bytes_to_read;
+  }
+
+  return true;
+}
+
+const DedupRegionEntry* DedupFileReader::GetPartition(u64 partition_data_offset) const
+{
+  const auto it = std::lower_bound(
+      m_regions.begin(), m_regions.end(), partition_data_offset,
+      [](const DedupRegionEntry& region, u64 value) { return region.offset < value; });
+
+  if (it == m_regions.end() || it->offset != partition_data_offset || !it->encrypted)
+    return nullptr;
+
+  return &*it;
+}
+
+bool DedupFileReader::SupportsReadWiiDecrypted(u64 offset, u64 size,
+                                               u64 partition_data_offset) const
+{
+  const DedupRegionEntry* partition = GetPartition(partition_data_offset);
+  return partition && offset + size <= GetStoredSize(*partition);
+}
+
+bool DedupFileReader::ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr,
+                                       u64 partition_data_offset)
+{
+  const DedupRegionEntry* partition = GetPartition(partition_data_offset);
+  if (!partition || offset + size > GetStoredSize(*partition))
+    return false;
+
+  return ReadFromChunks(partition->first_chunk, offset, size, out_ptr);
+}
+
+void DedupFileReader::ApplyHashExceptions(
+    const DedupRegionEntry& region, u64 group,
+    VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]) const
+{
+  const auto begin = m_hash_exceptions.begin() + region.first_hash_exception;
+  const auto end = begin + region.num_hash_exceptions;
+  const auto first = std::lower_bound(
+      begin, end, group,
+      [](const DedupHashException& exception, u64 value) { return exception.group < value; });
+  const auto last = std::upper_bound(
+      first, end, group,
+      [](u64 value, const DedupHashException& exception) { return value < exception.group; });
+
+  u8* hash_data = reinterpret_cast<u8*>(hash_blocks);
+  for (auto it = first; it != last; ++it)
+    std::memcpy(hash_data + it->offset, it->hash.data(), it->hash.size());
+}
+
+u32 DedupFileReader::Verify(const CompressCB& callback)
+{
+  u32 bad_chunks = 0;
+
+  for (u32 i = 0; i < m_header.num_chunks; ++i)
+  {
+    m_cached_chunk.reset();
+    if (!LoadChunk(i) || Common::SHA1::CalculateDigest(m_chunk_buffer) != m_chunks[i].hash)
+    {
+      ERROR_LOG_FMT(DISCIO, "Chunk {} of \"{}\" is corrupt", i, m_path);
+      m_cached_chunk.reset();
+      ++bad_chunks;
+    }
+
+    if (i % 64 == 0 &&
+        !callback(Common::FmtFormatT("{0} of {1} chunks", i, m_header.num_chunks),
+                  static_cast<float>(i) / m_header.num_chunks))
+    {
+      break;
+    }
+  }
+
+  return bad_chunks;
+}
+
+DedupStoreWriter::DedupStoreWriter(File::IOFile file, std::string store_path,
+                                   const DedupStoreHeader& header,
+                                   std::vector<DedupChunkEntry> entries, u64 write_position,
+                                   int compression_level)
+    : m_file(std::move(file)), m_store_path(std::move(store_path)), m_header(header),
+      m_entries(std::move(entries)), m_write_position(write_position),
+      m_compression_level(compression_level)
+{
+  for (u32 i = 0; i < m_entries.size(); ++i)
+    m_index.emplace(m_entries[i].hash, i);
+}
+
+DedupStoreWriter::~DedupStoreWriter() = default;
+
+std::unique_ptr<DedupStoreWriter> DedupStoreWriter::Open(const std::string& store_path,
+                                                         u32 chunk_size, int compression_level)
+{
+  if (!File::Exists(store_path))
+  {
+    File::IOFile file(store_path, "w+b");
+    if (!file)
+      return nullptr;
+
+    DedupStoreHeader header{};
+    header.magic = DEDUP_STORE_MAGIC;
+    header.version = DEDUP_VERSION;
+    header.chunk_size = chunk_size;
+    header.num_chunks = 0;
+    header.index_offset = sizeof(DedupStoreHeader);
+    Common::Random::Generate(header.store_id.data(), header.store_id.size());
+    if (!file.WriteArray(&header, 1))
+      return nullptr;
+
+    return std::unique_ptr<DedupStoreWriter>(new DedupStoreWriter(
+        std::move(file), store_path, header, {}, sizeof(DedupStoreHeader), compression_level));
+  }
+
+  File::IOFile file(store_path, "r+b");
+  DedupStoreHeader header;
+  if (!file.ReadArray(&header, 1) || header.magic != DEDUP_STORE_MAGIC ||
+      header.version != DEDUP_VERSION)
+  {
+    ERROR_LOG_FMT(DISCIO, "\"{}\" is not a supported chunk store", store_path);
+    return nullptr;
+  }
+
+  if (header.chunk_size != chunk_size)
+  {
+    ERROR_LOG_FMT(DISCIO, "The chunk store \"{}\" uses a chunk size of {}", store_path,
+                  header.chunk_size);
+    return nullptr;
+  }
+
+  std::vector<DedupChunkEntry> entries;
+  u64 write_position;
+  const bool index_invalidated = header.index_offset == 0;
+  if (index_invalidated)
+  {
+    RebuildIndex(&file, store_path, chunk_size, &entries, &write_position);
+  }
+  else
+  {
+    entries.resize(header.num_chunks);
+    if (!file.Seek(header.index_offset, File::SeekOrigin::Begin) ||
+        !file.ReadArray(entries.data(), entries.size()))
+    {
+      ERROR_LOG_FMT(DISCIO, "The chunk store \"{}\" is truncated", store_path);
+      return nullptr;
+    }
+
+    // New chunks overwrite the old index, and Finish writes a new one after them
+    write_position = header.index_offset;
+  }
+
+  auto writer = std::unique_ptr<DedupStoreWriter>(new DedupStoreWriter(
+      std::move(file), store_path, header, std::move(entries), write_position, compression_level));
+
+  // Make Finish write the rebuilt index even if no images get added
+  writer->m_index_invalidated = index_invalidated;
+  return writer;
+}
+
+void DedupStoreWriter::RebuildIndex(File::IOFile* file, const std::string& store_path,
+                                    u32 chunk_size, std::vector<DedupChunkEntry>* entries,
+                                    u64* write_position)
+{
+  WARN_LOG_FMT(DISCIO, "The chunk store \"{}\" was not closed properly, rebuilding its index",
+               store_path);
+
+  const u64 file_size = file->GetSize();
+  std::vector<u8> stored_buffer(ZSTD_compressBound(chunk_size));
+  std::vector<u8> chunk_buffer(chunk_size);
+
+  // Everything up to the first chunk that isn't intact is kept. Manifests can only reference
+  // chunks that were completely written, so the rest is unused and gets overwritten.
+  u64 position = sizeof(DedupStoreHeader);
+  while (position + sizeof(DedupChunkEntry) <= file_size)
+  {
+    DedupChunkEntry entry;
+    if (!file->Seek(position, File::SeekOrigin::Begin) || !file->ReadArray(&entry, 1))
+      break;
+
+    if (entry.offset != position + sizeof(DedupChunkEntry) || entry.compressed > 1 ||
+        entry.stored_size > stored_buffer.size() || entry.stored_size > file_size - entry.offset ||
+        !file->ReadBytes(stored_buffer.data(), entry.stored_size))
+    {
+      break;
+    }
+
+    if (entry.compressed)
+    {
+      const size_t result = ZSTD_decompress(chunk_buffer.data(), chunk_buffer.size(),
+                                            stored_buffer.data(), entry.stored_size);
+      if (ZSTD_isError(result) || result != chunk_buffer.size())
+        break;
+    }
+    else
+    {
+      if (entry.stored_size != chunk_buffer.size())
+        break;
+      std::copy_n(stored_buffer.data(), entry.stored_size, chunk_buffer.data());
+    }
+
+    if (Common::SHA1::CalculateDigest(chunk_buffer) != entry.hash)
+      break;
+
+    entries->push_back(entry);
+    position = entry.offset + entry.stored_size;
+  }
+
+  file->ClearError();
+  *write_position = position;
+
+  NOTICE_LOG_FMT(DISCIO, "Recovered {} chunks from \"{}\"", entries->size(), store_path);
+}
+
+bool DedupStoreWriter::InvalidateIndex()
+{
+  if (m_index_invalidated)
+    return true;
+
+  // The old index is about to be overwritten, so make the next Open rebuild it if this run
+  // doesn't get to Finish
+  DedupStoreHeader header = m_header;
+  header.num_chunks = 0;
+  header.index_offset = 0;
+  if (!m_file.Seek(0, File::SeekOrigin::Begin) || !m_file.WriteArray(&header, 1) ||
+      !m_file.Flush())
+  {
+    return false;
+  }
+
+  m_index_invalidated = true;
+  return true;
+}
+
+std::string DedupStoreWriter::GetManifestPath(const std::string& infile_path)
+{
+  std::string directory;
+  SplitPath(m_store_path, &directory, nullptr, nullptr);
+
+  // The extension is kept so that e.g. "Game.iso" and "Game.wbfs" don't collide
+  std::string name;
+  std::string extension;
+  SplitPath(infile_path, nullptr, &name, &extension);
+  name += extension;
+
+  std::string path = directory + name + ".dedup";
+  for (int i = 2; File::Exists(path) || m_manifest_paths.contains(path); ++i)
+    path = fmt::format("{}{} ({}).dedup", directory, name, i);
+
+  m_manifest_paths.insert(path);
+  return path;
+}
+
+namespace
+{
+struct CompressThreadState
+{
+  CompressThreadState() : cctx(ZSTD_createCCtx()) {}
+  ~CompressThreadState() { ZSTD_freeCCtx(cctx); }
+
+  CompressThreadState(const CompressThreadState&) = delete;
+  CompressThreadState& operator=(const CompressThreadState&) = delete;
+
+  ZSTD_CCtx* cctx;
+  std::vector<u8> compressed_buffer;
+};
+
+struct CompressParameters
+{
+  std::vector<u8> data;
+  u32 chunk_index;
+  u64 bytes_read;
+};
+
+struct OutputParameters
+{
+  std::vector<u8> data;
+  Common::SHA1::Digest hash;
+  u32 chunk_index;
+  u64 bytes_read;
+  bool compressed;
+  bool already_stored;
+};
+}  // namespace
+
+// Splits the image into regions, with the data of every usable Wii partition in its own region
+static std::vector<DedupRegionEntry> GetRegions(const VolumeDisc* volume, u64 data_size,
+                                                u32 chunk_size)
+{
+  std::vector<Partition> partitions;
+  if (volume && volume->HasWiiHashes() && volume->HasWiiEncryption())
+    partitions = volume->GetPartitions();
+
+  std::sort(partitions.begin(), partitions.end(),
+            [](const Partition& a, const Partition& b) { return a.offset < b.offset; });
+
+  std::vector<DedupRegionEntry> regions;
+  u32 chunk_index = 0;
+  u64 last_region_end_offset = 0;
+
+  const auto add_region = [&](u64 offset, u64 size, const WiiEncryptionCache::Key* key) {
+    if (size == 0)
+      return;
+
+    DedupRegionEntry& region = regions.emplace_back();
+    region.offset = offset;
+    region.size = size;
+    region.first_chunk = chunk_index;
+    region.encrypted = key ? 1 : 0;
+    if (key)
+      region.key = *key;
+
+    chunk_index += GetChunkCount(region, chunk_size);
+    last_region_end_offset = offset + size;
+  };
+
+  for (const Partition& partition : partitions)
+  {
+    // Partitions that are odd in some way are stored as raw data, like RVZ does
+    if (partition.offset < last_region_end_offset)
+    {
+      WARN_LOG_FMT(DISCIO, "Overlapping partitions at {:x}", partition.offset);
+      continue;
+    }
+
+    if (volume->ReadSwapped<u32>(partition.offset, PARTITION_NONE) != 0x10001U)
+    {
+      WARN_LOG_FMT(DISCIO, "Invalid partition at {:x}", partition.offset);
+      continue;
+    }
+
+    const std::optional<u64> data_offset =
+        volume->ReadSwappedAndShifted(partition.offset + 0x2b8, PARTITION_NONE);
+    std::optional<u64> partition_data_size =
+        volume->ReadSwappedAndShifted(partition.offset + 0x2bc, PARTITION_NONE);
+    if (!data_offset || !partition_data_size)
+      continue;
+
+    const u64 data_start = partition.offset + *data_offset;
+    if (data_start % VolumeWii::BLOCK_TOTAL_SIZE != 0 || data_start >= data_size)
+    {
+      WARN_LOG_FMT(DISCIO, "Misaligned partition at {:x}", partition.offset);
+      continue;
+    }
+
+    if (*partition_data_size > data_size - data_start)
+    {
+      WARN_LOG_FMT(DISCIO, "Too large partition at {:x}", partition.offset);
+      *partition_data_size = data_size - data_start;
+    }
+
+    // A trailing partial block is stored as part of the raw data after the partition
+    *partition_data_size -= *partition_data_size % VolumeWii::BLOCK_TOTAL_SIZE;
+    if (*partition_data_size == 0)
+    {
+      WARN_LOG_FMT(DISCIO, "Very small partition at {:x}", partition.offset);
+      continue;
+    }
+
+    const IOS::ES::TicketReader& ticket = volume->GetTicket(partition);
+    if (!ticket.IsValid())
+      continue;
+
+    const WiiEncryptionCache::Key key = ticket.GetTitleKey();
+    add_region(last_region_end_offset, data_start - last_region_end_offset, nullptr);
+    add_region(data_start, *partition_data_size, &key);
+  }
+
+  add_region(last_region_end_offset, data_size - last_region_end_offset, nullptr);
+
+  return regions;
+}
+
+// Decrypts one group of partition data into data, and adds an exception for every hash that
+// differs from the one that will be recalculated from the decrypted data when reading
+static void
+DecryptGroup(const u8* in, size_t blocks, u32 group, Common::AES::Context* aes,
+             std::array<u8, VolumeWii::BLOCK_DATA_SIZE> data[VolumeWii::BLOCKS_PER_GROUP],
+             std::vector<DedupHashException>* hash_exceptions)
+{
+  VolumeWii::DecryptGroupData(in, data, blocks, aes);
+
+  // This matches how VolumeWii::ReadAndHashGroup pads the last group of a partition
+  for (size_t i = blocks; i < VolumeWii::BLOCKS_PER_GROUP; ++i)
+    data[i].fill(0);
+
+  std::array<VolumeWii::HashBlock, VolumeWii::BLOCKS_PER_GROUP> computed_hashes;
+  VolumeWii::HashGroup(data, computed_hashes.data());
+
+  for (size_t i = 0; i < blocks; ++i)
+  {
+    VolumeWii::HashBlock hashes;
+    VolumeWii::DecryptBlockHashes(in + i * VolumeWii::BLOCK_TOTAL_SIZE, &hashes, aes);
+
+    const auto compare_hash = [&](size_t offset_in_block) {
+      const u8* desired_hash = reinterpret_cast<const u8*>(&hashes) + offset_in_block;
+      const u8* computed_hash = reinterpret_cast<const u8*>(&computed_hashes[i]) + offset_in_block;
+      if (std::equal(desired_hash, desired_hash + Common::SHA1::DIGEST_LEN, computed_hash))
+        return;
+
+      DedupHashException& exception = hash_exceptions->emplace_back();
+      exception.group = group;
+      exception.offset = static_cast<u16>(i * VolumeWii::BLOCK_HEADER_SIZE + offset_in_block);
+      std::memcpy(exception.hash.data(), desired_hash, Common::SHA1::DIGEST_LEN);
+    };
+
+    const auto compare_hashes = [&compare_hash](size_t offset, size_t size) {
+      for (size_t j = 0; j < size; j += Common::SHA1::DIGEST_LEN)
+        // The std::min is to ensure that we don't go beyond the end of HashBlock with
+        // padding_2, which is 32 bytes long (not divisible by SHA1::DIGEST_LEN, which is 20).
+        compare_hash(offset + std::min(j, size - Common::SHA1::DIGEST_LEN));
+    };
+
+    using HashBlock = VolumeWii::HashBlock;
+    compare_hashes(offsetof(HashBlock, h0), sizeof(HashBlock::h0));
+    compare_hashes(offsetof(HashBlock, padding_0), sizeof(HashBlock::padding_0));
+    compare_hashes(offsetof(HashBlock, h1), sizeof(HashBlock::h1));
+    compare_hashes(offsetof(HashBlock, padding_1), sizeof(HashBlock::padding_1));
+    compare_hashes(offsetof(HashBlock, h2), sizeof(HashBlock::h2));
+    compare_hashes(offsetof(HashBlock, padding_2), sizeof(HashBlock::padding_2));
+  }
+}
+
+bool DedupStoreWriter::AddImage(BlobReader* infile, const VolumeDisc* infile_volume,
+                                const std::string& infile_path, const std::string& manifest_path,
+                                CompressCB callback)
+{
+  ASSERT(infile->GetDataSizeType() == DataSizeType::Accurate);
+
+  File::IOFile manifest(manifest_path, "wb");
+  if (!manifest)
+  {
+    PanicAlertFmtT(
+        "Failed to open the output file \"{0}\".\n"
+        "Check that you have permissions to write the target folder and that the media can "
+        "be written.",
+        manifest_path);
+    return false;
+  }
+
+  const u32 chunk_size = m_header.chunk_size;
+  const u64 data_size = infile->GetDataSize();
+
+  std::vector<DedupRegionEntry> regions = GetRegions(infile_volume, data_size, chunk_size);
+  const u32 num_chunks = regions.empty() ?
+                             0 :
+                             regions.back().first_chunk + GetChunkCount(regions.back(), chunk_size);
+
+  std::vector<DedupChunkEntry> chunks(num_chunks);
+  std::vector<DedupHashException> hash_exceptions;
+  std::mutex index_mutex;
+
+  const auto set_up_compress_thread_state = [&](CompressThreadState* state) {
+    if (!state->cctx ||
+        ZSTD_isError(ZSTD_CCtx_setParameter(state->cctx, ZSTD_c_compressionLevel,
+                                            m_compression_level)))
+    {
+      return ConversionResultCode::InternalError;
+    }
+    state->compressed_buffer.resize(ZSTD_compressBound(chunk_size));
+    return ConversionResultCode::Success;
+  };
+
+  const auto compress = [&](CompressThreadState* state, CompressParameters parameters) {
+    OutputParameters output{};
+    output.hash = Common::SHA1::CalculateDigest(parameters.data);
+    output.chunk_index = parameters.chunk_index;
+    output.bytes_read = parameters.bytes_read;
+
+    {
+      std::lock_guard lk(index_mutex);
+      output.already_stored = m_index.contains(output.hash);
+    }
+
+    // Chunks that are already in the store don't need to be compressed again
+    if (output.already_stored)
+      return ConversionResult<OutputParameters>(std::move(output));
+
+    const size_t result =
+        ZSTD_compress2(state->cctx, state->compressed_buffer.data(),
+                       state->compressed_buffer.size(), parameters.data.data(), chunk_size);
+    if (ZSTD_isError(result))
+      return ConversionResult<OutputParameters>(ConversionResultCode::InternalError);
+
+    // Chunks that don't compress to less than 97% of the original size are stored as-is
+    if (result < static_cast<u64>(chunk_size) * 97 / 100)
+    {
+      output.data.assign(state->compressed_buffer.begin(),
+                         state->compressed_buffer.begin() + result);
+      output.compressed = true;
+    }
+    else
+    {
+      output.data = std::move(parameters.data);
+      output.compressed = false;
+    }
+
+    return ConversionResult<OutputParameters>(std::move(output));
+  };
+
+  const int progress_monitor = std::max<int>(1, num_chunks / 1000);
+
+  const auto output = [&](OutputParameters parameters) {
+    std::lock_guard lk(index_mutex);
+
+    const auto it = m_index.find(parameters.hash);
+    if (it != m_index.end())
+    {
+      chunks[parameters.chunk_index] = m_entries[it->second];
+    }
+    else
+    {
+      // Entries are never removed from the index, so anything found while hashing is found here
+      ASSERT(!parameters.already_stored);
+
+      // Every chunk is preceded by its entry so that the index can be rebuilt from them
+      DedupChunkEntry entry{};
+      entry.offset = m_write_position + sizeof(DedupChunkEntry);
+      entry.stored_size = static_cast<u32>(parameters.data.size());
+      entry.compressed = parameters.compressed ? 1 : 0;
+      entry.hash = parameters.hash;
+
+      if (!InvalidateIndex() || !m_file.Seek(m_write_position, File::SeekOrigin::Begin) ||
+          !m_file.WriteArray(&entry, 1) ||
+          !m_file.WriteBytes(parameters.data.data(), parameters.data.size()))
+      {
+        return ConversionResultCode::WriteFailed;
+      }
+
+      m_write_position = entry.offset + parameters.data.size();
+      m_new_stored_bytes += sizeof(DedupChunkEntry) + parameters.data.size();
+      ++m_new_chunks;
+
+      m_index.emplace(entry.hash, static_cast<u32>(m_entries.size()));
+      m_entries.push_back(entry);
+      chunks[parameters.chunk_index] = entry;
+    }
+
+    if (parameters.chunk_index % progress_monitor == 0)
+    {
+      const std::string text = Common::FmtFormatT("{0} of {1} chunks. {2} new chunks stored",
+                                                  parameters.chunk_index, num_chunks, m_new_chunks);
+      if (!callback(text, static_cast<float>(parameters.chunk_index) / num_chunks))
+        return ConversionResultCode::Canceled;
+    }
+
+    return ConversionResultCode::Success;
+  };
+
+  MultithreadedCompressor<CompressThreadState, CompressParameters, OutputParameters> compressor(
+      set_up_compress_thread_state, compress, output);
+
+  u32 chunk_index = 0;
+  std::vector<u8> buffer(chunk_size);
+  size_t buffer_size = 0;
+
+  const auto submit_buffer = [&](u64 bytes_read) {
+    compressor.CompressAndWrite(CompressParameters{std::move(buffer), chunk_index++, bytes_read});
+    buffer = std::vector<u8>(chunk_size);
+    buffer_size = 0;
+  };
+
+  const auto read_region = [&](DedupRegionEntry* region) {
+    if (!region->encrypted)
+    {
+      for (u64 offset = 0; offset < region->size; offset += chunk_size)
+      {
+        if (compressor.GetStatus() != ConversionResultCode::Success)
+          return false;
+
+        const u64 bytes_to_read = std::min<u64>(chunk_size, region->size - offset);
+        if (!infile->Read(region->offset + offset, bytes_to_read, buffer.data()))
+        {
+          compressor.SetError(ConversionResultCode::ReadFailed);
+          return false;
+        }
+
+        submit_buffer(region->offset + offset + bytes_to_read);
+      }
+
+      return true;
+    }
+
+    region->first_hash_exception = static_cast<u32>(hash_exceptions.size());
+
+    const std::unique_ptr<Common::AES::Context> aes =
+        Common::AES::CreateContextDecrypt(region->key.data());
+    std::vector<u8> group_buffer(VolumeWii::GROUP_TOTAL_SIZE);
+    std::vector<std::array<u8, VolumeWii::BLOCK_DATA_SIZE>> data(VolumeWii::BLOCKS_PER_GROUP);
+
+    for (u64 offset = 0; offset < region->size; offset += VolumeWii::GROUP_TOTAL_SIZE)
+    {
+      if (compressor.GetStatus() != ConversionResultCode::Success)
+        return false;
+
+      const u64 bytes_to_read = std::min(VolumeWii::GROUP_TOTAL_SIZE, region->size - offset);
+      if (!infile->Read(region->offset + offset, bytes_to_read, group_buffer.data()))
+      {
+        compressor.SetError(ConversionResultCode::ReadFailed);
+        return false;
+      }
+
+      const size_t blocks = bytes_to_read / VolumeWii::BLOCK_TOTAL_SIZE;
+      DecryptGroup(group_buffer.data(), blocks,
+                   static_cast<u32>(offset / VolumeWii::GROUP_TOTAL_SIZE), aes.get(), data.data(),
+                   &hash_exceptions);
+
+      for (size_t i = 0; i < blocks; ++i)
+      {
+        for (size_t j = 0; j < VolumeWii::BLOCK_DATA_SIZE;)
+        {
+          const size_t bytes_to_copy =
+              std::min<size_t>(VolumeWii::BLOCK_DATA_SIZE - j, chunk_size - buffer_size);
+          std::copy_n(data[i].data() + j, bytes_to_copy, buffer.data() + buffer_size);
+          j += bytes_to_copy;
+          buffer_size += bytes_to_copy;
+
+          if (buffer_size == chunk_size)
+            submit_buffer(region->offset + offset + (i + 1) * VolumeWii::BLOCK_TOTAL_SIZE);
+        }
+      }
+    }
+
+    if (buffer_size != 0)
+      submit_buffer(region->offset + region->size);
+
+    region->num_hash_exceptions =
+        static_cast<u32>(hash_exceptions.size()) - region->first_hash_exception;
+    return true;
+  };
+
+  for (DedupRegionEntry& region : regions)
+  {
+    if (!read_region(&region))
+      break;
+  }
+
+  compressor.Shutdown();
+
+  ConversionResultCode result = compressor.GetStatus();
+
+  if (result == ConversionResultCode::Success)
+  {
+    std::string store_file_name;
+    std::string store_extension;
+    SplitPath(m_store_path, nullptr, &store_file_name, &store_extension);
+    store_file_name += store_extension;
+
+    DedupImageHeader header{};
+    header.magic = DEDUP_MAGIC;
+    header.version = DEDUP_VERSION;
+    header.data_size = data_size;
+    header.chunk_size = chunk_size;
+    header.num_chunks = num_chunks;
+    header.store_id = m_header.store_id;
+    header.store_file_name_size = static_cast<u32>(store_file_name.size());
+    header.num_regions = static_cast<u32>(regions.size());
+    header.num_hash_exceptions = static_cast<u32>(hash_exceptions.size());
+
+    if (!manifest.WriteArray(&header, 1) ||
+        !manifest.WriteBytes(store_file_name.data(), store_file_name.size()) ||
+        !manifest.WriteArray(regions.data(), regions.size()) ||
+        !manifest.WriteArray(hash_exceptions.data(), hash_exceptions.size()) ||
+        !manifest.WriteArray(chunks.data(), chunks.size()))
+    {
+      result = ConversionResultCode::WriteFailed;
+    }
+    else
+    {
+      m_input_bytes += data_size;
+      callback(Common::GetStringT("Done compressing disc image."), 1.0f);
+    }
+  }
+
+  if (result != ConversionResultCode::Success)
+  {
+    // Remove the incomplete manifest. Chunks that were already written stay in the store
+    // and will be reused if the image is added again.
+    manifest.Close();
+    File::Delete(manifest_path);
+  }
+
+  if (result == ConversionResultCode::ReadFailed)
+    PanicAlertFmtT("Failed to read from the input file \"{0}\".", infile_path);
+
+  if (result == ConversionResultCode::WriteFailed)
+  {
+    PanicAlertFmtT("Failed to write the output file \"{0}\".\n"
+                   "Check that you have enough space available on the target drive.",
+                   m_store_path);
+  }
+
+  return result == ConversionResultCode::Success;
+}
+
+bool DedupStoreWriter::Finish()
+{
+  // Nothing was added, so the index on disk is still up to date
+  if (!m_index_invalidated)
+    return true;
+
+  m_header.num_chunks = static_cast<u32>(m_entries.size());
+  m_header.index_offset = m_write_position;
+
+  // The index goes right after the chunks, and anything after it, such as the rest of an older
+  // and longer index, is cut off
+  const u64 index_end = m_write_position + m_entries.size() * sizeof(DedupChunkEntry);
+  if (!m_file.Seek(m_write_position, File::SeekOrigin::Begin) ||
+      !m_file.WriteArray(m_entries.data(), m_entries.size()) || !m_file.Flush() ||
+      !m_file.Seek(0, File::SeekOrigin::Begin) || !m_file.WriteArray(&m_header, 1) ||
+      !m_file.Flush() || !m_file.Resize(index_end))
+  {
+    return false;
+  }
+
+  m_index_invalidated = false;
+  return true;
+}
+
+}  // namespace DiscIO
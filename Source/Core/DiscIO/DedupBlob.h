@@ -0,0 +1,231 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// EXPERIMENTAL: This format is subject to change and is not big-endian safe.
+
+// Deduplicated disc image libraries.
+//
+// A set of disc images is stored as one shared chunk store plus one small manifest per image.
+// Every image is split into fixed-size chunks, and each distinct chunk (identified by the SHA-1
+// of its contents) is stored only once in the chunk store, compressed with Zstandard. Images
+// that share data, such as regional revisions of a game or discs carrying the same update
+// partition, only pay for that data once.
+//
+// Like RVZ, the data of Wii partitions is deduplicated in decrypted form, with the hashes
+// recalculated and encrypted again when reading. Hashes that don't match the recalculated ones
+// are stored in the manifest as hash exceptions. This lets the same partition in two dumps that
+// use different keys, or in which only the hashes differ, share its chunks.
+//
+// Chunk store file structure:
+// * DedupStoreHeader
+// * For each chunk: DedupChunkEntry, then [chunk data]
+// * DedupChunkEntry[num_chunks] (located at index_offset)
+//
+// Adding images overwrites the index with new chunks and writes a new index at the end. While
+// this is going on, index_offset is 0, and if a run gets interrupted, the index is rebuilt from
+// the entries in front of the chunks the next time the store is opened.
+//
+// Manifest file structure (this is what CreateBlobReader opens):
+// * DedupImageHeader
+// * char store_file_name[store_file_name_size], the store must be in the same directory
+// * DedupRegionEntry[num_regions]
+// * DedupHashException[num_hash_exceptions]
+// * DedupChunkEntry[num_chunks]
+
+#pragma once
+
+#include <array>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+#include "Common/IOFile.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/WiiEncryptionCache.h"
+
+struct ZSTD_DCtx_s;
+
+namespace DiscIO
+{
+class VolumeDisc;
+
+static constexpr u32 DEDUP_MAGIC = 0x50554444;        // "DDUP" (byteswapped to little endian)
+static constexpr u32 DEDUP_STORE_MAGIC = 0x54534444;  // "DDST" (byteswapped to little endian)
+static constexpr u32 DEDUP_VERSION = 1;
+
+using DedupStoreID = std::array<u8, 16>;
+
+struct DedupStoreHeader
+{
+  u32 magic;
+  u32 version;
+  u32 chunk_size;
+  u32 num_chunks;
+  u64 index_offset;  // 0 while images are being added
+  DedupStoreID store_id;
+};
+static_assert(sizeof(DedupStoreHeader) == 0x28);
+
+struct DedupChunkEntry
+{
+  u64 offset;  // Offset of the chunk data in the store file
+  u32 stored_size;
+  u32 compressed;  // 0 if stored as-is, 1 if compressed with Zstandard
+  Common::SHA1::Digest hash;  // Hash of the uncompressed chunk, zero-padded to chunk_size
+  u32 padding;
+};
+static_assert(sizeof(DedupChunkEntry) == 0x28);
+
+struct DedupImageHeader
+{
+  u32 magic;
+  u32 version;
+  u64 data_size;
+  u32 chunk_size;
+  u32 num_chunks;
+  DedupStoreID store_id;
+  u32 store_file_name_size;
+  u32 num_regions;
+  u32 num_hash_exceptions;
+  u32 padding;
+};
+static_assert(sizeof(DedupImageHeader) == 0x38);
+
+// The regions cover the whole image in order. The chunks of a region hold its data zero-padded
+// to a multiple of chunk_size, or for an encrypted region, the decrypted data of its blocks.
+struct DedupRegionEntry
+{
+  u64 offset;
+  u64 size;
+  u32 first_chunk;
+  u32 encrypted;  // 1 if this is the data of a Wii partition, 0 if it is stored as-is
+  u32 first_hash_exception;
+  u32 num_hash_exceptions;
+  WiiEncryptionCache::Key key;  // Title key of the partition, if encrypted
+};
+static_assert(sizeof(DedupRegionEntry) == 0x30);
+
+struct DedupHashException
+{
+  u32 group;   // Index of the group in the partition data
+  u16 offset;  // Offset of the hash in the hash blocks of the group
+  u16 padding;
+  Common::SHA1::Digest hash;
+};
+static_assert(sizeof(DedupHashException) == 0x1C);
+
+class DedupFileReader : public BlobReader
+{
+public:
+  static std::unique_ptr<DedupFileReader> Create(File::IOFile file, const std::string& path);
+  ~DedupFileReader();
+
+  BlobType GetBlobType() const override { return BlobType::DEDUP; }
+  std::unique_ptr<BlobReader> CopyReader() const override;
+
+  // The raw size counts the stored size of every distinct chunk used by this image,
+  // even though those chunks may be shared with other images in the same store.
+  u64 GetRawSize() const override { return m_raw_size; }
+  u64 GetDataSize() const override { return m_header.data_size; }
+  DataSizeType GetDataSizeType() const override { return DataSizeType::Accurate; }
+
+  u64 GetBlockSize() const override { return m_header.chunk_size; }
+  bool HasFastRandomAccessInBlock() const override { return false; }
+  std::string GetCompressionMethod() const override { return "Zstandard"; }
+  std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
+
+  bool Read(u64 offset, u64 size, u8* out_ptr) override;
+  bool SupportsReadWiiDecrypted(u64 offset, u64 size, u64 partition_data_offset) const override;
+  bool ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset) override;
+
+  // Decompresses every chunk and checks it against its stored hash.
+  // Returns the number of chunks that could not be read or did not match.
+  u32 Verify(const CompressCB& callback);
+
+private:
+  DedupFileReader(File::IOFile file, File::IOFile store, const std::string& path,
+                  const DedupImageHeader& header, std::vector<DedupRegionEntry> regions,
+                  std::vector<DedupHashException> hash_exceptions,
+                  std::vector<DedupChunkEntry> chunks);
+
+  const DedupRegionEntry* GetPartition(u64 partition_data_offset) const;
+  void ApplyHashExceptions(const DedupRegionEntry& region, u64 group,
+                           VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]) const;
+  bool ReadFromChunks(u32 first_chunk, u64 offset, u64 size, u8* out_ptr);
+  bool LoadChunk(u32 chunk_index);
+
+  File::IOFile m_file;
+  File::IOFile m_store;
+  std::string m_path;
+  DedupImageHeader m_header;
+  std::vector<DedupRegionEntry> m_regions;
+  std::vector<DedupHashException> m_hash_exceptions;
+  std::vector<DedupChunkEntry> m_chunks;
+  u64 m_raw_size = 0;
+
+  WiiEncryptionCache m_encryption_cache;
+
+  ZSTD_DCtx_s* m_dctx = nullptr;
+  std::vector<u8> m_stored_buffer;
+  std::vector<u8> m_chunk_buffer;
+  std::optional<u32> m_cached_chunk;
+};
+
+// Adds disc images to a chunk store, creating it if it doesn't exist.
+// Chunks that are already in the store are never moved or overwritten, so an interrupted run
+// never damages images that were added earlier.
+class DedupStoreWriter
+{
+public:
+  static std::unique_ptr<DedupStoreWriter> Open(const std::string& store_path, u32 chunk_size,
+                                                int compression_level);
+  ~DedupStoreWriter();
+
+  // Returns a path next to the store for the manifest of infile_path that isn't used by an
+  // existing file or by an earlier call.
+  std::string GetManifestPath(const std::string& infile_path);
+
+  // Writes a manifest for infile. infile_volume is optional, and is used for finding Wii
+  // partitions so that their data can be stored decrypted.
+  bool AddImage(BlobReader* infile, const VolumeDisc* infile_volume,
+                const std::string& infile_path, const std::string& manifest_path,
+                CompressCB callback);
+
+  // Writes the chunk index in place of the old one and updates the store header.
+  bool Finish();
+
+  u32 GetChunkSize() const { return m_header.chunk_size; }
+  u64 GetInputBytes() const { return m_input_bytes; }
+  u64 GetNewChunkCount() const { return m_new_chunks; }
+  u64 GetNewStoredBytes() const { return m_new_stored_bytes; }
+
+private:
+  DedupStoreWriter(File::IOFile file, std::string store_path, const DedupStoreHeader& header,
+                   std::vector<DedupChunkEntry> entries, u64 write_position,
+                   int compression_level);
+
+  static void RebuildIndex(File::IOFile* file, const std::string& store_path, u32 chunk_size,
+                           std::vector<DedupChunkEntry>* entries, u64* write_position);
+  bool InvalidateIndex();
+
+  File::IOFile m_file;
+  std::string m_store_path;
+  DedupStoreHeader m_header;
+  std::vector<DedupChunkEntry> m_entries;
+  std::map<Common::SHA1::Digest, u32> m_index;
+  u64 m_write_position;
+  int m_compression_level;
+  bool m_index_invalidated = false;
+  std::set<std::string> m_manifest_paths;
+
+  u64 m_input_bytes = 0;
+  u64 m_new_chunks = 0;
+  u64 m_new_stored_bytes = 0;
+};
+
+}  // namespace DiscIO
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <functional>
 #include <memory>
@@ -14,6 +15,7 @@
 #include "Common/Assert.h"
 #include "Common/Event.h"
 #include "Common/Result.h"
+#include "Common/Semaphore.h"
 
 namespace DiscIO
 {
@@ -29,6 +31,17 @@ enum class ConversionResultCode
 template <typename T>
 using ConversionResult = Common::Result<ConversionResultCode, T>;
 
+// Limits how many compress calls can run at the same time across every MultithreadedCompressor
+// in the process. With a single conversion this never blocks, but when several conversions run
+// at once (such as in dolphin-tool's batch mode), they share the CPU instead of each one
+// starting a full set of busy threads.
+inline Common::Semaphore& GetSharedCompressionSlots()
+{
+  static const int slots = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  static Common::Semaphore semaphore(slots, slots);
+  return semaphore;
+}
+
 // This class starts a number of compression threads and one output thread.
 // The set_up_compress_thread_state function is called at the start of each compression thread.
 // When CompressAndWrite is called, the compress function will be called on one of the
@@ -156,8 +169,10 @@ private:
       state->compress_done_event.Reset();
       state->compress_ready_event.Set();
 
+      GetSharedCompressionSlots().Wait();
       ConversionResult<OutputParameters> result =
           m_compress(&compress_thread_state, std::move(parameters));
+      GetSharedCompressionSlots().Post();
 
       if (result)
       {
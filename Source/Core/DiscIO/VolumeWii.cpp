@@ -468,14 +468,14 @@ bool VolumeWii::CheckBlockIntegrity(u64 block_index, const u8* encrypted_data,
     cluster_data = encrypted_data + BLOCK_HEADER_SIZE;
   }
 
-  for (u32 hash_index = 0; hash_index < 31; ++hash_index)
-  {
-    if (Common::SHA1::CalculateDigest(&cluster_data[hash_index * 0x400], 0x400) !=
-        hashes.h0[hash_index])
-    {
-      return false;
-    }
-  }
+  std::array<const u8*, 31> h0_chunks;
+  for (size_t i = 0; i < h0_chunks.size(); ++i)
+    h0_chunks[i] = &cluster_data[i * 0x400];
+
+  std::array<Common::SHA1::Digest, 31> h0;
+  Common::SHA1::CalculateDigests(h0_chunks.data(), 0x400, h0.data(), h0.size());
+  if (h0 != hashes.h0)
+    return false;
 
   if (Common::SHA1::CalculateDigest(hashes.h0) != hashes.h1[block_index % 8])
     return false;
@@ -526,8 +526,11 @@ bool VolumeWii::HashGroup(const std::array<u8, BLOCK_DATA_SIZE> in[BLOCKS_PER_GR
       if (success)
       {
         // H0 hashes
-        for (size_t j = 0; j < 31; ++j)
-          out[i].h0[j] = Common::SHA1::CalculateDigest(in[i].data() + j * 0x400, 0x400);
+        std::array<const u8*, 31> h0_chunks;
+        for (size_t j = 0; j < h0_chunks.size(); ++j)
+          h0_chunks[j] = in[i].data() + j * 0x400;
+        Common::SHA1::CalculateDigests(h0_chunks.data(), 0x400, out[i].h0.data(),
+                                       h0_chunks.size());
 
         // H0 padding
         out[i].padding_0 = {};
@@ -579,38 +582,33 @@ bool VolumeWii::HashGroup(const std::array<u8, BLOCK_DATA_SIZE> in[BLOCKS_PER_GR
   return success;
 }
 
-bool VolumeWii::EncryptGroup(
-    u64 offset, u64 partition_data_offset, u64 partition_data_decrypted_size,
-    const std::array<u8, AES_KEY_SIZE>& key, BlobReader* blob,
-    std::array<u8, GROUP_TOTAL_SIZE>* out,
-    const std::function<void(HashBlock hash_blocks[BLOCKS_PER_GROUP])>& hash_exception_callback)
+bool VolumeWii::ReadAndHashGroup(u64 offset, u64 partition_data_offset,
+                                 u64 partition_data_decrypted_size, BlobReader* blob,
+                                 std::array<u8, BLOCK_DATA_SIZE> out_data[BLOCKS_PER_GROUP],
+                                 HashBlock out_hashes[BLOCKS_PER_GROUP])
 {
-  std::vector<std::array<u8, BLOCK_DATA_SIZE>> unencrypted_data(BLOCKS_PER_GROUP);
-  std::vector<HashBlock> unencrypted_hashes(BLOCKS_PER_GROUP);
-
-  const bool success =
-      HashGroup(unencrypted_data.data(), unencrypted_hashes.data(), [&](size_t block) {
-        if (offset + (block + 1) * BLOCK_DATA_SIZE <= partition_data_decrypted_size)
-        {
-          if (!blob->ReadWiiDecrypted(offset + block * BLOCK_DATA_SIZE, BLOCK_DATA_SIZE,
-                                      unencrypted_data[block].data(), partition_data_offset))
-          {
-            return false;
-          }
-        }
-        else
-        {
-          unencrypted_data[block].fill(0);
-        }
-        return true;
-      });
-
-  if (!success)
-    return false;
-
-  if (hash_exception_callback)
-    hash_exception_callback(unencrypted_hashes.data());
+  return HashGroup(out_data, out_hashes, [&](size_t block) {
+    if (offset + (block + 1) * BLOCK_DATA_SIZE <= partition_data_decrypted_size)
+    {
+      if (!blob->ReadWiiDecrypted(offset + block * BLOCK_DATA_SIZE, BLOCK_DATA_SIZE,
+                                  out_data[block].data(), partition_data_offset))
+      {
+        return false;
+      }
+    }
+    else
+    {
+      out_data[block].fill(0);
+    }
+    return true;
+  });
+}
 
+void VolumeWii::EncryptHashedGroup(const std::array<u8, BLOCK_DATA_SIZE> data[BLOCKS_PER_GROUP],
+                                   const HashBlock hashes[BLOCKS_PER_GROUP],
+                                   const std::array<u8, AES_KEY_SIZE>& key,
+                                   std::array<u8, GROUP_TOTAL_SIZE>* out)
+{
   const unsigned int threads =
       std::min(BLOCKS_PER_GROUP, std::max<unsigned int>(1, std::thread::hardware_concurrency()));
 
@@ -622,23 +620,57 @@ bool VolumeWii::EncryptGroup(
   {
     encryption_futures[i] = std::async(
         std::launch::async,
-        [&unencrypted_data, &unencrypted_hashes, &aes_context, &out](size_t start, size_t end) {
-          for (size_t j = start; j < end; ++j)
+        [data, hashes, &aes_context, &out](size_t start, size_t end) {
+          std::array<const u8*, BLOCKS_PER_GROUP> in_ptrs;
+          std::array<u8*, BLOCKS_PER_GROUP> out_ptrs;
+          std::array<const u8*, BLOCKS_PER_GROUP> iv_ptrs;
+          const size_t count = end - start;
+
+          // The hash blocks use an IV of zero
+          for (size_t j = 0; j < count; ++j)
           {
-            u8* out_ptr = out->data() + j * BLOCK_TOTAL_SIZE;
-
-            aes_context->CryptIvZero(reinterpret_cast<u8*>(&unencrypted_hashes[j]), out_ptr,
-                                     BLOCK_HEADER_SIZE);
+            in_ptrs[j] = reinterpret_cast<const u8*>(&hashes[start + j]);
+            out_ptrs[j] = out->data() + (start + j) * BLOCK_TOTAL_SIZE;
+          }
+          aes_context->CryptMultiple(nullptr, in_ptrs.data(), out_ptrs.data(), BLOCK_HEADER_SIZE,
+                                     count);
 
-            aes_context->Crypt(out_ptr + 0x3D0, unencrypted_data[j].data(),
-                               out_ptr + BLOCK_HEADER_SIZE, BLOCK_DATA_SIZE);
+          // The data uses part of the encrypted hash block as its IV
+          for (size_t j = 0; j < count; ++j)
+          {
+            in_ptrs[j] = data[start + j].data();
+            iv_ptrs[j] = out_ptrs[j] + 0x3D0;
+            out_ptrs[j] += BLOCK_HEADER_SIZE;
           }
+          aes_context->CryptMultiple(iv_ptrs.data(), in_ptrs.data(), out_ptrs.data(),
+                                     BLOCK_DATA_SIZE, count);
         },
         i * BLOCKS_PER_GROUP / threads, (i + 1) * BLOCKS_PER_GROUP / threads);
   }
 
   for (std::future<void>& future : encryption_futures)
     future.get();
+}
+
+bool VolumeWii::EncryptGroup(
+    u64 offset, u64 partition_data_offset, u64 partition_data_decrypted_size,
+    const std::array<u8, AES_KEY_SIZE>& key, BlobReader* blob,
+    std::array<u8, GROUP_TOTAL_SIZE>* out,
+    const std::function<void(HashBlock hash_blocks[BLOCKS_PER_GROUP])>& hash_exception_callback)
+{
+  std::vector<std::array<u8, BLOCK_DATA_SIZE>> unencrypted_data(BLOCKS_PER_GROUP);
+  std::vector<HashBlock> unencrypted_hashes(BLOCKS_PER_GROUP);
+
+  if (!ReadAndHashGroup(offset, partition_data_offset, partition_data_decrypted_size, blob,
+                        unencrypted_data.data(), unencrypted_hashes.data()))
+  {
+    return false;
+  }
+
+  if (hash_exception_callback)
+    hash_exception_callback(unencrypted_hashes.data());
+
+  EncryptHashedGroup(unencrypted_data.data(), unencrypted_hashes.data(), key, out);
 
   return true;
 }
@@ -653,4 +685,23 @@ void VolumeWii::DecryptBlockData(const u8* in, u8* out, Common::AES::Context* ae
   aes_context->Crypt(&in[0x3d0], &in[sizeof(HashBlock)], out, BLOCK_DATA_SIZE);
 }
 
+void VolumeWii::DecryptGroupData(const u8* in,
+                                 std::array<u8, BLOCK_DATA_SIZE> out[BLOCKS_PER_GROUP],
+                                 size_t num_blocks, Common::AES::Context* aes_context)
+{
+  std::array<const u8*, BLOCKS_PER_GROUP> iv_ptrs;
+  std::array<const u8*, BLOCKS_PER_GROUP> in_ptrs;
+  std::array<u8*, BLOCKS_PER_GROUP> out_ptrs;
+  for (size_t i = 0; i < num_blocks; ++i)
+  {
+    const u8* block = in + i * BLOCK_TOTAL_SIZE;
+    iv_ptrs[i] = &block[0x3d0];
+    in_ptrs[i] = &block[sizeof(HashBlock)];
+    out_ptrs[i] = out[i].data();
+  }
+
+  aes_context->CryptMultiple(iv_ptrs.data(), in_ptrs.data(), out_ptrs.data(), BLOCK_DATA_SIZE,
+                             num_blocks);
+}
+
 }  // namespace DiscIO
@@ -100,6 +100,19 @@ public:
                         HashBlock out[BLOCKS_PER_GROUP],
                         const std::function<bool(size_t block)>& read_function = {});
 
+  // Reads one group of decrypted data from the blob and hashes it.
+  static bool ReadAndHashGroup(u64 offset, u64 partition_data_offset,
+                               u64 partition_data_decrypted_size, BlobReader* blob,
+                               std::array<u8, BLOCK_DATA_SIZE> out_data[BLOCKS_PER_GROUP],
+                               HashBlock out_hashes[BLOCKS_PER_GROUP]);
+
+  // Encrypts one group that has already been read and hashed. Doesn't access any blob,
+  // so it can run on a different thread than the one reading the next group.
+  static void EncryptHashedGroup(const std::array<u8, BLOCK_DATA_SIZE> data[BLOCKS_PER_GROUP],
+                                 const HashBlock hashes[BLOCKS_PER_GROUP],
+                                 const std::array<u8, AES_KEY_SIZE>& key,
+                                 std::array<u8, GROUP_TOTAL_SIZE>* out);
+
   static bool EncryptGroup(u64 offset, u64 partition_data_offset, u64 partition_data_decrypted_size,
                            const std::array<u8, AES_KEY_SIZE>& key, BlobReader* blob,
                            std::array<u8, GROUP_TOTAL_SIZE>* out,
@@ -108,6 +121,9 @@ public:
 
   static void DecryptBlockHashes(const u8* in, HashBlock* out, Common::AES::Context* aes_context);
   static void DecryptBlockData(const u8* in, u8* out, Common::AES::Context* aes_context);
+  // Decrypts the data of the first num_blocks blocks of an encrypted group.
+  static void DecryptGroupData(const u8* in, std::array<u8, BLOCK_DATA_SIZE> out[BLOCKS_PER_GROUP],
+                               size_t num_blocks, Common::AES::Context* aes_context);
 
 protected:
   u32 GetOffsetShift() const override { return 2; }
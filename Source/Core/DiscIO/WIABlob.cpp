@@ -1387,19 +1387,11 @@ WIARVZFileReader<RVZ>::ProcessAndCompress(CompressThreadState* state, CompressPa
         const u64 blocks_in_this_group =
             std::min<u64>(VolumeWii::BLOCKS_PER_GROUP, blocks - i * VolumeWii::BLOCKS_PER_GROUP);
 
-        for (u32 j = 0; j < VolumeWii::BLOCKS_PER_GROUP; ++j)
-        {
-          if (j < blocks_in_this_group)
-          {
-            const u64 offset_of_block = offset_of_group + j * VolumeWii::BLOCK_TOTAL_SIZE;
-            VolumeWii::DecryptBlockData(parameters.data.data() + offset_of_block,
-                                        state->decryption_buffer[j].data(), aes_context.get());
-          }
-          else
-          {
-            state->decryption_buffer[j].fill(0);
-          }
-        }
+        VolumeWii::DecryptGroupData(parameters.data.data() + offset_of_group,
+                                    state->decryption_buffer.data(), blocks_in_this_group,
+                                    aes_context.get());
+        for (u64 j = blocks_in_this_group; j < VolumeWii::BLOCKS_PER_GROUP; ++j)
+          state->decryption_buffer[j].fill(0);
 
         VolumeWii::HashGroup(state->decryption_buffer.data(), state->hash_buffer.data());
 
@@ -3,13 +3,17 @@
 
 #include "DiscIO/WiiEncryptionCache.h"
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include "Common/Align.h"
+#include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/VolumeWii.h"
 
@@ -19,50 +23,157 @@ WiiEncryptionCache::WiiEncryptionCache(BlobReader* blob) : m_blob(blob)
 {
 }
 
-WiiEncryptionCache::~WiiEncryptionCache() = default;
+WiiEncryptionCache::~WiiEncryptionCache()
+{
+  if (m_statistics.hits + m_statistics.misses != 0)
+  {
+    DEBUG_LOG_FMT(DISCIO, "Wii encryption cache: {} hits, {} misses, {} bytes encrypted",
+                  m_statistics.hits, m_statistics.misses, m_statistics.bytes_encrypted);
+  }
+}
 
-const std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>*
-WiiEncryptionCache::EncryptGroup(u64 offset, u64 partition_data_offset,
-                                 u64 partition_data_decrypted_size, const Key& key,
-                                 const HashExceptionCallback& hash_exception_callback)
+bool WiiEncryptionCache::LoadGroups(u64 offset, size_t count, u64 partition_data_offset,
+                                    u64 partition_data_decrypted_size, const Key& key,
+                                    const HashExceptionCallback& hash_exception_callback,
+                                    std::array<const Group*, CACHE_SIZE>* out)
 {
+  ASSERT(count <= CACHE_SIZE);
+  ASSERT(offset % VolumeWii::GROUP_TOTAL_SIZE == 0);
+
   // Only allocate memory if this function actually ends up getting called
-  if (!m_cache)
+  if (m_cache.empty())
   {
-    m_cache = std::make_unique<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>>();
-    m_cached_offset = std::numeric_limits<u64>::max();
+    m_cache.resize(CACHE_SIZE);
+    m_encryption_thread = std::make_unique<Common::WorkQueueThread<EncryptionTask>>(
+        "Wii Encryption", [](EncryptionTask task) {
+          VolumeWii::EncryptHashedGroup(task.data, task.hashes, *task.key, task.out);
+        });
   }
 
-  ASSERT(offset % VolumeWii::GROUP_TOTAL_SIZE == 0);
-  const u64 group_offset_in_partition =
-      offset / VolumeWii::GROUP_TOTAL_SIZE * VolumeWii::GROUP_DATA_SIZE;
-  const u64 group_offset_on_disc = partition_data_offset + offset;
+  struct PendingGroup
+  {
+    CacheEntry* entry;
+    u64 offset_on_disc;
+    std::vector<std::array<u8, VolumeWii::BLOCK_DATA_SIZE>> data;
+    std::vector<VolumeWii::HashBlock> hashes;
+    bool queued = false;
+  };
+
+  std::array<bool, CACHE_SIZE> in_use{};
+  std::vector<PendingGroup> pending;
+  std::array<size_t, CACHE_SIZE> entry_indices;
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    const u64 offset_on_disc = partition_data_offset + offset + i * VolumeWii::GROUP_TOTAL_SIZE;
+
+    const auto it = std::find_if(m_cache.begin(), m_cache.end(), [&](const CacheEntry& entry) {
+      return entry.offset == offset_on_disc;
+    });
+
+    if (it != m_cache.end())
+    {
+      ++m_statistics.hits;
+      entry_indices[i] = it - m_cache.begin();
+    }
+    else
+    {
+      ++m_statistics.misses;
+
+      // Evict the least recently used entry that isn't needed by this call
+      size_t lru_index = 0;
+      u64 lru_value = std::numeric_limits<u64>::max();
+      for (size_t j = 0; j < m_cache.size(); ++j)
+      {
+        if (in_use[j])
+          continue;
+
+        if (m_cache[j].last_used < lru_value)
+        {
+          lru_index = j;
+          lru_value = m_cache[j].last_used;
+        }
+      }
+
+      entry_indices[i] = lru_index;
+      m_cache[lru_index].offset = std::numeric_limits<u64>::max();
+      if (!m_cache[lru_index].data)
+        m_cache[lru_index].data = std::make_unique<Group>();
+
+      pending.push_back(PendingGroup{&m_cache[lru_index], offset_on_disc});
+    }
+
+    in_use[entry_indices[i]] = true;
+    m_cache[entry_indices[i]].last_used = ++m_use_counter;
+  }
 
-  if (m_cached_offset != group_offset_on_disc)
+  bool success = true;
+
+  // Reading and hashing has to happen in order on this thread, since the blob isn't thread-safe
+  // and the hash exception callback may rely on state set up by the read. Encryption has no such
+  // restrictions, so it runs on the encryption thread while the next group is being read.
+  for (PendingGroup& group : pending)
   {
-    std::function<void(VolumeWii::HashBlock * hash_blocks)> hash_exception_callback_2;
+    group.data.resize(VolumeWii::BLOCKS_PER_GROUP);
+    group.hashes.resize(VolumeWii::BLOCKS_PER_GROUP);
 
-    if (hash_exception_callback)
+    const u64 group_offset = group.offset_on_disc - partition_data_offset;
+    const u64 group_offset_in_partition =
+        group_offset / VolumeWii::GROUP_TOTAL_SIZE * VolumeWii::GROUP_DATA_SIZE;
+
+    if (!VolumeWii::ReadAndHashGroup(group_offset_in_partition, partition_data_offset,
+                                     partition_data_decrypted_size, m_blob, group.data.data(),
+                                     group.hashes.data()))
     {
-      hash_exception_callback_2 =
-          [offset, &hash_exception_callback](
-              VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]) {
-            return hash_exception_callback(hash_blocks, offset);
-          };
+      success = false;
+      break;
     }
 
-    if (!VolumeWii::EncryptGroup(group_offset_in_partition, partition_data_offset,
-                                 partition_data_decrypted_size, key, m_blob, m_cache.get(),
-                                 hash_exception_callback_2))
+    if (hash_exception_callback)
+      hash_exception_callback(group.hashes.data(), group_offset);
+
+    m_encryption_thread->EmplaceItem(EncryptionTask{group.data.data(), group.hashes.data(), &key,
+                                                    group.entry->data.get()});
+    group.queued = true;
+  }
+
+  m_encryption_thread->WaitForCompletion();
+
+  for (PendingGroup& group : pending)
+  {
+    if (!group.queued)
+      continue;
+
+    // Entries that failed to load keep their invalid offset
+    if (success)
     {
-      m_cached_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
-      return nullptr;
+      group.entry->offset = group.offset_on_disc;
+      m_statistics.bytes_encrypted += VolumeWii::GROUP_TOTAL_SIZE;
     }
+  }
+
+  if (!success)
+    return false;
+
+  for (size_t i = 0; i < count; ++i)
+    (*out)[i] = m_cache[entry_indices[i]].data.get();
+
+  return true;
+}
 
-    m_cached_offset = group_offset_on_disc;
+const std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>*
+WiiEncryptionCache::EncryptGroup(u64 offset, u64 partition_data_offset,
+                                 u64 partition_data_decrypted_size, const Key& key,
+                                 const HashExceptionCallback& hash_exception_callback)
+{
+  std::array<const Group*, CACHE_SIZE> groups;
+  if (!LoadGroups(offset, 1, partition_data_offset, partition_data_decrypted_size, key,
+                  hash_exception_callback, &groups))
+  {
+    return nullptr;
   }
 
-  return m_cache.get();
+  return groups[0];
 }
 
 bool WiiEncryptionCache::EncryptGroups(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset,
@@ -71,20 +182,30 @@ bool WiiEncryptionCache::EncryptGroups(u64 offset, u64 size, u8* out_ptr, u64 pa
 {
   while (size > 0)
   {
-    const std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>* group =
-        EncryptGroup(Common::AlignDown(offset, VolumeWii::GROUP_TOTAL_SIZE), partition_data_offset,
-                     partition_data_decrypted_size, key, hash_exception_callback);
-
-    if (!group)
+    const u64 first_group_offset = Common::AlignDown(offset, VolumeWii::GROUP_TOTAL_SIZE);
+    const u64 offset_in_group = offset - first_group_offset;
+    const size_t group_count = static_cast<size_t>(
+        std::min<u64>(CACHE_SIZE, Common::AlignUp(offset_in_group + size,
+                                                  VolumeWii::GROUP_TOTAL_SIZE) /
+                                      VolumeWii::GROUP_TOTAL_SIZE));
+
+    std::array<const Group*, CACHE_SIZE> groups;
+    if (!LoadGroups(first_group_offset, group_count, partition_data_offset,
+                    partition_data_decrypted_size, key, hash_exception_callback, &groups))
+    {
       return false;
+    }
 
-    const u64 offset_in_group = offset % VolumeWii::GROUP_TOTAL_SIZE;
-    const u64 bytes_to_read = std::min(VolumeWii::GROUP_TOTAL_SIZE - offset_in_group, size);
-    std::memcpy(out_ptr, group->data() + offset_in_group, bytes_to_read);
+    for (size_t i = 0; i < group_count && size > 0; ++i)
+    {
+      const u64 offset_in_this_group = offset % VolumeWii::GROUP_TOTAL_SIZE;
+      const u64 bytes_to_read = std::min(VolumeWii::GROUP_TOTAL_SIZE - offset_in_this_group, size);
+      std::memcpy(out_ptr, groups[i]->data() + offset_in_this_group, bytes_to_read);
 
-    offset += bytes_to_read;
-    size -= bytes_to_read;
-    out_ptr += bytes_to_read;
+      offset += bytes_to_read;
+      size -= bytes_to_read;
+      out_ptr += bytes_to_read;
+    }
   }
 
   return true;
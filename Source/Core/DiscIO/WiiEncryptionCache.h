@@ -4,10 +4,13 @@
 #pragma once
 
 #include <array>
+#include <functional>
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
 #include "DiscIO/VolumeWii.h"
 
 namespace DiscIO
@@ -33,6 +36,16 @@ public:
   WiiEncryptionCache(const WiiEncryptionCache&) = delete;
   WiiEncryptionCache& operator=(const WiiEncryptionCache&) = delete;
 
+  struct Statistics
+  {
+    u64 hits = 0;
+    u64 misses = 0;
+    u64 bytes_encrypted = 0;
+  };
+
+  // The number of groups that are kept around.
+  static constexpr size_t CACHE_SIZE = 4;
+
   // Encrypts exactly one group.
   // If the returned pointer is nullptr, reading from the blob failed.
   // If the returned pointer is not nullptr, it is guaranteed to be valid until
@@ -42,15 +55,45 @@ public:
                const Key& key, const HashExceptionCallback& hash_exception_callback = {});
 
   // Encrypts a variable number of groups, as determined by the offset and size parameters.
-  // Supports reading groups partially.
+  // Supports reading groups partially. When several groups are missing from the cache,
+  // the encryption of each group runs on a worker thread while the next one is being read.
   bool EncryptGroups(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset,
                      u64 partition_data_decrypted_size, const Key& key,
                      const HashExceptionCallback& hash_exception_callback = {});
 
+  const Statistics& GetStatistics() const { return m_statistics; }
+
 private:
+  using Group = std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>;
+
+  struct CacheEntry
+  {
+    std::unique_ptr<Group> data;
+    u64 offset = std::numeric_limits<u64>::max();
+    u64 last_used = 0;
+  };
+
+  struct EncryptionTask
+  {
+    const std::array<u8, VolumeWii::BLOCK_DATA_SIZE>* data;
+    const VolumeWii::HashBlock* hashes;
+    const Key* key;
+    Group* out;
+  };
+
+  // Makes sure that count consecutive groups starting at offset are in the cache and writes
+  // pointers to them to out. count must not be larger than CACHE_SIZE.
+  bool LoadGroups(u64 offset, size_t count, u64 partition_data_offset,
+                  u64 partition_data_decrypted_size, const Key& key,
+                  const HashExceptionCallback& hash_exception_callback,
+                  std::array<const Group*, CACHE_SIZE>* out);
+
   BlobReader* m_blob;
-  std::unique_ptr<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>> m_cache;
-  u64 m_cached_offset = 0;
+  std::vector<CacheEntry> m_cache;
+  // Started on first use. Kept in a unique_ptr so that this class stays movable.
+  std::unique_ptr<Common::WorkQueueThread<EncryptionTask>> m_encryption_thread;
+  u64 m_use_counter = 0;
+  Statistics m_statistics;
 };
 
 }  // namespace DiscIO
@@ -271,7 +271,8 @@ void AdvancedWidget::AddDescriptions()
                  "emulation performance.<br><br><dolphin_emphasis>If unsure, leave this "
                  "unchecked.</dolphin_emphasis>");
   static const char TR_SHOW_SPEED_DESCRIPTION[] =
-      QT_TR_NOOP("Shows the % speed of emulation compared to full speed."
+      QT_TR_NOOP("Shows the % speed of emulation compared to full speed, along with the audio "
+                 "latency and the number of times the audio output ran out of samples."
                  "<br><br><dolphin_emphasis>If unsure, leave this "
                  "unchecked.</dolphin_emphasis>");
   static const char TR_SHOW_SPEED_COLORS_DESCRIPTION[] =
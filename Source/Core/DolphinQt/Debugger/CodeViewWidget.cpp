@@ -5,6 +5,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
+#include <optional>
 
 #include <fmt/format.h>
 
@@ -38,6 +40,8 @@
 #include "DolphinQt/Debugger/AssembleInstructionDialog.h"
 #include "DolphinQt/Debugger/PatchInstructionDialog.h"
 #include "DolphinQt/Host.h"
+#include "DolphinQt/QtUtils/DolphinFileDialog.h"
+#include "DolphinQt/QtUtils/ModalMessageBox.h"
 #include "DolphinQt/QtUtils/SetWindowDecorations.h"
 #include "DolphinQt/Resources.h"
 #include "DolphinQt/Settings.h"
@@ -638,6 +642,10 @@ void CodeViewWidget::OnContextMenu()
                             [this] { AutoStep(CodeTrace::AutoStop::Changed); });
 
   run_until_menu->setEnabled(!target.isEmpty());
+
+  auto* record_trace_action =
+      menu->addAction(tr("Record instruction trace..."), this, &CodeViewWidget::OnRecordTrace);
+  record_trace_action->setEnabled(paused);
   follow_branch_action->setEnabled(follow_branch_enabled);
 
   for (auto* action :
@@ -744,6 +752,38 @@ void CodeViewWidget::AutoStep(CodeTrace::AutoStop option)
   } while (msgbox.clickedButton() == (QAbstractButton*)run_button);
 }
 
+void CodeViewWidget::OnRecordTrace()
+{
+  bool good;
+  const int count = QInputDialog::getInt(this, tr("Record instruction trace"),
+                                         tr("Number of instructions to record:"), 1000000, 1,
+                                         std::numeric_limits<int>::max(), 1000, &good,
+                                         Qt::WindowCloseButtonHint);
+  if (!good)
+    return;
+
+  const QString path = DolphinFileDialog::getSaveFileName(
+      this, tr("Save Instruction Trace As"), QString(),
+      tr("Dolphin Instruction Traces (*.dtrace)"));
+  if (path.isEmpty())
+    return;
+
+  std::optional<u64> recorded;
+  {
+    Core::CPUThreadGuard guard(m_system);
+    recorded = CodeTrace().RecordTrace(guard, path.toStdString(), static_cast<u64>(count));
+  }
+  emit Host::GetInstance()->UpdateDisasmDialog();
+
+  if (!recorded)
+  {
+    ModalMessageBox::critical(this, tr("Error"), tr("Failed to write the instruction trace."));
+    return;
+  }
+  ModalMessageBox::information(this, tr("Record instruction trace"),
+                               tr("Recorded %1 instructions.").arg(QString::number(*recorded)));
+}
+
 void CodeViewWidget::OnCopyAddress()
 {
   const u32 addr = GetContextAddress();
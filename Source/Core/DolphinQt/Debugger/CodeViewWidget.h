@@ -77,6 +77,7 @@ private:
   void OnContextMenu();
 
   void AutoStep(CodeTrace::AutoStop option = CodeTrace::AutoStop::Always);
+  void OnRecordTrace();
   void OnFollowBranch();
   void OnCopyAddress();
   void OnCopyTargetAddress();
@@ -6,6 +6,8 @@
 #include <cinttypes>
 #include <future>
 
+#include <fmt/format.h>
+
 #include <QAction>
 #include <QActionGroup>
 #include <QDesktopServices>
@@ -18,6 +20,7 @@
 #include "Common/Align.h"
 #include "Common/CommonPaths.h"
 #include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/StringUtil.h"
 
 #include "Core/AchievementManager.h"
@@ -27,6 +30,7 @@
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/CoreTiming.h"
 #include "Core/Debugger/RSO.h"
 #include "Core/HLE/HLE.h"
 #include "Core/HW/AddressSpace.h"
@@ -157,6 +161,11 @@ void MenuBar::OnEmulationStateChanged(Core::State state)
   m_jit_clear_cache->setEnabled(running);
   m_jit_log_coverage->setEnabled(!running);
   m_jit_search_instruction->setEnabled(running);
+  // Stopping the emulation also stops the sampling, and this writes out what was collected.
+  if (!running && m_jit_sample_call_stacks->isChecked())
+    m_jit_sample_call_stacks->setChecked(false);
+  m_jit_sample_call_stacks->setEnabled(running);
+  m_jit_show_idle_loops->setEnabled(running);
 
   // Symbols
   m_symbols->setEnabled(running);
@@ -894,6 +903,11 @@ void MenuBar::AddJITMenu()
       m_jit->addAction(tr("Log JIT Instruction Coverage"), this, &MenuBar::LogInstructions);
   m_jit_search_instruction =
       m_jit->addAction(tr("Search for an Instruction"), this, &MenuBar::SearchInstruction);
+  m_jit_sample_call_stacks = m_jit->addAction(tr("Sample Guest Call Stacks"));
+  m_jit_sample_call_stacks->setCheckable(true);
+  connect(m_jit_sample_call_stacks, &QAction::toggled, this, &MenuBar::SampleGuestCallStacks);
+  m_jit_show_idle_loops =
+      m_jit->addAction(tr("Show Detected Idle Loops"), this, &MenuBar::ShowIdleLoops);
 
   m_jit->addSeparator();
 
@@ -1269,6 +1283,48 @@ void MenuBar::ClearSymbols()
   emit NotifySymbolsUpdated();
 }
 
+// Finds the functions in [start, end) and names them from the signature database. Returns whether
+// the signature database was found. This takes a while for large games, so if there were no
+// symbols to begin with, the result is cached (per range) until the scanned memory or the database
+// changes.
+static bool FindAndNameFunctions(const Core::CPUThreadGuard& guard, u32 start, u32 end)
+{
+  const std::string db_path = File::GetSysDirectory() + TOTALDB;
+  std::string db_contents;
+  const bool has_db = File::ReadFileToString(db_path, db_contents);
+
+  // New code anywhere in the range can add functions, not just change the ones that were found
+  // before, so the whole range is part of the key.
+  const u8* const code = guard.GetSystem().GetMemory().GetPointerForRange(start, end - start);
+
+  const std::string& game_id = SConfig::GetInstance().m_debugger_game_id;
+  const bool use_cache = g_symbolDB.IsEmpty() && !game_id.empty() && code;
+  const std::string cache_path = fmt::format("{}Symbols/{}_{:08x}_{:08x}.map",
+                                             File::GetUserPath(D_CACHE_IDX), game_id, start, end);
+  u32 source_hash = Common::ComputeCRC32(db_contents);
+  if (code)
+    source_hash = Common::UpdateCRC32(source_hash, code, end - start);
+
+  if (use_cache && g_symbolDB.LoadGeneratedMap(guard, cache_path, source_hash))
+    return has_db;
+
+  PPCAnalyst::FindFunctions(guard, start, end, &g_symbolDB);
+  if (has_db)
+  {
+    SignatureDB db(SignatureDB::HandlerType::DSY);
+    if (db.Load(db_path))
+    {
+      db.Apply(guard, &g_symbolDB);
+      db.List();
+    }
+  }
+
+  if (use_cache && File::CreateFullPath(cache_path))
+    g_symbolDB.SaveGeneratedMap(cache_path, source_hash);
+
+  return has_db;
+}
+
 void MenuBar::GenerateSymbolsFromAddress()
 {
   Core::CPUThreadGuard guard(Core::System::GetInstance());
@@ -1288,16 +1344,12 @@ void MenuBar::GenerateSymbolsFromSignatureDB()
   auto& system = Core::System::GetInstance();
   auto& memory = system.GetMemory();
 
-  PPCAnalyst::FindFunctions(guard, Memory::MEM1_BASE_ADDR,
-                            Memory::MEM1_BASE_ADDR + memory.GetRamSizeReal(), &g_symbolDB);
-  SignatureDB db(SignatureDB::HandlerType::DSY);
-  if (db.Load(File::GetSysDirectory() + TOTALDB))
+  if (FindAndNameFunctions(guard, Memory::MEM1_BASE_ADDR,
+                           Memory::MEM1_BASE_ADDR + memory.GetRamSizeReal()))
   {
-    db.Apply(guard, &g_symbolDB);
     ModalMessageBox::information(
         this, tr("Information"),
         tr("Generated symbol names from '%1'").arg(QString::fromStdString(TOTALDB)));
-    db.List();
   }
   else
   {
@@ -1517,11 +1569,8 @@ void MenuBar::LoadSymbolMap()
     {
       Core::CPUThreadGuard guard(Core::System::GetInstance());
 
-      PPCAnalyst::FindFunctions(guard, Memory::MEM1_BASE_ADDR + 0x1300000,
-                                Memory::MEM1_BASE_ADDR + memory.GetRamSizeReal(), &g_symbolDB);
-      SignatureDB db(SignatureDB::HandlerType::DSY);
-      if (db.Load(File::GetSysDirectory() + TOTALDB))
-        db.Apply(guard, &g_symbolDB);
+      FindAndNameFunctions(guard, Memory::MEM1_BASE_ADDR + 0x1300000,
+                           Memory::MEM1_BASE_ADDR + memory.GetRamSizeReal());
     }
 
     ModalMessageBox::warning(this, tr("Warning"),
@@ -1765,6 +1814,51 @@ void MenuBar::LogInstructions()
   PPCTables::LogCompiledInstructions();
 }
 
+void MenuBar::ShowIdleLoops()
+{
+  std::string summary;
+  {
+    Core::CPUThreadGuard guard(Core::System::GetInstance());
+    summary = guard.GetSystem().GetCoreTiming().GetIdleLoopSummary();
+  }
+
+  if (summary.empty())
+  {
+    ModalMessageBox::information(this, tr("Detected Idle Loops"),
+                                 tr("No idle loops have been detected in this title yet."));
+    return;
+  }
+
+  ModalMessageBox::information(
+      this, tr("Detected Idle Loops"),
+      tr("The loops are listed by how much emulated time was skipped by idling in them.\n\n%1")
+          .arg(QString::fromStdString(summary)));
+}
+
+void MenuBar::SampleGuestCallStacks(bool enabled)
+{
+  auto& profiler = Core::System::GetInstance().GetPowerPC().GetSamplingProfiler();
+  if (enabled)
+  {
+    // Emulation might have stopped by the time the samples are written.
+    m_guest_profile_game_id = SConfig::GetInstance().GetGameID();
+    profiler.Start();
+    return;
+  }
+
+  profiler.Stop();
+  const std::string path =
+      File::GetUserPath(D_DUMP_IDX) + "GuestProfile_" + m_guest_profile_game_id + ".folded";
+  if (profiler.WriteCollapsedStacks(path))
+  {
+    ModalMessageBox::information(
+        this, tr("Sample Guest Call Stacks"),
+        tr("Wrote %1 samples to %2.")
+            .arg(profiler.GetSampleCount())
+            .arg(QString::fromStdString(path)));
+  }
+}
+
 void MenuBar::SearchInstruction()
 {
   bool good;
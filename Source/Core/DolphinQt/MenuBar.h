@@ -183,6 +183,8 @@ private:
   void ClearCache();
   void LogInstructions();
   void SearchInstruction();
+  void SampleGuestCallStacks(bool enabled);
+  void ShowIdleLoops();
 
   void OnSelectionChanged(std::shared_ptr<const UICommon::GameFile> game_file);
   void OnRecordingStatusChanged(bool recording);
@@ -272,6 +274,8 @@ private:
   QAction* m_jit_clear_cache;
   QAction* m_jit_log_coverage;
   QAction* m_jit_search_instruction;
+  QAction* m_jit_sample_call_stacks;
+  QAction* m_jit_show_idle_loops;
   QAction* m_jit_off;
   QAction* m_jit_loadstore_off;
   QAction* m_jit_loadstore_lbzx_off;
@@ -287,4 +291,6 @@ private:
   QAction* m_jit_register_cache_off;
 
   bool m_game_selected = false;
+  // The game that was running when sampling guest call stacks started
+  std::string m_guest_profile_game_id;
 };
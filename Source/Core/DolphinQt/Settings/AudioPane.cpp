@@ -93,6 +93,12 @@ void AudioPane::CreateWidgets()
            "crackling. Certain backends only."));
   }
 
+  m_adaptive_latency = new QCheckBox(tr("Adaptive Latency"));
+  m_adaptive_latency->setToolTip(
+      tr("Keeps as little audio buffered as possible without crackling. The buffer grows "
+         "whenever the audio output runs out of samples and shrinks again while playback is "
+         "stable.<br><br>Has no effect while audio stretching is enabled."));
+
   m_dolby_pro_logic->setToolTip(
       tr("Enables Dolby Pro Logic II emulation using 5.1 surround. Certain backends only."));
 
@@ -124,6 +130,7 @@ void AudioPane::CreateWidgets()
   backend_layout->addRow(m_backend_label, m_backend_combo);
   if (m_latency_control_supported)
     backend_layout->addRow(m_latency_label, m_latency_spin);
+  backend_layout->addRow(m_adaptive_latency);
 
 #ifdef _WIN32
   m_wasapi_device_label = new QLabel(tr("Device:"));
@@ -180,6 +187,7 @@ void AudioPane::ConnectWidgets()
   {
     connect(m_latency_spin, &QSpinBox::valueChanged, this, &AudioPane::SaveSettings);
   }
+  connect(m_adaptive_latency, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_stretching_buffer_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
   connect(m_dolby_pro_logic, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dolby_quality_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
@@ -241,9 +249,11 @@ void AudioPane::LoadSettings()
   // Latency
   if (m_latency_control_supported)
     m_latency_spin->setValue(Config::Get(Config::MAIN_AUDIO_LATENCY));
+  m_adaptive_latency->setChecked(Config::Get(Config::MAIN_AUDIO_ADAPTIVE_LATENCY));
 
   // Stretch
   m_stretching_enable->setChecked(Config::Get(Config::MAIN_AUDIO_STRETCH));
+  m_adaptive_latency->setEnabled(!m_stretching_enable->isChecked());
   m_stretching_buffer_label->setEnabled(m_stretching_enable->isChecked());
   m_stretching_buffer_slider->setValue(Config::Get(Config::MAIN_AUDIO_STRETCH_LATENCY));
   m_stretching_buffer_slider->setEnabled(m_stretching_enable->isChecked());
@@ -309,9 +319,11 @@ void AudioPane::SaveSettings()
   // Latency
   if (m_latency_control_supported)
     Config::SetBaseOrCurrent(Config::MAIN_AUDIO_LATENCY, m_latency_spin->value());
+  Config::SetBaseOrCurrent(Config::MAIN_AUDIO_ADAPTIVE_LATENCY, m_adaptive_latency->isChecked());
 
   // Stretch
   Config::SetBaseOrCurrent(Config::MAIN_AUDIO_STRETCH, m_stretching_enable->isChecked());
+  m_adaptive_latency->setEnabled(!m_stretching_enable->isChecked());
   Config::SetBaseOrCurrent(Config::MAIN_AUDIO_STRETCH_LATENCY, m_stretching_buffer_slider->value());
   m_stretching_buffer_label->setEnabled(m_stretching_enable->isChecked());
   m_stretching_buffer_slider->setEnabled(m_stretching_enable->isChecked());
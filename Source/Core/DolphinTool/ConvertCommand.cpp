@@ -3,11 +3,19 @@
 
 #include "DolphinTool/ConvertCommand.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 #include <OptionParser.h>
@@ -15,6 +23,9 @@
 #include <fmt/ostream.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/ScrubbedBlob.h"
@@ -56,6 +67,342 @@ static std::optional<DiscIO::BlobType> ParseFormatString(const std::string& form
   return std::nullopt;
 }
 
+struct ConversionSettings
+{
+  DiscIO::BlobType format;
+  bool scrub = false;
+  std::optional<int> block_size;
+  std::optional<DiscIO::WIARVZCompressionType> compression;
+  std::optional<int> compression_level;
+};
+
+static std::string GetExtensionForFormat(DiscIO::BlobType format)
+{
+  switch (format)
+  {
+  case DiscIO::BlobType::GCZ:
+    return ".gcz";
+  case DiscIO::BlobType::WIA:
+    return ".wia";
+  case DiscIO::BlobType::RVZ:
+    return ".rvz";
+  case DiscIO::BlobType::PLAIN:
+  default:
+    return ".iso";
+  }
+}
+
+static std::vector<std::string> FindBatchInputs(const std::string& path)
+{
+  if (File::IsDirectory(path))
+  {
+    static const std::vector<std::string> disc_extensions = {
+        ".gcm", ".tgc", ".iso", ".ciso", ".gcz", ".wbfs", ".wia", ".rvz", ".nfs"};
+    return Common::DoFileSearch({path}, disc_extensions, false);
+  }
+
+  // Anything else is treated as a list file with one path per line
+  std::vector<std::string> result;
+  std::ifstream list_file;
+  File::OpenFStream(list_file, path, std::ios_base::in);
+  std::string line;
+  while (std::getline(list_file, line))
+  {
+    line = StripWhitespace(line);
+    if (!line.empty() && line[0] != '#')
+      result.push_back(std::move(line));
+  }
+  return result;
+}
+
+// Batch conversions run concurrently, so their output is serialized.
+static std::mutex s_output_mutex;
+
+// In batch mode, messages are prefixed with the input they are about.
+static void PrintMessage(std::string_view prefix, std::string_view message)
+{
+  std::lock_guard lk(s_output_mutex);
+  fmt::print(std::cerr, "{}{}\n", prefix, message);
+}
+
+// Converts a single file. Returns the number of input bytes converted, or std::nullopt on failure.
+static std::optional<u64> ConvertFile(const ConversionSettings& settings,
+                                      const std::string& input_file_path,
+                                      const std::string& output_file_path,
+                                      std::string_view message_prefix = {})
+{
+  const DiscIO::BlobType format = settings.format;
+  const bool scrub = settings.scrub;
+
+  // Open the blob reader
+  std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_file_path);
+  if (!blob_reader)
+  {
+    PrintMessage(message_prefix, "Error: The input file could not be opened.");
+    return std::nullopt;
+  }
+
+  // Open the volume
+  std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateDisc(input_file_path);
+  if (!volume)
+  {
+    if (scrub)
+    {
+      PrintMessage(message_prefix, "Error: Scrubbing is only supported for GC/Wii disc images.");
+      return std::nullopt;
+    }
+
+    PrintMessage(message_prefix,
+                 "Warning: The input file is not a GC/Wii disc image. Continuing anyway.");
+  }
+
+  if (scrub)
+  {
+    if (volume->IsDatelDisc())
+    {
+      PrintMessage(message_prefix, "Error: Scrubbing a Datel disc is not supported.");
+      return std::nullopt;
+    }
+
+    blob_reader = DiscIO::ScrubbedBlob::Create(input_file_path);
+
+    if (!blob_reader)
+    {
+      PrintMessage(message_prefix,
+                   "Error: Unable to process disc image. Try again without --scrub.");
+      return std::nullopt;
+    }
+  }
+
+  if (scrub && format == DiscIO::BlobType::RVZ)
+  {
+    PrintMessage(message_prefix, "Warning: Scrubbing an RVZ container does not offer significant "
+                                 "space advantages. Continuing anyway.");
+  }
+
+  if (scrub && format == DiscIO::BlobType::PLAIN)
+  {
+    PrintMessage(message_prefix, "Warning: Scrubbing does not save space when converting to ISO "
+                                 "unless using external compression. Continuing anyway.");
+  }
+
+  if (!scrub && format == DiscIO::BlobType::GCZ && volume &&
+      volume->GetVolumeType() == DiscIO::Platform::WiiDisc && !volume->IsDatelDisc())
+  {
+    PrintMessage(message_prefix, "Warning: Converting Wii disc images to GCZ without scrubbing may "
+                                 "not offer space advantages over ISO. Continuing anyway.");
+  }
+
+  if (volume && volume->IsNKit())
+  {
+    PrintMessage(message_prefix, "Warning: Converting an NKit file, output will still be NKit! "
+                                 "Continuing anyway.");
+  }
+
+  if (format == DiscIO::BlobType::GCZ && volume &&
+      !DiscIO::IsGCZBlockSizeLegacyCompatible(settings.block_size.value(), volume->GetDataSize()))
+  {
+    PrintMessage(message_prefix,
+                 "Warning: For GCZs to be compatible with Dolphin < 5.0-11893, the file size must "
+                 "be an integer multiple of the block size and must not be an integer multiple of "
+                 "the block size multiplied by 32. Continuing anyway.");
+  }
+
+  // Perform the conversion
+  const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
+
+  const u64 input_size = blob_reader->GetDataSize();
+  bool success = false;
+
+  switch (format)
+  {
+  case DiscIO::BlobType::PLAIN:
+  {
+    success = DiscIO::ConvertToPlain(blob_reader.get(), input_file_path, output_file_path,
+                                     NOOP_STATUS_CALLBACK);
+    break;
+  }
+
+  case DiscIO::BlobType::GCZ:
+  {
+    u32 sub_type = std::numeric_limits<u32>::max();
+    if (volume)
+    {
+      if (volume->GetVolumeType() == DiscIO::Platform::GameCubeDisc)
+        sub_type = 0;
+      else if (volume->GetVolumeType() == DiscIO::Platform::WiiDisc)
+        sub_type = 1;
+    }
+    success = DiscIO::ConvertToGCZ(blob_reader.get(), input_file_path, output_file_path, sub_type,
+                                   settings.block_size.value(), NOOP_STATUS_CALLBACK);
+    break;
+  }
+
+  case DiscIO::BlobType::WIA:
+  case DiscIO::BlobType::RVZ:
+  {
+    success = DiscIO::ConvertToWIAOrRVZ(
+        blob_reader.get(), input_file_path, output_file_path, format == DiscIO::BlobType::RVZ,
+        settings.compression.value(), settings.compression_level.value(),
+        settings.block_size.value(), NOOP_STATUS_CALLBACK);
+    break;
+  }
+
+  default:
+  {
+    ASSERT(false);
+    break;
+  }
+  }
+
+  if (!success)
+  {
+    PrintMessage(message_prefix, "Error: Conversion failed");
+    return std::nullopt;
+  }
+
+  return input_size;
+}
+
+static double GetMiBPerSecond(u64 bytes, std::chrono::steady_clock::duration duration)
+{
+  const double seconds = std::chrono::duration<double>(duration).count();
+  return seconds > 0 ? bytes / 1048576.0 / seconds : 0.0;
+}
+
+// Picks an output name for every input. Inputs from different directories can have the same name,
+// in which case the later ones get a number appended. The names only depend on the order of the
+// inputs, so running the same batch again picks the same names.
+static std::vector<std::string> GetBatchOutputNames(const std::vector<std::string>& inputs)
+{
+  // Compared in lowercase, since the output directory can be on a case-insensitive file system.
+  std::set<std::string> used_names;
+  std::vector<std::string> names;
+  names.reserve(inputs.size());
+  for (const std::string& input : inputs)
+  {
+    std::string basename;
+    SplitPath(input, nullptr, &basename, nullptr);
+
+    std::string name = basename;
+    for (int number = 2;; ++number)
+    {
+      std::string lowercase_name = name;
+      Common::ToLower(&lowercase_name);
+      if (used_names.insert(std::move(lowercase_name)).second)
+        break;
+      name = fmt::format("{} ({})", basename, number);
+    }
+    names.push_back(std::move(name));
+  }
+  return names;
+}
+
+// Converts many files into output_directory, running several conversions at once. Compression
+// threads are shared process-wide (see DiscIO::GetSharedCompressionSlots), so a small GameCube
+// image finishing early lets another conversion use its cores instead of leaving them idle.
+//
+// Each output is first written to a .part file and renamed once complete, so an interrupted
+// batch can be resumed by running the same command again: finished outputs are skipped.
+static int ConvertBatch(const ConversionSettings& settings, const std::vector<std::string>& inputs,
+                        const std::string& output_directory, int jobs)
+{
+  if (!File::IsDirectory(output_directory) && !File::CreateFullPath(output_directory + '/'))
+  {
+    fmt::print(std::cerr, "Error: Could not create output directory {}\n", output_directory);
+    return EXIT_FAILURE;
+  }
+
+  const std::vector<std::string> output_names = GetBatchOutputNames(inputs);
+  for (size_t i = 0; i < inputs.size(); ++i)
+  {
+    std::string basename;
+    SplitPath(inputs[i], nullptr, &basename, nullptr);
+    if (output_names[i] != basename)
+    {
+      fmt::print(std::cout, "Note: {} has the same name as another input, so it is saved as {}\n",
+                 inputs[i], output_names[i] + GetExtensionForFormat(settings.format));
+    }
+  }
+
+  std::atomic<size_t> next_index = 0;
+  std::atomic<size_t> converted_count = 0;
+  std::atomic<size_t> skipped_count = 0;
+  std::atomic<size_t> failed_count = 0;
+  std::atomic<u64> converted_bytes = 0;
+
+  const auto batch_start = std::chrono::steady_clock::now();
+
+  const auto worker = [&] {
+    while (true)
+    {
+      const size_t index = next_index++;
+      if (index >= inputs.size())
+        return;
+
+      const std::string& input_path = inputs[index];
+      const std::string output_path =
+          output_directory + '/' + output_names[index] + GetExtensionForFormat(settings.format);
+      const std::string partial_path = output_path + ".part";
+      const std::string message_prefix =
+          fmt::format("[{}/{}] {}: ", index + 1, inputs.size(), input_path);
+
+      if (File::Exists(output_path))
+      {
+        std::lock_guard lk(s_output_mutex);
+        fmt::print(std::cout, "[{}/{}] Skipping {}: output already exists\n", index + 1,
+                   inputs.size(), input_path);
+        ++skipped_count;
+        continue;
+      }
+
+      {
+        std::lock_guard lk(s_output_mutex);
+        fmt::print(std::cout, "[{}/{}] Converting {}\n", index + 1, inputs.size(), input_path);
+      }
+
+      const auto start = std::chrono::steady_clock::now();
+      const std::optional<u64> bytes =
+          ConvertFile(settings, input_path, partial_path, message_prefix);
+      const auto duration = std::chrono::steady_clock::now() - start;
+
+      std::lock_guard lk(s_output_mutex);
+      if (bytes && File::Rename(partial_path, output_path))
+      {
+        fmt::print(std::cout, "[{}/{}] Finished {} ({:.1f} MiB/s)\n", index + 1, inputs.size(),
+                   output_path, GetMiBPerSecond(*bytes, duration));
+        converted_bytes += *bytes;
+        ++converted_count;
+      }
+      else
+      {
+        fmt::print(std::cerr, "[{}/{}] Failed to convert {}\n", index + 1, inputs.size(),
+                   input_path);
+        File::Delete(partial_path);
+        ++failed_count;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  const size_t thread_count = std::min<size_t>(std::max(jobs, 1), inputs.size());
+  for (size_t i = 0; i < thread_count; ++i)
+    threads.emplace_back(worker);
+  for (std::thread& thread : threads)
+    thread.join();
+
+  const auto batch_duration = std::chrono::steady_clock::now() - batch_start;
+
+  fmt::print(std::cout,
+             "Converted {} file(s), skipped {}, failed {}: {:.2f} GiB in {:.1f} s ({:.1f} MiB/s)\n",
+             converted_count.load(), skipped_count.load(), failed_count.load(),
+             converted_bytes.load() / 1073741824.0,
+             std::chrono::duration<double>(batch_duration).count(),
+             GetMiBPerSecond(converted_bytes.load(), batch_duration));
+
+  return failed_count.load() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 int ConvertCommand(const std::vector<std::string>& args)
 {
   optparse::OptionParser parser;
@@ -78,9 +425,24 @@ int ConvertCommand(const std::vector<std::string>& args)
   parser.add_option("-o", "--output")
       .type("string")
       .action("store")
-      .help("Path to the destination FILE.")
+      .help("Path to the destination FILE. In batch mode, path to the destination directory.")
       .metavar("FILE");
 
+  parser.add_option("--batch")
+      .type("string")
+      .action("store")
+      .help("Convert every disc image in PATH, which is either a directory or a text file "
+            "listing one image per line. Additional images can be passed as arguments. "
+            "Existing outputs are skipped, so an interrupted batch can be resumed.")
+      .metavar("PATH");
+
+  parser.add_option("-j", "--jobs")
+      .type("int")
+      .action("store")
+      .help("Number of images to convert at the same time in batch mode. Compression threads "
+            "are shared between all of them. Default is 2.")
+      .set_default(2);
+
   parser.add_option("-f", "--format")
       .type("string")
       .action("store")
@@ -119,13 +481,25 @@ int ConvertCommand(const std::vector<std::string>& args)
 
   // Validate options
 
-  // --input
-  if (!options.is_set("input"))
+  // --input, --batch
+  const std::vector<std::string>& positional_args = parser.args();
+  const bool batch = options.is_set("batch") || !positional_args.empty();
+
+  std::vector<std::string> batch_inputs;
+  if (batch)
+  {
+    if (options.is_set("batch"))
+      batch_inputs = FindBatchInputs(options["batch"]);
+    if (options.is_set("input"))
+      batch_inputs.push_back(options["input"]);
+    batch_inputs.insert(batch_inputs.end(), positional_args.begin(), positional_args.end());
+  }
+
+  if (!batch && !options.is_set("input"))
   {
     fmt::print(std::cerr, "Error: No input set\n");
     return EXIT_FAILURE;
   }
-  const std::string& input_file_path = options["input"];
 
   // --output
   if (!options.is_set("output"))
@@ -135,6 +509,8 @@ int ConvertCommand(const std::vector<std::string>& args)
   }
   const std::string& output_file_path = options["output"];
 
+  ConversionSettings settings;
+
   // --format
   const std::optional<DiscIO::BlobType> format_o = ParseFormatString(options["format"]);
   if (!format_o.has_value())
@@ -143,73 +519,10 @@ int ConvertCommand(const std::vector<std::string>& args)
     return EXIT_FAILURE;
   }
   const DiscIO::BlobType format = format_o.value();
-
-  // Open the blob reader
-  std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_file_path);
-  if (!blob_reader)
-  {
-    fmt::print(std::cerr, "Error: The input file could not be opened.\n");
-    return EXIT_FAILURE;
-  }
+  settings.format = format;
 
   // --scrub
-  const bool scrub = static_cast<bool>(options.get("scrub"));
-
-  // Open the volume
-  std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateDisc(input_file_path);
-  if (!volume)
-  {
-    if (scrub)
-    {
-      fmt::print(std::cerr, "Error: Scrubbing is only supported for GC/Wii disc images.\n");
-      return EXIT_FAILURE;
-    }
-
-    fmt::print(std::cerr,
-               "Warning: The input file is not a GC/Wii disc image. Continuing anyway.\n");
-  }
-
-  if (scrub)
-  {
-    if (volume->IsDatelDisc())
-    {
-      fmt::print(std::cerr, "Error: Scrubbing a Datel disc is not supported.\n");
-      return EXIT_FAILURE;
-    }
-
-    blob_reader = DiscIO::ScrubbedBlob::Create(input_file_path);
-
-    if (!blob_reader)
-    {
-      fmt::print(std::cerr, "Error: Unable to process disc image. Try again without --scrub.\n");
-      return EXIT_FAILURE;
-    }
-  }
-
-  if (scrub && format == DiscIO::BlobType::RVZ)
-  {
-    fmt::print(std::cerr, "Warning: Scrubbing an RVZ container does not offer significant space "
-                          "advantages. Continuing anyway.\n");
-  }
-
-  if (scrub && format == DiscIO::BlobType::PLAIN)
-  {
-    fmt::print(std::cerr, "Warning: Scrubbing does not save space when converting to ISO unless "
-                          "using external compression. Continuing anyway.\n");
-  }
-
-  if (!scrub && format == DiscIO::BlobType::GCZ && volume &&
-      volume->GetVolumeType() == DiscIO::Platform::WiiDisc && !volume->IsDatelDisc())
-  {
-    fmt::print(std::cerr, "Warning: Converting Wii disc images to GCZ without scrubbing may not "
-                          "offer space advantages over ISO. Continuing anyway.\n");
-  }
-
-  if (volume && volume->IsNKit())
-  {
-    fmt::print(std::cerr,
-               "Warning: Converting an NKit file, output will still be NKit! Continuing anyway.\n");
-  }
+  settings.scrub = static_cast<bool>(options.get("scrub"));
 
   // --block_size
   std::optional<int> block_size_o;
@@ -237,16 +550,8 @@ int ConvertCommand(const std::vector<std::string>& args)
       fmt::print(std::cerr,
                  "Warning: Block size is not ideal for performance. Continuing anyway.\n");
     }
-
-    if (format == DiscIO::BlobType::GCZ && volume &&
-        !DiscIO::IsGCZBlockSizeLegacyCompatible(block_size_o.value(), volume->GetDataSize()))
-    {
-      fmt::print(std::cerr,
-                 "Warning: For GCZs to be compatible with Dolphin < 5.0-11893, the file size "
-                 "must be an integer multiple of the block size and must not be an integer "
-                 "multiple of the block size multiplied by 32. Continuing anyway.\n");
-    }
   }
+  settings.block_size = block_size_o;
 
   // --compress, --compress_level
   std::optional<DiscIO::WIARVZCompressionType> compression_o =
@@ -295,58 +600,23 @@ int ConvertCommand(const std::vector<std::string>& args)
       }
     }
   }
+  settings.compression = compression_o;
+  settings.compression_level = compression_level_o;
 
-  // Perform the conversion
-  const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
-
-  bool success = false;
-
-  switch (format)
+  if (batch)
   {
-  case DiscIO::BlobType::PLAIN:
-  {
-    success = DiscIO::ConvertToPlain(blob_reader.get(), input_file_path, output_file_path,
-                                     NOOP_STATUS_CALLBACK);
-    break;
-  }
-
-  case DiscIO::BlobType::GCZ:
-  {
-    u32 sub_type = std::numeric_limits<u32>::max();
-    if (volume)
+    if (batch_inputs.empty())
     {
-      if (volume->GetVolumeType() == DiscIO::Platform::GameCubeDisc)
-        sub_type = 0;
-      else if (volume->GetVolumeType() == DiscIO::Platform::WiiDisc)
-        sub_type = 1;
+      fmt::print(std::cerr, "Error: No disc images found for batch conversion\n");
+      return EXIT_FAILURE;
     }
-    success = DiscIO::ConvertToGCZ(blob_reader.get(), input_file_path, output_file_path, sub_type,
-                                   block_size_o.value(), NOOP_STATUS_CALLBACK);
-    break;
-  }
-
-  case DiscIO::BlobType::WIA:
-  case DiscIO::BlobType::RVZ:
-  {
-    success = DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), input_file_path, output_file_path,
-                                        format == DiscIO::BlobType::RVZ, compression_o.value(),
-                                        compression_level_o.value(), block_size_o.value(),
-                                        NOOP_STATUS_CALLBACK);
-    break;
-  }
 
-  default:
-  {
-    ASSERT(false);
-    break;
-  }
+    return ConvertBatch(settings, batch_inputs, output_file_path,
+                        static_cast<int>(options.get("jobs")));
   }
 
-  if (!success)
-  {
-    fmt::print(std::cerr, "Error: Conversion failed\n");
+  if (!ConvertFile(settings, options["input"], output_file_path))
     return EXIT_FAILURE;
-  }
 
   return EXIT_SUCCESS;
 }
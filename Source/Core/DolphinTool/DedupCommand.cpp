@@ -0,0 +1,203 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/DedupCommand.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/MathUtil.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/DedupBlob.h"
+#include "DiscIO/Volume.h"
+#include "DiscIO/VolumeDisc.h"
+#include "UICommon/UICommon.h"
+
+namespace DolphinTool
+{
+static int DedupBuild(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: dedup build [options]... FILE...");
+
+  parser.add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("User folder path, required for temporary processing files. "
+            "Will be automatically created if this option is not set.")
+      .set_default("");
+
+  parser.add_option("-s", "--store")
+      .type("string")
+      .action("store")
+      .help("Path to the chunk store FILE. It is created if it doesn't exist, otherwise the "
+            "images are added to it. A .dedup file named after the image is written next to it "
+            "for every image, with a number added if that name is already taken.")
+      .metavar("FILE");
+
+  parser.add_option("-b", "--block_size")
+      .type("int")
+      .action("store")
+      .help("Chunk size, as a power of two. Must match the existing store. Default is 131072 "
+            "(128 KiB)")
+      .set_default(0x20000);
+
+  parser.add_option("-l", "--compression_level")
+      .type("int")
+      .action("store")
+      .help("Zstandard compression level. Default is 5")
+      .set_default(5);
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  UICommon::SetUserDirectory(options["user"]);
+  UICommon::Init();
+
+  if (!options.is_set("store"))
+  {
+    fmt::print(std::cerr, "Error: No store set\n");
+    return EXIT_FAILURE;
+  }
+  const std::string& store_path = options["store"];
+
+  const std::vector<std::string>& inputs = parser.args();
+  if (inputs.empty())
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+
+  const int block_size = static_cast<int>(options.get("block_size"));
+  if (block_size < 0x8000 || !MathUtil::IsPow2(block_size))
+  {
+    fmt::print(std::cerr, "Error: Block size is not valid\n");
+    return EXIT_FAILURE;
+  }
+
+  std::unique_ptr<DiscIO::DedupStoreWriter> writer = DiscIO::DedupStoreWriter::Open(
+      store_path, static_cast<u32>(block_size), static_cast<int>(options.get("compression_level")));
+  if (!writer)
+  {
+    fmt::print(std::cerr, "Error: The store could not be opened.\n");
+    return EXIT_FAILURE;
+  }
+
+  const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
+
+  bool success = true;
+  for (const std::string& input_path : inputs)
+  {
+    std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_path);
+    if (!blob_reader || blob_reader->GetDataSizeType() != DiscIO::DataSizeType::Accurate)
+    {
+      fmt::print(std::cerr, "Error: {} could not be opened or is not a full disc image.\n",
+                 input_path);
+      success = false;
+      continue;
+    }
+
+    // The volume is only used for finding Wii partitions, so it's fine if it can't be opened
+    const std::unique_ptr<DiscIO::VolumeDisc> volume = DiscIO::CreateDisc(input_path);
+    const std::string manifest_path = writer->GetManifestPath(input_path);
+
+    const u64 stored_before = writer->GetNewStoredBytes();
+    if (!writer->AddImage(blob_reader.get(), volume.get(), input_path, manifest_path,
+                          NOOP_STATUS_CALLBACK))
+    {
+      fmt::print(std::cerr, "Error: Failed to add {}\n", input_path);
+      success = false;
+      continue;
+    }
+
+    fmt::print(std::cout, "Added {} ({:.1f} MiB, {:.1f} MiB of new data stored)\n", input_path,
+               blob_reader->GetDataSize() / 1048576.0,
+               (writer->GetNewStoredBytes() - stored_before) / 1048576.0);
+  }
+
+  if (!writer->Finish())
+  {
+    fmt::print(std::cerr, "Error: Failed to write the store index\n");
+    return EXIT_FAILURE;
+  }
+
+  fmt::print(std::cout, "Stored {} new chunks ({:.1f} MiB) for {:.1f} MiB of input\n",
+             writer->GetNewChunkCount(), writer->GetNewStoredBytes() / 1048576.0,
+             writer->GetInputBytes() / 1048576.0);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static int DedupVerify(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: dedup verify FILE...");
+
+  parser.parse_args(args);
+
+  const std::vector<std::string>& inputs = parser.args();
+  if (inputs.empty())
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+
+  const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
+
+  bool success = true;
+  for (const std::string& input_path : inputs)
+  {
+    std::unique_ptr<DiscIO::DedupFileReader> reader =
+        DiscIO::DedupFileReader::Create(File::IOFile(input_path, "rb"), input_path);
+    if (!reader)
+    {
+      fmt::print(std::cerr, "Error: {} is not a deduplicated image or its store is missing.\n",
+                 input_path);
+      success = false;
+      continue;
+    }
+
+    const u32 bad_chunks = reader->Verify(NOOP_STATUS_CALLBACK);
+    if (bad_chunks != 0)
+    {
+      fmt::print(std::cout, "{}: {} corrupt chunk(s)\n", input_path, bad_chunks);
+      success = false;
+    }
+    else
+    {
+      fmt::print(std::cout, "{}: OK\n", input_path);
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int DedupCommand(const std::vector<std::string>& args)
+{
+  if (args.empty())
+  {
+    fmt::print(std::cerr, "usage: dedup build|verify [options]... FILE...\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::vector<std::string> sub_args(args.begin() + 1, args.end());
+  if (args[0] == "build")
+    return DedupBuild(sub_args);
+  else if (args[0] == "verify")
+    return DedupVerify(sub_args);
+
+  fmt::print(std::cerr, "usage: dedup build|verify [options]... FILE...\n");
+  return EXIT_FAILURE;
+}
+}  // namespace DolphinTool
@@ -0,0 +1,164 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/LockstepCommand.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/ScopeGuard.h"
+#include "Core/Boot/Boot.h"
+#include "Core/Boot/DolReader.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/LockstepTester.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+#include "UICommon/Disassembler.h"
+#include "UICommon/UICommon.h"
+
+namespace DolphinTool
+{
+static std::unique_ptr<HostDisassembler> GetHostDisassembler()
+{
+#if defined(_M_X86_64)
+  return GetNewDisassembler("x86");
+#elif defined(_M_ARM_64)
+  return GetNewDisassembler("aarch64");
+#else
+  return GetNewDisassembler("UNK");
+#endif
+}
+
+int LockstepCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: lockstep [options]... FILE\n\n"
+               "Runs a DOL with the JIT, checking every block against the interpreter. Returns 1 "
+               "and prints the block if they diverge.");
+
+  parser.add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("User folder path, required for temporary processing files. "
+            "Will be automatically created if this option is not set.")
+      .set_default("");
+
+  parser.add_option("-n", "--blocks")
+      .type("long")
+      .action("store")
+      .help("Maximum number of blocks to run. Default is 1000000")
+      .set_default(1000000);
+
+  parser.add_option("--ignore_fpscr_flags")
+      .action("store_true")
+      .help("Only compare the FPSCR rounding mode and exception enable bits, since the JIT "
+            "doesn't compute the other bits unless the accuracy options are enabled");
+
+  parser.add_option("--ignore_cr_so")
+      .action("store_true")
+      .help("Don't compare the SO bits of the CR fields, since the JITs set them for negative "
+            "results instead of copying XER[SO]");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  const std::vector<std::string>& inputs = parser.args();
+  if (inputs.size() != 1)
+  {
+    fmt::print(std::cerr, "Error: Exactly one input must be set\n");
+    return EXIT_FAILURE;
+  }
+
+  const DolReader dol(inputs[0]);
+  if (!dol.IsValid())
+  {
+    fmt::print(std::cerr, "Error: {} is not a valid DOL file\n", inputs[0]);
+    return EXIT_FAILURE;
+  }
+
+  UICommon::SetUserDirectory(options["user"]);
+  UICommon::Init();
+  Common::ScopeGuard ui_common_guard([] { UICommon::Shutdown(); });
+
+  // The JIT only returns to the tester after every block with debugging enabled, and the memory
+  // has to go through the MMU so that the stores the tester undoes are the ones that happened.
+  Config::SetCurrent(Config::MAIN_ENABLE_DEBUGGING, true);
+  Config::SetCurrent(Config::MAIN_FASTMEM, false);
+  Config::SetCurrent(Config::MAIN_FASTMEM_ARENA, false);
+  SConfig::GetInstance().bWii = dol.IsWii();
+
+  Core::UndeclareAsHostThread();
+  Core::DeclareAsCPUThread();
+  Common::ScopeGuard cpu_thread_guard([] {
+    Core::UndeclareAsCPUThread();
+    Core::DeclareAsHostThread();
+  });
+
+  auto& system = Core::System::GetInstance();
+  system.GetMemory().Init();
+  Common::ScopeGuard memory_guard([&system] { system.GetMemory().Shutdown(); });
+  system.GetPowerPC().Init(PowerPC::DefaultCPUCore());
+  Common::ScopeGuard power_pc_guard([&system] { system.GetPowerPC().Shutdown(); });
+  system.GetCoreTiming().Init();
+  Common::ScopeGuard core_timing_guard([&system] { system.GetCoreTiming().Shutdown(); });
+
+  PowerPC::LockstepTester tester(system);
+  if (!tester.IsAvailable())
+  {
+    fmt::print(std::cerr, "Error: No JIT is available on this platform\n");
+    return EXIT_FAILURE;
+  }
+  if (static_cast<bool>(options.get("ignore_fpscr_flags")))
+    tester.SetFPSCRMask(0xff);
+  if (static_cast<bool>(options.get("ignore_cr_so")))
+    tester.SetCRMask(0xeeeeeeee);
+
+  auto& ppc_state = system.GetPPCState();
+  CBoot::SetupMSR(ppc_state);
+  CBoot::SetupHID(ppc_state, dol.IsWii());
+  CBoot::SetupBAT(system, dol.IsWii());
+  if (!dol.LoadIntoMemory(system))
+  {
+    fmt::print(std::cerr, "Error: {} could not be loaded into memory\n", inputs[0]);
+    return EXIT_FAILURE;
+  }
+  ppc_state.pc = dol.GetEntryPoint();
+
+  const Core::CPUThreadGuard guard(system);
+  const long max_blocks = static_cast<long>(options.get("blocks"));
+  for (long i = 0; i < max_blocks; ++i)
+  {
+    const std::optional<PowerPC::LockstepDivergence> divergence = tester.RunBlock(guard);
+    if (!divergence)
+      continue;
+
+    fmt::print(std::cout, "{}", divergence->ToString());
+
+    u32 host_instruction_count = 0;
+    const std::string host_disassembly = GetHostDisassembler()->DisassembleHostBlock(
+        divergence->host_code.data(), static_cast<u32>(divergence->host_code.size()),
+        &host_instruction_count, divergence->host_address);
+    fmt::print(std::cout, "Host disassembly ({} instructions):\n{}\n", host_instruction_count,
+               host_disassembly);
+    return 1;
+  }
+
+  fmt::print(std::cout, "No divergence in {} blocks ({} instructions)\n", tester.GetBlockCount(),
+             tester.GetInstructionCount());
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
@@ -17,14 +17,17 @@
 #include "Core/Core.h"
 
 #include "DolphinTool/ConvertCommand.h"
+#include "DolphinTool/DedupCommand.h"
 #include "DolphinTool/HeaderCommand.h"
+#include "DolphinTool/LockstepCommand.h"
+#include "DolphinTool/TraceCommand.h"
 #include "DolphinTool/VerifyCommand.h"
 
 static void PrintUsage()
 {
   fmt::print(std::cerr, "usage: dolphin-tool COMMAND -h\n"
                         "\n"
-                        "commands supported: [convert, verify, header]\n");
+                        "commands supported: [convert, verify, header, dedup, trace, lockstep]\n");
 }
 
 #ifdef _WIN32
@@ -51,6 +54,12 @@ int main(int argc, char* argv[])
     return DolphinTool::VerifyCommand(args);
   else if (command_str == "header")
     return DolphinTool::HeaderCommand(args);
+  else if (command_str == "dedup")
+    return DolphinTool::DedupCommand(args);
+  else if (command_str == "trace")
+    return DolphinTool::TraceCommand(args);
+  else if (command_str == "lockstep")
+    return DolphinTool::LockstepCommand(args);
   PrintUsage();
   return EXIT_FAILURE;
 }
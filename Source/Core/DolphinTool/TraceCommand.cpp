@@ -0,0 +1,236 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/TraceCommand.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/GekkoDisassembler.h"
+#include "Common/StringUtil.h"
+#include "Core/Debugger/TraceFile.h"
+
+namespace DolphinTool
+{
+static std::string FormatRecord(u64 index, const TraceFile::Record& record)
+{
+  std::string line =
+      fmt::format("{:>10} {:08x}: {:08x}  {:<32}", index, record.pc, record.instruction,
+                  Common::GekkoDisassembler::Disassemble(record.instruction, record.pc));
+
+  for (const TraceFile::GPRChange& change : record.gprs)
+    line += fmt::format(" r{}={:08x}", change.index, change.value);
+  for (const TraceFile::FPRChange& change : record.fprs)
+    line += fmt::format(" f{}={:016x},{:016x}", change.index, change.ps0, change.ps1);
+  for (const TraceFile::SpecialRegisterChange& change : record.special_registers)
+    line += fmt::format(" {}={:08x}", TraceFile::GetSpecialRegisterName(change.reg), change.value);
+  if (record.memory)
+  {
+    line += fmt::format(" {}{}[{:08x}]={:x}", record.memory->is_store ? "st" : "ld",
+                        record.memory->size * 8, record.memory->address, record.memory->value);
+  }
+
+  return line;
+}
+
+static std::unique_ptr<TraceFile::Reader> OpenTrace(const std::string& path)
+{
+  std::unique_ptr<TraceFile::Reader> reader = TraceFile::Reader::Open(path);
+  if (!reader)
+    fmt::print(std::cerr, "Error: {} could not be opened or is not an instruction trace.\n", path);
+  return reader;
+}
+
+static int TraceDump(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: trace dump [options]... FILE");
+
+  parser.add_option("-s", "--start")
+      .type("long")
+      .action("store")
+      .help("Index of the first instruction to print. Default is 0")
+      .set_default(0);
+
+  parser.add_option("-n", "--count")
+      .type("long")
+      .action("store")
+      .help("Maximum number of instructions to print. Default is all of them")
+      .set_default(-1);
+
+  parser.add_option("-p", "--pc")
+      .type("string")
+      .action("store")
+      .help("Only print the instructions at this ADDRESS")
+      .metavar("ADDRESS");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  const std::vector<std::string>& inputs = parser.args();
+  if (inputs.size() != 1)
+  {
+    fmt::print(std::cerr, "Error: Exactly one input must be set\n");
+    return EXIT_FAILURE;
+  }
+
+  std::optional<u32> pc_filter;
+  if (options.is_set("pc"))
+  {
+    u32 pc;
+    if (!TryParse(options["pc"], &pc))
+    {
+      fmt::print(std::cerr, "Error: {} is not a valid address\n", options["pc"]);
+      return EXIT_FAILURE;
+    }
+    pc_filter = pc;
+  }
+
+  std::unique_ptr<TraceFile::Reader> reader = OpenTrace(inputs[0]);
+  if (!reader)
+    return EXIT_FAILURE;
+
+  const long start = static_cast<long>(options.get("start"));
+  const long count = static_cast<long>(options.get("count"));
+  long printed = 0;
+
+  TraceFile::Record record;
+  for (u64 index = 0; (count < 0 || printed < count) && reader->Read(&record); ++index)
+  {
+    if (static_cast<long>(index) < start || (pc_filter && record.pc != *pc_filter))
+      continue;
+
+    fmt::print(std::cout, "{}\n", FormatRecord(index, record));
+    ++printed;
+  }
+
+  if (reader->HasError())
+  {
+    fmt::print(std::cerr, "Error: {} is corrupt or truncated\n", inputs[0]);
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+static void PrintStateDifferences(const TraceFile::RegisterState& a,
+                                  const TraceFile::RegisterState& b)
+{
+  for (size_t i = 0; i < a.gprs.size(); ++i)
+  {
+    if (a.gprs[i] != b.gprs[i])
+      fmt::print(std::cout, "  r{}: {:08x} != {:08x}\n", i, a.gprs[i], b.gprs[i]);
+  }
+  for (size_t i = 0; i < a.fprs.size(); ++i)
+  {
+    if (a.fprs[i] != b.fprs[i])
+    {
+      fmt::print(std::cout, "  f{}: {:016x},{:016x} != {:016x},{:016x}\n", i, a.fprs[i][0],
+                 a.fprs[i][1], b.fprs[i][0], b.fprs[i][1]);
+    }
+  }
+  for (size_t i = 0; i < a.special_registers.size(); ++i)
+  {
+    if (a.special_registers[i] != b.special_registers[i])
+    {
+      fmt::print(std::cout, "  {}: {:08x} != {:08x}\n",
+                 TraceFile::GetSpecialRegisterName(static_cast<TraceFile::SpecialRegister>(i)),
+                 a.special_registers[i], b.special_registers[i]);
+    }
+  }
+}
+
+static int TraceDiff(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: trace diff FILE_A FILE_B\n\n"
+               "Prints the first instruction after which the two traces differ. Returns 1 if they "
+               "differ, and 0 if they match.");
+
+  parser.parse_args(args);
+
+  const std::vector<std::string>& inputs = parser.args();
+  if (inputs.size() != 2)
+  {
+    fmt::print(std::cerr, "Error: Two inputs must be set\n");
+    return EXIT_FAILURE;
+  }
+
+  std::unique_ptr<TraceFile::Reader> reader_a = OpenTrace(inputs[0]);
+  std::unique_ptr<TraceFile::Reader> reader_b = OpenTrace(inputs[1]);
+  if (!reader_a || !reader_b)
+    return EXIT_FAILURE;
+
+  TraceFile::RegisterState state_a;
+  TraceFile::RegisterState state_b;
+  TraceFile::Record record_a;
+  TraceFile::Record record_b;
+  for (u64 index = 0;; ++index)
+  {
+    const bool has_a = reader_a->Read(&record_a);
+    const bool has_b = reader_b->Read(&record_b);
+    if (reader_a->HasError() || reader_b->HasError())
+    {
+      fmt::print(std::cerr, "Error: {} is corrupt or truncated\n",
+                 reader_a->HasError() ? inputs[0] : inputs[1]);
+      return EXIT_FAILURE;
+    }
+
+    if (!has_a || !has_b)
+    {
+      if (has_a == has_b)
+      {
+        fmt::print(std::cout, "The traces match ({} instructions)\n", index);
+        return EXIT_SUCCESS;
+      }
+
+      fmt::print(std::cout, "{} ends after {} instructions\n", has_a ? inputs[1] : inputs[0],
+                 index);
+      return 1;
+    }
+
+    state_a.Apply(record_a);
+    state_b.Apply(record_b);
+
+    if (record_a.pc == record_b.pc && record_a.instruction == record_b.instruction &&
+        record_a.memory == record_b.memory && state_a == state_b)
+    {
+      continue;
+    }
+
+    fmt::print(std::cout, "The traces differ at instruction {}:\n", index);
+    fmt::print(std::cout, "A: {}\nB: {}\n", FormatRecord(index, record_a),
+               FormatRecord(index, record_b));
+    PrintStateDifferences(state_a, state_b);
+    return 1;
+  }
+}
+
+int TraceCommand(const std::vector<std::string>& args)
+{
+  if (args.empty())
+  {
+    fmt::print(std::cerr, "usage: trace dump|diff [options]... FILE...\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::vector<std::string> sub_args(args.begin() + 1, args.end());
+  if (args[0] == "dump")
+    return TraceDump(sub_args);
+  else if (args[0] == "diff")
+    return TraceDiff(sub_args);
+
+  fmt::print(std::cerr, "usage: trace dump|diff [options]... FILE...\n");
+  return EXIT_FAILURE;
+}
+}  // namespace DolphinTool
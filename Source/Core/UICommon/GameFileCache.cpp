@@ -4,7 +4,9 @@
 #include "UICommon/GameFileCache.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstring>
 #include <functional>
 #include <list>
 #include <memory>
@@ -19,6 +21,7 @@
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/WorkQueueThreadPool.h"
 
 #include "DiscIO/DirectoryBlob.h"
 
@@ -26,19 +29,46 @@
 
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 24;  // Last changed in PR 11557
+static constexpr u32 CACHE_REVISION = 26;
 
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
 {
   static const std::vector<std::string> search_extensions = {
-      ".gcm", ".tgc", ".iso", ".ciso", ".gcz", ".wbfs", ".wia",
-      ".rvz", ".nfs", ".wad", ".dol",  ".elf", ".json"};
+      ".gcm", ".tgc", ".iso", ".ciso", ".gcz",  ".wbfs", ".wia",
+      ".rvz", ".nfs", ".wad", ".dol",  ".elf", ".json", ".dedup"};
 
   // TODO: We could process paths iteratively as they are found
   return Common::DoFileSearch(directories_to_scan, search_extensions, recursive_scan);
 }
 
+struct CacheFileHeader
+{
+  u32 revision;
+  u32 padding;
+  u64 deleted_bytes;
+};
+
+struct CacheRecordHeader
+{
+  u32 size;
+  u32 deleted;
+};
+
+// Opening volumes and checking for changed metadata is mostly spent waiting for I/O, so it is done
+// on a pool of threads that take one game at a time from a shared queue. The work is queued in
+// chunks so that the game list is updated as the scan goes on, and so that the scan can be halted
+// in between.
+constexpr size_t SCAN_CHUNK_SIZE = 64;
+
+template <typename Function>
+static void ForEachChunk(size_t count, const std::atomic_bool& processing_halted,
+                         const Function& function)
+{
+  for (size_t begin = 0; begin < count && !processing_halted; begin += SCAN_CHUNK_SIZE)
+    function(begin, std::min(begin + SCAN_CHUNK_SIZE, count));
+}
+
 GameFileCache::GameFileCache() : m_path(File::GetUserPath(D_CACHE_IDX) + "gamelist.cache")
 {
 }
@@ -60,6 +90,27 @@ void GameFileCache::Clear(DeleteOnDisk delete_on_disk)
     File::Delete(m_path);
 
   m_cached_files.clear();
+  m_record_offsets.clear();
+  m_dirty_paths.clear();
+  m_stale_records.clear();
+  m_needs_rewrite = true;
+}
+
+void GameFileCache::MarkDirty(const std::string& path)
+{
+  m_dirty_paths.insert(path);
+}
+
+void GameFileCache::MarkRemoved(const std::string& path)
+{
+  m_dirty_paths.erase(path);
+
+  const auto it = m_record_offsets.find(path);
+  if (it != m_record_offsets.end())
+  {
+    m_stale_records.push_back(it->second);
+    m_record_offsets.erase(it);
+  }
 }
 
 std::shared_ptr<const GameFile> GameFileCache::AddOrGet(const std::string& path,
@@ -78,7 +129,10 @@ std::shared_ptr<const GameFile> GameFileCache::AddOrGet(const std::string& path,
   }
   std::shared_ptr<GameFile>& result = found ? *it : m_cached_files.back();
   if (UpdateAdditionalMetadata(&result) || !found)
+  {
+    MarkDirty(path);
     *cache_changed = true;
+  }
 
   return result;
 }
@@ -121,6 +175,7 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
         if (game_removed_from_cache)
           game_removed_from_cache((*it)->GetFilePath());
 
+        MarkRemoved((*it)->GetFilePath());
         cache_changed = true;
         --end;
         *it = std::move(*end);
@@ -131,21 +186,34 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
 
   // Now that the previous loop has run, game_paths only contains paths that
   // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const std::string& path : game_paths)
-  {
-    if (processing_halted)
-      break;
+  // Constructing a GameFile means opening the volume and decoding its banner,
+  // so this is done on several threads at once.
+  const std::vector<std::string> new_paths(game_paths.begin(), game_paths.end());
+  std::vector<std::shared_ptr<GameFile>> new_files(new_paths.size());
 
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
+  Common::WorkQueueThreadPool<size_t> scan_pool(
+      "Game List Scan", Common::WorkQueueThreadPool<size_t>::GetDefaultThreadCount(),
+      [&](size_t i) { new_files[i] = std::make_shared<GameFile>(new_paths[i]); });
+
+  ForEachChunk(new_paths.size(), processing_halted, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      scan_pool.Push(i);
+    scan_pool.WaitForCompletion();
+
+    for (size_t i = begin; i < end; ++i)
     {
-      if (game_added_to_cache)
-        game_added_to_cache(file);
+      std::shared_ptr<GameFile>& file = new_files[i];
+      if (file->IsValid())
+      {
+        if (game_added_to_cache)
+          game_added_to_cache(file);
 
-      cache_changed = true;
-      m_cached_files.push_back(std::move(file));
+        MarkDirty(file->GetFilePath());
+        cache_changed = true;
+        m_cached_files.push_back(std::move(file));
+      }
     }
-  }
+  });
 
   return cache_changed;
 }
@@ -155,28 +223,48 @@ bool GameFileCache::UpdateAdditionalMetadata(const GameUpdatedFn& game_updated,
 {
   bool cache_changed = false;
 
-  for (std::shared_ptr<GameFile>& file : m_cached_files)
-  {
-    if (processing_halted)
-      break;
+  std::vector<char> updated(m_cached_files.size());
 
-    const bool updated = UpdateAdditionalMetadata(&file);
-    cache_changed |= updated;
-    if (game_updated && updated)
-      game_updated(file);
-  }
+  Common::WorkQueueThreadPool<size_t> scan_pool(
+      "Game List Scan", Common::WorkQueueThreadPool<size_t>::GetDefaultThreadCount(),
+      [&](size_t i) { updated[i] = CommitMetadataChanges(&m_cached_files[i]); });
+
+  ForEachChunk(m_cached_files.size(), processing_halted, [&](size_t begin, size_t end) {
+    // Covers are downloaded one at a time on this thread, so that the scan threads only ever wait
+    // for local files and the server doesn't get a burst of requests.
+    for (size_t i = begin; i < end; ++i)
+      m_cached_files[i]->DownloadDefaultCover();
+
+    for (size_t i = begin; i < end; ++i)
+      scan_pool.Push(i);
+    scan_pool.WaitForCompletion();
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      if (!updated[i])
+        continue;
+
+      MarkDirty(m_cached_files[i]->GetFilePath());
+      cache_changed = true;
+      if (game_updated)
+        game_updated(m_cached_files[i]);
+    }
+  });
 
   return cache_changed;
 }
 
 bool GameFileCache::UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_file)
+{
+  (*game_file)->DownloadDefaultCover();
+  return CommitMetadataChanges(game_file);
+}
+
+bool GameFileCache::CommitMetadataChanges(std::shared_ptr<GameFile>* game_file)
 {
   const bool xml_metadata_changed = (*game_file)->XMLMetadataChanged();
   const bool wii_banner_changed = (*game_file)->WiiBannerChanged();
   const bool custom_banner_changed = (*game_file)->CustomBannerChanged();
-
-  (*game_file)->DownloadDefaultCover();
-
   const bool default_cover_changed = (*game_file)->DefaultCoverChanged();
   const bool custom_cover_changed = (*game_file)->CustomCoverChanged();
 
@@ -208,79 +296,185 @@ bool GameFileCache::UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_fil
 
 bool GameFileCache::Load()
 {
-  return SyncCacheFile(false);
+  if (LoadCacheFile())
+    return true;
+
+  // If some file operation failed, try to delete the probably-corrupted cache
+  File::Delete(m_path);
+  m_cached_files.clear();
+  m_record_offsets.clear();
+  m_needs_rewrite = true;
+  return false;
 }
 
 bool GameFileCache::Save()
 {
-  return SyncCacheFile(true);
+  if (!m_needs_rewrite && UpdateCacheFile())
+    return true;
+
+  if (RewriteCacheFile())
+    return true;
+
+  File::Delete(m_path);
+  m_needs_rewrite = true;
+  return false;
 }
 
-bool GameFileCache::SyncCacheFile(bool save)
+bool GameFileCache::LoadCacheFile()
 {
-  const char* open_mode = save ? "wb" : "rb";
-  File::IOFile f(m_path, open_mode);
+  File::IOFile f(m_path, "rb");
   if (!f)
     return false;
-  bool success = false;
-  if (save)
-  {
-    // Measure the size of the buffer.
-    u8* ptr = nullptr;
-    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-    DoState(&p_measure);
-    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-
-    // Then actually do the write.
-    std::vector<u8> buffer(buffer_size);
-    ptr = buffer.data();
-    PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-    DoState(&p, buffer_size);
-    if (f.WriteBytes(buffer.data(), buffer.size()))
-      success = true;
-  }
-  else
+
+  std::vector<u8> buffer(f.GetSize());
+  if (buffer.size() < sizeof(CacheFileHeader) || !f.ReadBytes(buffer.data(), buffer.size()))
+    return false;
+
+  CacheFileHeader header;
+  std::memcpy(&header, buffer.data(), sizeof(header));
+  if (header.revision != CACHE_REVISION)
+    return false;
+
+  std::vector<std::shared_ptr<GameFile>> cached_files;
+  std::unordered_map<std::string, u64> record_offsets;
+
+  size_t position = sizeof(CacheFileHeader);
+  while (position < buffer.size())
   {
-    std::vector<u8> buffer(f.GetSize());
-    if (!buffer.empty() && f.ReadBytes(buffer.data(), buffer.size()))
+    CacheRecordHeader record;
+    if (buffer.size() - position < sizeof(record))
+      return false;
+    std::memcpy(&record, buffer.data() + position, sizeof(record));
+
+    const size_t data_position = position + sizeof(record);
+    if (buffer.size() - data_position < record.size)
+      return false;
+
+    if (!record.deleted)
     {
-      u8* ptr = buffer.data();
-      PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
-      DoState(&p, buffer.size());
-      if (p.IsReadMode())
-        success = true;
+      u8* ptr = buffer.data() + data_position;
+      PointerWrap p(&ptr, record.size, PointerWrap::Mode::Read);
+      auto file = std::make_shared<GameFile>();
+      file->DoState(p);
+      if (!p.IsReadMode())
+        return false;
+
+      record_offsets[file->GetFilePath()] = position;
+      cached_files.push_back(std::move(file));
     }
+
+    position = data_position + record.size;
   }
-  if (!success)
+
+  m_cached_files = std::move(cached_files);
+  m_record_offsets = std::move(record_offsets);
+  m_dirty_paths.clear();
+  m_stale_records.clear();
+  m_needs_rewrite = header.deleted_bytes > buffer.size() / 2;
+  return true;
+}
+
+static std::vector<u8> SerializeRecord(GameFile& file)
+{
+  // Measure the size of the buffer.
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  file.DoState(p_measure);
+  const size_t data_size = reinterpret_cast<size_t>(ptr);
+
+  // Then actually do the write.
+  std::vector<u8> buffer(sizeof(CacheRecordHeader) + data_size);
+  const CacheRecordHeader record{static_cast<u32>(data_size), 0};
+  std::memcpy(buffer.data(), &record, sizeof(record));
+  ptr = buffer.data() + sizeof(record);
+  PointerWrap p(&ptr, data_size, PointerWrap::Mode::Write);
+  file.DoState(p);
+
+  return buffer;
+}
+
+bool GameFileCache::RewriteCacheFile()
+{
+  File::IOFile f(m_path, "wb");
+  if (!f)
+    return false;
+
+  const CacheFileHeader header{CACHE_REVISION, 0, 0};
+  if (!f.WriteArray(&header, 1))
+    return false;
+
+  std::unordered_map<std::string, u64> record_offsets;
+  u64 position = sizeof(CacheFileHeader);
+  for (const std::shared_ptr<GameFile>& file : m_cached_files)
   {
-    // If some file operation failed, try to delete the probably-corrupted cache
-    f.Close();
-    File::Delete(m_path);
+    const std::vector<u8> record = SerializeRecord(*file);
+    if (!f.WriteBytes(record.data(), record.size()))
+      return false;
+
+    record_offsets[file->GetFilePath()] = position;
+    position += record.size();
   }
-  return success;
+
+  m_record_offsets = std::move(record_offsets);
+  m_dirty_paths.clear();
+  m_stale_records.clear();
+  m_needs_rewrite = false;
+  return true;
 }
 
-void GameFileCache::DoState(PointerWrap* p, u64 size)
+bool GameFileCache::UpdateCacheFile()
 {
-  struct
-  {
-    u32 revision;
-    u64 expected_size;
-  } header = {CACHE_REVISION, size};
-  p->Do(header);
-  if (p->IsReadMode())
+  File::IOFile f(m_path, "r+b");
+  CacheFileHeader header;
+  if (!f || !f.ReadArray(&header, 1) || header.revision != CACHE_REVISION)
+    return false;
+
+  // Entries that are going to be appended again make their old records stale
+  for (const std::string& path : m_dirty_paths)
   {
-    if (header.revision != CACHE_REVISION || header.expected_size != size)
+    const auto it = m_record_offsets.find(path);
+    if (it != m_record_offsets.end())
     {
-      p->SetMeasureMode();
-      return;
+      m_stale_records.push_back(it->second);
+      m_record_offsets.erase(it);
     }
   }
-  p->DoEachElement(m_cached_files, [](PointerWrap& state, std::shared_ptr<GameFile>& elem) {
-    if (state.IsReadMode())
-      elem = std::make_shared<GameFile>();
-    elem->DoState(state);
-  });
+
+  for (const u64 offset : m_stale_records)
+  {
+    CacheRecordHeader record;
+    if (!f.Seek(offset, File::SeekOrigin::Begin) || !f.ReadArray(&record, 1))
+      return false;
+
+    record.deleted = 1;
+    if (!f.Seek(offset, File::SeekOrigin::Begin) || !f.WriteArray(&record, 1))
+      return false;
+
+    header.deleted_bytes += sizeof(record) + record.size;
+  }
+  m_stale_records.clear();
+
+  u64 position = f.GetSize();
+  for (const std::shared_ptr<GameFile>& file : m_cached_files)
+  {
+    if (!m_dirty_paths.contains(file->GetFilePath()))
+      continue;
+
+    const std::vector<u8> record = SerializeRecord(*file);
+    if (!f.Seek(position, File::SeekOrigin::Begin) || !f.WriteBytes(record.data(), record.size()))
+      return false;
+
+    m_record_offsets[file->GetFilePath()] = position;
+    position += record.size();
+  }
+  m_dirty_paths.clear();
+
+  if (!f.Seek(0, File::SeekOrigin::Begin) || !f.WriteArray(&header, 1))
+    return false;
+
+  // Compact the file on the next save once it's mostly made up of deleted records
+  m_needs_rewrite = header.deleted_bytes > position / 2;
+  return true;
 }
 
 }  // namespace UICommon
@@ -9,12 +9,12 @@
 #include <memory>
 #include <span>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 
-class PointerWrap;
-
 namespace UICommon
 {
 class GameFile;
@@ -59,12 +59,27 @@ public:
 
 private:
   bool UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_file);
+  // Like UpdateAdditionalMetadata, but doesn't download anything, only reads local files.
+  bool CommitMetadataChanges(std::shared_ptr<GameFile>* game_file);
+
+  // Marks the entry for path as needing to be written by the next Save call.
+  void MarkDirty(const std::string& path);
+  void MarkRemoved(const std::string& path);
 
-  bool SyncCacheFile(bool save);
-  void DoState(PointerWrap* p, u64 size = 0);
+  bool LoadCacheFile();
+  bool RewriteCacheFile();
+  bool UpdateCacheFile();
 
   std::string m_path;
   std::vector<std::shared_ptr<GameFile>> m_cached_files;
+
+  // The cache file is a sequence of records, one per game. Changed games are appended as new
+  // records and their old records are marked as deleted, so saving only writes what changed.
+  // The file is rewritten from scratch once deleted records take up too much of it.
+  std::unordered_map<std::string, u64> m_record_offsets;
+  std::unordered_set<std::string> m_dirty_paths;
+  std::vector<u64> m_stale_records;
+  bool m_needs_rewrite = true;
 };
 
 }  // namespace UICommon
@@ -0,0 +1,272 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/FrameDumpConvert.h"
+
+#include <algorithm>
+#include <thread>
+
+#include <fmt/format.h>
+
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#define USE_SSE
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#define USE_NEON
+#endif
+
+namespace
+{
+// Each SIMD iteration converts 16 pixels of two rows.
+constexpr int SIMD_WIDTH = 16;
+
+u8 RGBToY(int r, int g, int b)
+{
+  return static_cast<u8>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+}
+
+u8 RGBToU(int r, int g, int b)
+{
+  return static_cast<u8>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+}
+
+u8 RGBToV(int r, int g, int b)
+{
+  return static_cast<u8>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+}
+
+// Converts the 2x2 blocks starting at columns [first_x, width) of the row pair starting at row.
+void ConvertRowPairGeneric(const u8* rgba, int width, int height, int stride,
+                           const YUV420Planes& out, int row, int first_x)
+{
+  const u8* const row0 = rgba + static_cast<size_t>(row) * stride;
+  const u8* const row1 = row + 1 < height ? row0 + stride : row0;
+  u8* const y0 = out.y + static_cast<size_t>(row) * out.y_stride;
+  u8* const y1 = y0 + out.y_stride;
+  u8* const u = out.u + static_cast<size_t>(row / 2) * out.u_stride;
+  u8* const v = out.v + static_cast<size_t>(row / 2) * out.v_stride;
+
+  for (int x = first_x; x < width; x += 2)
+  {
+    const int x1 = std::min(x + 1, width - 1);
+    const u8* const p[4] = {row0 + x * 4, row0 + x1 * 4, row1 + x * 4, row1 + x1 * 4};
+
+    y0[x] = RGBToY(p[0][0], p[0][1], p[0][2]);
+    if (x + 1 < width)
+      y0[x + 1] = RGBToY(p[1][0], p[1][1], p[1][2]);
+    if (row + 1 < height)
+    {
+      y1[x] = RGBToY(p[2][0], p[2][1], p[2][2]);
+      if (x + 1 < width)
+        y1[x + 1] = RGBToY(p[3][0], p[3][1], p[3][2]);
+    }
+
+    const int r = (p[0][0] + p[1][0] + p[2][0] + p[3][0] + 2) >> 2;
+    const int g = (p[0][1] + p[1][1] + p[2][1] + p[3][1] + 2) >> 2;
+    const int b = (p[0][2] + p[1][2] + p[2][2] + p[3][2] + 2) >> 2;
+    u[x / 2] = RGBToU(r, g, b);
+    v[x / 2] = RGBToV(r, g, b);
+  }
+}
+
+#if defined(USE_SSE)
+
+// Splits 8 RGBA pixels into 16-bit R, G and B lanes.
+void Deinterleave8(const u8* src, __m128i* r, __m128i* g, __m128i* b)
+{
+  const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+  const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+  const __m128i mask = _mm_set1_epi32(0xFF);
+  *r = _mm_packs_epi32(_mm_and_si128(lo, mask), _mm_and_si128(hi, mask));
+  *g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(lo, 8), mask),
+                       _mm_and_si128(_mm_srli_epi32(hi, 8), mask));
+  *b = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(lo, 16), mask),
+                       _mm_and_si128(_mm_srli_epi32(hi, 16), mask));
+}
+
+// The sum is at most 56228, so it can be computed with wrapping 16-bit math.
+__m128i LumaSSE(__m128i r, __m128i g, __m128i b)
+{
+  __m128i sum = _mm_mullo_epi16(r, _mm_set1_epi16(66));
+  sum = _mm_add_epi16(sum, _mm_mullo_epi16(g, _mm_set1_epi16(129)));
+  sum = _mm_add_epi16(sum, _mm_mullo_epi16(b, _mm_set1_epi16(25)));
+  sum = _mm_add_epi16(sum, _mm_set1_epi16(128));
+  return _mm_add_epi16(_mm_srli_epi16(sum, 8), _mm_set1_epi16(16));
+}
+
+// Chroma sums stay within [-28560, 28688], so signed 16-bit math is enough.
+__m128i ChromaSSE(__m128i r, __m128i g, __m128i b, s16 cr, s16 cg, s16 cb)
+{
+  __m128i sum = _mm_mullo_epi16(r, _mm_set1_epi16(cr));
+  sum = _mm_add_epi16(sum, _mm_mullo_epi16(g, _mm_set1_epi16(cg)));
+  sum = _mm_add_epi16(sum, _mm_mullo_epi16(b, _mm_set1_epi16(cb)));
+  sum = _mm_add_epi16(sum, _mm_set1_epi16(128));
+  return _mm_add_epi16(_mm_srai_epi16(sum, 8), _mm_set1_epi16(128));
+}
+
+// Sums horizontal pairs of two rows of 8 values, giving 4 sums of 2x2 blocks in 32-bit lanes.
+__m128i BlockSums(__m128i row0, __m128i row1)
+{
+  return _mm_madd_epi16(_mm_add_epi16(row0, row1), _mm_set1_epi16(1));
+}
+
+void ConvertRowPairSIMD(const u8* rgba, int stride, const YUV420Planes& out, int row, int width)
+{
+  const u8* const row0 = rgba + static_cast<size_t>(row) * stride;
+  const u8* const row1 = row0 + stride;
+  u8* const y0 = out.y + static_cast<size_t>(row) * out.y_stride;
+  u8* const y1 = y0 + out.y_stride;
+  u8* const u = out.u + static_cast<size_t>(row / 2) * out.u_stride;
+  u8* const v = out.v + static_cast<size_t>(row / 2) * out.v_stride;
+
+  for (int x = 0; x + SIMD_WIDTH <= width; x += SIMD_WIDTH)
+  {
+    __m128i r[4], g[4], b[4];
+    Deinterleave8(row0 + x * 4, &r[0], &g[0], &b[0]);
+    Deinterleave8(row0 + x * 4 + 32, &r[1], &g[1], &b[1]);
+    Deinterleave8(row1 + x * 4, &r[2], &g[2], &b[2]);
+    Deinterleave8(row1 + x * 4 + 32, &r[3], &g[3], &b[3]);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(y0 + x),
+                     _mm_packus_epi16(LumaSSE(r[0], g[0], b[0]), LumaSSE(r[1], g[1], b[1])));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(y1 + x),
+                     _mm_packus_epi16(LumaSSE(r[2], g[2], b[2]), LumaSSE(r[3], g[3], b[3])));
+
+    const __m128i round = _mm_set1_epi16(2);
+    const auto average = [&round](__m128i* c) {
+      const __m128i sums = _mm_packs_epi32(BlockSums(c[0], c[2]), BlockSums(c[1], c[3]));
+      return _mm_srli_epi16(_mm_add_epi16(sums, round), 2);
+    };
+    const __m128i ar = average(r);
+    const __m128i ag = average(g);
+    const __m128i ab = average(b);
+
+    const __m128i cu = ChromaSSE(ar, ag, ab, -38, -74, 112);
+    const __m128i cv = ChromaSSE(ar, ag, ab, 112, -94, -18);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(u + x / 2), _mm_packus_epi16(cu, cu));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(v + x / 2), _mm_packus_epi16(cv, cv));
+  }
+}
+
+#elif defined(USE_NEON)
+
+uint8x8_t LumaNEON(uint8x8_t r, uint8x8_t g, uint8x8_t b)
+{
+  uint16x8_t sum = vmull_u8(r, vdup_n_u8(66));
+  sum = vmlal_u8(sum, g, vdup_n_u8(129));
+  sum = vmlal_u8(sum, b, vdup_n_u8(25));
+  sum = vaddq_u16(sum, vdupq_n_u16(128));
+  return vadd_u8(vshrn_n_u16(sum, 8), vdup_n_u8(16));
+}
+
+uint8x8_t ChromaNEON(int16x8_t r, int16x8_t g, int16x8_t b, s16 cr, s16 cg, s16 cb)
+{
+  int16x8_t sum = vmulq_n_s16(r, cr);
+  sum = vmlaq_n_s16(sum, g, cg);
+  sum = vmlaq_n_s16(sum, b, cb);
+  sum = vaddq_s16(sum, vdupq_n_s16(128));
+  return vqmovun_s16(vaddq_s16(vshrq_n_s16(sum, 8), vdupq_n_s16(128)));
+}
+
+int16x8_t AverageNEON(uint8x16_t row0, uint8x16_t row1)
+{
+  const uint16x8_t sums = vaddq_u16(vpaddlq_u8(row0), vpaddlq_u8(row1));
+  return vreinterpretq_s16_u16(vrshrq_n_u16(sums, 2));
+}
+
+void ConvertRowPairSIMD(const u8* rgba, int stride, const YUV420Planes& out, int row, int width)
+{
+  const u8* const row0 = rgba + static_cast<size_t>(row) * stride;
+  const u8* const row1 = row0 + stride;
+  u8* const y0 = out.y + static_cast<size_t>(row) * out.y_stride;
+  u8* const y1 = y0 + out.y_stride;
+  u8* const u = out.u + static_cast<size_t>(row / 2) * out.u_stride;
+  u8* const v = out.v + static_cast<size_t>(row / 2) * out.v_stride;
+
+  for (int x = 0; x + SIMD_WIDTH <= width; x += SIMD_WIDTH)
+  {
+    const uint8x16x4_t p0 = vld4q_u8(row0 + x * 4);
+    const uint8x16x4_t p1 = vld4q_u8(row1 + x * 4);
+
+    vst1q_u8(y0 + x, vcombine_u8(LumaNEON(vget_low_u8(p0.val[0]), vget_low_u8(p0.val[1]),
+                                          vget_low_u8(p0.val[2])),
+                                 LumaNEON(vget_high_u8(p0.val[0]), vget_high_u8(p0.val[1]),
+                                          vget_high_u8(p0.val[2]))));
+    vst1q_u8(y1 + x, vcombine_u8(LumaNEON(vget_low_u8(p1.val[0]), vget_low_u8(p1.val[1]),
+                                          vget_low_u8(p1.val[2])),
+                                 LumaNEON(vget_high_u8(p1.val[0]), vget_high_u8(p1.val[1]),
+                                          vget_high_u8(p1.val[2]))));
+
+    const int16x8_t r = AverageNEON(p0.val[0], p1.val[0]);
+    const int16x8_t g = AverageNEON(p0.val[1], p1.val[1]);
+    const int16x8_t b = AverageNEON(p0.val[2], p1.val[2]);
+    vst1_u8(u + x / 2, ChromaNEON(r, g, b, -38, -74, 112));
+    vst1_u8(v + x / 2, ChromaNEON(r, g, b, 112, -94, -18));
+  }
+}
+
+#endif
+}  // namespace
+
+void ConvertRGBAToYUV420(const u8* rgba, int width, int height, int stride,
+                         const YUV420Planes& out, int first_row, int end_row)
+{
+  for (int row = first_row; row < end_row; row += 2)
+  {
+    int x = 0;
+#if defined(USE_SSE) || defined(USE_NEON)
+    if (row + 1 < height)
+    {
+      ConvertRowPairSIMD(rgba, stride, out, row, width);
+      x = width / SIMD_WIDTH * SIMD_WIDTH;
+    }
+#endif
+    ConvertRowPairGeneric(rgba, width, height, stride, out, row, x);
+  }
+}
+
+FrameDumpConverter::FrameDumpConverter(size_t worker_count)
+{
+  m_workers.reserve(worker_count);
+  for (size_t i = 0; i < worker_count; ++i)
+  {
+    m_workers.push_back(std::make_unique<Common::WorkQueueThread<Job>>(
+        fmt::format("Frame Dump Convert {}", i + 1), [](const Job& job) {
+          ConvertRGBAToYUV420(job.rgba, job.width, job.height, job.stride, job.out,
+                              job.first_row, job.end_row);
+        }));
+  }
+}
+
+FrameDumpConverter::~FrameDumpConverter() = default;
+
+void FrameDumpConverter::ConvertToYUV420(const u8* rgba, int width, int height, int stride,
+                                         const YUV420Planes& out)
+{
+  // Split by row pairs, since each pair shares a row of chroma.
+  const size_t pairs = static_cast<size_t>(height + 1) / 2;
+  const size_t thread_count = m_workers.size() + 1;
+  const auto range_begin = [&](size_t thread) {
+    return static_cast<int>(std::min<size_t>(pairs * thread / thread_count * 2, height));
+  };
+
+  for (size_t i = 0; i < m_workers.size(); ++i)
+  {
+    const int first_row = range_begin(i + 1);
+    const int end_row = range_begin(i + 2);
+    if (first_row != end_row)
+      m_workers[i]->Push(Job{rgba, width, height, stride, out, first_row, end_row});
+  }
+
+  ConvertRGBAToYUV420(rgba, width, height, stride, out, 0, range_begin(1));
+
+  for (auto& worker : m_workers)
+    worker->WaitForCompletion();
+}
+
+size_t FrameDumpConverter::GetDefaultWorkerCount()
+{
+  const size_t threads = std::thread::hardware_concurrency();
+  return std::clamp<size_t>(threads / 2, 1, 4) - 1;
+}
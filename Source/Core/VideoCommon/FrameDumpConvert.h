@@ -0,0 +1,61 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
+
+// Destination for a planar YUV 4:2:0 image. The chroma planes are half the width and height of
+// the luma plane, rounded up.
+struct YUV420Planes
+{
+  u8* y = nullptr;
+  u8* u = nullptr;
+  u8* v = nullptr;
+  int y_stride = 0;
+  int u_stride = 0;
+  int v_stride = 0;
+};
+
+// Converts rows [first_row, end_row) of an RGBA8 image to YUV 4:2:0, using the BT.601 matrix
+// with limited range (the same as what swscale produces for yuv420p by default). first_row must be
+// even, and end_row must either be even or equal to height. Chroma is the rounded average of each
+// 2x2 block, with the last row and column repeated for odd sizes.
+void ConvertRGBAToYUV420(const u8* rgba, int width, int height, int stride,
+                         const YUV420Planes& out, int first_row, int end_row);
+
+// Converts whole frames, splitting the rows across a few worker threads.
+class FrameDumpConverter
+{
+public:
+  // worker_count threads are started in addition to the thread calling ConvertToYUV420.
+  explicit FrameDumpConverter(size_t worker_count);
+  ~FrameDumpConverter();
+
+  FrameDumpConverter(const FrameDumpConverter&) = delete;
+  FrameDumpConverter& operator=(const FrameDumpConverter&) = delete;
+
+  void ConvertToYUV420(const u8* rgba, int width, int height, int stride, const YUV420Planes& out);
+
+  // A worker count that leaves cores free for emulation and the encoder.
+  static size_t GetDefaultWorkerCount();
+
+private:
+  struct Job
+  {
+    const u8* rgba;
+    int width;
+    int height;
+    int stride;
+    YUV420Planes out;
+    int first_row;
+    int end_row;
+  };
+
+  std::vector<std::unique_ptr<Common::WorkQueueThread<Job>>> m_workers;
+};
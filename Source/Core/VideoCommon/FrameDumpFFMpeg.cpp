@@ -8,8 +8,11 @@
 #endif
 
 #include <array>
+#include <condition_variable>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
@@ -31,6 +34,7 @@ extern "C" {
 #include "Common/Logging/LogManager.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
+#include "Common/WorkQueueThread.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
@@ -38,6 +42,7 @@ extern "C" {
 #include "Core/HW/VideoInterface.h"
 #include "Core/System.h"
 
+#include "VideoCommon/FrameDumpConvert.h"
 #include "VideoCommon/FrameDumper.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
@@ -48,9 +53,19 @@ struct FrameDumpContext
   AVStream* stream = nullptr;
   AVCodecContext* codec = nullptr;
   AVFrame* src_frame = nullptr;
-  AVFrame* scaled_frame = nullptr;
   SwsContext* sws = nullptr;
 
+  // Frames in the codec's pixel format. They are filled on the frame dumping thread, and then
+  // handed to the encoder thread, which puts them back on the free list once they're sent.
+  std::vector<AVFrame*> scaled_frames;
+  std::vector<AVFrame*> free_scaled_frames;
+  std::mutex free_scaled_frames_lock;
+  std::condition_variable free_scaled_frames_cv;
+  Common::WorkQueueThread<AVFrame*> encode_thread;
+
+  // Used instead of swscale for the common case of RGBA to yuv420p without scaling.
+  std::unique_ptr<FrameDumpConverter> converter;
+
   s64 last_pts = AV_NOPTS_VALUE;
 
   int width = 0;
@@ -64,6 +79,9 @@ struct FrameDumpContext
 
 namespace
 {
+// How many converted frames can be waiting for the encoder before conversion has to wait.
+constexpr size_t ENCODE_QUEUE_SIZE = 3;
+
 AVRational GetTimeBaseForCurrentRefreshRate()
 {
   auto& vi = Core::System::GetInstance().GetVideoInterface();
@@ -300,14 +318,28 @@ bool FFMpegFrameDump::CreateVideoFile()
   }
 
   m_context->src_frame = av_frame_alloc();
-  m_context->scaled_frame = av_frame_alloc();
 
-  m_context->scaled_frame->format = m_context->codec->pix_fmt;
-  m_context->scaled_frame->width = m_context->width;
-  m_context->scaled_frame->height = m_context->height;
+  for (size_t i = 0; i < ENCODE_QUEUE_SIZE; ++i)
+  {
+    AVFrame* const scaled_frame = av_frame_alloc();
+    if (!scaled_frame)
+      return false;
+    m_context->scaled_frames.push_back(scaled_frame);
+
+    scaled_frame->format = m_context->codec->pix_fmt;
+    scaled_frame->width = m_context->width;
+    scaled_frame->height = m_context->height;
 
-  if (av_frame_get_buffer(m_context->scaled_frame, 1))
-    return false;
+    if (av_frame_get_buffer(scaled_frame, 1))
+      return false;
+  }
+  m_context->free_scaled_frames = m_context->scaled_frames;
+
+  if (m_context->codec->pix_fmt == AV_PIX_FMT_YUV420P)
+  {
+    m_context->converter =
+        std::make_unique<FrameDumpConverter>(FrameDumpConverter::GetDefaultWorkerCount());
+  }
 
   m_context->stream = avformat_new_stream(m_context->format, codec);
   if (!m_context->stream ||
@@ -333,6 +365,17 @@ bool FFMpegFrameDump::CreateVideoFile()
                  m_context->stream->time_base.num);
   }
 
+  m_context->encode_thread.Reset("Frame Dump Encoder", [this](AVFrame* scaled_frame) {
+    if (const int error = avcodec_send_frame(m_context->codec, scaled_frame))
+      ERROR_LOG_FMT(FRAMEDUMP, "Error while encoding video: {}", AVErrorString(error));
+    else
+      ProcessPackets();
+
+    std::lock_guard lk(m_context->free_scaled_frames_lock);
+    m_context->free_scaled_frames.push_back(scaled_frame);
+    m_context->free_scaled_frames_cv.notify_one();
+  });
+
   OSD::AddMessage(fmt::format("Dumping Frames to \"{}\" ({}x{})", dump_path, m_context->width,
                               m_context->height));
   return true;
@@ -375,34 +418,60 @@ void FFMpegFrameDump::AddFrame(const FrameData& frame)
     }
   }
 
-  constexpr AVPixelFormat pix_fmt = AV_PIX_FMT_RGBA;
-
-  m_context->src_frame->data[0] = const_cast<u8*>(frame.data);
-  m_context->src_frame->linesize[0] = frame.stride;
-  m_context->src_frame->format = pix_fmt;
-  m_context->src_frame->width = m_context->width;
-  m_context->src_frame->height = m_context->height;
-
-  // Convert image from RGBA to desired pixel format.
-  m_context->sws = sws_getCachedContext(
-      m_context->sws, frame.width, frame.height, pix_fmt, m_context->width, m_context->height,
-      m_context->codec->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
-  if (m_context->sws)
+  // Wait for the encoder to give back a frame to convert into.
+  AVFrame* scaled_frame;
   {
-    sws_scale(m_context->sws, m_context->src_frame->data, m_context->src_frame->linesize, 0,
-              frame.height, m_context->scaled_frame->data, m_context->scaled_frame->linesize);
+    std::unique_lock lk(m_context->free_scaled_frames_lock);
+    m_context->free_scaled_frames_cv.wait(
+        lk, [this] { return !m_context->free_scaled_frames.empty(); });
+    scaled_frame = m_context->free_scaled_frames.back();
+    m_context->free_scaled_frames.pop_back();
   }
 
-  m_context->last_pts = pts;
-  m_context->scaled_frame->pts = pts;
-
-  if (const int error = avcodec_send_frame(m_context->codec, m_context->scaled_frame))
+  // The encoder may still hold a reference to the frame's buffers.
+  if (const int error = av_frame_make_writable(scaled_frame))
   {
-    ERROR_LOG_FMT(FRAMEDUMP, "Error while encoding video: {}", AVErrorString(error));
+    ERROR_LOG_FMT(FRAMEDUMP, "Could not make frame writable: {}", AVErrorString(error));
+    std::lock_guard lk(m_context->free_scaled_frames_lock);
+    m_context->free_scaled_frames.push_back(scaled_frame);
     return;
   }
 
-  ProcessPackets();
+  if (m_context->converter && frame.width == m_context->width &&
+      frame.height == m_context->height)
+  {
+    const YUV420Planes planes{scaled_frame->data[0],     scaled_frame->data[1],
+                              scaled_frame->data[2],     scaled_frame->linesize[0],
+                              scaled_frame->linesize[1], scaled_frame->linesize[2]};
+    m_context->converter->ConvertToYUV420(frame.data, frame.width, frame.height, frame.stride,
+                                          planes);
+  }
+  else
+  {
+    constexpr AVPixelFormat pix_fmt = AV_PIX_FMT_RGBA;
+
+    m_context->src_frame->data[0] = const_cast<u8*>(frame.data);
+    m_context->src_frame->linesize[0] = frame.stride;
+    m_context->src_frame->format = pix_fmt;
+    m_context->src_frame->width = m_context->width;
+    m_context->src_frame->height = m_context->height;
+
+    // Convert image from RGBA to desired pixel format.
+    m_context->sws = sws_getCachedContext(
+        m_context->sws, frame.width, frame.height, pix_fmt, m_context->width, m_context->height,
+        m_context->codec->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
+    if (m_context->sws)
+    {
+      sws_scale(m_context->sws, m_context->src_frame->data, m_context->src_frame->linesize, 0,
+                frame.height, scaled_frame->data, scaled_frame->linesize);
+    }
+  }
+
+  m_context->last_pts = pts;
+  scaled_frame->pts = pts;
+
+  // The source frame isn't needed anymore, so encoding can overlap with the next frame.
+  m_context->encode_thread.Push(scaled_frame);
 }
 
 void FFMpegFrameDump::ProcessPackets()
@@ -448,6 +517,9 @@ void FFMpegFrameDump::Stop()
   if (!IsStarted())
     return;
 
+  // Let the encoder thread finish the frames it has been given.
+  m_context->encode_thread.WaitForCompletion();
+
   // Signal end of stream to encoder.
   if (const int flush_error = avcodec_send_frame(m_context->codec, nullptr))
     WARN_LOG_FMT(FRAMEDUMP, "Error sending flush packet: {}", AVErrorString(flush_error));
@@ -467,8 +539,11 @@ bool FFMpegFrameDump::IsStarted() const
 
 void FFMpegFrameDump::CloseVideoFile()
 {
+  m_context->encode_thread.Shutdown();
+
   av_frame_free(&m_context->src_frame);
-  av_frame_free(&m_context->scaled_frame);
+  for (AVFrame*& scaled_frame : m_context->scaled_frames)
+    av_frame_free(&scaled_frame);
 
   avcodec_free_context(&m_context->codec);
 
@@ -58,13 +58,34 @@ void FrameDumper::DumpCurrentFrame(const AbstractTexture* src_texture,
     copy_rect = src_texture->GetRect();
   }
 
-  if (!CheckFrameDumpReadbackTexture(target_width, target_height))
+  ReclaimReadbacks();
+
+  // Every readback texture is in use, so the frame dump thread has fallen behind.
+  if (m_frames_copied - m_frames_reclaimed == READBACK_RING_SIZE)
+  {
+    if (Config::Get(Config::GFX_DUMP_FRAMES_DROP_WHEN_BEHIND))
+    {
+      m_frames_dropped++;
+      return;
+    }
+
+    const auto wait_start = std::chrono::steady_clock::now();
+    QueueReadbacks(m_frames_copied);
+    while (m_frames_copied - m_frames_reclaimed == READBACK_RING_SIZE)
+    {
+      m_frame_dump_done.Wait();
+      ReclaimReadbacks();
+    }
+    m_time_waited += std::chrono::steady_clock::now() - wait_start;
+  }
+
+  Readback& readback = m_readbacks[m_frames_copied % READBACK_RING_SIZE];
+  if (!CheckFrameDumpReadbackTexture(readback.texture, target_width, target_height))
     return;
 
-  m_frame_dump_readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0,
-                                                 m_frame_dump_readback_texture->GetRect());
-  m_last_frame_state = m_ffmpeg_dump.FetchState(ticks, frame_number);
-  m_frame_dump_needs_flush = true;
+  readback.texture->CopyFromTexture(src_texture, copy_rect, 0, 0, readback.texture->GetRect());
+  readback.state = m_ffmpeg_dump.FetchState(ticks, frame_number);
+  m_frames_copied++;
 }
 
 bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
@@ -95,9 +116,9 @@ bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_heigh
   return true;
 }
 
-bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height)
+bool FrameDumper::CheckFrameDumpReadbackTexture(std::unique_ptr<AbstractStagingTexture>& rbtex,
+                                                 u32 target_width, u32 target_height)
 {
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_texture;
   if (rbtex && rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
     return true;
 
@@ -114,60 +135,88 @@ bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_hei
 
 void FrameDumper::FlushFrameDump()
 {
-  if (!m_frame_dump_needs_flush)
-    return;
+  // Leave the readbacks started during this frame in flight until the next one.
+  QueueReadbacks(m_frames_copied_before_flush);
+  m_frames_copied_before_flush = m_frames_copied;
 
-  // Ensure dumping thread is done with output texture before swapping.
-  FinishFrameData();
+  ReclaimReadbacks();
 
-  std::swap(m_frame_dump_output_texture, m_frame_dump_readback_texture);
+  // Shutdown frame dumping if it is no longer active.
+  if (!IsFrameDumping())
+    ShutdownFrameDumping();
+}
 
-  // Queue encoding of the last frame dumped.
-  auto& output = m_frame_dump_output_texture;
-  output->Flush();
-  if (output->Map())
-  {
-    DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), output->GetConfig().width,
-                  output->GetConfig().height, static_cast<int>(output->GetMappedStride()));
-  }
-  else
+void FrameDumper::QueueReadbacks(u64 end)
+{
+  for (; m_frames_queued < end; m_frames_queued++)
   {
-    ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
+    Readback& readback = m_readbacks[m_frames_queued % READBACK_RING_SIZE];
+    AbstractStagingTexture* const texture = readback.texture.get();
+    texture->Flush();
+    if (texture->Map())
+    {
+      DumpFrameData(FrameData{reinterpret_cast<const u8*>(texture->GetMappedPointer()),
+                              static_cast<int>(texture->GetConfig().width),
+                              static_cast<int>(texture->GetConfig().height),
+                              static_cast<int>(texture->GetMappedStride()), readback.state});
+    }
+    else
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
+      // Still send the frame, so that it is released in order.
+      DumpFrameData(FrameData{nullptr, 0, 0, 0, readback.state});
+    }
   }
+}
 
-  m_frame_dump_needs_flush = false;
-
-  // Shutdown frame dumping if it is no longer active.
-  if (!IsFrameDumping())
-    ShutdownFrameDumping();
+void FrameDumper::ReclaimReadbacks()
+{
+  const u64 released = m_frames_released.load(std::memory_order_acquire);
+  for (; m_frames_reclaimed < released; m_frames_reclaimed++)
+    m_readbacks[m_frames_reclaimed % READBACK_RING_SIZE].texture->Unmap();
 }
 
 void FrameDumper::ShutdownFrameDumping()
 {
-  // Ensure the last queued readback has been sent to the encoder.
-  FlushFrameDump();
+  // Ensure all readbacks have been sent to the encoder.
+  QueueReadbacks(m_frames_copied);
+  m_frames_copied_before_flush = m_frames_copied;
 
   if (!m_frame_dump_thread_running.IsSet())
     return;
 
-  // Ensure previous frame has been encoded.
-  FinishFrameData();
-
-  // Wake thread up, and wait for it to exit.
+  // Wake thread up, and wait for it to finish the queued frames and exit.
   m_frame_dump_thread_running.Clear();
   m_frame_dump_start.Set();
   if (m_frame_dump_thread.joinable())
     m_frame_dump_thread.join();
+  ReclaimReadbacks();
+
   m_frame_dump_render_framebuffer.reset();
   m_frame_dump_render_texture.reset();
 
-  m_frame_dump_readback_texture.reset();
-  m_frame_dump_output_texture.reset();
+  for (Readback& readback : m_readbacks)
+    readback.texture.reset();
+
+  if (m_frames_dropped != 0 || m_time_waited != std::chrono::steady_clock::duration::zero())
+  {
+    const auto waited_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(m_time_waited).count();
+    NOTICE_LOG_FMT(VIDEO, "Frame dump: {} frames dropped, waited {} ms for the encoder.",
+                   m_frames_dropped, waited_ms);
+    if (m_frames_dropped != 0)
+    {
+      OSD::AddMessage(fmt::format("Frame dump fell behind, {} frames were dropped.",
+                                  m_frames_dropped));
+    }
+  }
+  m_frames_dropped = 0;
+  m_time_waited = {};
 }
 
-void FrameDumper::DumpFrameData(const u8* data, int w, int h, int stride)
+void FrameDumper::DumpFrameData(const FrameData& frame)
 {
-  m_frame_dump_data = FrameData{data, w, h, stride, m_last_frame_state};
+  m_frame_dump_queue.Push(frame);
 
   if (!m_frame_dump_thread_running.IsSet())
   {
@@ -179,18 +228,6 @@ void FrameDumper::DumpFrameData(const u8* data, int w, int h, int stride)
 
   // Wake worker thread up.
   m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
-}
-
-void FrameDumper::FinishFrameData()
-{
-  if (!m_frame_dump_frame_running)
-    return;
-
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
-
-  m_frame_dump_output_texture->Unmap();
 }
 
 void FrameDumper::FrameDumpThreadFunc()
@@ -213,49 +250,23 @@ void FrameDumper::FrameDumpThreadFunc()
   while (true)
   {
     m_frame_dump_start.Wait();
-    if (!m_frame_dump_thread_running.IsSet())
-      break;
 
-    auto frame = m_frame_dump_data;
+    // Frames that were queued before shutting down are still processed.
+    const bool running = m_frame_dump_thread_running.IsSet();
 
-    // Save screenshot
-    if (m_screenshot_request.TestAndClear())
+    FrameData frame;
+    while (m_frame_dump_queue.Pop(frame))
     {
-      std::lock_guard<std::mutex> lk(m_screenshot_lock);
-
-      if (DumpFrameToPNG(frame, m_screenshot_name))
-        OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
-
-      // Reset settings
-      m_screenshot_name.clear();
-      m_screenshot_completed.Set();
-    }
+      ProcessFrame(frame, dump_to_ffmpeg, &frame_dump_started);
 
-    if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
-    {
-      if (!frame_dump_started)
-      {
-        if (dump_to_ffmpeg)
-          frame_dump_started = StartFrameDumpToFFMPEG(frame);
-        else
-          frame_dump_started = StartFrameDumpToImage(frame);
-
-        // Stop frame dumping if we fail to start.
-        if (!frame_dump_started)
-          Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
-      }
-
-      // If we failed to start frame dumping, don't write a frame.
-      if (frame_dump_started)
-      {
-        if (dump_to_ffmpeg)
-          DumpFrameToFFMPEG(frame);
-        else
-          DumpFrameToImage(frame);
-      }
+      // The readback texture can be reused now. For FFmpeg, the frame has been converted, but
+      // the encoder can still be working on it.
+      m_frames_released.fetch_add(1, std::memory_order_release);
+      m_frame_dump_done.Set();
     }
 
-    m_frame_dump_done.Set();
+    if (!running)
+      break;
   }
 
   if (frame_dump_started)
@@ -266,6 +277,51 @@ void FrameDumper::FrameDumpThreadFunc()
   }
 }
 
+void FrameDumper::ProcessFrame(const FrameData& frame, bool dump_to_ffmpeg,
+                               bool* frame_dump_started)
+{
+  // Mapping the readback texture failed.
+  if (!frame.data)
+    return;
+
+  // Save screenshot
+  if (m_screenshot_request.TestAndClear())
+  {
+    std::lock_guard<std::mutex> lk(m_screenshot_lock);
+
+    if (DumpFrameToPNG(frame, m_screenshot_name))
+      OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
+
+    // Reset settings
+    m_screenshot_name.clear();
+    m_screenshot_completed.Set();
+  }
+
+  if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
+  {
+    if (!*frame_dump_started)
+    {
+      if (dump_to_ffmpeg)
+        *frame_dump_started = StartFrameDumpToFFMPEG(frame);
+      else
+        *frame_dump_started = StartFrameDumpToImage(frame);
+
+      // Stop frame dumping if we fail to start.
+      if (!*frame_dump_started)
+        Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
+    }
+
+    // If we failed to start frame dumping, don't write a frame.
+    if (*frame_dump_started)
+    {
+      if (dump_to_ffmpeg)
+        DumpFrameToFFMPEG(frame);
+      else
+        DumpFrameToImage(frame);
+    }
+  }
+}
+
 #if defined(HAVE_FFMPEG)
 
 bool FrameDumper::StartFrameDumpToFFMPEG(const FrameData& frame)
@@ -3,10 +3,15 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
+
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/MathUtil.h"
+#include "Common/SPSCQueue.h"
 #include "Common/Thread.h"
 
 #include "VideoCommon/FrameDumpFFMpeg.h"
@@ -22,10 +27,11 @@ public:
   FrameDumper();
   ~FrameDumper();
 
-  // Ensures all rendered frames are queued for encoding.
+  // Queues the frames whose readback was started before the current frame for encoding. The most
+  // recent readback is left for the next call, so that mapping it doesn't wait for the GPU.
   void FlushFrameDump();
 
-  // Fills the frame dump staging texture with the current XFB texture.
+  // Starts a readback of the current XFB texture into the next free staging texture.
   void DumpCurrentFrame(const AbstractTexture* src_texture,
                         const MathUtil::Rectangle<int>& src_rect,
                         const MathUtil::Rectangle<int>& target_rect, u64 ticks, int frame_number);
@@ -39,6 +45,7 @@ public:
 private:
   // NOTE: The methods below are called on the framedumping thread.
   void FrameDumpThreadFunc();
+  void ProcessFrame(const FrameData& frame, bool dump_to_ffmpeg, bool* frame_dump_started);
   bool StartFrameDumpToFFMPEG(const FrameData&);
   void DumpFrameToFFMPEG(const FrameData&);
   void StopFrameDumpToFFMPEG();
@@ -51,14 +58,19 @@ private:
   // Checks that the frame dump render texture exists and is the correct size.
   bool CheckFrameDumpRenderTexture(u32 target_width, u32 target_height);
 
-  // Checks that the frame dump readback texture exists and is the correct size.
-  bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
+  // Checks that the given readback texture exists and is the correct size.
+  bool CheckFrameDumpReadbackTexture(std::unique_ptr<AbstractStagingTexture>& rbtex,
+                                     u32 target_width, u32 target_height);
 
-  // Asynchronously encodes the specified pointer of frame data to the frame dump.
-  void DumpFrameData(const u8* data, int w, int h, int stride);
+  // Maps the readback textures of frames [m_frames_queued, end) and hands them to the frame
+  // dump thread.
+  void QueueReadbacks(u64 end);
 
-  // Ensures all encoded frames have been written to the output file.
-  void FinishFrameData();
+  // Unmaps the readback textures that the frame dump thread is done with.
+  void ReclaimReadbacks();
+
+  // Asynchronously encodes the specified pointer of frame data to the frame dump.
+  void DumpFrameData(const FrameData& frame);
 
   std::thread m_frame_dump_thread;
   Common::Flag m_frame_dump_thread_running;
@@ -66,26 +78,40 @@ private:
   // Used to kick frame dump thread.
   Common::Event m_frame_dump_start;
 
-  // Set by frame dump thread on frame completion.
+  // Set by frame dump thread whenever it is done with a frame.
   Common::Event m_frame_dump_done;
 
-  // Holds emulation state during the last swap when dumping.
-  FrameState m_last_frame_state;
-
-  // Communication of frame between video and dump threads.
-  FrameData m_frame_dump_data;
+  // Communication of frames between video and dump threads, in the order they were rendered.
+  Common::SPSCQueue<FrameData, false> m_frame_dump_queue;
 
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
 
-  // Double buffer:
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_readback_texture;
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_output_texture;
-  // Set when readback texture holds a frame that needs to be dumped.
-  bool m_frame_dump_needs_flush = false;
-  // Set when thread is processing output texture.
-  bool m_frame_dump_frame_running = false;
+  // Ring of readback textures, so that the GPU copy, the conversion and the encoding of different
+  // frames can overlap. Frame n uses entry n % READBACK_RING_SIZE. The counters below only grow,
+  // and m_frames_reclaimed <= m_frames_released <= m_frames_queued <= m_frames_copied always holds.
+  static constexpr size_t READBACK_RING_SIZE = 4;
+  struct Readback
+  {
+    std::unique_ptr<AbstractStagingTexture> texture;
+    FrameState state;
+  };
+  std::array<Readback, READBACK_RING_SIZE> m_readbacks;
+  // Frames that have been copied to a readback texture.
+  u64 m_frames_copied = 0;
+  // Frames that had been copied when FlushFrameDump was last called.
+  u64 m_frames_copied_before_flush = 0;
+  // Frames that have been mapped and sent to the frame dump thread.
+  u64 m_frames_queued = 0;
+  // Frames that the frame dump thread is done with. Written by the frame dump thread.
+  std::atomic<u64> m_frames_released = 0;
+  // Frames whose readback texture has been unmapped and can be reused.
+  u64 m_frames_reclaimed = 0;
+
+  // Statistics, reported when frame dumping stops.
+  u64 m_frames_dropped = 0;
+  std::chrono::steady_clock::duration m_time_waited{};
 
   // Used to generate screenshot names.
   u32 m_frame_dump_image_counter = 0;
@@ -22,6 +22,8 @@ void PerformanceMetrics::Reset()
   m_speed_counter.Reset();
 
   m_time_sleeping = DT::zero();
+  m_audio_latency.store(DT::zero(), std::memory_order_relaxed);
+  m_audio_underruns.store(0, std::memory_order_relaxed);
   m_real_times.fill(Clock::now());
   m_cpu_times.fill(Core::System::GetInstance().GetCoreTiming().GetCPUTimePoint(0));
 }
@@ -52,6 +54,16 @@ void PerformanceMetrics::CountPerformanceMarker(Core::System& system, s64 cycles
   m_time_index += 1;
 }
 
+void PerformanceMetrics::SetAudioLatency(DT latency)
+{
+  m_audio_latency.store(latency, std::memory_order_relaxed);
+}
+
+void PerformanceMetrics::CountAudioUnderrun()
+{
+  m_audio_underruns.fetch_add(1, std::memory_order_relaxed);
+}
+
 double PerformanceMetrics::GetFPS() const
 {
   return m_fps_counter.GetHzAvg();
@@ -80,6 +92,16 @@ double PerformanceMetrics::GetLastSpeedDenominator() const
          Core::System::GetInstance().GetVideoInterface().GetTargetRefreshRate();
 }
 
+DT PerformanceMetrics::GetAudioLatency() const
+{
+  return m_audio_latency.load(std::memory_order_relaxed);
+}
+
+u64 PerformanceMetrics::GetAudioUnderrunCount() const
+{
+  return m_audio_underruns.load(std::memory_order_relaxed);
+}
+
 void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
 {
   const float bg_alpha = 0.7f;
@@ -190,7 +212,7 @@ void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
   if (g_ActiveConfig.bShowSpeed)
   {
     // Position in the top-right corner of the screen.
-    float window_height = 47.f * backbuffer_scale;
+    float window_height = 81.f * backbuffer_scale;
 
     ImGui::SetNextWindowPos(ImVec2(window_x, window_y), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
     ImGui::SetNextWindowSize(ImVec2(window_width, window_height));
@@ -205,6 +227,10 @@ void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
     {
       ImGui::TextColored(ImVec4(r, g, b, 1.0f), "Speed:%4.0lf%%", 100.0 * speed);
       ImGui::TextColored(ImVec4(r, g, b, 1.0f), "Max:%6.0lf%%", 100.0 * GetMaxSpeed());
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "Audio:%4.0lfms",
+                         DT_ms(GetAudioLatency()).count());
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "Underrun:%3llu",
+                         static_cast<unsigned long long>(GetAudioUnderrunCount()));
       ImGui::End();
     }
   }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <shared_mutex>
 
 #include "Common/CommonTypes.h"
@@ -33,6 +34,10 @@ public:
   void CountThrottleSleep(DT sleep);
   void CountPerformanceMarker(Core::System& system, s64 cyclesLate);
 
+  // Called from the audio thread
+  void SetAudioLatency(DT latency);
+  void CountAudioUnderrun();
+
   // Getter Functions
   double GetFPS() const;
   double GetVPS() const;
@@ -41,6 +46,9 @@ public:
 
   double GetLastSpeedDenominator() const;
 
+  DT GetAudioLatency() const;
+  u64 GetAudioUnderrunCount() const;
+
   // ImGui Functions
   void DrawImGuiStats(const float backbuffer_scale);
 
@@ -57,6 +65,9 @@ private:
   std::array<TimePoint, 256> m_real_times{};
   std::array<TimePoint, 256> m_cpu_times{};
   DT m_time_sleeping{};
+
+  std::atomic<DT> m_audio_latency{};
+  std::atomic<u64> m_audio_underruns{0};
 };
 
 extern PerformanceMetrics g_perf_metrics;
@@ -0,0 +1,506 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <numbers>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#ifdef HAVE_FFMPEG
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/samplefmt.h>
+}
+#endif
+
+#include "AudioCommon/AudioDumpEncoder.h"
+#include "AudioCommon/Mixer.h"
+#include "AudioCommon/WaveFile.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Swap.h"
+
+using AudioCommon::AudioDumpFormat;
+
+namespace
+{
+constexpr u32 SAMPLE_RATE = 48000;
+
+class BitReader
+{
+public:
+  BitReader(const std::vector<u8>& data, size_t offset) : m_data(data), m_position(offset * 8) {}
+
+  u32 Read(u32 bits)
+  {
+    u32 value = 0;
+    for (u32 i = 0; i < bits; ++i)
+    {
+      const u8 byte = m_data.at(m_position / 8);
+      value = (value << 1) | ((byte >> (7 - m_position % 8)) & 1);
+      ++m_position;
+    }
+    return value;
+  }
+
+  s32 ReadSigned(u32 bits)
+  {
+    const u32 value = Read(bits);
+    return static_cast<s32>(value << (32 - bits)) >> (32 - bits);
+  }
+
+  u32 ReadUnary()
+  {
+    u32 zeros = 0;
+    while (Read(1) == 0)
+      ++zeros;
+    return zeros;
+  }
+
+  void AlignToByte() { m_position = (m_position + 7) & ~size_t{7}; }
+  size_t GetBytePosition() const { return m_position / 8; }
+
+private:
+  const std::vector<u8>& m_data;
+  size_t m_position;
+};
+
+u8 ReferenceCRC8(const u8* data, size_t size)
+{
+  u8 crc = 0;
+  for (size_t i = 0; i < size; ++i)
+  {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; ++bit)
+      crc = static_cast<u8>(crc & 0x80 ? (crc << 1) ^ 0x07 : crc << 1);
+  }
+  return crc;
+}
+
+u16 ReferenceCRC16(const u8* data, size_t size)
+{
+  u16 crc = 0;
+  for (size_t i = 0; i < size; ++i)
+  {
+    crc ^= data[i] << 8;
+    for (int bit = 0; bit < 8; ++bit)
+      crc = static_cast<u16>(crc & 0x8000 ? (crc << 1) ^ 0x8005 : crc << 1);
+  }
+  return crc;
+}
+
+std::vector<s32> DecodeSubframe(BitReader& reader, u32 count, u32 bps)
+{
+  EXPECT_EQ(reader.Read(1), 0u);
+  const u32 type = reader.Read(6);
+  EXPECT_EQ(reader.Read(1), 0u);  // wasted bits
+
+  std::vector<s32> x(count);
+  if (type == 0)
+  {
+    const s32 value = reader.ReadSigned(bps);
+    std::fill(x.begin(), x.end(), value);
+  }
+  else if (type == 1)
+  {
+    for (s32& sample : x)
+      sample = reader.ReadSigned(bps);
+  }
+  else
+  {
+    EXPECT_EQ(type & 0b111000, 0b001000u);
+    const u32 order = type & 0b111;
+    for (u32 i = 0; i < order; ++i)
+      x[i] = reader.ReadSigned(bps);
+
+    EXPECT_EQ(reader.Read(2), 0u);
+    const u32 partition_order = reader.Read(4);
+    const u32 partition_size = count >> partition_order;
+    for (u32 p = 0; p < (1u << partition_order); ++p)
+    {
+      const u32 parameter = reader.Read(4);
+      for (u32 i = p == 0 ? order : p * partition_size; i < (p + 1) * partition_size; ++i)
+      {
+        const u32 folded = (reader.ReadUnary() << parameter) | reader.Read(parameter);
+        const s32 residual = static_cast<s32>(folded >> 1) ^ -static_cast<s32>(folded & 1);
+        switch (order)
+        {
+        case 0:
+          x[i] = residual;
+          break;
+        case 1:
+          x[i] = residual + x[i - 1];
+          break;
+        case 2:
+          x[i] = residual + 2 * x[i - 1] - x[i - 2];
+          break;
+        case 3:
+          x[i] = residual + 3 * x[i - 1] - 3 * x[i - 2] + x[i - 3];
+          break;
+        default:
+          x[i] = residual + 4 * x[i - 1] - 6 * x[i - 2] + 4 * x[i - 3] - x[i - 4];
+          break;
+        }
+      }
+    }
+  }
+  return x;
+}
+
+// A minimal decoder for the subset of FLAC that the encoder writes. Returns interleaved samples.
+std::optional<std::vector<s16>> DecodeFlac(const std::vector<u8>& data, u32* sample_rate)
+{
+  if (data.size() < 42 || std::memcmp(data.data(), "fLaC", 4) != 0 || data[4] != 0x80)
+    return std::nullopt;
+
+  BitReader info(data, 8);
+  info.Read(16 + 16 + 24 + 24);
+  *sample_rate = info.Read(20);
+  const u32 channels = info.Read(3) + 1;
+  const u32 bps = info.Read(5) + 1;
+  const u64 total_frames = (u64{info.Read(4)} << 32) | info.Read(32);
+  if (channels != 2 || bps != 16)
+    return std::nullopt;
+
+  std::vector<s16> samples;
+  size_t offset = 42;
+  u32 expected_frame_number = 0;
+  while (offset < data.size())
+  {
+    BitReader reader(data, offset);
+    if (reader.Read(16) != 0xFFF8 || reader.Read(4) != 0b0111)
+      return std::nullopt;
+    const u32 sample_rate_code = reader.Read(4);
+    const u32 channel_assignment = reader.Read(4);
+    if (reader.Read(3) != 0b100 || reader.Read(1) != 0)
+      return std::nullopt;
+
+    u32 frame_number = reader.Read(8);
+    if (frame_number & 0x80)
+    {
+      u32 length = 0;
+      while (frame_number & (0x80 >> length))
+        ++length;
+      frame_number &= 0x7F >> length;
+      for (u32 i = 1; i < length; ++i)
+        frame_number = (frame_number << 6) | (reader.Read(8) & 0x3F);
+    }
+    EXPECT_EQ(frame_number, expected_frame_number++);
+
+    const u32 count = reader.Read(16) + 1;
+    if (sample_rate_code == 12)
+      reader.Read(8);
+    else if (sample_rate_code == 13 || sample_rate_code == 14)
+      reader.Read(16);
+
+    const size_t header_size = reader.GetBytePosition() - offset;
+    EXPECT_EQ(reader.Read(8), ReferenceCRC8(&data[offset], header_size));
+
+    const bool first_is_side = channel_assignment == 0b1001;
+    const bool second_is_side = channel_assignment == 0b1000 || channel_assignment == 0b1010;
+    const std::vector<s32> a = DecodeSubframe(reader, count, first_is_side ? 17 : 16);
+    const std::vector<s32> b = DecodeSubframe(reader, count, second_is_side ? 17 : 16);
+    reader.AlignToByte();
+    const size_t frame_size = reader.GetBytePosition() - offset;
+    EXPECT_EQ(reader.Read(16), ReferenceCRC16(&data[offset], frame_size));
+    offset += frame_size + 2;
+
+    for (u32 i = 0; i < count; ++i)
+    {
+      s32 left, right;
+      switch (channel_assignment)
+      {
+      case 0b0001:
+        left = a[i], right = b[i];
+        break;
+      case 0b1000:
+        left = a[i], right = a[i] - b[i];
+        break;
+      case 0b1001:
+        left = a[i] + b[i], right = b[i];
+        break;
+      case 0b1010:
+      {
+        const s32 mid = (a[i] << 1) | (b[i] & 1);
+        left = (mid + b[i]) >> 1, right = (mid - b[i]) >> 1;
+        break;
+      }
+      default:
+        return std::nullopt;
+      }
+      samples.push_back(static_cast<s16>(left));
+      samples.push_back(static_cast<s16>(right));
+    }
+  }
+
+  if (samples.size() != total_frames * 2)
+    return std::nullopt;
+  return samples;
+}
+
+#ifdef HAVE_FFMPEG
+// Decodes with FFmpeg's FLAC decoder, as a reference that shares nothing with either the encoder
+// or DecodeFlac. Returns interleaved samples.
+std::optional<std::vector<s16>> DecodeFlacWithFFmpeg(const std::string& path, u32* sample_rate)
+{
+  AVFormatContext* format_context = nullptr;
+  if (avformat_open_input(&format_context, path.c_str(), nullptr, nullptr) != 0)
+    return std::nullopt;
+  const std::unique_ptr<AVFormatContext, void (*)(AVFormatContext*)> format_context_guard(
+      format_context, [](AVFormatContext* context) { avformat_close_input(&context); });
+  if (avformat_find_stream_info(format_context, nullptr) < 0)
+    return std::nullopt;
+
+  const AVCodec* codec = nullptr;
+  const int stream_index =
+      av_find_best_stream(format_context, AVMEDIA_TYPE_AUDIO, -1, -1, &codec, 0);
+  if (stream_index < 0 || codec->id != AV_CODEC_ID_FLAC)
+    return std::nullopt;
+
+  const std::unique_ptr<AVCodecContext, void (*)(AVCodecContext*)> codec_context(
+      avcodec_alloc_context3(codec),
+      [](AVCodecContext* context) { avcodec_free_context(&context); });
+  if (!codec_context ||
+      avcodec_parameters_to_context(codec_context.get(),
+                                    format_context->streams[stream_index]->codecpar) < 0 ||
+      avcodec_open2(codec_context.get(), codec, nullptr) < 0)
+  {
+    return std::nullopt;
+  }
+  *sample_rate = codec_context->sample_rate;
+
+  const std::unique_ptr<AVPacket, void (*)(AVPacket*)> packet(
+      av_packet_alloc(), [](AVPacket* pkt) { av_packet_free(&pkt); });
+  const std::unique_ptr<AVFrame, void (*)(AVFrame*)> frame(av_frame_alloc(),
+                                                           [](AVFrame* f) { av_frame_free(&f); });
+  if (!packet || !frame)
+    return std::nullopt;
+
+  std::vector<s16> samples;
+  const auto receive_frames = [&] {
+    while (avcodec_receive_frame(codec_context.get(), frame.get()) == 0)
+    {
+      const auto sample_format = static_cast<AVSampleFormat>(frame->format);
+      if (av_get_bytes_per_sample(sample_format) != sizeof(s16))
+        return false;
+
+      const bool planar = av_sample_fmt_is_planar(sample_format) != 0;
+      for (int i = 0; i < frame->nb_samples; ++i)
+      {
+        for (int channel = 0; channel < 2; ++channel)
+        {
+          samples.push_back(
+              planar ? reinterpret_cast<const s16*>(frame->data[channel])[i] :
+                       reinterpret_cast<const s16*>(frame->data[0])[i * 2 + channel]);
+        }
+      }
+    }
+    return true;
+  };
+
+  while (av_read_frame(format_context, packet.get()) >= 0)
+  {
+    const bool sent = packet->stream_index != stream_index ||
+                      avcodec_send_packet(codec_context.get(), packet.get()) == 0;
+    av_packet_unref(packet.get());
+    if (!sent || !receive_frames())
+      return std::nullopt;
+  }
+  if (avcodec_send_packet(codec_context.get(), nullptr) != 0 || !receive_frames())
+    return std::nullopt;
+
+  return samples;
+}
+#endif
+
+class AudioDumpTest : public testing::Test
+{
+protected:
+  AudioDumpTest() : m_directory(File::CreateTempDir()), m_path(m_directory + "/dump") {}
+
+  ~AudioDumpTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_directory.empty())
+      FAIL() << "CreateTempDir failed";
+  }
+
+  // Encodes in uneven pieces, the way the dump writer hands over whatever it has gathered.
+  std::vector<u8> Encode(AudioDumpFormat format, const std::vector<s16>& samples)
+  {
+    auto encoder = AudioCommon::CreateAudioDumpEncoder(format);
+    {
+      File::IOFile file(m_path, "wb");
+      EXPECT_TRUE(encoder->Start(file, SAMPLE_RATE));
+      const u32 frame_count = static_cast<u32>(samples.size() / 2);
+      for (u32 i = 0; i < frame_count;)
+      {
+        const u32 piece = std::min(frame_count - i, 1000 + i % 777);
+        encoder->Encode(file, &samples[i * 2], piece);
+        i += piece;
+      }
+      encoder->Finish(file);
+    }
+
+    std::string contents;
+    EXPECT_TRUE(File::ReadFileToString(m_path, contents));
+    return std::vector<u8>(contents.begin(), contents.end());
+  }
+
+  void ExpectFlacRoundTrip(const std::vector<s16>& samples)
+  {
+    const std::vector<u8> data = Encode(AudioDumpFormat::FLAC, samples);
+    u32 sample_rate = 0;
+    const std::optional<std::vector<s16>> decoded = DecodeFlac(data, &sample_rate);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(sample_rate, SAMPLE_RATE);
+    EXPECT_EQ(*decoded, samples);
+
+#ifdef HAVE_FFMPEG
+    // An empty stream has no frames for the reference decoder to check.
+    if (samples.empty())
+      return;
+    u32 reference_sample_rate = 0;
+    const std::optional<std::vector<s16>> reference =
+        DecodeFlacWithFFmpeg(m_path, &reference_sample_rate);
+    ASSERT_TRUE(reference.has_value());
+    EXPECT_EQ(reference_sample_rate, SAMPLE_RATE);
+    EXPECT_EQ(*reference, samples);
+#endif
+  }
+
+  std::string m_directory;
+  std::string m_path;
+};
+}  // namespace
+
+TEST_F(AudioDumpTest, WavHeader)
+{
+  const std::vector<s16> samples = {1, -1, 2, -2, 0x7FFF, -0x8000};
+  const std::vector<u8> data = Encode(AudioDumpFormat::WAV, samples);
+
+  ASSERT_EQ(data.size(), 44u + samples.size() * 2);
+  EXPECT_EQ(std::memcmp(data.data(), "RIFF", 4), 0);
+  u32 riff_size, data_size, sample_rate;
+  std::memcpy(&riff_size, &data[4], 4);
+  std::memcpy(&sample_rate, &data[24], 4);
+  std::memcpy(&data_size, &data[40], 4);
+  EXPECT_EQ(riff_size, 36u + samples.size() * 2);
+  EXPECT_EQ(sample_rate, SAMPLE_RATE);
+  EXPECT_EQ(data_size, samples.size() * 2);
+  EXPECT_EQ(std::memcmp(&data[44], samples.data(), samples.size() * 2), 0);
+}
+
+TEST_F(AudioDumpTest, FlacSilence)
+{
+  const std::vector<s16> samples(SAMPLE_RATE * 2, 0);
+  ExpectFlacRoundTrip(samples);
+  // Silence is stored as constant subframes.
+  EXPECT_LT(Encode(AudioDumpFormat::FLAC, samples).size(), 1024u);
+}
+
+TEST_F(AudioDumpTest, FlacSine)
+{
+  std::vector<s16> samples;
+  for (u32 i = 0; i < SAMPLE_RATE; ++i)
+  {
+    const double t = static_cast<double>(i) / SAMPLE_RATE;
+    samples.push_back(static_cast<s16>(20000 * std::sin(2 * std::numbers::pi * 440 * t)));
+    samples.push_back(static_cast<s16>(-15000 * std::sin(2 * std::numbers::pi * 660 * t)));
+  }
+  ExpectFlacRoundTrip(samples);
+  // Smooth signals are predictable, so they should compress well.
+  EXPECT_LT(Encode(AudioDumpFormat::FLAC, samples).size(), samples.size() * 2 * 2 / 3);
+}
+
+TEST_F(AudioDumpTest, FlacNoise)
+{
+  std::mt19937 rng(0x464c4143);
+  std::vector<s16> samples;
+  for (u32 i = 0; i < SAMPLE_RATE / 2 + 123; ++i)
+  {
+    const s16 left = static_cast<s16>(rng());
+    // Closely correlated channels, extreme values and plain noise.
+    samples.push_back(left);
+    samples.push_back(i % 3 == 0 ? left : i % 3 == 1 ? -0x8000 : static_cast<s16>(rng()));
+  }
+  ExpectFlacRoundTrip(samples);
+}
+
+TEST_F(AudioDumpTest, FlacShortStream)
+{
+  ExpectFlacRoundTrip({});
+  ExpectFlacRoundTrip({123, -456});
+  ExpectFlacRoundTrip({1, 2, 3, 4, 5, 6, 7, 8});
+}
+
+TEST_F(AudioDumpTest, WriterKeepsSamplesInOrder)
+{
+  // Enough samples to fill several of the writer's blocks, added in uneven pieces.
+  std::vector<s16> big_endian_samples;
+  std::vector<s16> expected;
+  for (u32 i = 0; i < 20000; ++i)
+  {
+    const s16 left = static_cast<s16>(i * 3);
+    const s16 right = static_cast<s16>(-static_cast<s32>(i));
+    // The writer takes big endian samples with the right channel first.
+    big_endian_samples.push_back(static_cast<s16>(Common::swap16(static_cast<u16>(right))));
+    big_endian_samples.push_back(static_cast<s16>(Common::swap16(static_cast<u16>(left))));
+    expected.push_back(left);
+    expected.push_back(right);
+  }
+
+  {
+    WaveFileWriter writer;
+    const u32 sample_rate_divisor = Mixer::FIXED_SAMPLE_RATE_DIVIDEND / SAMPLE_RATE;
+    ASSERT_TRUE(writer.Start(m_path, sample_rate_divisor, AudioDumpFormat::WAV));
+    const u32 frame_count = static_cast<u32>(expected.size() / 2);
+    for (u32 i = 0; i < frame_count;)
+    {
+      const u32 piece = std::min(frame_count - i, 1 + i % 1500);
+      writer.AddStereoSamplesBE(&big_endian_samples[i * 2], piece, sample_rate_divisor, 256, 256);
+      i += piece;
+    }
+    EXPECT_TRUE(writer.Stop());
+  }
+
+  std::string contents;
+  ASSERT_TRUE(File::ReadFileToString(m_path, contents));
+  ASSERT_EQ(contents.size(), 44u + expected.size() * 2);
+  EXPECT_EQ(std::memcmp(&contents[44], expected.data(), expected.size() * 2), 0);
+}
+
+TEST_F(AudioDumpTest, WriterDoesNotOverwriteFilesForNewSampleRates)
+{
+  // A new sample rate continues the dump in <basename><n>.<ext> in the audio dump directory.
+  File::SetUserPath(D_DUMPAUDIO_IDX, m_directory);
+  const std::string next_path = m_directory + "/dump1.wav";
+  ASSERT_TRUE(File::WriteStringToFile(next_path, "existing"));
+
+  const std::vector<s16> samples(2000, 0);
+  WaveFileWriter writer;
+  const u32 sample_rate_divisor = Mixer::FIXED_SAMPLE_RATE_DIVIDEND / SAMPLE_RATE;
+  ASSERT_TRUE(writer.Start(m_path, sample_rate_divisor, AudioDumpFormat::WAV));
+  writer.AddStereoSamplesBE(samples.data(), 1000, sample_rate_divisor, 256, 256);
+  writer.AddStereoSamplesBE(samples.data(), 1000, sample_rate_divisor * 2, 256, 256);
+  EXPECT_FALSE(writer.Stop());
+  EXPECT_NE(writer.GetError().find(next_path), std::string::npos) << writer.GetError();
+
+  std::string contents;
+  ASSERT_TRUE(File::ReadFileToString(next_path, contents));
+  EXPECT_EQ(contents, "existing");
+}
@@ -0,0 +1,117 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "AudioCommon/LatencyController.h"
+#include "Common/CommonTypes.h"
+
+using AudioCommon::LatencyController;
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr unsigned int SAMPLE_RATE = 48000;
+// 10 ms per callback.
+constexpr u32 FRAMES_PER_CALLBACK = 480;
+
+// Drives a LatencyController like a backend that asks for samples at regular intervals, with a
+// simulated clock.
+class SimulatedBackend
+{
+public:
+  explicit SimulatedBackend(DT jitter = DT::zero()) : m_jitter(jitter) {}
+
+  // Runs the given amount of simulated time. <underrun> decides whether a callback runs dry.
+  template <typename Function>
+  void Run(DT duration, Function underrun)
+  {
+    const TimePoint end = m_now + duration;
+    while (m_now < end)
+    {
+      m_now += 10ms;
+      const DT offset =
+          m_jitter == DT::zero() ? DT::zero() : DT(m_rng() % m_jitter.count()) - m_jitter / 2;
+      const bool dry = underrun();
+      m_controller.Update(m_now + offset, FRAMES_PER_CALLBACK, dry ? 0 : FRAMES_PER_CALLBACK);
+    }
+  }
+
+  void Run(DT duration)
+  {
+    Run(duration, [] { return false; });
+  }
+
+  const LatencyController& GetController() const { return m_controller; }
+
+private:
+  LatencyController m_controller{SAMPLE_RATE};
+  TimePoint m_now{};
+  DT m_jitter;
+  std::mt19937 m_rng{0x4c4154};
+};
+}  // namespace
+
+TEST(LatencyController, StartsConservatively)
+{
+  LatencyController controller(SAMPLE_RATE);
+  EXPECT_EQ(controller.GetTargetLatency(), LatencyController::MAX_LATENCY);
+}
+
+TEST(LatencyController, ShrinksWithStableCallbacks)
+{
+  SimulatedBackend backend;
+  backend.Run(60s);
+
+  const LatencyController& controller = backend.GetController();
+  EXPECT_EQ(controller.GetUnderrunCount(), 0u);
+  EXPECT_GE(controller.GetTargetLatency(), 10ms);
+  EXPECT_LE(controller.GetTargetLatency(), 11ms);
+}
+
+TEST(LatencyController, LeavesRoomForJitter)
+{
+  SimulatedBackend backend(8ms);
+  backend.Run(60s);
+
+  // The callbacks can be up to 8 ms apart from where they are expected to be.
+  const LatencyController& controller = backend.GetController();
+  EXPECT_GE(controller.GetJitter(), 6ms);
+  EXPECT_GE(controller.GetTargetLatency(), 10ms + 2 * controller.GetJitter());
+  EXPECT_LT(controller.GetTargetLatency(), LatencyController::MAX_LATENCY);
+}
+
+TEST(LatencyController, GrowsAfterUnderruns)
+{
+  SimulatedBackend backend;
+  backend.Run(60s);
+  const DT stable_target = backend.GetController().GetTargetLatency();
+
+  // Run dry every 50th callback for a second.
+  int callback = 0;
+  backend.Run(1s, [&callback] { return ++callback % 50 == 0; });
+
+  const LatencyController& controller = backend.GetController();
+  EXPECT_EQ(controller.GetUnderrunCount(), 2u);
+  EXPECT_GE(controller.GetTargetLatency(), stable_target + 15ms);
+
+  // Once the output is stable again, the target shrinks back.
+  backend.Run(60s);
+  EXPECT_EQ(controller.GetUnderrunCount(), 2u);
+  EXPECT_LE(controller.GetTargetLatency(), stable_target + 1ms);
+}
+
+TEST(LatencyController, SilenceIsNotAnUnderrun)
+{
+  SimulatedBackend backend;
+  backend.Run(1s, [] { return true; });
+  EXPECT_EQ(backend.GetController().GetUnderrunCount(), 0u);
+
+  // Running dry right after the fifo could keep up is one underrun, not one per callback.
+  backend.Run(1s);
+  backend.Run(1s, [] { return true; });
+  EXPECT_EQ(backend.GetController().GetUnderrunCount(), 1u);
+}
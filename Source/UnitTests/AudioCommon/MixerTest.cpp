@@ -0,0 +1,163 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "AudioCommon/Mixer.h"
+#include "AudioCommon/Resampler.h"
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+
+namespace
+{
+// The per-sample loop that the mixer used before resampling whole blocks, reading from a linear
+// buffer instead of the ring buffer. Returns the number of output frames.
+u32 ReferenceResampleAndMix(s16* output, const s16* input, u32 input_frames, u32 max_count,
+                            u32 frac, u32 ratio, s32 volume_0, s32 volume_1)
+{
+  u32 index = 0;
+  u32 count = 0;
+  for (; count < max_count && index + 1 < input_frames; ++count)
+  {
+    for (u32 channel = 0; channel < 2; ++channel)
+    {
+      const s16 s1 = input[index * 2 + channel];
+      const s16 s2 = input[index * 2 + 2 + channel];
+      const s64 interpolated = (s64{s1} << 16) + s64{s2 - s1} * static_cast<u16>(frac);
+      int sample = static_cast<int>(interpolated >> 16);
+      sample = (sample * (channel == 0 ? volume_0 : volume_1)) >> 8;
+      sample += output[count * 2 + channel];
+      output[count * 2 + channel] = std::clamp(sample, -32767, 32767);
+    }
+
+    frac += ratio;
+    index += frac >> 16;
+    frac &= 0xffff;
+  }
+  return count;
+}
+
+s16 RandomSample(std::mt19937& rng)
+{
+  switch (rng() % 8)
+  {
+  case 0:
+    return -32768;
+  case 1:
+    return 32767;
+  default:
+    return static_cast<s16>(rng());
+  }
+}
+
+std::vector<s16> RandomSamples(std::mt19937& rng, size_t count)
+{
+  std::vector<s16> samples(count);
+  std::generate(samples.begin(), samples.end(), [&rng] { return RandomSample(rng); });
+  return samples;
+}
+}  // namespace
+
+TEST(Mixer, ResampleAndMix)
+{
+  std::mt19937 rng(0x4d4958);
+
+  for (int iteration = 0; iteration < 2000; ++iteration)
+  {
+    const u32 input_frames = rng() % 80;
+    const u32 max_count = rng() % 100;
+    const u32 frac = rng() & 0xFFFF;
+    u32 ratio;
+    switch (iteration % 4)
+    {
+    case 0:
+      ratio = 0x10000;
+      break;
+    case 1:
+      ratio = 0xAAAA;  // 32000 Hz to 48000 Hz
+      break;
+    case 2:
+      ratio = iteration % 3 ? rng() % 0x30000 : 0;
+      break;
+    default:
+      ratio = rng() % 0x1000;
+      break;
+    }
+    const s32 volume_0 = rng() % 0x200;
+    const s32 volume_1 = rng() % 2 ? 256 : rng() % 0x200;
+
+    const std::vector<s16> input = RandomSamples(rng, input_frames * 2);
+    std::vector<s16> expected = RandomSamples(rng, max_count * 2);
+    std::vector<s16> actual = expected;
+
+    const u32 expected_count = ReferenceResampleAndMix(expected.data(), input.data(), input_frames,
+                                                       max_count, frac, ratio, volume_0, volume_1);
+    const u32 actual_count =
+        AudioCommon::GetResampleOutputCount(input_frames, frac, ratio, max_count);
+    AudioCommon::ResampleAndMix(actual.data(), input.data(), actual_count, frac, ratio, volume_0,
+                                volume_1);
+
+    SCOPED_TRACE(testing::Message() << "input frames " << input_frames << ", ratio " << ratio
+                                    << ", position " << frac);
+    EXPECT_EQ(expected_count, actual_count);
+    EXPECT_EQ(expected, actual);
+  }
+}
+
+TEST(Mixer, MixConstantInput)
+{
+  Mixer mixer(48000);
+
+  // DMA samples are big endian, with the left channel first.
+  std::vector<s16> input(256 * 2);
+  for (size_t i = 0; i < input.size(); i += 2)
+  {
+    input[i] = Common::swap16(static_cast<u16>(1000));
+    input[i + 1] = Common::swap16(static_cast<u16>(-2000));
+  }
+  mixer.PushSamples(input.data(), 256);
+
+  // The output has the right channel first. Once the input runs out, the last frame is repeated.
+  std::vector<s16> output(512 * 2);
+  mixer.Mix(output.data(), 512);
+  for (size_t i = 0; i < output.size(); i += 2)
+  {
+    EXPECT_EQ(output[i], -2000);
+    EXPECT_EQ(output[i + 1], 1000);
+  }
+}
+
+// Not really a test, but measures how long mixing the typical streams takes. Disabled by default;
+// run it with --gtest_also_run_disabled_tests.
+TEST(Mixer, DISABLED_Benchmark)
+{
+  constexpr u32 FRAMES_PER_MIX = 512;
+  constexpr u32 ITERATIONS = 2000;
+
+  Mixer mixer(48000);
+  std::mt19937 rng(0x42454e);
+  const std::vector<s16> dma_input = RandomSamples(rng, FRAMES_PER_MIX * 2);
+  const std::vector<s16> streaming_input = RandomSamples(rng, FRAMES_PER_MIX * 2);
+  std::vector<s16> output(FRAMES_PER_MIX * 2);
+
+  std::chrono::nanoseconds mix_time{0};
+  for (u32 i = 0; i < ITERATIONS; ++i)
+  {
+    // Push what 512 output frames at 48000 Hz consume: 32000 Hz DMA and 48000 Hz streaming audio.
+    mixer.PushSamples(dma_input.data(), FRAMES_PER_MIX * 2 / 3);
+    mixer.PushStreamingSamples(streaming_input.data(), FRAMES_PER_MIX);
+
+    const auto start = std::chrono::steady_clock::now();
+    mixer.Mix(output.data(), FRAMES_PER_MIX);
+    mix_time += std::chrono::steady_clock::now() - start;
+  }
+
+  fmt::print("mixing {} frames: {:.2f} ns/frame\n", FRAMES_PER_MIX * ITERATIONS,
+             static_cast<double>(mix_time.count()) / (FRAMES_PER_MIX * ITERATIONS));
+}
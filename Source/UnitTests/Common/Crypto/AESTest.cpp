@@ -0,0 +1,164 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
+
+namespace
+{
+constexpr std::array<u8, 16> KEY{0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                                 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+
+// The size of a Wii disc cluster without its hash block, and the number of clusters in a group
+constexpr size_t CLUSTER_DATA_SIZE = 0x7c00;
+constexpr size_t CLUSTERS_PER_GROUP = 64;
+
+std::vector<u8> MakeData(size_t size, u8 seed)
+{
+  std::vector<u8> data(size);
+  for (size_t i = 0; i < size; ++i)
+    data[i] = static_cast<u8>(i * 7 + seed);
+  return data;
+}
+
+void CheckCryptMultiple(const Common::AES::Context& context, size_t len, size_t count,
+                        bool use_ivs)
+{
+  std::vector<std::vector<u8>> inputs, ivs, expected, actual;
+  std::vector<const u8*> input_ptrs, iv_ptrs;
+  std::vector<u8*> output_ptrs;
+  for (size_t i = 0; i < count; ++i)
+  {
+    inputs.push_back(MakeData(len, static_cast<u8>(i)));
+    ivs.push_back(MakeData(Common::AES::Context::BLOCK_SIZE, static_cast<u8>(i * 3 + 1)));
+    expected.emplace_back(len);
+    actual.emplace_back(len);
+
+    ASSERT_TRUE(context.Crypt(use_ivs ? ivs[i].data() : nullptr, nullptr, inputs[i].data(),
+                              expected[i].data(), len));
+  }
+  for (size_t i = 0; i < count; ++i)
+  {
+    input_ptrs.push_back(inputs[i].data());
+    iv_ptrs.push_back(ivs[i].data());
+    output_ptrs.push_back(actual[i].data());
+  }
+
+  ASSERT_TRUE(context.CryptMultiple(use_ivs ? iv_ptrs.data() : nullptr, input_ptrs.data(),
+                                    output_ptrs.data(), len, count));
+  for (size_t i = 0; i < count; ++i)
+    EXPECT_EQ(expected[i], actual[i]) << "len " << len << ", buffer " << i << " of " << count;
+}
+
+template <typename F>
+double MiBPerSecond(size_t bytes, int iterations, F f)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+    f();
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return bytes * iterations / elapsed.count() / (1024 * 1024);
+}
+}  // namespace
+
+TEST(AES, Vectors)
+{
+  // NIST SP 800-38A F.2.1, first block
+  constexpr std::array<u8, 16> iv{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                  0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+  constexpr std::array<u8, 16> plaintext{0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96,
+                                         0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a};
+  constexpr std::array<u8, 16> ciphertext{0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46,
+                                          0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d};
+
+  std::array<u8, 16> out;
+  ASSERT_TRUE(Common::AES::CreateContextEncrypt(KEY.data())
+                  ->Crypt(iv.data(), plaintext.data(), out.data(), out.size()));
+  EXPECT_EQ(ciphertext, out);
+  ASSERT_TRUE(Common::AES::CreateContextDecrypt(KEY.data())
+                  ->Crypt(iv.data(), ciphertext.data(), out.data(), out.size()));
+  EXPECT_EQ(plaintext, out);
+}
+
+TEST(AES, DecryptMatchesEncrypt)
+{
+  const auto encrypt = Common::AES::CreateContextEncrypt(KEY.data());
+  const auto decrypt = Common::AES::CreateContextDecrypt(KEY.data());
+
+  // Covers the unrolled paths as well as the leftover blocks
+  constexpr size_t LENGTHS[]{0x10, 0xa0, 0x130, 0x400, CLUSTER_DATA_SIZE};
+  for (size_t len : LENGTHS)
+  {
+    const std::vector<u8> plaintext = MakeData(len, 0x55);
+    const std::vector<u8> iv = MakeData(Common::AES::Context::BLOCK_SIZE, 0xaa);
+    std::vector<u8> ciphertext(len), decrypted(len);
+    ASSERT_TRUE(encrypt->Crypt(iv.data(), plaintext.data(), ciphertext.data(), len));
+    ASSERT_TRUE(decrypt->Crypt(iv.data(), ciphertext.data(), decrypted.data(), len));
+    EXPECT_EQ(plaintext, decrypted) << "len " << len;
+  }
+}
+
+TEST(AES, CryptMultiple)
+{
+  const auto encrypt = Common::AES::CreateContextEncrypt(KEY.data());
+  const auto decrypt = Common::AES::CreateContextDecrypt(KEY.data());
+
+  constexpr size_t LENGTHS[]{0x10, 0x400, CLUSTER_DATA_SIZE};
+  for (size_t count : {1, 3, 4, 8, 11, 17})
+  {
+    for (size_t len : LENGTHS)
+    {
+      CheckCryptMultiple(*encrypt, len, count, true);
+      CheckCryptMultiple(*encrypt, len, count, false);
+      CheckCryptMultiple(*decrypt, len, count, true);
+    }
+  }
+}
+
+// Not a correctness test. Compares the throughput of handling a group one cluster at a time
+// against handing the whole group to CryptMultiple.
+// Only prints timings, since CryptMultiple checks the results. Run it with
+// --gtest_also_run_disabled_tests.
+TEST(AES, DISABLED_GroupThroughput)
+{
+  constexpr int ITERATIONS = 8;
+  constexpr size_t GROUP_SIZE = CLUSTER_DATA_SIZE * CLUSTERS_PER_GROUP;
+
+  std::vector<u8> group = MakeData(GROUP_SIZE, 0);
+  std::vector<u8> ivs = MakeData(Common::AES::Context::BLOCK_SIZE * CLUSTERS_PER_GROUP, 1);
+  std::array<const u8*, CLUSTERS_PER_GROUP> iv_ptrs;
+  std::array<const u8*, CLUSTERS_PER_GROUP> in_ptrs;
+  std::array<u8*, CLUSTERS_PER_GROUP> out_ptrs;
+  for (size_t i = 0; i < CLUSTERS_PER_GROUP; ++i)
+  {
+    iv_ptrs[i] = ivs.data() + i * Common::AES::Context::BLOCK_SIZE;
+    in_ptrs[i] = group.data() + i * CLUSTER_DATA_SIZE;
+    out_ptrs[i] = group.data() + i * CLUSTER_DATA_SIZE;
+  }
+
+  for (const bool is_encrypt : {true, false})
+  {
+    const auto context = is_encrypt ? Common::AES::CreateContextEncrypt(KEY.data()) :
+                                      Common::AES::CreateContextDecrypt(KEY.data());
+
+    const double per_cluster = MiBPerSecond(GROUP_SIZE, ITERATIONS, [&] {
+      for (size_t i = 0; i < CLUSTERS_PER_GROUP; ++i)
+        context->Crypt(iv_ptrs[i], in_ptrs[i], out_ptrs[i], CLUSTER_DATA_SIZE);
+    });
+    const double batched = MiBPerSecond(GROUP_SIZE, ITERATIONS, [&] {
+      context->CryptMultiple(iv_ptrs.data(), in_ptrs.data(), out_ptrs.data(), CLUSTER_DATA_SIZE,
+                             CLUSTERS_PER_GROUP);
+    });
+
+    fmt::print("AES {}: {:.0f} MiB/s per cluster, {:.0f} MiB/s per group\n",
+               is_encrypt ? "encrypt" : "decrypt", per_cluster, batched);
+  }
+}
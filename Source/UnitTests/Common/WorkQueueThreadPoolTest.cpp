@@ -0,0 +1,46 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "Common/WorkQueueThreadPool.h"
+
+TEST(WorkQueueThreadPool, RunsEveryItemOnce)
+{
+  constexpr size_t COUNT = 1000;
+  std::vector<int> runs(COUNT);
+  Common::WorkQueueThreadPool<size_t> pool("WorkQueueThreadPool Test", 4,
+                                           [&runs](size_t i) { ++runs[i]; });
+
+  // The threads are reused for every batch
+  for (size_t batch = 0; batch < 4; ++batch)
+  {
+    for (size_t i = 0; i < COUNT; ++i)
+      pool.Push(i);
+    pool.WaitForCompletion();
+
+    for (size_t i = 0; i < COUNT; ++i)
+      EXPECT_EQ(runs[i], static_cast<int>(batch + 1)) << i;
+  }
+}
+
+TEST(WorkQueueThreadPool, WaitWithEmptyQueue)
+{
+  std::atomic<bool> ran = false;
+  Common::WorkQueueThreadPool<int> pool("WorkQueueThreadPool Test", 2, [&ran](int) { ran = true; });
+  pool.WaitForCompletion();
+  EXPECT_FALSE(ran);
+}
+
+TEST(WorkQueueThreadPool, ShutdownFinishesQueuedItems)
+{
+  std::atomic<int> sum = 0;
+  Common::WorkQueueThreadPool<int> pool("WorkQueueThreadPool Test", 3, [&sum](int i) { sum += i; });
+  for (int i = 1; i <= 100; ++i)
+    pool.Push(i);
+  pool.Shutdown();
+  EXPECT_EQ(sum, 5050);
+}
@@ -0,0 +1,323 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/MathUtil.h"
+#include "Core/HW/DSPHLE/UCodes/AXMixing.h"
+#include "Core/HW/DSPHLE/UCodes/AXStructs.h"
+
+using namespace DSP::HLE;
+
+namespace
+{
+// The per-sample implementations that the block based ones have to match.
+u32 ReferenceResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count,
+                           s16* last_samples, u32 curr_pos, u32 ratio, int srctype,
+                           const s16* coeffs)
+{
+  int read_samples_count = 0;
+
+  if (coeffs && srctype == SRCTYPE_POLYPHASE)
+  {
+    s16 temp[4];
+    u32 idx = 0;
+
+    temp[idx++ & 3] = last_samples[0];
+    temp[idx++ & 3] = last_samples[1];
+    temp[idx++ & 3] = last_samples[2];
+    temp[idx++ & 3] = last_samples[3];
+
+    for (u32 i = 0; i < count; ++i)
+    {
+      curr_pos += ratio;
+      while (curr_pos >= 0x10000)
+      {
+        temp[idx++ & 3] = input_callback(read_samples_count++);
+        curr_pos -= 0x10000;
+      }
+
+      u16 curr_pos_frac = ((curr_pos & 0xFFFF) >> 9) << 2;
+      const s16* c = &coeffs[curr_pos_frac];
+
+      s64 t0 = temp[idx++ & 3];
+      s64 t1 = temp[idx++ & 3];
+      s64 t2 = temp[idx++ & 3];
+      s64 t3 = temp[idx++ & 3];
+
+      s64 samp = (t0 * c[0] + t1 * c[1] + t2 * c[2] + t3 * c[3]) >> 15;
+
+      output[i] = MathUtil::SaturatingCast<s16>(samp);
+    }
+
+    last_samples[3] = temp[--idx & 3];
+    last_samples[2] = temp[--idx & 3];
+    last_samples[1] = temp[--idx & 3];
+    last_samples[0] = temp[--idx & 3];
+  }
+  else if (srctype == SRCTYPE_LINEAR || srctype == SRCTYPE_POLYPHASE)
+  {
+    s16 temp[4];
+    u32 idx = 0;
+
+    temp[idx++ & 3] = last_samples[0];
+    temp[idx++ & 3] = last_samples[1];
+    temp[idx++ & 3] = last_samples[2];
+    temp[idx++ & 3] = last_samples[3];
+
+    for (u32 i = 0; i < count; ++i)
+    {
+      curr_pos += ratio;
+      while (curr_pos >= 0x10000)
+      {
+        temp[idx++ & 3] = input_callback(read_samples_count++);
+        curr_pos -= 0x10000;
+      }
+
+      u16 curr_frac = curr_pos & 0xFFFF;
+      u16 inv_curr_frac = -curr_frac;
+
+      s16 sample;
+      if (curr_frac)
+      {
+        s32 s0 = temp[idx++ & 3];
+        s32 s1 = temp[idx++ & 3];
+
+        sample = ((s0 * inv_curr_frac) + (s1 * curr_frac)) >> 16;
+        idx += 2;
+      }
+      else
+      {
+        sample = temp[idx++ & 3];
+        idx += 3;
+      }
+
+      output[i] = sample;
+    }
+
+    last_samples[3] = temp[--idx & 3];
+    last_samples[2] = temp[--idx & 3];
+    last_samples[1] = temp[--idx & 3];
+    last_samples[0] = temp[--idx & 3];
+  }
+  else
+  {
+    for (u32 i = 0; i < count; ++i)
+      output[i] = input_callback(i);
+
+    std::copy_n(output + count - 4, 4, last_samples);
+  }
+
+  return curr_pos;
+}
+
+s16 ReferenceApplyVolumeEnvelope(s16* samples, u32 count, s16 cur_volume, s16 cur_volume_delta,
+                                 bool unsigned_volume)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    const s32 volume = unsigned_volume ? (u16)cur_volume : (s16)cur_volume;
+    const s32 sample = ((s32)samples[i] * volume) >> 15;
+    samples[i] = std::clamp(sample, -32767, 32767);
+    cur_volume += cur_volume_delta;
+  }
+  return cur_volume;
+}
+
+void ReferenceMixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bool ramp)
+{
+  u16& volume = vd->volume;
+  u16 volume_delta = vd->volume_delta;
+
+  if (!ramp)
+    volume_delta = 0;
+
+  for (u32 i = 0; i < count; ++i)
+  {
+    s64 sample = input[i];
+    sample *= volume;
+    sample >>= 15;
+    sample = std::clamp((s32)sample, -32767, 32767);
+
+    out[i] += (s16)sample;
+    volume += volume_delta;
+
+    *dpop = (s16)sample;
+  }
+}
+
+// Random samples, with a good chance of hitting the extreme values.
+s16 RandomSample(std::mt19937& rng)
+{
+  switch (rng() % 8)
+  {
+  case 0:
+    return -32768;
+  case 1:
+    return 32767;
+  default:
+    return static_cast<s16>(rng());
+  }
+}
+
+std::vector<s16> RandomSamples(std::mt19937& rng, size_t count)
+{
+  std::vector<s16> samples(count);
+  std::generate(samples.begin(), samples.end(), [&rng] { return RandomSample(rng); });
+  return samples;
+}
+}  // namespace
+
+TEST(AXMixing, ResampleAudio)
+{
+  std::mt19937 rng(0x4158);
+
+  // One set of polyphase filters, followed by a second set to test coefficient offsets.
+  const std::vector<s16> coeffs = RandomSamples(rng, 0x400);
+
+  constexpr std::array<u32, 5> counts = {32, 96, 18, 6, 5};
+  constexpr std::array<u32, 9> ratios = {0x10000, 0x8000,  0x5555,   0x55555, 0x1,
+                                         0x0,     0x18000, 0x123456, 0xffff};
+
+  for (int iteration = 0; iteration < 200; ++iteration)
+  {
+    for (const int srctype : {SRCTYPE_POLYPHASE, SRCTYPE_LINEAR, SRCTYPE_NEAREST})
+    {
+      for (const bool has_coeffs : {true, false})
+      {
+        for (const u32 count : counts)
+        {
+          const u32 ratio = iteration == 0 ? ratios[count % ratios.size()] :
+                                             static_cast<u32>(rng() % 0x40000);
+          const u32 curr_pos = rng() & 0xFFFF;
+          const s16* const filters = has_coeffs ? coeffs.data() + (rng() & 1) * 0x200 : nullptr;
+
+          std::array<s16, 4> history;
+          std::generate(history.begin(), history.end(), [&rng] { return RandomSample(rng); });
+
+          const u32 input_count = GetResampleInputCount(count, curr_pos, ratio, srctype);
+          std::vector<s16> input = RandomSamples(rng, RESAMPLE_HISTORY_SIZE + input_count);
+          std::copy(history.begin(), history.end(), input.begin());
+
+          std::vector<s16> expected(count);
+          std::array<s16, 4> expected_history = history;
+          u32 read_count = 0;
+          const u32 expected_pos = ReferenceResampleAudio(
+              [&](u32 i) {
+                read_count++;
+                return input[RESAMPLE_HISTORY_SIZE + i];
+              },
+              expected.data(), count, expected_history.data(), curr_pos, ratio, srctype, filters);
+
+          std::vector<s16> actual(count);
+          std::array<s16, 4> actual_history = history;
+          const u32 actual_pos = ResampleAudio(input.data(), actual.data(), count,
+                                               actual_history.data(), curr_pos, ratio, srctype,
+                                               filters);
+
+          SCOPED_TRACE(testing::Message() << "srctype " << srctype << ", count " << count
+                                          << ", ratio " << ratio << ", position " << curr_pos);
+          EXPECT_EQ(read_count, input_count);
+          EXPECT_EQ(expected_pos, actual_pos);
+          EXPECT_EQ(expected, actual);
+          EXPECT_EQ(expected_history, actual_history);
+        }
+      }
+    }
+  }
+}
+
+TEST(AXMixing, PolyphaseOverflow)
+{
+  // All operands at -32768 make each pair of products sum up to exactly 2^31.
+  std::vector<s16> coeffs(0x200, -32768);
+  std::vector<s16> input(RESAMPLE_HISTORY_SIZE + 64, -32768);
+  input[20] = 32767;
+  input[31] = 0;
+
+  for (const u32 ratio : {0x10000u, 0x8000u, 0x20000u})
+  {
+    const u32 count = 32;
+    std::array<s16, 4> expected_history;
+    std::copy_n(input.begin(), 4, expected_history.begin());
+    std::array<s16, 4> actual_history = expected_history;
+
+    std::vector<s16> expected(count);
+    ReferenceResampleAudio([&](u32 i) { return input[RESAMPLE_HISTORY_SIZE + i]; },
+                           expected.data(), count, expected_history.data(), 0, ratio,
+                           SRCTYPE_POLYPHASE, coeffs.data());
+
+    std::vector<s16> actual(count);
+    ResampleAudio(input.data(), actual.data(), count, actual_history.data(), 0, ratio,
+                  SRCTYPE_POLYPHASE, coeffs.data());
+
+    EXPECT_EQ(expected, actual);
+    EXPECT_EQ(expected_history, actual_history);
+  }
+}
+
+TEST(AXMixing, ApplyVolumeEnvelope)
+{
+  std::mt19937 rng(0x564f4c);
+
+  for (int iteration = 0; iteration < 1000; ++iteration)
+  {
+    for (const bool unsigned_volume : {false, true})
+    {
+      const u32 count = iteration % 2 ? 96 : rng() % 100;
+      const s16 volume = RandomSample(rng);
+      const s16 volume_delta = iteration % 3 ? static_cast<s16>(rng()) : 0;
+
+      std::vector<s16> expected = RandomSamples(rng, count);
+      std::vector<s16> actual = expected;
+
+      const s16 expected_volume = ReferenceApplyVolumeEnvelope(expected.data(), count, volume,
+                                                               volume_delta, unsigned_volume);
+      const s16 actual_volume =
+          ApplyVolumeEnvelope(actual.data(), count, volume, volume_delta, unsigned_volume);
+
+      EXPECT_EQ(expected_volume, actual_volume);
+      EXPECT_EQ(expected, actual);
+    }
+  }
+}
+
+TEST(AXMixing, MixAdd)
+{
+  std::mt19937 rng(0x4d4958);
+
+  for (int iteration = 0; iteration < 1000; ++iteration)
+  {
+    for (const bool ramp : {false, true})
+    {
+      const u32 count = iteration % 2 ? 32 : rng() % 100;
+      const std::vector<s16> input = RandomSamples(rng, count);
+      const VolumeData volume{static_cast<u16>(RandomSample(rng)), static_cast<u16>(rng())};
+      const s16 dpop = static_cast<s16>(rng());
+
+      std::vector<int> expected(count);
+      std::generate(expected.begin(), expected.end(),
+                    [&rng] { return static_cast<int>(rng() % 0x1000000) - 0x800000; });
+      std::vector<int> actual = expected;
+      VolumeData expected_volume = volume;
+      VolumeData actual_volume = volume;
+      s16 expected_dpop = dpop;
+      s16 actual_dpop = dpop;
+
+      ReferenceMixAdd(expected.data(), input.data(), count, &expected_volume, &expected_dpop,
+                      ramp);
+      MixAdd(actual.data(), input.data(), count, &actual_volume, &actual_dpop, ramp);
+
+      EXPECT_EQ(expected, actual);
+      EXPECT_EQ(expected_volume.volume, actual_volume.volume);
+      EXPECT_EQ(expected_dpop, actual_dpop);
+    }
+  }
+}
@@ -0,0 +1,228 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/BitUtils.h"
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+#include "Core/CheatSearchCompare.h"
+
+using Cheats::CompareType;
+
+namespace
+{
+constexpr CompareType COMPARE_TYPES[] = {CompareType::Equal,       CompareType::NotEqual,
+                                         CompareType::Less,        CompareType::LessOrEqual,
+                                         CompareType::Greater,     CompareType::GreaterOrEqual};
+
+template <typename T>
+T ReadBigEndian(const u8* data)
+{
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return Common::FromBigEndian(value);
+}
+
+template <typename T>
+bool ReferenceCompare(CompareType op, T a, T b)
+{
+  switch (op)
+  {
+  case CompareType::Equal:
+    return a == b;
+  case CompareType::NotEqual:
+    return a != b;
+  case CompareType::Less:
+    return a < b;
+  case CompareType::LessOrEqual:
+    return a <= b;
+  case CompareType::Greater:
+    return a > b;
+  default:
+    return a >= b;
+  }
+}
+
+// Random bytes, with a lot of repeated values so that equality checks match often.
+std::vector<u8> MakeData(size_t size, u32 seed)
+{
+  std::mt19937 rng(seed);
+  std::vector<u8> data(size);
+  for (u8& byte : data)
+    byte = rng() % 4 == 0 ? static_cast<u8>(rng()) : static_cast<u8>(rng() % 3 * 0x7F);
+  return data;
+}
+
+template <typename T>
+std::vector<T> InterestingValues()
+{
+  std::vector<T> values = {T(0), T(1), std::numeric_limits<T>::max(),
+                           std::numeric_limits<T>::lowest()};
+  if constexpr (std::is_same_v<T, float>)
+  {
+    values.push_back(std::numeric_limits<float>::quiet_NaN());
+    values.push_back(-0.0f);
+    values.push_back(Common::BitCast<float>(0x7F7F7F7Fu));
+  }
+  else if constexpr (std::is_same_v<T, double>)
+  {
+    values.push_back(std::numeric_limits<double>::quiet_NaN());
+    values.push_back(Common::BitCast<double>(0x7F7F7F7F7F7F7F7Full));
+  }
+  else
+  {
+    values.push_back(static_cast<T>(0x7F7F7F7F7F7F7F7Full));
+    values.push_back(static_cast<T>(0xFEFEFEFEFEFEFEFEull));
+  }
+  return values;
+}
+
+template <typename T>
+void ExpectMatches(const std::vector<u64>& matches, size_t count,
+                   const std::function<bool(size_t)>& expected, CompareType op)
+{
+  for (size_t i = 0; i < (count + 63) / 64 * 64; ++i)
+  {
+    const bool actual = (matches[i / 64] >> (i % 64)) & 1;
+    if (actual != (i < count && expected(i)))
+    {
+      ADD_FAILURE() << "sizeof(T) = " << sizeof(T) << ", op " << static_cast<int>(op)
+                    << ", count " << count << ", index " << i;
+      return;
+    }
+  }
+}
+
+template <typename T>
+void TestType()
+{
+  const std::vector<u8> data = MakeData(4096, sizeof(T));
+  const std::vector<u8> old_data = MakeData(4096, sizeof(T) + 100);
+
+  for (const size_t stride : {size_t{1}, sizeof(T)})
+  {
+    // Odd offsets and counts exercise the unaligned loads and the scalar tail.
+    for (const size_t offset : {size_t{0}, size_t{3}})
+    {
+      for (const size_t count : {size_t{0}, size_t{1}, size_t{63}, size_t{64}, size_t{200}})
+      {
+        const u8* const new_base = data.data() + offset;
+        const u8* const old_base = old_data.data() + offset;
+        // The extra word checks that nothing is written past the end.
+        std::vector<u64> matches((count + 63) / 64 + 1, ~u64{0});
+
+        for (const CompareType op : COMPARE_TYPES)
+        {
+          for (const T value : InterestingValues<T>())
+          {
+            Cheats::CompareValues<T>(new_base, count, stride, op, value, matches.data());
+            EXPECT_EQ(matches.back(), ~u64{0});
+            ExpectMatches<T>(
+                matches, count,
+                [&](size_t i) {
+                  return ReferenceCompare(op, ReadBigEndian<T>(new_base + i * stride), value);
+                },
+                op);
+          }
+
+          Cheats::CompareValues<T>(new_base, old_base, count, stride, op, matches.data());
+          EXPECT_EQ(matches.back(), ~u64{0});
+          ExpectMatches<T>(
+              matches, count,
+              [&](size_t i) {
+                return ReferenceCompare(op, ReadBigEndian<T>(new_base + i * stride),
+                                        ReadBigEndian<T>(old_base + i * stride));
+              },
+              op);
+        }
+      }
+    }
+  }
+}
+}  // namespace
+
+TEST(CheatSearchCompare, U8)
+{
+  TestType<u8>();
+}
+
+TEST(CheatSearchCompare, U16)
+{
+  TestType<u16>();
+}
+
+TEST(CheatSearchCompare, U32)
+{
+  TestType<u32>();
+}
+
+TEST(CheatSearchCompare, U64)
+{
+  TestType<u64>();
+}
+
+TEST(CheatSearchCompare, S8)
+{
+  TestType<s8>();
+}
+
+TEST(CheatSearchCompare, S16)
+{
+  TestType<s16>();
+}
+
+TEST(CheatSearchCompare, S32)
+{
+  TestType<s32>();
+}
+
+TEST(CheatSearchCompare, S64)
+{
+  TestType<s64>();
+}
+
+TEST(CheatSearchCompare, F32)
+{
+  TestType<float>();
+}
+
+TEST(CheatSearchCompare, F64)
+{
+  TestType<double>();
+}
+
+// Times a search over all of a Wii's memory. The per-type tests check the results, so this one only
+// runs with --gtest_also_run_disabled_tests.
+TEST(CheatSearchCompare, DISABLED_Benchmark)
+{
+  // The size of MEM1 and MEM2 together on a Wii.
+  constexpr size_t SIZE = 88 * 1024 * 1024;
+  std::vector<u8> data(SIZE);
+  for (size_t i = 0; i < SIZE; ++i)
+    data[i] = static_cast<u8>(i * 7);
+  std::vector<u64> matches(SIZE / 64);
+
+  const auto start = std::chrono::steady_clock::now();
+  Cheats::CompareValues<u8>(data.data(), SIZE, 1, CompareType::Equal, u8(0x7F), matches.data());
+  const std::chrono::duration<double, std::milli> u8_elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  const auto start_u32 = std::chrono::steady_clock::now();
+  Cheats::CompareValues<u32>(data.data(), SIZE / 4, 4, CompareType::Greater, u32(0x1000),
+                             matches.data());
+  const std::chrono::duration<double, std::milli> u32_elapsed =
+      std::chrono::steady_clock::now() - start_u32;
+
+  fmt::print("Comparing 88 MiB: {:.2f} ms as u8, {:.2f} ms as aligned u32\n", u8_elapsed.count(),
+             u32_elapsed.count());
+}
@@ -3,9 +3,15 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
 #include <bitset>
+#include <chrono>
 #include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
 
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
@@ -401,3 +407,173 @@ TEST(CoreTiming, Overclocking)
   Config::SetCurrent(Config::MAIN_OVERCLOCK, 1.0f);
   AdvanceAndCheck(system, 4, MAX_SLICE_LENGTH);
 }
+
+TEST(CoreTiming, IdleLoopStats)
+{
+  auto& system = Core::System::GetInstance();
+
+  ScopeInit guard(system);
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  // Syncing with the GPU needs a video backend.
+  Config::SetCurrent(Config::MAIN_SYNC_ON_SKIP_IDLE, false);
+
+  auto& core_timing = system.GetCoreTiming();
+  auto& ppc_state = system.GetPPCState();
+
+  CoreTiming::EventType* cb_a = core_timing.RegisterEvent("callbackA", CallbackTemplate<0>);
+
+  // Enter slice 0
+  core_timing.Advance();
+
+  core_timing.RecordIdleLoopDetection(0x80003100);
+  core_timing.RecordIdleLoopDetection(0x80003100);
+
+  core_timing.ScheduleEvent(1000, cb_a, CB_IDS[0]);
+  ppc_state.downcount = 400;  // Pretend that the loop ran for 600 cycles.
+  core_timing.IdleLoop(0x80003100);
+  EXPECT_EQ(0, ppc_state.downcount);
+  AdvanceAndCheck(system, 0, MAX_SLICE_LENGTH);
+
+  core_timing.IdleLoop(0x80004000);
+  EXPECT_EQ(0, ppc_state.downcount);
+
+  const std::vector<CoreTiming::IdleLoopStats> stats = core_timing.GetIdleLoopStats();
+  ASSERT_EQ(2u, stats.size());
+  EXPECT_EQ(0x80004000u, stats[0].address);
+  EXPECT_EQ(0u, stats[0].detections);
+  EXPECT_EQ(1u, stats[0].times_idled);
+  EXPECT_EQ(MAX_SLICE_LENGTH, stats[0].cycles_skipped);
+  EXPECT_EQ(0x80003100u, stats[1].address);
+  EXPECT_EQ(2u, stats[1].detections);
+  EXPECT_EQ(1u, stats[1].times_idled);
+  EXPECT_EQ(400, stats[1].cycles_skipped);
+  EXPECT_EQ(core_timing.GetIdleTicks(), u64{MAX_SLICE_LENGTH + 400});
+}
+
+namespace EventQueueTest
+{
+static std::vector<u64> s_fired;
+
+static void RecordCallback(Core::System& system, u64 userdata, s64 lateness)
+{
+  s_fired.push_back(userdata);
+}
+
+static std::array<CoreTiming::EventType*, 32> s_types;
+static u32 s_rng = 1;
+static u64 s_fired_count = 0;
+
+static u32 NextRandom()
+{
+  s_rng = s_rng * 1103515245 + 12345;
+  return s_rng >> 8;
+}
+
+// Reschedules itself like the periodic hardware events do.
+static void RescheduleCallback(Core::System& system, u64 userdata, s64 lateness)
+{
+  ++s_fired_count;
+  system.GetCoreTiming().ScheduleEvent(100 + NextRandom() % 10000 - lateness,
+                                       s_types[userdata % s_types.size()], userdata);
+}
+}  // namespace EventQueueTest
+
+TEST(CoreTiming, RemoveEventKeepsOrder)
+{
+  using namespace EventQueueTest;
+  auto& system = Core::System::GetInstance();
+
+  ScopeInit guard(system);
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  // Don't sleep when running events.
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+
+  auto& core_timing = system.GetCoreTiming();
+  auto& ppc_state = system.GetPPCState();
+
+  std::array<CoreTiming::EventType*, 5> types;
+  for (size_t i = 0; i < types.size(); ++i)
+    types[i] = core_timing.RegisterEvent(fmt::format("callback{}", i), RecordCallback);
+
+  // Enter slice 0
+  core_timing.Advance();
+
+  // (time, userdata) of the events that should run, in the order they should run in.
+  std::vector<std::pair<s64, u64>> expected;
+  s_rng = 1;
+  for (u64 i = 0; i < 1000; ++i)
+  {
+    // Lots of events are scheduled for the same time, which must run in the order they were added.
+    const s64 time = NextRandom() % 200 * 50;
+    const size_t type = NextRandom() % types.size();
+    core_timing.ScheduleEvent(time, types[type], i);
+    if (type != 1 && type != 3)
+      expected.emplace_back(time, i);
+  }
+  core_timing.RemoveEvent(types[1]);
+  core_timing.RemoveEvent(types[3]);
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  s_fired.clear();
+  while (s_fired.size() < expected.size())
+  {
+    ppc_state.downcount = 0;  // Run until the next event.
+    core_timing.Advance();
+  }
+
+  ASSERT_EQ(expected.size(), s_fired.size());
+  for (size_t i = 0; i < expected.size(); ++i)
+    EXPECT_EQ(expected[i].second, s_fired[i]);
+  EXPECT_EQ(MAX_SLICE_LENGTH, ppc_state.downcount);
+}
+
+// A million advances with a busy event queue. The ordering is checked by the tests above, so this
+// is disabled and only run with --gtest_also_run_disabled_tests.
+TEST(CoreTiming, DISABLED_Benchmark)
+{
+  using namespace EventQueueTest;
+  auto& system = Core::System::GetInstance();
+
+  ScopeInit guard(system);
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+
+  auto& core_timing = system.GetCoreTiming();
+  auto& ppc_state = system.GetPPCState();
+
+  for (size_t i = 0; i < s_types.size(); ++i)
+    s_types[i] = core_timing.RegisterEvent(fmt::format("callback{}", i), RescheduleCallback);
+
+  core_timing.Advance();
+
+  // A few events of every type, like the EXI, SI, DVD and audio events of a running game.
+  s_rng = 1;
+  for (u64 i = 0; i < s_types.size() * 4; ++i)
+    core_timing.ScheduleEvent(NextRandom() % 10000, s_types[i % s_types.size()], i);
+
+  constexpr u32 ADVANCES = 1000000;
+  s_fired_count = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (u32 i = 0; i < ADVANCES; ++i)
+  {
+    // Some hardware cancels and reschedules its events all the time.
+    if (i % 4 == 0)
+    {
+      const u64 type = NextRandom() % s_types.size();
+      core_timing.RemoveEvent(s_types[type]);
+      core_timing.ScheduleEvent(NextRandom() % 10000, s_types[type], type);
+    }
+
+    ppc_state.downcount = 0;
+    core_timing.Advance();
+  }
+  const std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  fmt::print("{} advances running {} events: {:.2f} M advances/s, {:.2f} M events/s\n", ADVANCES,
+             s_fired_count, ADVANCES / elapsed.count(), s_fired_count / elapsed.count());
+}
@@ -0,0 +1,101 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/DSP/DSPAnalyzer.h"
+#include "Core/DSP/DSPCodeUtil.h"
+#include "Core/DSP/DSPCore.h"
+#include "Core/DSP/DSPTables.h"
+
+class DSPAnalyzerTest : public testing::Test
+{
+protected:
+  DSPAnalyzerTest()
+  {
+    DSP::InitInstructionTable();
+
+    // Fill IRAM with HALT opcodes, like SDSP::Initialize does
+    m_iram.fill(0x0021);
+    m_irom.fill(0x0021);
+    m_core.DSPState().iram = m_iram.data();
+    m_core.DSPState().irom = m_irom.data();
+  }
+
+  ~DSPAnalyzerTest() override
+  {
+    m_core.DSPState().iram = nullptr;
+    m_core.DSPState().irom = nullptr;
+  }
+
+  const DSP::Analyzer& Analyze(const std::string& text)
+  {
+    const std::string header = "DSCR: equ 0xffc9\n"
+                               "DMBH: equ 0xfffc\n"
+                               "CMBH: equ 0xfffe\n";
+    std::vector<u16> code;
+    EXPECT_TRUE(DSP::Assemble(header + text, code));
+    std::copy(code.begin(), code.end(), m_iram.begin());
+
+    DSP::SDSP& state = m_core.DSPState();
+    state.GetAnalyzer().Analyze(state);
+    return state.GetAnalyzer();
+  }
+
+private:
+  DSP::DSPCore m_core;
+  std::array<u16, DSP::DSP_IRAM_SIZE> m_iram{};
+  std::array<u16, DSP::DSP_IROM_SIZE> m_irom{};
+};
+
+TEST_F(DSPAnalyzerTest, MailboxPollingLoop)
+{
+  const DSP::Analyzer& analyzer = Analyze("  nop\n"
+                                          "wait:\n"
+                                          "  lr $ax0.h, @CMBH\n"
+                                          "  tstaxh $ax0.h\n"
+                                          "  jge wait\n"
+                                          "  halt\n");
+  EXPECT_TRUE(analyzer.IsIdleSkip(1));
+  EXPECT_FALSE(analyzer.IsIdleSkip(0));
+}
+
+TEST_F(DSPAnalyzerTest, DMAPollingLoop)
+{
+  const DSP::Analyzer& analyzer = Analyze("  nop\n"
+                                          "wait:\n"
+                                          "  lr $ac1.m, @DSCR\n"
+                                          "  andf $ac1.m, #0x4\n"
+                                          "  jlnz wait\n"
+                                          "  halt\n");
+  EXPECT_TRUE(analyzer.IsIdleSkip(1));
+}
+
+TEST_F(DSPAnalyzerTest, LoopWithStoreIsNotIdle)
+{
+  const DSP::Analyzer& analyzer = Analyze("  nop\n"
+                                          "wait:\n"
+                                          "  lr $ac0.m, @CMBH\n"
+                                          "  si @DMBH, #0x1234\n"
+                                          "  andcf $ac0.m, #0x8000\n"
+                                          "  jlnz wait\n"
+                                          "  halt\n");
+  EXPECT_FALSE(analyzer.IsIdleSkip(1));
+}
+
+TEST_F(DSPAnalyzerTest, LoopOnDRAMIsNotIdle)
+{
+  const DSP::Analyzer& analyzer = Analyze("  nop\n"
+                                          "wait:\n"
+                                          "  lr $ac0.m, @0x0352\n"
+                                          "  andcf $ac0.m, #0x8000\n"
+                                          "  jlnz wait\n"
+                                          "  halt\n");
+  EXPECT_FALSE(analyzer.IsIdleSkip(1));
+}
@@ -0,0 +1,439 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/DSP/DSPCodeUtil.h"
+#include "Core/DSP/DSPCore.h"
+#include "Core/DSP/DSPTables.h"
+#include "Core/DSP/Interpreter/DSPInterpreter.h"
+#include "Core/DSP/Jit/DSPEmitterBase.h"
+
+#if defined(_M_X86_64)
+#include "Core/DSP/Jit/x64/DSPEmitter.h"
+#endif
+
+// include order is important
+#include <gtest/gtest.h>  // NOLINT
+
+namespace
+{
+// Every instruction under test gets a small slot of IRAM of its own, so that the recompiler
+// does not have to throw its block cache away after every single test.
+constexpr u16 SLOT_SIZE = 8;
+constexpr u16 SLOT_COUNT = 0x100;
+
+// Target of all branches, and the immediate of all two-word instructions. It is well outside of
+// the slots, and as a data address it points into DRAM.
+constexpr u16 FAR_ADDRESS = 0x0f00;
+
+constexpr u16 OPCODE_NOP = 0x0000;
+constexpr u16 OPCODE_JMP = 0x029f;
+
+struct Memory
+{
+  std::array<u16, DSP::DSP_IRAM_SIZE> iram{};
+  std::array<u16, DSP::DSP_DRAM_SIZE> dram{};
+  std::array<u16, DSP::DSP_IROM_SIZE> irom{};
+  std::array<u16, DSP::DSP_COEF_SIZE> coef{};
+};
+
+// The recompiler is created directly rather than through CreateDSPEmitter, so that hosts without
+// one skip the tests instead of comparing the interpreter against itself.
+std::unique_ptr<DSP::JIT::DSPEmitter> CreateHostEmitter([[maybe_unused]] DSP::DSPCore& core)
+{
+#if defined(_M_X86_64)
+  return std::make_unique<DSP::JIT::x64::DSPEmitter>(core);
+#else
+  return nullptr;
+#endif
+}
+
+bool IsExcluded(DSP::UDSPInstruction inst)
+{
+  const char* name = DSP::GetOpTemplate(inst)->name;
+  const std::string_view view{name};
+
+  // The recompilers leave HALT by returning to the address on top of the call stack, while
+  // the interpreter stays on the HALT instruction.
+  if (view == "HALT")
+    return true;
+  // SI always writes to the hardware registers, which would start DMAs and mailbox transfers.
+  if (view == "SI")
+    return true;
+
+  return false;
+}
+
+void RandomizeState(std::mt19937& rng, DSP::SDSP& state)
+{
+  const auto random_u16 = [&rng] { return static_cast<u16>(rng()); };
+  // Keep pointers inside the upper half of DRAM and away from the slots.
+  const auto random_address = [&rng] { return static_cast<u16>(0x0800 | (rng() & 0x07ff)); };
+
+  DSP::DSP_Regs& r = state.r;
+  for (size_t i = 0; i < 4; i++)
+  {
+    r.ar[i] = random_address();
+    r.ix[i] = random_u16();
+    r.wr[i] = random_u16();
+    r.st[i] = random_address();
+  }
+  r.cr = 0;
+  r.sr = random_u16();
+  r.prod.val = (static_cast<u64>(rng()) << 32) | rng();
+  for (size_t i = 0; i < 2; i++)
+  {
+    r.ax[i].val = static_cast<u32>(rng());
+    // The accumulators are 40 bits wide and always kept sign extended.
+    const u64 ac = (static_cast<u64>(rng()) << 32) | rng();
+    r.ac[i].val = static_cast<u64>(static_cast<s64>(ac << 24) >> 24);
+  }
+
+  for (size_t i = 0; i < 4; i++)
+  {
+    state.reg_stack_ptrs[i] = static_cast<u8>(rng() & DSP::DSP_STACK_MASK);
+    for (u16& value : state.reg_stacks[i])
+      value = random_address();
+  }
+
+  state.control_reg = 0;
+  state.exceptions = 0;
+}
+
+void CopyState(const DSP::SDSP& source, DSP::SDSP& dest)
+{
+  dest.r = source.r;
+  dest.pc = source.pc;
+  dest.control_reg = source.control_reg;
+  dest.exceptions = source.exceptions;
+  std::copy(std::begin(source.reg_stack_ptrs), std::end(source.reg_stack_ptrs),
+            std::begin(dest.reg_stack_ptrs));
+  for (size_t i = 0; i < 4; i++)
+  {
+    std::copy(std::begin(source.reg_stacks[i]), std::end(source.reg_stacks[i]),
+              std::begin(dest.reg_stacks[i]));
+  }
+  std::copy(source.dram, source.dram + DSP::DSP_DRAM_SIZE, dest.dram);
+}
+
+testing::AssertionResult StatesMatch(const DSP::SDSP& expected, const DSP::SDSP& actual)
+{
+  const DSP::DSP_Regs& e = expected.r;
+  const DSP::DSP_Regs& a = actual.r;
+  const auto compare = [](const char* name, size_t index, u16 expected_value, u16 actual_value) {
+    if (expected_value == actual_value)
+      return testing::AssertionSuccess();
+    return testing::AssertionFailure()
+           << fmt::format("{}{}: {:04x} != {:04x}", name, index, expected_value, actual_value);
+  };
+  for (size_t i = 0; i < 4; i++)
+  {
+    for (const auto& result :
+         {compare("ar", i, e.ar[i], a.ar[i]), compare("ix", i, e.ix[i], a.ix[i]),
+          compare("wr", i, e.wr[i], a.wr[i]), compare("st", i, e.st[i], a.st[i])})
+    {
+      if (!result)
+        return result;
+    }
+  }
+  if (e.cr != a.cr)
+    return testing::AssertionFailure() << fmt::format("cr: {:04x} != {:04x}", e.cr, a.cr);
+  if (e.sr != a.sr)
+    return testing::AssertionFailure() << fmt::format("sr: {:04x} != {:04x}", e.sr, a.sr);
+  if (e.prod.val != a.prod.val)
+  {
+    return testing::AssertionFailure()
+           << fmt::format("prod: {:016x} != {:016x}", e.prod.val, a.prod.val);
+  }
+  for (size_t i = 0; i < 2; i++)
+  {
+    if (e.ax[i].val != a.ax[i].val)
+    {
+      return testing::AssertionFailure()
+             << fmt::format("ax{}: {:08x} != {:08x}", i, e.ax[i].val, a.ax[i].val);
+    }
+    // Only the low 16 bits of the high part are visible to DSP code.
+    for (const auto& result : {compare("ac.h", i, e.ac[i].h, a.ac[i].h),
+                               compare("ac.m", i, e.ac[i].m, a.ac[i].m),
+                               compare("ac.l", i, e.ac[i].l, a.ac[i].l)})
+    {
+      if (!result)
+        return result;
+    }
+  }
+  if (expected.pc != actual.pc)
+  {
+    return testing::AssertionFailure()
+           << fmt::format("pc: {:04x} != {:04x}", expected.pc, actual.pc);
+  }
+  if (expected.control_reg != actual.control_reg || expected.exceptions != actual.exceptions)
+    return testing::AssertionFailure() << "control register or pending exceptions differ";
+  for (size_t i = 0; i < 4; i++)
+  {
+    if (expected.reg_stack_ptrs[i] != actual.reg_stack_ptrs[i] ||
+        !std::equal(std::begin(expected.reg_stacks[i]), std::end(expected.reg_stacks[i]),
+                    std::begin(actual.reg_stacks[i])))
+    {
+      return testing::AssertionFailure() << "stack " << i << " differs";
+    }
+  }
+  if (!std::equal(expected.dram, expected.dram + DSP::DSP_DRAM_SIZE, actual.dram))
+    return testing::AssertionFailure() << "DRAM differs";
+
+  return testing::AssertionSuccess();
+}
+}  // namespace
+
+class DSPJitTest : public testing::Test
+{
+protected:
+  DSPJitTest()
+  {
+    DSP::InitInstructionTable();
+
+    AttachMemory(m_interpreter_core, m_interpreter_memory);
+    AttachMemory(m_jit_core, m_jit_memory);
+  }
+
+  ~DSPJitTest() override
+  {
+    DetachMemory(m_interpreter_core);
+    DetachMemory(m_jit_core);
+  }
+
+  // Both cores get the same IRAM contents.
+  void WriteIRAM(u16 address, u16 value)
+  {
+    m_interpreter_memory.iram[address] = value;
+    m_jit_memory.iram[address] = value;
+  }
+
+  // Runs inst at the start of IRAM on the recompiler, followed by a jump out of the block.
+  DSP::SDSP& RunOnRecompiler(DSP::JIT::DSPEmitter& emitter, DSP::UDSPInstruction inst)
+  {
+    WriteIRAM(0, inst);
+    WriteIRAM(1, OPCODE_NOP);
+    WriteIRAM(2, OPCODE_JMP);
+    WriteIRAM(3, FAR_ADDRESS);
+    emitter.ClearIRAM();
+
+    DSP::SDSP& state = m_jit_core.DSPState();
+    state.pc = 0;
+    for (int step = 0; step < 8 && state.pc != FAR_ADDRESS; step++)
+      emitter.RunCycles(1);
+    return state;
+  }
+
+  DSP::DSPCore m_interpreter_core;
+  DSP::DSPCore m_jit_core;
+
+private:
+  static void AttachMemory(DSP::DSPCore& core, Memory& memory)
+  {
+    // Fill IRAM with HALT opcodes, like SDSP::Initialize does
+    memory.iram.fill(0x0021);
+    memory.irom.fill(0x0021);
+
+    DSP::SDSP& state = core.DSPState();
+    state.iram = memory.iram.data();
+    state.dram = memory.dram.data();
+    state.irom = memory.irom.data();
+    state.coef = memory.coef.data();
+  }
+
+  static void DetachMemory(DSP::DSPCore& core)
+  {
+    DSP::SDSP& state = core.DSPState();
+    state.iram = nullptr;
+    state.dram = nullptr;
+    state.irom = nullptr;
+    state.coef = nullptr;
+  }
+
+  Memory m_interpreter_memory;
+  Memory m_jit_memory;
+};
+
+// Runs every instruction once on the interpreter and once on the recompiler, starting from the
+// same random state, and checks that both end up in the same state.
+TEST_F(DSPJitTest, MatchesInterpreter)
+{
+  const auto emitter = CreateHostEmitter(m_jit_core);
+  if (!emitter)
+    GTEST_SKIP() << "There is no DSP recompiler for this host.";
+
+  std::mt19937 rng(0x05d5a1);
+  DSP::SDSP& interpreter_state = m_interpreter_core.DSPState();
+  DSP::SDSP& jit_state = m_jit_core.DSPState();
+  std::generate(interpreter_state.dram, interpreter_state.dram + DSP::DSP_DRAM_SIZE,
+                [&rng] { return static_cast<u16>(rng()); });
+
+  u32 tested = 0;
+  for (u32 i = 0; i < 0x10000; i++)
+  {
+    const auto inst = static_cast<DSP::UDSPInstruction>(i);
+    const DSP::DSPOPCTemplate* const op_template = DSP::GetOpTemplate(inst);
+    if (op_template == nullptr || IsExcluded(inst))
+      continue;
+
+    const u16 slot = tested % SLOT_COUNT;
+    if (slot == 0)
+      emitter->ClearIRAM();
+    tested++;
+
+    // The recompilers do not charge any cycles for a block that is left by its very first
+    // instruction, so RunCycles(1) would carry on into the branch target. NOPs in front of the
+    // instruction and in front of the exit jump (which IF and LOOPI may skip one of) make sure
+    // that every block ends up costing at least one cycle.
+    const u16 base = slot * SLOT_SIZE;
+    u16 address = base;
+    WriteIRAM(address++, OPCODE_NOP);
+    WriteIRAM(address++, inst);
+    if (op_template->size == 2)
+      WriteIRAM(address++, FAR_ADDRESS);
+    WriteIRAM(address++, OPCODE_NOP);
+    WriteIRAM(address++, OPCODE_NOP);
+    WriteIRAM(address++, OPCODE_JMP);
+    WriteIRAM(address++, FAR_ADDRESS);
+    const u16 end = address;
+
+    RandomizeState(rng, interpreter_state);
+    interpreter_state.pc = base;
+    CopyState(interpreter_state, jit_state);
+
+    const auto in_slot = [base, end](u16 pc) { return pc >= base && pc < end; };
+
+    // Each of the two runs stops once the slot has been left.
+    constexpr int MAX_STEPS = 8;
+
+    for (int step = 0; step < MAX_STEPS && in_slot(interpreter_state.pc); step++)
+      m_interpreter_core.GetInterpreter().Step();
+
+    for (int step = 0; step < MAX_STEPS && in_slot(jit_state.pc); step++)
+      emitter->RunCycles(1);
+
+    ASSERT_TRUE(StatesMatch(interpreter_state, jit_state))
+        << fmt::format("{:04x} ({})", inst, op_template->name);
+  }
+
+  EXPECT_GT(tested, 0U);
+}
+
+// The flags are computed from the accumulator after it has been sign extended from 40 bits.
+TEST_F(DSPJitTest, ShiftFlagsUseSignExtendedAccumulator)
+{
+  const auto emitter = CreateHostEmitter(m_jit_core);
+  if (!emitter)
+    GTEST_SKIP() << "There is no DSP recompiler for this host.";
+
+  // LSL16 $ac0
+  m_jit_core.DSPState().r.ac[0].val = 0x0000800000;
+  const DSP::SDSP& state = RunOnRecompiler(*emitter, 0xf000);
+
+  EXPECT_EQ(state.r.ac[0].val, 0xffffff8000000000);
+  EXPECT_NE(state.r.sr & DSP::SR_SIGN, 0);
+}
+
+// x86 masks shift counts to 6 bits, which must not keep LSR from clearing the accumulator.
+TEST_F(DSPJitTest, LogicalShiftRightBy40ClearsAccumulator)
+{
+  const auto emitter = CreateHostEmitter(m_jit_core);
+  if (!emitter)
+    GTEST_SKIP() << "There is no DSP recompiler for this host.";
+
+  // LSR $ac0, #-40
+  m_jit_core.DSPState().r.ac[0].val = 0x7f12345678;
+  const DSP::SDSP& state = RunOnRecompiler(*emitter, 0x1458);
+
+  EXPECT_EQ(state.r.ac[0].val, 0);
+  EXPECT_NE(state.r.sr & DSP::SR_ARITH_ZERO, 0);
+}
+
+TEST_F(DSPJitTest, ADDPAXZSetsCarry)
+{
+  const auto emitter = CreateHostEmitter(m_jit_core);
+  if (!emitter)
+    GTEST_SKIP() << "There is no DSP recompiler for this host.";
+
+  // ADDPAXZ $ac0, $ax0 with $prod = -0x10000 and $ax0 = 0x10000
+  DSP::SDSP& initial_state = m_jit_core.DSPState();
+  initial_state.r.prod.l = 0;
+  initial_state.r.prod.m = 0xffff;
+  initial_state.r.prod.h = 0xff;
+  initial_state.r.prod.m2 = 0;
+  initial_state.r.ax[0].val = 0x10000;
+  const DSP::SDSP& state = RunOnRecompiler(*emitter, 0xf800);
+
+  EXPECT_EQ(state.r.ac[0].val, 0);
+  EXPECT_NE(state.r.sr & DSP::SR_CARRY, 0);
+  EXPECT_NE(state.r.sr & DSP::SR_ARITH_ZERO, 0);
+}
+
+// Conditional jumps and calls are linked to their target block once it has been compiled. Only
+// the taken path leaves through the link, so the register cache has to be in the same state on
+// the path that isn't taken.
+TEST_F(DSPJitTest, LinkedConditionalBranchesMatchInterpreter)
+{
+  const auto emitter = CreateHostEmitter(m_jit_core);
+  if (!emitter)
+    GTEST_SKIP() << "There is no DSP recompiler for this host.";
+
+  // Both the loop's back edge and the jump to add_sixteen are conditional branches that get linked
+  // once their destinations have been compiled. The accumulators are modified right before each
+  // branch, so that they are still dirty in the register cache. The nop at the end label is needed
+  // because a block consisting of a lone branch is counted as taking no cycles.
+  constexpr char code[] = R"(
+        lri     $AC1.M, #0x10
+        clr     $ACC0
+loop:
+        call    step
+        tst     $ACC1
+        jnz     loop
+end:
+        nop
+        jmp     end
+step:
+        addis   $AC1.M, #-1
+        callnz  add_one
+        jnz     add_sixteen
+        ret
+add_one:
+        addis   $AC0.M, #0x1
+        ret
+add_sixteen:
+        addis   $AC0.M, #0x10
+        ret
+)";
+  std::vector<u16> binary;
+  ASSERT_TRUE(DSP::Assemble(code, binary));
+  for (size_t i = 0; i < binary.size(); i++)
+    WriteIRAM(static_cast<u16>(i), binary[i]);
+  emitter->ClearIRAM();
+
+  DSP::SDSP& interpreter_state = m_interpreter_core.DSPState();
+  DSP::SDSP& jit_state = m_jit_core.DSPState();
+  interpreter_state.pc = 0;
+  CopyState(interpreter_state, jit_state);
+
+  // The recompiler only follows a link if there are enough cycles left for the next block, so it
+  // is given enough of them to reach the end label in one go. It then spins there a block at a
+  // time, while the interpreter is stepped until it gets there for the first time.
+  constexpr u16 END_ADDRESS = 8;
+  constexpr u16 CYCLES = 1000;
+  for (u16 step = 0; step < CYCLES && interpreter_state.pc != END_ADDRESS; step++)
+    m_interpreter_core.GetInterpreter().Step();
+  emitter->RunCycles(CYCLES);
+
+  // add_one runs for 15 of the 16 iterations, and add_sixteen after each of those.
+  EXPECT_EQ(interpreter_state.r.ac[0].m, 15 * 0x11);
+  EXPECT_TRUE(StatesMatch(interpreter_state, jit_state));
+}
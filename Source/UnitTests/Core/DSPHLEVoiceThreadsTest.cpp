@@ -0,0 +1,520 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/BitUtils.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/CoreTiming.h"
+#include "Core/DSPEmulator.h"
+#include "Core/HW/DSP.h"
+#include "Core/HW/DSPHLE/DSPHLE.h"
+#include "Core/HW/DSPHLE/UCodes/AXStructs.h"
+#include "Core/HW/DSPHLE/UCodes/Zelda.h"
+#include "Core/HW/DSPHLE/VoiceWorkers.h"
+#include "Core/HW/Memmap.h"
+#include "Core/System.h"
+#include "UICommon/UICommon.h"
+
+using namespace DSP::HLE;
+
+// These tests render the same voices with and without the voice worker threads, and check that
+// every byte the ucodes write to RAM comes out the same.
+
+namespace
+{
+constexpr u32 CMDLIST_ADDR = 0x00100000;
+constexpr u32 PB_ADDR = 0x00200000;
+constexpr u32 PB_STRIDE = 0x200;
+constexpr u32 UPDATES_ADDR = 0x00300000;
+constexpr u32 OUTPUT_ADDR = 0x00400000;
+constexpr u32 FRAME_OUTPUT_STRIDE = 0x10000;
+constexpr u32 MRAM_SAMPLES_ADDR = 0x00800000;
+
+constexpr u32 NUM_VOICES = 24;
+constexpr u32 NUM_FRAMES = 4;
+
+// Compared against a run without voice threads. NUM_VOICES doesn't split evenly across 3 + 1
+// threads.
+constexpr std::array<int, 2> VOICE_THREAD_COUNTS = {1, 3};
+
+// Mails understood by all the AX ucodes.
+constexpr u32 MAIL_CMDLIST = 0xBABE0000;
+constexpr u32 MAIL_CONTINUE = 0xCDD10003;
+
+class ScopeInit final
+{
+public:
+  explicit ScopeInit(bool wii)
+      : m_system(Core::System::GetInstance()), m_profile_path(File::CreateTempDir())
+  {
+    if (!UserDirectoryExists())
+      return;
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    SConfig::GetInstance().bWii = wii;
+    m_system.GetMemory().Init();
+    m_system.GetDSP().Init(true);
+  }
+  ~ScopeInit()
+  {
+    if (!UserDirectoryExists())
+      return;
+    m_system.GetDSP().Shutdown();
+    m_system.GetCoreTiming().UnregisterAllEvents();
+    m_system.GetMemory().Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+  bool UserDirectoryExists() const { return !m_profile_path.empty(); }
+
+private:
+  Core::System& m_system;
+  std::string m_profile_path;
+};
+
+void FillRandom(std::mt19937& rng, u8* ptr, size_t size)
+{
+  for (size_t i = 0; i + sizeof(u32) <= size; i += sizeof(u32))
+  {
+    const u32 value = rng();
+    std::memcpy(ptr + i, &value, sizeof(value));
+  }
+}
+
+// Gives every run the same RAM and ARAM contents, so that the results only depend on the number
+// of voice threads.
+void FillMemory(Core::System& system, std::mt19937& rng)
+{
+  auto& memory = system.GetMemory();
+  FillRandom(rng, memory.GetRAM(), memory.GetRamSizeReal());
+  if (!SConfig::GetInstance().bWii)
+    FillRandom(rng, system.GetDSP().GetARAMPtr(), DSP::ARAM_SIZE);
+}
+
+std::vector<u8> CopyRAM(Core::System& system)
+{
+  auto& memory = system.GetMemory();
+  return std::vector<u8>(memory.GetRAM(), memory.GetRAM() + memory.GetRamSizeReal());
+}
+
+void ExpectSameRAM(const std::vector<u8>& serial, const std::vector<u8>& parallel,
+                   int voice_threads)
+{
+  ASSERT_EQ(serial.size(), parallel.size());
+  const auto mismatch = std::mismatch(serial.begin(), serial.end(), parallel.begin());
+  EXPECT_TRUE(mismatch.first == serial.end())
+      << "With " << voice_threads << " voice threads, the first difference is at 0x" << std::hex
+      << (mismatch.first - serial.begin());
+}
+
+template <typename T>
+void WriteWords(Core::System& system, u32 address, const T& data)
+{
+  auto& memory = system.GetMemory();
+  const auto words = Common::BitCastToArray<u16>(data);
+  for (size_t i = 0; i < words.size(); ++i)
+    memory.Write_U16(words[i], address + static_cast<u32>(i * sizeof(u16)));
+}
+
+template <typename T>
+T RandomWords(std::mt19937& rng)
+{
+  std::array<u16, sizeof(T) / sizeof(u16)> words;
+  for (u16& word : words)
+    word = static_cast<u16>(rng());
+  return Common::BitCastFromArray<u16, T>(words);
+}
+
+u32 PBAddress(u32 index)
+{
+  return index < NUM_VOICES ? PB_ADDR + index * PB_STRIDE : 0;
+}
+
+// Fills in the parts of a PB that both AX flavours share. Everything else is random.
+template <typename PB>
+void SetUpPB(std::mt19937& rng, u32 index, PB& pb)
+{
+  static constexpr std::array<u16, 3> formats = {AUDIOFORMAT_ADPCM, AUDIOFORMAT_PCM8,
+                                                 AUDIOFORMAT_PCM16};
+
+  const u32 next_pb = PBAddress(index + 1);
+  pb.next_pb_hi = next_pb >> 16;
+  pb.next_pb_lo = next_pb & 0xFFFF;
+  pb.this_pb_hi = PBAddress(index) >> 16;
+  pb.this_pb_lo = PBAddress(index) & 0xFFFF;
+
+  pb.src_type = rng() % 3;
+  pb.running = 1;
+  pb.is_stream = rng() & 1;
+  pb.initial_time_delay.on = 0;
+
+  pb.vol_env.cur_volume = rng() & 0x7FFF;
+  pb.vol_env.cur_volume_delta = static_cast<s16>(rng() % 64) - 32;
+
+  // ARAM addresses are masked, and Wii addresses without 0x10000000 point to MEM1, so any address
+  // is safe to read samples from.
+  const u32 start = 0x10000 * (index + 1);
+  const u32 loop = start + 0x100;
+  const u32 end = start + 0x8000;
+  pb.audio_addr.looping = rng() & 1;
+  pb.audio_addr.sample_format = formats[rng() % formats.size()];
+  pb.audio_addr.loop_addr_hi = loop >> 16;
+  pb.audio_addr.loop_addr_lo = loop & 0xFFFF;
+  pb.audio_addr.end_addr_hi = end >> 16;
+  pb.audio_addr.end_addr_lo = end & 0xFFFF;
+  pb.audio_addr.cur_addr_hi = start >> 16;
+  pb.audio_addr.cur_addr_lo = start & 0xFFFF;
+
+  pb.adpcm.pred_scale &= 0x7F;
+  pb.adpcm_loop_info.pred_scale &= 0x7F;
+
+  // Between 0.5 and 2.
+  pb.src.ratio_hi = rng() & 1;
+  pb.src.ratio_lo = (rng() & 0x7FFF) | (pb.src.ratio_hi ? 0 : 0x8000);
+
+  pb.lpf.enabled = rng() & 1;
+}
+
+void SendMail(DSPEmulator* dsp, u32 mail)
+{
+  dsp->DSP_WriteMailBoxHigh(true, mail >> 16);
+  dsp->DSP_WriteMailBoxLow(true, mail & 0xFFFF);
+}
+
+void WriteCommandList(Core::System& system, u32 address, const std::vector<u16>& cmdlist)
+{
+  auto& memory = system.GetMemory();
+  for (size_t i = 0; i < cmdlist.size(); ++i)
+    memory.Write_U16(cmdlist[i], address + static_cast<u32>(i * sizeof(u16)));
+}
+
+void AddAddress(std::vector<u16>* cmdlist, u32 address)
+{
+  cmdlist->push_back(address >> 16);
+  cmdlist->push_back(address & 0xFFFF);
+}
+
+// Runs a few frames through an AX ucode, and returns MEM1 afterwards.
+template <typename WritePBs, typename MakeCommandList>
+std::vector<u8> RunAX(bool wii, u32 crc, int voice_threads, const WritePBs& write_pbs,
+                      const MakeCommandList& make_cmdlist)
+{
+  auto& system = Core::System::GetInstance();
+  Config::SetCurrent(Config::MAIN_DSP_HLE_VOICE_THREADS, voice_threads);
+
+  DSPEmulator* dsp = system.GetDSP().GetDSPEmulator();
+  auto* dsp_hle = static_cast<DSPHLE*>(dsp);
+  dsp_hle->Initialize(wii, false);
+  dsp_hle->SetUCode(crc);
+  EXPECT_EQ(dsp_hle->GetVoiceWorkers().IsParallel(), voice_threads > 0);
+
+  std::mt19937 rng(0x1234);
+  FillMemory(system, rng);
+  write_pbs(rng);
+
+  for (u32 frame = 0; frame < NUM_FRAMES; ++frame)
+  {
+    const u32 cmdlist_addr = CMDLIST_ADDR + frame * 0x100;
+    const std::vector<u16> cmdlist = make_cmdlist(OUTPUT_ADDR + frame * FRAME_OUTPUT_STRIDE);
+    WriteCommandList(system, cmdlist_addr, cmdlist);
+
+    if (frame != 0)
+      SendMail(dsp, MAIL_CONTINUE);
+    SendMail(dsp, MAIL_CMDLIST | static_cast<u32>(cmdlist.size()));
+    SendMail(dsp, cmdlist_addr);
+  }
+
+  dsp_hle->Shutdown();
+  return CopyRAM(system);
+}
+}  // namespace
+
+TEST(DSPHLEVoiceThreads, AXGameCubeIsBitIdentical)
+{
+  ScopeInit scope_init(false);
+  if (!scope_init.UserDirectoryExists())
+  {
+    FAIL() << "Couldn't create temporary directory";
+    return;
+  }
+  auto& system = Core::System::GetInstance();
+
+  const auto write_pbs = [&system](std::mt19937& rng) {
+    for (u32 i = 0; i < NUM_VOICES; ++i)
+    {
+      AXPB pb = RandomWords<AXPB>(rng);
+      SetUpPB(rng, i, pb);
+      pb.mixer_control = rng() & 0x1F;
+
+      const u32 updates_addr = UPDATES_ADDR + i * 0x40;
+      pb.updates.data_hi = updates_addr >> 16;
+      pb.updates.data_lo = updates_addr & 0xFFFF;
+      std::fill(std::begin(pb.updates.num_updates), std::end(pb.updates.num_updates), 0);
+      if (i % 5 == 2 && i + 2 < NUM_VOICES)
+      {
+        // Change the volume in the first millisecond, and skip the next PB from the third one
+        // on. The parallel path has to follow the list the same way.
+        pb.updates.num_updates[0] = 1;
+        pb.updates.num_updates[2] = 1;
+        const u32 skip_to = PBAddress(i + 2);
+        const std::array<u16, 4> updates = {
+            static_cast<u16>(offsetof(AXPB, vol_env) / sizeof(u16)),
+            static_cast<u16>(rng() & 0x7FFF),
+            static_cast<u16>(offsetof(AXPB, next_pb_lo) / sizeof(u16)),
+            static_cast<u16>(skip_to & 0xFFFF),
+        };
+        WriteWords(system, updates_addr, updates);
+      }
+
+      WriteWords(system, PBAddress(i), pb);
+    }
+  };
+
+  const auto make_cmdlist = [](u32 output_addr) {
+    std::vector<u16> cmdlist;
+    cmdlist.push_back(0x00);  // CMD_SETUP
+    AddAddress(&cmdlist, output_addr + 0x8000);
+    cmdlist.push_back(0x02);  // CMD_PB_ADDR
+    AddAddress(&cmdlist, PB_ADDR);
+    cmdlist.push_back(0x03);  // CMD_PROCESS
+    for (u16 cmd : {0x04, 0x05})  // CMD_MIX_AUXA, CMD_MIX_AUXB
+    {
+      cmdlist.push_back(cmd);
+      AddAddress(&cmdlist, output_addr + (cmd - 0x04 + 1) * 0x1000);
+      AddAddress(&cmdlist, output_addr + 0x9000);
+    }
+    cmdlist.push_back(0x0E);  // CMD_OUTPUT
+    AddAddress(&cmdlist, output_addr + 0x3000);
+    AddAddress(&cmdlist, output_addr);
+    cmdlist.push_back(0x0F);  // CMD_END
+    return cmdlist;
+  };
+
+  // 0x4e8a8b21 is the most common GameCube AX ucode, and has its own mixer control format.
+  for (u32 crc : {0x4e8a8b21u, 0x07f88145u})
+  {
+    const std::vector<u8> serial = RunAX(false, crc, 0, write_pbs, make_cmdlist);
+    for (int voice_threads : VOICE_THREAD_COUNTS)
+    {
+      ExpectSameRAM(serial, RunAX(false, crc, voice_threads, write_pbs, make_cmdlist),
+                    voice_threads);
+    }
+  }
+}
+
+TEST(DSPHLEVoiceThreads, AXWiiIsBitIdentical)
+{
+  ScopeInit scope_init(true);
+  if (!scope_init.UserDirectoryExists())
+  {
+    FAIL() << "Couldn't create temporary directory";
+    return;
+  }
+  auto& system = Core::System::GetInstance();
+
+  const auto write_pbs = [&system](std::mt19937& rng) {
+    for (u32 i = 0; i < NUM_VOICES; ++i)
+    {
+      AXPBWii pb = RandomWords<AXPBWii>(rng);
+      SetUpPB(rng, i, pb);
+      pb.biquad.on = (rng() & 1) ? FILTER_BIQUAD : 0;
+      pb.remote = rng() & 1;
+      WriteWords(system, PBAddress(i), pb);
+    }
+  };
+
+  const auto make_cmdlist = [](u32 output_addr) {
+    std::vector<u16> cmdlist;
+    cmdlist.push_back(0x00);  // CMD_SETUP
+    AddAddress(&cmdlist, output_addr + 0x8000);
+    cmdlist.push_back(0x04);  // CMD_PROCESS
+    AddAddress(&cmdlist, PB_ADDR);
+    for (u16 cmd : {0x05, 0x06, 0x07})  // CMD_MIX_AUXA, CMD_MIX_AUXB, CMD_MIX_AUXC
+    {
+      cmdlist.push_back(cmd);
+      cmdlist.push_back(0x6000);
+      AddAddress(&cmdlist, output_addr + (cmd - 0x05 + 1) * 0x1000);
+      AddAddress(&cmdlist, output_addr + 0x9000);
+    }
+    cmdlist.push_back(0x0B);  // CMD_OUTPUT
+    cmdlist.push_back(0x8000);
+    AddAddress(&cmdlist, output_addr + 0x4000);
+    AddAddress(&cmdlist, output_addr);
+    cmdlist.push_back(0x0D);  // CMD_WM_OUTPUT
+    for (u32 i = 0; i < 4; ++i)
+      AddAddress(&cmdlist, output_addr + 0x5000 + i * 0x100);
+    cmdlist.push_back(0x0E);  // CMD_END
+    return cmdlist;
+  };
+
+  // Raving Rabbids uses the newer AXWii command list format.
+  constexpr u32 crc = 0x347112ba;
+  const std::vector<u8> serial = RunAX(true, crc, 0, write_pbs, make_cmdlist);
+  for (int voice_threads : VOICE_THREAD_COUNTS)
+    ExpectSameRAM(serial, RunAX(true, crc, voice_threads, write_pbs, make_cmdlist), voice_threads);
+}
+
+namespace
+{
+// Word offsets into a Zelda VPB.
+constexpr size_t VPB_SIZE = 0xC0;
+constexpr size_t VPB_ENABLED = 0x00;
+constexpr size_t VPB_DONE = 0x01;
+constexpr size_t VPB_RESAMPLING_RATIO = 0x02;
+constexpr size_t VPB_RESET = 0x04;
+constexpr size_t VPB_END_REACHED = 0x05;
+constexpr size_t VPB_USE_CONSTANT_SAMPLE = 0x06;
+constexpr size_t VPB_CHANNELS = 0x08;
+constexpr size_t VPB_USE_DOLBY_VOLUME = 0x2C;
+constexpr size_t VPB_CURRENT_POS_FRAC = 0x30;
+constexpr size_t VPB_AFC_REMAINING_DECODED_SAMPLES = 0x32;
+constexpr size_t VPB_CURRENT_POSITION = 0x34;
+constexpr size_t VPB_REMAINING_LENGTH = 0x3A;
+constexpr size_t VPB_SAMPLES_SOURCE_TYPE = 0x80;
+constexpr size_t VPB_IS_LOOPING = 0x81;
+constexpr size_t VPB_END_REQUESTED = 0x85;
+constexpr size_t VPB_LOOP_ADDRESS = 0x88;
+constexpr size_t VPB_LOOP_START_POSITION = 0x8A;
+constexpr size_t VPB_BASE_ADDRESS = 0x8C;
+
+constexpr u16 SRC_SQUARE_WAVE = 0;
+constexpr u16 SRC_SAW_WAVE = 1;
+constexpr u16 SRC_CONST_PATTERN_1 = 4;
+constexpr u16 SRC_AFC_LQ_FROM_ARAM = 5;
+constexpr u16 SRC_PCM8_FROM_ARAM = 8;
+constexpr u16 SRC_AFC_HQ_FROM_ARAM = 9;
+constexpr u16 SRC_CONST_PATTERN_0_VARIABLE_STEP = 10;
+constexpr u16 SRC_PCM16_FROM_ARAM = 16;
+constexpr u16 SRC_PCM16_FROM_MRAM = 33;
+
+void Set32(std::array<u16, VPB_SIZE>* vpb, size_t offset, u32 value)
+{
+  (*vpb)[offset] = value >> 16;
+  (*vpb)[offset + 1] = value & 0xFFFF;
+}
+
+template <size_t N>
+std::array<s16, N> RandomSamples(std::mt19937& rng)
+{
+  std::array<s16, N> samples;
+  for (s16& sample : samples)
+    sample = static_cast<s16>(rng());
+  return samples;
+}
+
+std::vector<u8> RunZelda(int voice_threads)
+{
+  static constexpr std::array<u16, 9> sources = {
+      SRC_SQUARE_WAVE,      SRC_SAW_WAVE,         SRC_CONST_PATTERN_1,
+      SRC_AFC_LQ_FROM_ARAM, SRC_PCM8_FROM_ARAM,   SRC_AFC_HQ_FROM_ARAM,
+      SRC_PCM16_FROM_ARAM,  SRC_PCM16_FROM_MRAM,  SRC_CONST_PATTERN_0_VARIABLE_STEP,
+  };
+  static constexpr std::array<u16, 8> buffer_ids = {0,      0x0D00, 0x0D60, 0x0F40,
+                                                    0x0CA0, 0x0E80, 0x0EE0, 0x0B00};
+
+  auto& system = Core::System::GetInstance();
+  std::mt19937 rng(0x5678);
+  FillMemory(system, rng);
+
+  for (u32 i = 0; i < NUM_VOICES; ++i)
+  {
+    std::array<u16, VPB_SIZE> vpb;
+    for (u16& word : vpb)
+      word = static_cast<u16>(rng());
+
+    const u16 source = sources[i % sources.size()];
+    vpb[VPB_ENABLED] = 1;
+    vpb[VPB_DONE] = 0;
+    vpb[VPB_RESAMPLING_RATIO] = 0x800 + rng() % 0x1000;
+    vpb[VPB_RESET] = 1;
+    vpb[VPB_END_REACHED] = 0;
+    vpb[VPB_USE_CONSTANT_SAMPLE] = i % 11 == 10;
+    for (size_t channel = 0; channel < 6; ++channel)
+    {
+      vpb[VPB_CHANNELS + channel * 4] = buffer_ids[rng() % buffer_ids.size()];
+      vpb[VPB_CHANNELS + channel * 4 + 1] = rng() & 0x7FFF;
+      vpb[VPB_CHANNELS + channel * 4 + 2] = rng() & 0x7FFF;
+    }
+    vpb[VPB_USE_DOLBY_VOLUME] = i % 4 == 3;
+    vpb[VPB_CURRENT_POS_FRAC] &= 0xFFF;
+    vpb[VPB_AFC_REMAINING_DECODED_SAMPLES] = 0;
+    Set32(&vpb, VPB_CURRENT_POSITION, 0);
+    Set32(&vpb, VPB_REMAINING_LENGTH, 0x1000);
+    vpb[VPB_SAMPLES_SOURCE_TYPE] = source;
+    vpb[VPB_IS_LOOPING] = rng() & 1;
+    vpb[VPB_END_REQUESTED] = i % 6 == 5;
+    Set32(&vpb, VPB_LOOP_START_POSITION, 0x800);
+    if (source == SRC_PCM16_FROM_MRAM)
+    {
+      const u32 address = MRAM_SAMPLES_ADDR + i * 0x10000;
+      Set32(&vpb, VPB_BASE_ADDRESS, address);
+      Set32(&vpb, VPB_LOOP_ADDRESS, address);
+    }
+    else
+    {
+      Set32(&vpb, VPB_BASE_ADDRESS, 0x10000 * (i + 1));
+      Set32(&vpb, VPB_LOOP_ADDRESS, 0x10);
+    }
+
+    WriteWords(system, PB_ADDR + i * VPB_SIZE * sizeof(u16), vpb);
+  }
+
+  ZeldaAudioRenderer renderer;
+  renderer.SetFlags(0);
+  renderer.SetSineTable(RandomSamples<0x80>(rng));
+  renderer.SetConstPatterns(RandomSamples<0x100>(rng));
+  renderer.SetResamplingCoeffs(RandomSamples<0x100>(rng));
+  renderer.SetAfcCoeffs(RandomSamples<0x20>(rng));
+  renderer.SetVPBBaseAddress(PB_ADDR);
+  renderer.SetReverbPBBaseAddress(0);
+  renderer.SetOutputVolume(0x1000);
+  renderer.SetOutputLeftBufferAddr(OUTPUT_ADDR);
+  renderer.SetOutputRightBufferAddr(OUTPUT_ADDR + FRAME_OUTPUT_STRIDE);
+  renderer.SetARAMBaseAddr(0);
+
+  VoiceWorkers workers;
+  workers.SetWorkerCount(voice_threads);
+
+  std::vector<u16> voice_ids(NUM_VOICES);
+  for (u32 i = 0; i < NUM_VOICES; ++i)
+    voice_ids[i] = static_cast<u16>(i);
+
+  for (u32 frame = 0; frame < NUM_FRAMES; ++frame)
+  {
+    renderer.PrepareFrame();
+    renderer.AddVoices(voice_ids, workers);
+    renderer.FinalizeFrame();
+  }
+
+  return CopyRAM(system);
+}
+}  // namespace
+
+TEST(DSPHLEVoiceThreads, ZeldaIsBitIdentical)
+{
+  ScopeInit scope_init(false);
+  if (!scope_init.UserDirectoryExists())
+  {
+    FAIL() << "Couldn't create temporary directory";
+    return;
+  }
+
+  const std::vector<u8> serial = RunZelda(0);
+  for (int voice_threads : VOICE_THREAD_COUNTS)
+    ExpectSameRAM(serial, RunZelda(voice_threads), voice_threads);
+}
@@ -0,0 +1,347 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <optional>
+#include <string>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/MemoryWatcher.h"
+#include "Core/System.h"
+
+namespace
+{
+using Header = MemoryWatcher::SharedMemoryHeader;
+using Record = MemoryWatcher::SharedMemoryRecord;
+
+struct RecordCopy
+{
+  u64 frame;
+  u32 watch_index;
+  u32 value;
+};
+
+// A separate mapping of the shared memory object, read the way another process would.
+class SharedMemoryReader
+{
+public:
+  explicit SharedMemoryReader(const std::string& name)
+  {
+    const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+      return;
+    const off_t size = lseek(fd, 0, SEEK_END);
+    void* const memory = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED)
+      return;
+    m_memory = static_cast<const u8*>(memory);
+    m_size = size;
+  }
+
+  ~SharedMemoryReader()
+  {
+    if (m_memory)
+      munmap(const_cast<u8*>(m_memory), m_size);
+  }
+
+  SharedMemoryReader(const SharedMemoryReader&) = delete;
+  SharedMemoryReader& operator=(const SharedMemoryReader&) = delete;
+
+  bool IsValid() const
+  {
+    return m_memory && m_size >= sizeof(Header) &&
+           GetHeader().magic.load(std::memory_order_acquire) == MemoryWatcher::SHARED_MEMORY_MAGIC;
+  }
+
+  const Header& GetHeader() const { return *reinterpret_cast<const Header*>(m_memory); }
+
+  u32 GetValue(u32 watch_index) const
+  {
+    const auto* values =
+        reinterpret_cast<const std::atomic<u32>*>(m_memory + GetHeader().values_offset);
+    return values[watch_index].load(std::memory_order_relaxed);
+  }
+
+  // Copies record n with the seqlock protocol. Returns nothing if the record was being written or
+  // has already been replaced by a later one.
+  std::optional<RecordCopy> ReadRecord(u64 n) const
+  {
+    const Header& header = GetHeader();
+    const auto* records = reinterpret_cast<const Record*>(m_memory + header.records_offset);
+    const Record& record = records[n % header.record_capacity];
+
+    const u64 sequence_before = record.sequence.load(std::memory_order_acquire);
+    RecordCopy copy;
+    copy.frame = record.frame;
+    copy.watch_index = record.watch_index;
+    copy.value = record.value;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const u64 sequence_after = record.sequence.load(std::memory_order_relaxed);
+
+    if (sequence_before != n + 1 || sequence_after != n + 1)
+      return std::nullopt;
+    return copy;
+  }
+
+private:
+  const u8* m_memory = nullptr;
+  size_t m_size = 0;
+};
+
+class MemoryWatcherTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    if (m_directory.empty())
+      FAIL() << "CreateTempDir failed";
+
+    Core::DeclareAsCPUThread();
+    Config::Init();
+    SConfig::Init();
+    m_memory.Init();
+    File::SetUserPath(F_MEMORYWATCHERLOCATIONS_IDX, m_directory + "/Locations.txt");
+    File::SetUserPath(F_MEMORYWATCHERSOCKET_IDX, m_directory + "/MemoryWatcher");
+  }
+
+  void TearDown() override
+  {
+    m_memory.Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    Core::UndeclareAsCPUThread();
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void WriteLocations(const std::string& locations)
+  {
+    ASSERT_TRUE(
+        File::WriteStringToFile(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX), locations));
+  }
+
+  std::unique_ptr<MemoryWatcher> CreateSharedMemoryWatcher()
+  {
+    Config::SetCurrent(Config::MAIN_MEMORY_WATCHER_SHARED_MEMORY, m_shared_memory_name);
+    return std::make_unique<MemoryWatcher>();
+  }
+
+  void Step(MemoryWatcher& watcher)
+  {
+    Core::CPUThreadGuard guard(m_system);
+    watcher.Step(guard);
+  }
+
+  // Translation is off, so the watched addresses are physical addresses in MEM1.
+  Core::System& m_system = Core::System::GetInstance();
+  Memory::MemoryManager& m_memory = m_system.GetMemory();
+  std::string m_directory = File::CreateTempDir();
+  std::string m_shared_memory_name = fmt::format("/dolphin-memory-watcher-test-{}", getpid());
+};
+}  // namespace
+
+TEST_F(MemoryWatcherTest, FollowsPointerChains)
+{
+  WriteLocations("10\n"
+                 "20 8\n"
+                 "20 C\n"
+                 "20 C 4\n");
+  m_memory.Write_U32(0x11111111, 0x10);
+  m_memory.Write_U32(0x3000, 0x20);
+  m_memory.Write_U32(0xAAAA, 0x3008);
+  m_memory.Write_U32(0x4000, 0x300C);
+  m_memory.Write_U32(0xBBBB, 0x4004);
+
+  const auto watcher = CreateSharedMemoryWatcher();
+  Step(*watcher);
+
+  const SharedMemoryReader reader(m_shared_memory_name);
+  ASSERT_TRUE(reader.IsValid());
+  ASSERT_EQ(reader.GetHeader().watch_count, 4u);
+  EXPECT_EQ(reader.GetValue(0), 0x11111111u);
+  EXPECT_EQ(reader.GetValue(1), 0xAAAAu);
+  EXPECT_EQ(reader.GetValue(2), 0x4000u);
+  EXPECT_EQ(reader.GetValue(3), 0xBBBBu);
+
+  // Moving the shared pointer updates every chain that goes through it.
+  m_memory.Write_U32(0x5000, 0x20);
+  m_memory.Write_U32(0xCCCC, 0x5008);
+  m_memory.Write_U32(0x4000, 0x500C);
+  Step(*watcher);
+  EXPECT_EQ(reader.GetValue(0), 0x11111111u);
+  EXPECT_EQ(reader.GetValue(1), 0xCCCCu);
+  EXPECT_EQ(reader.GetValue(2), 0x4000u);
+  EXPECT_EQ(reader.GetValue(3), 0xBBBBu);
+}
+
+TEST_F(MemoryWatcherTest, StopsAtPointersOutsideOfRAM)
+{
+  WriteLocations("20 8 4\n");
+  m_memory.Write_U32(0x3000, 0x20);
+  m_memory.Write_U32(0xFFFF0000, 0x3008);
+
+  const auto watcher = CreateSharedMemoryWatcher();
+  Step(*watcher);
+
+  // The chain ends at the first value that isn't a RAM address.
+  const SharedMemoryReader reader(m_shared_memory_name);
+  ASSERT_TRUE(reader.IsValid());
+  EXPECT_EQ(reader.GetValue(0), 0xFFFF0000u);
+}
+
+TEST_F(MemoryWatcherTest, IgnoresDuplicateAndEmptyLines)
+{
+  WriteLocations("10\n"
+                 "\n"
+                 "20 8\n"
+                 "10\n"
+                 "20 8\n");
+
+  const auto watcher = CreateSharedMemoryWatcher();
+  const SharedMemoryReader reader(m_shared_memory_name);
+  ASSERT_TRUE(reader.IsValid());
+  EXPECT_EQ(reader.GetHeader().watch_count, 2u);
+}
+
+TEST_F(MemoryWatcherTest, OnlyReportsChanges)
+{
+  WriteLocations("10\n"
+                 "14\n");
+  m_memory.Write_U32(1, 0x10);
+  m_memory.Write_U32(2, 0x14);
+
+  const auto watcher = CreateSharedMemoryWatcher();
+  const SharedMemoryReader reader(m_shared_memory_name);
+  ASSERT_TRUE(reader.IsValid());
+  const Header& header = reader.GetHeader();
+
+  Step(*watcher);
+  EXPECT_EQ(header.frame.load(), 1u);
+  EXPECT_EQ(header.records_written.load(), 2u);
+
+  Step(*watcher);
+  EXPECT_EQ(header.frame.load(), 2u);
+  EXPECT_EQ(header.records_written.load(), 2u);
+
+  m_memory.Write_U32(3, 0x14);
+  Step(*watcher);
+  ASSERT_EQ(header.records_written.load(), 3u);
+  const std::optional<RecordCopy> record = reader.ReadRecord(2);
+  ASSERT_TRUE(record.has_value());
+  EXPECT_EQ(record->frame, 3u);
+  EXPECT_EQ(record->watch_index, 1u);
+  EXPECT_EQ(record->value, 3u);
+}
+
+TEST_F(MemoryWatcherTest, SocketOnlyReceivesChanges)
+{
+  const std::string socket_path = File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX);
+  const int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+  ASSERT_GE(fd, 0);
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+  ASSERT_EQ(bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+
+  const auto receive = [fd] {
+    char buffer[256]{};
+    const ssize_t size = recv(fd, buffer, sizeof(buffer) - 1, MSG_DONTWAIT);
+    return size > 0 ? std::string(buffer) : std::string();
+  };
+
+  WriteLocations("10\n"
+                 "20 8\n");
+  m_memory.Write_U32(0x1234, 0x10);
+  m_memory.Write_U32(0x3000, 0x20);
+  m_memory.Write_U32(0xABCD, 0x3008);
+
+  {
+    MemoryWatcher watcher;
+    Step(watcher);
+    EXPECT_EQ(receive(), "10\n1234\n20 8\nabcd\n");
+
+    Step(watcher);
+    EXPECT_EQ(receive(), "");
+
+    m_memory.Write_U32(0xABCE, 0x3008);
+    Step(watcher);
+    EXPECT_EQ(receive(), "20 8\nabce\n");
+  }
+
+  close(fd);
+}
+
+// Checks the seqlock on the records while a reader races with the writer, including once the ring
+// has wrapped around.
+TEST_F(MemoryWatcherTest, ReaderNeverSeesTornRecords)
+{
+  WriteLocations("10\n");
+
+  const auto watcher = CreateSharedMemoryWatcher();
+  const SharedMemoryReader reader(m_shared_memory_name);
+  ASSERT_TRUE(reader.IsValid());
+  const Header& header = reader.GetHeader();
+  const u64 frame_count = u64{header.record_capacity} * 2 + 100;
+
+  std::atomic<bool> done = false;
+  u64 records_read = 0;
+  u64 torn_records = 0;
+  std::thread reader_thread([&] {
+    // Runs at least once after the writer is done, so that the last record is always checked.
+    bool writer_done;
+    do
+    {
+      writer_done = done.load(std::memory_order_relaxed);
+      const u64 written = header.records_written.load(std::memory_order_acquire);
+      if (written == 0)
+        continue;
+
+      const std::optional<RecordCopy> record = reader.ReadRecord(written - 1);
+      if (!record)
+        continue;
+
+      // Every frame writes its own frame number to the watched address.
+      ++records_read;
+      if (record->value != record->frame || record->watch_index != 0)
+        ++torn_records;
+    } while (!writer_done);
+  });
+
+  for (u64 frame = 1; frame <= frame_count; ++frame)
+  {
+    m_memory.Write_U32(static_cast<u32>(frame), 0x10);
+    Step(*watcher);
+  }
+  done = true;
+  reader_thread.join();
+
+  EXPECT_EQ(header.records_written.load(), frame_count);
+  EXPECT_EQ(torn_records, 0u);
+  EXPECT_GT(records_read, 0u);
+
+  // Only the last record_capacity records are still in the ring.
+  EXPECT_FALSE(reader.ReadRecord(0).has_value());
+  const std::optional<RecordCopy> last = reader.ReadRecord(frame_count - 1);
+  ASSERT_TRUE(last.has_value());
+  EXPECT_EQ(last->frame, frame_count);
+  EXPECT_EQ(last->value, static_cast<u32>(frame_count));
+}
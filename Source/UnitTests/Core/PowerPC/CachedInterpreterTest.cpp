@@ -0,0 +1,121 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/ScopeGuard.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+// include order is important
+#include <gtest/gtest.h>  // NOLINT
+
+namespace
+{
+constexpr u32 LOOP_ADDRESS = 0x00003100;
+
+// A loop of the kind of integer code that games spend a lot of time in. It is written by hand
+// rather than taken from a game, so that the test doesn't need a recorded trace or a disc image.
+constexpr std::array<u32, 12> LOOP = {
+    0x3C608000,  // lis r3, 0x8000
+    0x38631234,  // addi r3, r3, 0x1234
+    0x3C801234,  // lis r4, 0x1234
+    0x60845678,  // ori r4, r4, 0x5678
+    0x7CA51A14,  // add r5, r5, r3
+    0x54A61838,  // rlwinm r6, r5, 3, 0, 28
+    0x68C6FFFF,  // xori r6, r6, 0xFFFF
+    0x7CC73378,  // mr r7, r6
+    0x3907FFFF,  // addi r8, r7, -1
+    0x60000000,  // nop
+    0x7D282850,  // subf r9, r8, r5
+    0x3D490001,  // addis r10, r9, 1
+};
+constexpr u32 BDNZ_LOOP = 0x4200FFD0;  // bdnz LOOP_ADDRESS
+constexpr u32 END_ADDRESS = LOOP_ADDRESS + (LOOP.size() + 1) * 4;
+
+struct RunResult
+{
+  std::array<u32, 32> gpr;
+  double mips;
+};
+
+RunResult RunLoop(PowerPC::PowerPCState& ppc_state, u32 iterations,
+                  const std::function<void()>& step)
+{
+  std::fill(std::begin(ppc_state.gpr), std::end(ppc_state.gpr), 0);
+  CTR(ppc_state) = iterations;
+  ppc_state.pc = LOOP_ADDRESS;
+
+  const auto start = std::chrono::steady_clock::now();
+  while (ppc_state.pc != END_ADDRESS)
+    step();
+  const std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  RunResult result;
+  std::copy(std::begin(ppc_state.gpr), std::end(ppc_state.gpr), result.gpr.begin());
+  result.mips = u64{iterations} * (LOOP.size() + 1) / elapsed.count();
+  return result;
+}
+
+// Runs the loop on the interpreter and then on the cached interpreter, and checks that both end up
+// with the same registers. Returns how fast each of them was, in MIPS.
+std::pair<double, double> RunOnBothInterpreters(u32 iterations)
+{
+  Core::DeclareAsCPUThread();
+  Common::ScopeGuard cpu_thread_guard([] { Core::UndeclareAsCPUThread(); });
+
+  auto& system = Core::System::GetInstance();
+  auto& memory = system.GetMemory();
+  memory.Init();
+  Common::ScopeGuard memory_guard([&memory] { memory.Shutdown(); });
+
+  for (size_t i = 0; i < LOOP.size(); ++i)
+    memory.Write_U32(LOOP[i], LOOP_ADDRESS + static_cast<u32>(i * 4));
+  memory.Write_U32(BDNZ_LOOP, LOOP_ADDRESS + static_cast<u32>(LOOP.size() * 4));
+
+  auto& ppc_state = system.GetPPCState();
+  ppc_state.msr.Hex = 0;
+
+  auto& interpreter = system.GetInterpreter();
+  const RunResult interpreter_result =
+      RunLoop(ppc_state, iterations, [&interpreter] { interpreter.SingleStepInner(); });
+
+  CachedInterpreter cached_interpreter(system);
+  cached_interpreter.Init();
+  Common::ScopeGuard cached_interpreter_guard([&] { cached_interpreter.Shutdown(); });
+  const RunResult cached_interpreter_result = RunLoop(
+      ppc_state, iterations, [&cached_interpreter] { cached_interpreter.ExecuteOneBlock(); });
+
+  EXPECT_EQ(interpreter_result.gpr, cached_interpreter_result.gpr);
+  return {interpreter_result.mips, cached_interpreter_result.mips};
+}
+}  // namespace
+
+TEST(CachedInterpreter, MatchesInterpreter)
+{
+  RunOnBothInterpreters(1000);
+}
+
+// Only prints how fast both interpreters are, so it is disabled by default. Run it with
+// --gtest_also_run_disabled_tests.
+TEST(CachedInterpreter, DISABLED_Benchmark)
+{
+  constexpr u32 ITERATIONS = 1000000;
+  const auto [interpreter_mips, cached_interpreter_mips] = RunOnBothInterpreters(ITERATIONS);
+
+  fmt::print("{} instructions: {:.1f} MIPS interpreted, {:.1f} MIPS cached interpreter\n",
+             u64{ITERATIONS} * (LOOP.size() + 1), interpreter_mips, cached_interpreter_mips);
+}
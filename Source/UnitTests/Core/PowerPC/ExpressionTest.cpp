@@ -0,0 +1,171 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <optional>
+#include <string>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/ScopeGuard.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/BreakPoints.h"
+#include "Core/PowerPC/Expression.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+namespace
+{
+// Writing a register back to itself keeps the expression library from compiling a condition,
+// without changing what it evaluates to.
+std::optional<Expression> ParseInterpreted(const std::string& text)
+{
+  return Expression::TryParse(fmt::format("r31 = r31, ({})", text));
+}
+
+class ExpressionTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    Core::DeclareAsCPUThread();
+    m_memory.Init();
+
+    m_ppc_state.msr.Hex = 0;
+    for (u32 i = 0; i < 32; ++i)
+      m_ppc_state.gpr[i] = i * 0x01010101;
+    m_ppc_state.gpr[3] = 0x00001234;
+    m_ppc_state.ps[1].SetPS0(2.5);
+    m_ppc_state.ps[2].SetPS0(-0.0);
+    LR(m_ppc_state) = 0x80004000;
+    CTR(m_ppc_state) = 7;
+    m_ppc_state.pc = 0x80003000;
+
+    m_memory.Write_U32(0xFFFF8001, 0x00001234);
+    m_memory.Write_U32(0x3FC00000, 0x00001238);
+  }
+
+  void TearDown() override
+  {
+    m_system.GetPowerPC().GetBreakPoints().Clear();
+    m_memory.Shutdown();
+    Core::UndeclareAsCPUThread();
+  }
+
+  Core::System& m_system = Core::System::GetInstance();
+  Memory::MemoryManager& m_memory = m_system.GetMemory();
+  PowerPC::PowerPCState& m_ppc_state = m_system.GetPPCState();
+};
+}  // namespace
+
+TEST_F(ExpressionTest, CompiledMatchesInterpreted)
+{
+  constexpr std::array<const char*, 24> conditions{
+      "r3 == 0x1234",
+      "r3 != 0x1234 || r4 > 3",
+      "r4 && r0",
+      "r0 || r5",
+      "r0 || f2",
+      "r4 && f2",
+      "-r5 + r6 * 3 - r7 / 2",
+      "r9 % 4 == 1 && lr == 0x80004000",
+      "2 ** ctr",
+      "!r0 + !r1",
+      "~r5 & 0xFFFF",
+      "(r5 | r6) ^ (r7 << 4) >> 2",
+      "pc == 0x80003000",
+      "f1 * 2 >= 5",
+      "f1 < 2.5 || f1 <= 2.5",
+      "read_u32(r3) == 0xFFFF8001",
+      "read_s32(r3) + read_s16(r3 + 2) + read_s8(r3 + 3) + read_u8(r3)",
+      "read_u16(r3) + read_f32(r3 + 4)",
+      "read_f64(r3 + 4) != 0",
+      "u8(200) + s8(0xFF) + u16(0xFFFF) + s16(0x8000) + u32(r3) + s32(r31)",
+      "r0, r1, r2",
+      "unknown_variable == 0",
+      "u8(1, 2) + 1",
+      "0 / 0",
+  };
+
+  for (const char* text : conditions)
+  {
+    SCOPED_TRACE(text);
+    const std::optional<Expression> compiled = Expression::TryParse(text);
+    const std::optional<Expression> interpreted = ParseInterpreted(text);
+    ASSERT_TRUE(compiled && interpreted);
+    EXPECT_TRUE(compiled->IsCompiled());
+    EXPECT_FALSE(interpreted->IsCompiled());
+
+    const double expected = interpreted->Evaluate(m_system);
+    const double result = compiled->Evaluate(m_system);
+    if (std::isnan(expected))
+    {
+      EXPECT_TRUE(std::isnan(result));
+    }
+    else
+    {
+      EXPECT_EQ(expected, result);
+      EXPECT_EQ(std::signbit(expected), std::signbit(result));
+    }
+  }
+}
+
+TEST_F(ExpressionTest, UncompilableConditions)
+{
+  for (const char* text : {"r3 = 5", "write_u32(1, r3)", "callstack(0x80003000)",
+                           "streq(r3, \"text\")"})
+  {
+    SCOPED_TRACE(text);
+    const std::optional<Expression> condition = Expression::TryParse(text);
+    ASSERT_TRUE(condition);
+    EXPECT_FALSE(condition->IsCompiled());
+  }
+
+  // Writes still reach the registers.
+  m_ppc_state.gpr[3] = 0;
+  EXPECT_EQ(Expression::TryParse("r3 = r4 + 1")->Evaluate(m_system), 0x01010105);
+  EXPECT_EQ(m_ppc_state.gpr[3], 0x01010105u);
+}
+
+// Compares the cost of compiled and interpreted conditions. The other tests check that both give
+// the same results, so this one is disabled unless --gtest_also_run_disabled_tests is passed.
+TEST_F(ExpressionTest, DISABLED_Benchmark)
+{
+  // A condition on a breakpoint in a hot loop that is almost never true.
+  constexpr char CONDITION[] = "r3 == 0x12345678 && read_u32(r4) > 10";
+  constexpr u32 BREAKPOINT_ADDRESS = 0x80003000;
+  constexpr u32 ITERATIONS = 1000000;
+
+  auto& power_pc = m_system.GetPowerPC();
+  auto& breakpoints = power_pc.GetBreakPoints();
+  m_ppc_state.pc = BREAKPOINT_ADDRESS;
+  m_ppc_state.gpr[4] = 0x00001234;
+
+  const auto measure = [&](std::optional<Expression> condition) {
+    breakpoints.Add(BREAKPOINT_ADDRESS, false, false, false, std::move(condition));
+    Common::ScopeGuard breakpoint_guard([&] { breakpoints.Remove(BREAKPOINT_ADDRESS); });
+
+    const auto start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < ITERATIONS; ++i)
+    {
+      m_ppc_state.gpr[3] = i;
+      power_pc.CheckBreakPoints();
+    }
+    const std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / ITERATIONS;
+  };
+
+  std::optional<Expression> compiled = Expression::TryParse(CONDITION);
+  ASSERT_TRUE(compiled && compiled->IsCompiled());
+  const double compiled_ns = measure(std::move(compiled));
+  const double interpreted_ns = measure(ParseInterpreted(CONDITION));
+
+  fmt::print("Conditional breakpoint check: {:.1f} ns compiled, {:.1f} ns interpreted\n",
+             compiled_ns, interpreted_ns);
+}
@@ -0,0 +1,268 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/ScopeGuard.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/LockstepTester.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+#include "UICommon/UICommon.h"
+
+// include order is important
+#include <gtest/gtest.h>  // NOLINT
+
+namespace
+{
+constexpr u32 CODE_ADDRESS = 0x00003000;
+constexpr u32 RETURN_ADDRESS = 0x00002000;
+constexpr u32 SCRATCH_ADDRESS = 0x00100000;
+constexpr u32 SCRATCH_SIZE = 0x400;
+constexpr u32 BLR = 0x4E800020;
+// bdnz with a branch offset of 0
+constexpr u32 BDNZ = 0x42000000;
+// Everything but the SO bits, which the JITs don't compute (see LockstepTester::SetCRMask).
+constexpr u32 CR_MASK_WITHOUT_SO = 0xEEEEEEEE;
+
+class InstructionGenerator
+{
+public:
+  explicit InstructionGenerator(u32 seed) : m_random(seed) {}
+
+  u32 Generate()
+  {
+    switch (Random(6))
+    {
+    case 0:
+    {
+      // addi, addis, ori, oris, xori, andi., mulli, cmpwi, cmplwi
+      constexpr std::array<u32, 9> opcodes = {14, 15, 24, 25, 26, 28, 7, 11, 10};
+      const u32 opcode = opcodes[Random(opcodes.size())];
+      if (opcode == 11 || opcode == 10)
+        return DForm(opcode, Random(8) << 2, Register(), Random(0x10000));
+      // The logical instructions write to rA rather than rD.
+      if (opcode >= 24)
+        return DForm(opcode, Register(), Destination(), Random(0x10000));
+      return DForm(opcode, Destination(), Register(), Random(0x10000));
+    }
+    case 1:
+    {
+      // add, subf, mullw, addc, adde, subfc, subfe, neg
+      constexpr std::array<u32, 8> subops = {266, 40, 235, 10, 138, 8, 136, 104};
+      return XForm(subops[Random(subops.size())], Destination(), Register(), Register(),
+                   Random(2));
+    }
+    case 2:
+    {
+      // and, or, xor, nor, andc, slw, srw, sraw, srawi, extsb, extsh, cntlzw
+      constexpr std::array<u32, 12> subops = {28,  444, 316, 124, 60,  24,
+                                              536, 792, 824, 954, 922, 26};
+      return XForm(subops[Random(subops.size())], Register(), Destination(), Register(),
+                   Random(2));
+    }
+    case 3:
+    {
+      // rlwinm, rlwimi, rlwnm
+      constexpr std::array<u32, 3> opcodes = {21, 20, 23};
+      return (opcodes[Random(opcodes.size())] << 26) | (Register() << 21) | (Destination() << 16) |
+             (Random(32) << 11) | (Random(32) << 6) | (Random(32) << 1) | Random(2);
+    }
+    case 4:
+    {
+      // cmpw, cmplw
+      return XForm(Random(2) * 32, Random(8) << 2, Register(), Register(), 0);
+    }
+    default:
+    {
+      // lwz, lhz, lha, lbz, stw, sth, stb, all relative to r1
+      constexpr std::array<std::pair<u32, u32>, 7> opcodes = {
+          {{32, 4}, {40, 2}, {42, 2}, {34, 1}, {36, 4}, {44, 2}, {38, 1}}};
+      const auto [opcode, size] = opcodes[Random(opcodes.size())];
+      const bool is_store = opcode == 36 || opcode == 44 || opcode == 38;
+      return DForm(opcode, is_store ? Register() : Destination(), 1,
+                   Random(SCRATCH_SIZE / size) * size);
+    }
+    }
+  }
+
+  u32 Random(size_t bound)
+  {
+    return std::uniform_int_distribution<u32>(0, static_cast<u32>(bound - 1))(m_random);
+  }
+
+private:
+  static u32 DForm(u32 opcode, u32 d, u32 a, u32 immediate)
+  {
+    return (opcode << 26) | (d << 21) | (a << 16) | immediate;
+  }
+
+  static u32 XForm(u32 subop, u32 d, u32 a, u32 b, u32 rc)
+  {
+    return (31 << 26) | (d << 21) | (a << 16) | (b << 11) | (subop << 1) | rc;
+  }
+
+  u32 Register() { return Random(32); }
+
+  // r1 holds the base address of the scratch memory, so it is never overwritten.
+  u32 Destination()
+  {
+    const u32 reg = Random(31);
+    return reg == 1 ? 31 : reg;
+  }
+
+  std::mt19937 m_random;
+};
+
+// Fills the scratch memory and the registers with random values, and sets up the call to
+// CODE_ADDRESS.
+void RandomizeState(InstructionGenerator& generator, Memory::MemoryManager& memory,
+                    PowerPC::PowerPCState& ppc_state)
+{
+  for (u32 i = 0; i < SCRATCH_SIZE; i += 4)
+  {
+    memory.Write_U32(generator.Random(0x10000) << 16 | generator.Random(0x10000),
+                     SCRATCH_ADDRESS + i);
+  }
+  for (u32& gpr : ppc_state.gpr)
+    gpr = generator.Random(0x10000) << 16 | generator.Random(0x10000);
+  ppc_state.gpr[1] = SCRATCH_ADDRESS;
+  ppc_state.cr.Set(generator.Random(0x10000) << 16 | generator.Random(0x10000));
+  ppc_state.xer_ca = generator.Random(2);
+  ppc_state.xer_so_ov = 0;
+  ppc_state.msr.Hex = 0;
+  ppc_state.msr.FP = 1;
+  PowerPC::MSRUpdated(ppc_state);
+  LR(ppc_state) = RETURN_ADDRESS;
+  ppc_state.pc = CODE_ADDRESS;
+}
+
+class ScopeInit final
+{
+public:
+  explicit ScopeInit(Core::System& system) : m_system(system), m_profile_path(File::CreateTempDir())
+  {
+    if (!UserDirectoryExists())
+      return;
+
+    Core::DeclareAsCPUThread();
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    Config::SetCurrent(Config::MAIN_ENABLE_DEBUGGING, true);
+    Config::SetCurrent(Config::MAIN_FASTMEM, false);
+    Config::SetCurrent(Config::MAIN_FASTMEM_ARENA, false);
+    system.GetMemory().Init();
+    system.GetPowerPC().Init(PowerPC::DefaultCPUCore());
+    system.GetCoreTiming().Init();
+  }
+  ~ScopeInit()
+  {
+    if (!UserDirectoryExists())
+      return;
+
+    m_system.GetCoreTiming().Shutdown();
+    m_system.GetPowerPC().Shutdown();
+    m_system.GetMemory().Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    Core::UndeclareAsCPUThread();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+  bool UserDirectoryExists() const { return !m_profile_path.empty(); }
+
+private:
+  Core::System& m_system;
+  std::string m_profile_path;
+};
+}  // namespace
+
+TEST(LockstepTester, RandomIntegerBlocks)
+{
+  auto& system = Core::System::GetInstance();
+  ScopeInit init(system);
+  ASSERT_TRUE(init.UserDirectoryExists());
+
+  PowerPC::LockstepTester tester(system);
+  ASSERT_TRUE(tester.IsAvailable());
+  tester.SetCRMask(CR_MASK_WITHOUT_SO);
+
+  const Core::CPUThreadGuard guard(system);
+  auto& memory = system.GetMemory();
+  auto& ppc_state = system.GetPPCState();
+
+  InstructionGenerator generator(1234);
+  constexpr u32 BLOCK_COUNT = 2000;
+  for (u32 block = 0; block < BLOCK_COUNT; ++block)
+  {
+    const u32 length = 1 + generator.Random(40);
+    for (u32 i = 0; i < length; ++i)
+      memory.Write_U32(generator.Generate(), CODE_ADDRESS + i * 4);
+    memory.Write_U32(BLR, CODE_ADDRESS + length * 4);
+    system.GetJitInterface().ClearCache();
+    RandomizeState(generator, memory, ppc_state);
+
+    const std::optional<PowerPC::LockstepDivergence> divergence = tester.RunBlock(guard);
+    ASSERT_FALSE(divergence) << divergence->ToString();
+    EXPECT_EQ(ppc_state.pc, RETURN_ADDRESS);
+  }
+
+  EXPECT_EQ(tester.GetBlockCount(), BLOCK_COUNT);
+}
+
+// Loops back to the start of the block with bdnz. The tester has to get control back after each
+// iteration, rather than the JIT following the branch into the same block again.
+TEST(LockstepTester, RandomLoopBlocks)
+{
+  auto& system = Core::System::GetInstance();
+  ScopeInit init(system);
+  ASSERT_TRUE(init.UserDirectoryExists());
+
+  PowerPC::LockstepTester tester(system);
+  ASSERT_TRUE(tester.IsAvailable());
+  tester.SetCRMask(CR_MASK_WITHOUT_SO);
+
+  const Core::CPUThreadGuard guard(system);
+  auto& memory = system.GetMemory();
+  auto& ppc_state = system.GetPPCState();
+
+  InstructionGenerator generator(5678);
+  constexpr u32 LOOP_COUNT = 500;
+  constexpr u32 MAX_ITERATIONS = 4;
+  for (u32 loop = 0; loop < LOOP_COUNT; ++loop)
+  {
+    const u32 length = 1 + generator.Random(20);
+    for (u32 i = 0; i < length; ++i)
+      memory.Write_U32(generator.Generate(), CODE_ADDRESS + i * 4);
+    memory.Write_U32(BDNZ | ((0 - length * 4) & 0xFFFC), CODE_ADDRESS + length * 4);
+    memory.Write_U32(BLR, CODE_ADDRESS + (length + 1) * 4);
+    system.GetJitInterface().ClearCache();
+    RandomizeState(generator, memory, ppc_state);
+
+    const u32 iterations = 1 + generator.Random(MAX_ITERATIONS);
+    CTR(ppc_state) = iterations;
+    u32 taken_branches = 0;
+    for (u32 block = 0; block < MAX_ITERATIONS * 2 && ppc_state.pc != RETURN_ADDRESS; ++block)
+    {
+      const std::optional<PowerPC::LockstepDivergence> divergence = tester.RunBlock(guard);
+      ASSERT_FALSE(divergence) << divergence->ToString();
+      if (ppc_state.pc == CODE_ADDRESS)
+        ++taken_branches;
+    }
+    EXPECT_EQ(ppc_state.pc, RETURN_ADDRESS);
+    EXPECT_EQ(taken_branches, iterations - 1);
+    EXPECT_EQ(CTR(ppc_state), 0u);
+  }
+}
@@ -0,0 +1,358 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/Memmap.h"
+#include "Core/MemTools.h"
+#include "Core/PowerPC/BreakPoints.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+#include "UICommon/UICommon.h"
+
+// include order is important
+#include <gtest/gtest.h>  // NOLINT
+
+namespace
+{
+// SDR1 for a 64 KiB page table at 0x00100000.
+constexpr u32 SDR1 = 0x00100000;
+constexpr u32 PAGE_TABLE_ADDRESS = 0x00100000;
+constexpr u32 PAGE_TABLE_HASH_MASK = 0x3FF;
+
+constexpr u32 SEGMENT = 9;
+constexpr u32 VSID = 0x123;
+constexpr u32 OTHER_VSID = 0x456;
+constexpr u32 EFFECTIVE_BASE = SEGMENT << 28;
+constexpr u32 PHYSICAL_BASE = 0x00200000;
+// More pages than fit in the data TLB.
+constexpr u32 PAGE_COUNT = 512;
+
+// Adds a page table entry and returns its physical address.
+u32 MapPage(Memory::MemoryManager& memory, u32 vsid, u32 effective_address, u32 physical_address)
+{
+  const u32 page_index = (effective_address >> PowerPC::HW_PAGE_INDEX_SHIFT) & 0xFFFF;
+  u32 pte_address = PAGE_TABLE_ADDRESS | (((vsid ^ page_index) & PAGE_TABLE_HASH_MASK) << 6);
+  while (UPTE_Lo(memory.Read_U32(pte_address)).V)
+    pte_address += 8;
+
+  UPTE_Lo pte1;
+  pte1.VSID = vsid;
+  pte1.API = page_index >> 10;
+  pte1.V = 1;
+  UPTE_Hi pte2;
+  pte2.RPN = physical_address >> PowerPC::HW_PAGE_INDEX_SHIFT;
+  memory.Write_U32(pte1.Hex, pte_address);
+  memory.Write_U32(pte2.Hex, pte_address + 4);
+  return pte_address;
+}
+
+class MMUTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    Core::DeclareAsCPUThread();
+    Config::Init();
+    SConfig::Init();
+    m_memory.Init();
+
+    for (u32 spr = SPR_DBAT0U; spr <= SPR_DBAT3L; ++spr)
+      m_ppc_state.spr[spr] = 0;
+    for (u32 spr = SPR_DBAT4U; spr <= SPR_DBAT7L; ++spr)
+      m_ppc_state.spr[spr] = 0;
+    m_mmu.DBATUpdated();
+
+    m_ppc_state.spr[SPR_SDR] = SDR1;
+    m_mmu.SDRUpdated();
+    m_ppc_state.SetSR(SEGMENT, VSID);
+
+    for (u32 i = 0; i < PAGE_COUNT; ++i)
+    {
+      m_pte_addresses[i] = MapPage(m_memory, VSID, EFFECTIVE_BASE + i * PowerPC::HW_PAGE_SIZE,
+                                   PHYSICAL_BASE + i * PowerPC::HW_PAGE_SIZE);
+    }
+
+    m_ppc_state.msr.DR = 1;
+  }
+
+  void TearDown() override
+  {
+    m_ppc_state.msr.Hex = 0;
+    m_ppc_state.SetSR(SEGMENT, 0);
+    for (auto& tlb : m_ppc_state.tlb)
+    {
+      for (auto& entry : tlb)
+        entry.Invalidate();
+    }
+    m_mmu.DBATUpdated();
+    m_memory.Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    Core::UndeclareAsCPUThread();
+  }
+
+  Core::System& m_system = Core::System::GetInstance();
+  Memory::MemoryManager& m_memory = m_system.GetMemory();
+  PowerPC::MMU& m_mmu = m_system.GetMMU();
+  PowerPC::PowerPCState& m_ppc_state = m_system.GetPPCState();
+  u32 m_pte_addresses[PAGE_COUNT]{};
+};
+
+// Runs the JIT with the fastmem arena, to check the accesses that memchecks make fault.
+class MMUFastmemTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    if (m_profile_path.empty())
+      FAIL() << "CreateTempDir failed";
+
+    Core::DeclareAsCPUThread();
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    // With debugging enabled and the CPU not running, the JIT returns after each block.
+    Config::SetCurrent(Config::MAIN_ENABLE_DEBUGGING, true);
+    Config::SetCurrent(Config::MAIN_FASTMEM, true);
+    Config::SetCurrent(Config::MAIN_FASTMEM_ARENA, true);
+    EMM::InstallExceptionHandler();
+    m_memory.Init();
+    m_system.GetPowerPC().Init(PowerPC::DefaultCPUCore());
+    m_system.GetCoreTiming().Init();
+  }
+
+  void TearDown() override
+  {
+    if (m_profile_path.empty())
+      return;
+
+    m_system.GetPowerPC().GetMemChecks().Clear();
+    m_system.GetCoreTiming().Shutdown();
+    m_system.GetPowerPC().Shutdown();
+    m_memory.Shutdown();
+    EMM::UninstallExceptionHandler();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    Core::UndeclareAsCPUThread();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+  Core::System& m_system = Core::System::GetInstance();
+  Memory::MemoryManager& m_memory = m_system.GetMemory();
+  PowerPC::MMU& m_mmu = m_system.GetMMU();
+  PowerPC::PowerPCState& m_ppc_state = m_system.GetPPCState();
+  std::string m_profile_path = File::CreateTempDir();
+};
+}  // namespace
+
+TEST_F(MMUTest, TranslatesPageTableAccesses)
+{
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    for (u32 i = 0; i < PAGE_COUNT; ++i)
+    {
+      const u32 offset = i * PowerPC::HW_PAGE_SIZE + 0x10;
+      m_mmu.Write_U32(i + pass, EFFECTIVE_BASE + offset);
+      EXPECT_EQ(m_memory.Read_U32(PHYSICAL_BASE + offset), i + pass);
+      EXPECT_EQ(m_mmu.Read_U32(EFFECTIVE_BASE + offset), i + pass);
+      EXPECT_EQ(m_mmu.Read_U16(EFFECTIVE_BASE + offset + 2), (i + pass) & 0xFFFF);
+    }
+  }
+
+  // Accessing the pages must still set the referenced and changed bits.
+  const UPTE_Hi pte2(m_memory.Read_U32(m_pte_addresses[0] + 4));
+  EXPECT_EQ(pte2.R.Value(), 1u);
+  EXPECT_EQ(pte2.C.Value(), 1u);
+}
+
+TEST_F(MMUTest, TlbieInvalidatesTranslation)
+{
+  constexpr u32 NEW_PHYSICAL_ADDRESS = 0x00500000;
+  m_memory.Write_U32(0x12345678, NEW_PHYSICAL_ADDRESS + 0x10);
+
+  m_mmu.Write_U32(0xCAFEF00D, EFFECTIVE_BASE + 0x10);
+  EXPECT_EQ(m_mmu.Read_U32(EFFECTIVE_BASE + 0x10), 0xCAFEF00D);
+
+  UPTE_Hi pte2(m_memory.Read_U32(m_pte_addresses[0] + 4));
+  pte2.RPN = NEW_PHYSICAL_ADDRESS >> PowerPC::HW_PAGE_INDEX_SHIFT;
+  m_memory.Write_U32(pte2.Hex, m_pte_addresses[0] + 4);
+  m_mmu.InvalidateTLBEntry(EFFECTIVE_BASE);
+
+  EXPECT_EQ(m_mmu.Read_U32(EFFECTIVE_BASE + 0x10), 0x12345678u);
+  m_mmu.Write_U32(0xDEADBEEF, EFFECTIVE_BASE + 0x10);
+  EXPECT_EQ(m_memory.Read_U32(NEW_PHYSICAL_ADDRESS + 0x10), 0xDEADBEEF);
+  EXPECT_EQ(m_memory.Read_U32(PHYSICAL_BASE + 0x10), 0xCAFEF00D);
+}
+
+TEST_F(MMUTest, SegmentRegisterChangesTranslation)
+{
+  constexpr u32 OTHER_PHYSICAL_ADDRESS = 0x00510000;
+  MapPage(m_memory, OTHER_VSID, EFFECTIVE_BASE, OTHER_PHYSICAL_ADDRESS);
+  m_memory.Write_U32(0x12345678, OTHER_PHYSICAL_ADDRESS + 0x10);
+
+  m_mmu.Write_U32(0xCAFEF00D, EFFECTIVE_BASE + 0x10);
+  EXPECT_EQ(m_mmu.Read_U32(EFFECTIVE_BASE + 0x10), 0xCAFEF00D);
+
+  m_ppc_state.SetSR(SEGMENT, OTHER_VSID);
+  EXPECT_EQ(m_mmu.Read_U32(EFFECTIVE_BASE + 0x10), 0x12345678u);
+
+  m_ppc_state.SetSR(SEGMENT, VSID);
+  EXPECT_EQ(m_mmu.Read_U32(EFFECTIVE_BASE + 0x10), 0xCAFEF00D);
+}
+
+TEST_F(MMUTest, MemcheckOnlyAffectsOverlappingPages)
+{
+  // The usual cached mapping of MEM1 at 0x80000000.
+  m_ppc_state.spr[SPR_DBAT0U] = 0x80001FFF;
+  m_ppc_state.spr[SPR_DBAT0L] = 0x00000002;
+  m_mmu.DBATUpdated();
+
+  constexpr u32 WATCHED_ADDRESS = 0x80401230;
+  EXPECT_TRUE(m_mmu.IsOptimizableRAMAddress(WATCHED_ADDRESS));
+
+  TMemCheck mem_check;
+  mem_check.start_address = WATCHED_ADDRESS;
+  mem_check.end_address = WATCHED_ADDRESS + 3;
+  mem_check.is_break_on_write = true;
+  auto& mem_checks = m_system.GetPowerPC().GetMemChecks();
+  mem_checks.Add(std::move(mem_check));
+
+  EXPECT_FALSE(m_mmu.IsOptimizableRAMAddress(WATCHED_ADDRESS));
+  EXPECT_FALSE(m_mmu.IsOptimizableRAMAddress(WATCHED_ADDRESS & ~(PowerPC::BAT_PAGE_SIZE - 1)));
+  EXPECT_TRUE(m_mmu.IsOptimizableRAMAddress(WATCHED_ADDRESS + PowerPC::BAT_PAGE_SIZE));
+  EXPECT_TRUE(m_mmu.IsOptimizableRAMAddress(WATCHED_ADDRESS - PowerPC::BAT_PAGE_SIZE));
+  EXPECT_TRUE(m_mmu.IsOptimizableRAMAddress(0x80000000));
+
+  // Slow accesses to the page still work and check the memcheck.
+  m_mmu.Write_U32(0x12345678, WATCHED_ADDRESS - 4);
+  EXPECT_EQ(mem_checks.GetMemCheck(WATCHED_ADDRESS)->num_hits, 0u);
+  m_mmu.Write_U32(0x9ABCDEF0, WATCHED_ADDRESS);
+  EXPECT_EQ(mem_checks.GetMemCheck(WATCHED_ADDRESS)->num_hits, 1u);
+  EXPECT_EQ(m_memory.Read_U32(0x00401230), 0x9ABCDEF0u);
+  EXPECT_EQ(m_mmu.Read_U32(WATCHED_ADDRESS - 4), 0x12345678u);
+
+  mem_checks.Clear();
+  EXPECT_TRUE(m_mmu.IsOptimizableRAMAddress(WATCHED_ADDRESS));
+
+  m_ppc_state.spr[SPR_DBAT0U] = 0;
+  m_ppc_state.spr[SPR_DBAT0L] = 0;
+  m_mmu.DBATUpdated();
+}
+
+TEST_F(MMUFastmemTest, MemcheckFaultsAreBackpatched)
+{
+  constexpr u32 CODE_ADDRESS = 0x00003000;
+  constexpr u32 RETURN_ADDRESS = 0x00002000;
+  constexpr u32 WATCHED_ADDRESS = 0x80401230;
+  // In the same BAT page, but in a different host page.
+  constexpr u32 UNWATCHED_ADDRESS = 0x80411230;
+
+  if (m_system.GetPowerPC().GetMode() != PowerPC::CoreMode::JIT)
+    GTEST_SKIP() << "There is no JIT for this platform";
+
+  const Core::CPUThreadGuard guard(m_system);
+  auto& jit = *static_cast<JitBase*>(m_system.GetJitInterface().GetCore());
+
+  // Instructions are fetched from physical addresses, and data goes through the usual cached
+  // mapping of MEM1 at 0x80000000.
+  m_ppc_state.spr[SPR_DBAT0U] = 0x80001FFF;
+  m_ppc_state.spr[SPR_DBAT0L] = 0x00000002;
+  m_ppc_state.msr.Hex = 0;
+  m_ppc_state.msr.DR = 1;
+  PowerPC::MSRUpdated(m_ppc_state);
+  m_mmu.DBATUpdated();
+
+  TMemCheck mem_check;
+  mem_check.start_address = WATCHED_ADDRESS;
+  mem_check.end_address = WATCHED_ADDRESS + 3;
+  mem_check.is_break_on_write = true;
+  auto& mem_checks = m_system.GetPowerPC().GetMemChecks();
+  mem_checks.Add(std::move(mem_check));
+
+  // Adding the memcheck cleared the JIT cache, which also refreshed the JIT options.
+  if (!jit.jo.fastmem)
+    GTEST_SKIP() << "The JIT doesn't use fastmem on this platform";
+
+  // stw r3, 0(r4); stw r3, 0(r5); blr
+  m_memory.Write_U32(0x90640000, CODE_ADDRESS);
+  m_memory.Write_U32(0x90650000, CODE_ADDRESS + 4);
+  m_memory.Write_U32(0x4E800020, CODE_ADDRESS + 8);
+
+  // The first run faults on the watched page and backpatches the store to a slow access. The
+  // second run goes straight to the slow access.
+  for (u32 run = 1; run <= 2; ++run)
+  {
+    const u32 value = 0x12345670 + run;
+    m_ppc_state.gpr[3] = value;
+    m_ppc_state.gpr[4] = WATCHED_ADDRESS;
+    m_ppc_state.gpr[5] = UNWATCHED_ADDRESS;
+    LR(m_ppc_state) = RETURN_ADDRESS;
+    m_ppc_state.pc = CODE_ADDRESS;
+    m_system.GetPowerPC().SingleStep();
+
+    EXPECT_EQ(m_ppc_state.pc, RETURN_ADDRESS);
+    EXPECT_EQ(mem_checks.GetMemCheck(WATCHED_ADDRESS)->num_hits, run);
+    EXPECT_EQ(m_memory.Read_U32(WATCHED_ADDRESS & 0x01FFFFFF), value);
+    EXPECT_EQ(m_memory.Read_U32(UNWATCHED_ADDRESS & 0x01FFFFFF), value);
+  }
+
+  m_ppc_state.msr.Hex = 0;
+  PowerPC::MSRUpdated(m_ppc_state);
+  m_ppc_state.spr[SPR_DBAT0U] = 0;
+  m_ppc_state.spr[SPR_DBAT0L] = 0;
+  m_mmu.DBATUpdated();
+}
+
+// Measures slowmem throughput through the translation cache. It doesn't check anything, so it is
+// only run with --gtest_also_run_disabled_tests.
+TEST_F(MMUTest, DISABLED_Benchmark)
+{
+  constexpr u32 ROUNDS = 200;
+  constexpr u32 ACCESSES_PER_PAGE = 16;
+  constexpr u32 ACCESS_COUNT = ROUNDS * PAGE_COUNT * ACCESSES_PER_PAGE;
+
+  const auto start = std::chrono::steady_clock::now();
+  u32 sum = 0;
+  for (u32 round = 0; round < ROUNDS; ++round)
+  {
+    for (u32 i = 0; i < PAGE_COUNT; ++i)
+    {
+      for (u32 j = 0; j < ACCESSES_PER_PAGE; ++j)
+        sum += m_mmu.Read_U32(EFFECTIVE_BASE + i * PowerPC::HW_PAGE_SIZE + j * 4);
+    }
+  }
+  const std::chrono::duration<double, std::micro> read_elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  const auto write_start = std::chrono::steady_clock::now();
+  for (u32 round = 0; round < ROUNDS; ++round)
+  {
+    for (u32 i = 0; i < PAGE_COUNT; ++i)
+    {
+      for (u32 j = 0; j < ACCESSES_PER_PAGE; ++j)
+        m_mmu.Write_U32(round, EFFECTIVE_BASE + i * PowerPC::HW_PAGE_SIZE + j * 4);
+    }
+  }
+  const std::chrono::duration<double, std::micro> write_elapsed =
+      std::chrono::steady_clock::now() - write_start;
+
+  fmt::print("Page table translated slowmem accesses over {} pages: {:.1f} M reads/s, "
+             "{:.1f} M writes/s (checksum {})\n",
+             PAGE_COUNT, ACCESS_COUNT / read_elapsed.count(),
+             ACCESS_COUNT / write_elapsed.count(), sum);
+}
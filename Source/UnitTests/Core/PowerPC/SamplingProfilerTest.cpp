@@ -0,0 +1,75 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/ScopeGuard.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/SamplingProfiler.h"
+#include "Core/System.h"
+
+TEST(SamplingProfiler, WalksTheBackChain)
+{
+  Core::DeclareAsCPUThread();
+  Common::ScopeGuard cpu_thread_guard([] { Core::UndeclareAsCPUThread(); });
+  Config::Init();
+  SConfig::Init();
+  Common::ScopeGuard config_guard([] {
+    SConfig::Shutdown();
+    Config::Shutdown();
+  });
+
+  auto& system = Core::System::GetInstance();
+  auto& memory = system.GetMemory();
+  memory.Init();
+  Common::ScopeGuard memory_guard([&memory] { memory.Shutdown(); });
+
+  // A leaf function at 0x300, called from 0x200, which was called from 0x7c, which was called
+  // from 0x100.
+  auto& ppc_state = system.GetPPCState();
+  ppc_state.msr.Hex = 0;
+  ppc_state.pc = 0x300;
+  LR(ppc_state) = 0x204;
+  ppc_state.gpr[1] = 0x2000;
+  memory.Write_U32(0x2100, 0x2000);
+  memory.Write_U32(0x2200, 0x2100);
+  memory.Write_U32(0x80, 0x2104);
+  memory.Write_U32(0, 0x2200);
+  memory.Write_U32(0x104, 0x2204);
+
+  // Without a timer, samples are only taken when requested, so this doesn't depend on timing.
+  Profiler::SamplingProfiler profiler(system);
+  profiler.Start(0);
+  for (int i = 0; i < 5; ++i)
+  {
+    profiler.RequestSample();
+    profiler.CheckSample();
+  }
+  EXPECT_EQ(profiler.GetSampleCount(), 5u);
+  EXPECT_EQ(profiler.GetSkippedSampleCount(), 0u);
+
+  // Requests that pile up while the CPU thread is busy elsewhere only count once.
+  for (int i = 0; i < 3; ++i)
+    profiler.RequestSample();
+  profiler.CheckSample();
+  EXPECT_EQ(profiler.GetSampleCount(), 6u);
+  EXPECT_EQ(profiler.GetSkippedSampleCount(), 2u);
+  EXPECT_EQ(profiler.GetCollapsedStacks(), "00000100;0000007c;00000200;00000300 6\n");
+
+  // Nothing is sampled once stopped.
+  profiler.Stop();
+  profiler.RequestSample();
+  profiler.CheckSample();
+  EXPECT_EQ(profiler.GetSampleCount(), 6u);
+
+  // Starting again clears the previous samples.
+  profiler.Start(0);
+  EXPECT_EQ(profiler.GetSampleCount(), 0u);
+  EXPECT_EQ(profiler.GetSkippedSampleCount(), 0u);
+  profiler.Stop();
+}
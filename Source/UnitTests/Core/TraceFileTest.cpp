@@ -0,0 +1,177 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/ScopeGuard.h"
+#include "Core/Debugger/TraceFile.h"
+#include "Core/PowerPC/PowerPC.h"
+
+namespace
+{
+TraceFile::Record MakeRecord(u32 i)
+{
+  TraceFile::Record record;
+  record.pc = 0x80003000 + i * 4;
+  record.instruction = 0x38600000 | (i & 0xffff);
+  record.gprs.push_back({static_cast<u8>(i % 32), i * 3});
+  if (i % 3 == 0)
+    record.fprs.push_back({static_cast<u8>(i % 32), u64{i} << 32, ~u64{i}});
+  if (i % 5 == 0)
+    record.special_registers.push_back({TraceFile::SpecialRegister::CTR, i});
+  if (i % 7 == 0)
+    record.memory = TraceFile::MemoryAccess{0x80001000 + i, 4, (i & 1) != 0, i * 11};
+  return record;
+}
+
+void ExpectRecordsEqual(const TraceFile::Record& expected, const TraceFile::Record& actual)
+{
+  EXPECT_EQ(expected.pc, actual.pc);
+  EXPECT_EQ(expected.instruction, actual.instruction);
+  ASSERT_EQ(expected.gprs.size(), actual.gprs.size());
+  for (size_t i = 0; i < expected.gprs.size(); ++i)
+  {
+    EXPECT_EQ(expected.gprs[i].index, actual.gprs[i].index);
+    EXPECT_EQ(expected.gprs[i].value, actual.gprs[i].value);
+  }
+  ASSERT_EQ(expected.fprs.size(), actual.fprs.size());
+  for (size_t i = 0; i < expected.fprs.size(); ++i)
+  {
+    EXPECT_EQ(expected.fprs[i].index, actual.fprs[i].index);
+    EXPECT_EQ(expected.fprs[i].ps0, actual.fprs[i].ps0);
+    EXPECT_EQ(expected.fprs[i].ps1, actual.fprs[i].ps1);
+  }
+  ASSERT_EQ(expected.special_registers.size(), actual.special_registers.size());
+  for (size_t i = 0; i < expected.special_registers.size(); ++i)
+  {
+    EXPECT_EQ(expected.special_registers[i].reg, actual.special_registers[i].reg);
+    EXPECT_EQ(expected.special_registers[i].value, actual.special_registers[i].value);
+  }
+  EXPECT_EQ(expected.memory, actual.memory);
+}
+}  // namespace
+
+TEST(TraceFile, RoundTrip)
+{
+  const std::string directory = File::CreateTempDir();
+  ASSERT_FALSE(directory.empty());
+  Common::ScopeGuard directory_guard([&directory] { File::DeleteDirRecursively(directory); });
+  const std::string path = directory + "/trace.dtrace";
+
+  // Enough records to span several compressed frames.
+  constexpr u32 RECORD_COUNT = 200000;
+  {
+    std::unique_ptr<TraceFile::Writer> writer = TraceFile::Writer::Create(path);
+    ASSERT_TRUE(writer);
+    for (u32 i = 0; i < RECORD_COUNT; ++i)
+      writer->Write(MakeRecord(i));
+    EXPECT_EQ(writer->GetRecordCount(), RECORD_COUNT);
+    ASSERT_TRUE(writer->Close());
+  }
+
+  std::unique_ptr<TraceFile::Reader> reader = TraceFile::Reader::Open(path);
+  ASSERT_TRUE(reader);
+  TraceFile::Record record;
+  for (u32 i = 0; i < RECORD_COUNT; ++i)
+  {
+    ASSERT_TRUE(reader->Read(&record)) << i;
+    ExpectRecordsEqual(MakeRecord(i), record);
+  }
+  EXPECT_FALSE(reader->Read(&record));
+  EXPECT_FALSE(reader->HasError());
+}
+
+TEST(TraceFile, TruncatedTraceIsAnError)
+{
+  const std::string directory = File::CreateTempDir();
+  ASSERT_FALSE(directory.empty());
+  Common::ScopeGuard directory_guard([&directory] { File::DeleteDirRecursively(directory); });
+  const std::string path = directory + "/trace.dtrace";
+
+  {
+    std::unique_ptr<TraceFile::Writer> writer = TraceFile::Writer::Create(path);
+    ASSERT_TRUE(writer);
+    for (u32 i = 0; i < 1000; ++i)
+      writer->Write(MakeRecord(i));
+    ASSERT_TRUE(writer->Close());
+  }
+  {
+    File::IOFile file(path, "r+b");
+    ASSERT_TRUE(file.Resize(file.GetSize() - 16));
+  }
+
+  std::unique_ptr<TraceFile::Reader> reader = TraceFile::Reader::Open(path);
+  ASSERT_TRUE(reader);
+  TraceFile::Record record;
+  while (reader->Read(&record))
+  {
+  }
+  EXPECT_TRUE(reader->HasError());
+}
+
+TEST(TraceFile, RegisterStateApply)
+{
+  TraceFile::RegisterState state;
+  TraceFile::Record record;
+  record.gprs.push_back({3, 0x1234});
+  record.fprs.push_back({31, 0x3ff0000000000000, 0x4000000000000000});
+  record.special_registers.push_back({TraceFile::SpecialRegister::LR, 0x80004000});
+  state.Apply(record);
+
+  TraceFile::RegisterState expected;
+  expected.gprs[3] = 0x1234;
+  expected.fprs[31] = {0x3ff0000000000000, 0x4000000000000000};
+  expected.special_registers[static_cast<u8>(TraceFile::SpecialRegister::LR)] = 0x80004000;
+  EXPECT_EQ(state, expected);
+}
+
+TEST(TraceFile, GetMemoryAccess)
+{
+  PowerPC::PowerPCState ppc_state{};
+  ppc_state.gpr[3] = 0x80001000;
+  ppc_state.gpr[4] = 0x20;
+
+  // lwz r5, 8(r3)
+  auto access = TraceFile::GetMemoryAccess(ppc_state, 0x80a30008);
+  ASSERT_TRUE(access);
+  EXPECT_EQ(access->address, 0x80001008u);
+  EXPECT_EQ(access->size, 4);
+  EXPECT_FALSE(access->is_store);
+
+  // stfd f1, -8(r3)
+  access = TraceFile::GetMemoryAccess(ppc_state, 0xd823fff8);
+  ASSERT_TRUE(access);
+  EXPECT_EQ(access->address, 0x80000ff8u);
+  EXPECT_EQ(access->size, 8);
+  EXPECT_TRUE(access->is_store);
+
+  // stbx r5, r3, r4
+  access = TraceFile::GetMemoryAccess(ppc_state, 0x7ca321ae);
+  ASSERT_TRUE(access);
+  EXPECT_EQ(access->address, 0x80001020u);
+  EXPECT_EQ(access->size, 1);
+  EXPECT_TRUE(access->is_store);
+
+  // lhz r5, 0x10(0) uses 0 as the base
+  access = TraceFile::GetMemoryAccess(ppc_state, 0xa0a00010);
+  ASSERT_TRUE(access);
+  EXPECT_EQ(access->address, 0x10u);
+  EXPECT_EQ(access->size, 2);
+
+  // psq_l f1, 0(r3), 0, qr0 with an unquantized GQR loads two floats
+  access = TraceFile::GetMemoryAccess(ppc_state, 0xe0230000);
+  ASSERT_TRUE(access);
+  EXPECT_EQ(access->address, 0x80001000u);
+  EXPECT_EQ(access->size, 8);
+  EXPECT_FALSE(access->is_store);
+
+  // addi r3, r3, 1
+  EXPECT_FALSE(TraceFile::GetMemoryAccess(ppc_state, 0x38630001));
+}
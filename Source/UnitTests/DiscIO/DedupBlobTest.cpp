@@ -0,0 +1,377 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Swap.h"
+#include "Core/IOS/ES/Formats.h"
+#include "Core/IOS/IOSC.h"
+#include "Core/IOS/Uids.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/DedupBlob.h"
+#include "DiscIO/DiscUtils.h"
+#include "DiscIO/Volume.h"
+#include "DiscIO/VolumeDisc.h"
+#include "DiscIO/VolumeWii.h"
+#include "DiscIO/WiiEncryptionCache.h"
+#include "UICommon/UICommon.h"
+
+using DiscIO::VolumeWii;
+
+namespace
+{
+constexpr u32 CHUNK_SIZE = 0x8000;
+
+// Layout of the synthetic Wii images
+constexpr u64 PARTITION_TABLE_OFFSET = 0x40020;
+constexpr u64 PARTITION_OFFSET = 0x50000;
+constexpr u64 PARTITION_DATA_OFFSET = 0x70000;
+constexpr u64 PARTITION_BLOCKS = VolumeWii::BLOCKS_PER_GROUP + 3;
+constexpr u64 TRAILER_SIZE = 0x1234;
+
+const auto NOOP_STATUS_CALLBACK = [](const std::string&, float) { return true; };
+
+std::vector<u8> RandomBytes(std::mt19937* rng, size_t size)
+{
+  std::vector<u8> data(size);
+  std::uniform_int_distribution<int> dist(0, 0xff);
+  std::generate(data.begin(), data.end(), [&] { return static_cast<u8>(dist(*rng)); });
+  return data;
+}
+
+template <typename T>
+void WriteBE(std::vector<u8>* image, u64 offset, T value)
+{
+  value = Common::FromBigEndian(value);
+  std::memcpy(image->data() + offset, &value, sizeof(T));
+}
+
+std::vector<u8> MakeGameCubeImage(std::mt19937* rng, size_t size)
+{
+  std::vector<u8> image = RandomBytes(rng, size);
+  WriteBE<u32>(&image, 0x18, 0);
+  WriteBE<u32>(&image, 0x1C, DiscIO::GAMECUBE_DISC_MAGIC);
+  return image;
+}
+
+// Builds a Wii disc with one partition holding partition_data, encrypted with title_key.
+// If corrupt_hashes is set, a few hashes are changed so that they don't match the data.
+std::vector<u8> MakeWiiImage(const std::vector<u8>& partition_data,
+                             const DiscIO::WiiEncryptionCache::Key& title_key, u64 title_id,
+                             bool corrupt_hashes)
+{
+  const u64 partition_data_size = PARTITION_BLOCKS * VolumeWii::BLOCK_TOTAL_SIZE;
+  std::vector<u8> image(PARTITION_DATA_OFFSET + partition_data_size + TRAILER_SIZE);
+
+  WriteBE<u32>(&image, 0x18, DiscIO::WII_DISC_MAGIC);
+  WriteBE<u32>(&image, 0x40000, 1);
+  WriteBE<u32>(&image, 0x40004, static_cast<u32>(PARTITION_TABLE_OFFSET >> 2));
+  WriteBE<u32>(&image, PARTITION_TABLE_OFFSET, static_cast<u32>(PARTITION_OFFSET >> 2));
+  WriteBE<u32>(&image, PARTITION_TABLE_OFFSET + 4, 0);
+
+  IOS::ES::Ticket ticket{};
+  ticket.signature.type =
+      static_cast<IOS::SignatureType>(Common::swap32(u32(IOS::SignatureType::RSA2048)));
+  std::strcpy(ticket.signature.issuer, "Root-CA00000001-XS00000003");
+  ticket.title_id = Common::swap64(title_id);
+  std::array<u8, 16> iv{};
+  std::memcpy(iv.data(), &ticket.title_id, sizeof(ticket.title_id));
+  IOS::HLE::IOSC iosc(IOS::HLE::IOSC::ConsoleType::Retail);
+  iosc.Encrypt(IOS::HLE::IOSC::HANDLE_COMMON_KEY, iv.data(), title_key.data(), title_key.size(),
+               ticket.title_key, IOS::PID_ES);
+  std::memcpy(image.data() + PARTITION_OFFSET, &ticket, sizeof(ticket));
+
+  WriteBE<u32>(&image, PARTITION_OFFSET + 0x2b8,
+               static_cast<u32>((PARTITION_DATA_OFFSET - PARTITION_OFFSET) >> 2));
+  WriteBE<u32>(&image, PARTITION_OFFSET + 0x2bc, static_cast<u32>(partition_data_size >> 2));
+
+  std::vector<std::array<u8, VolumeWii::BLOCK_DATA_SIZE>> data(VolumeWii::BLOCKS_PER_GROUP);
+  std::vector<VolumeWii::HashBlock> hashes(VolumeWii::BLOCKS_PER_GROUP);
+  std::array<u8, VolumeWii::GROUP_TOTAL_SIZE> group;
+  for (u64 i = 0; i < PARTITION_BLOCKS; i += VolumeWii::BLOCKS_PER_GROUP)
+  {
+    const u64 blocks = std::min<u64>(VolumeWii::BLOCKS_PER_GROUP, PARTITION_BLOCKS - i);
+    for (u64 j = 0; j < VolumeWii::BLOCKS_PER_GROUP; ++j)
+    {
+      data[j].fill(0);
+      if (j < blocks)
+      {
+        std::copy_n(partition_data.data() + (i + j) * VolumeWii::BLOCK_DATA_SIZE,
+                    VolumeWii::BLOCK_DATA_SIZE, data[j].data());
+      }
+    }
+
+    VolumeWii::HashGroup(data.data(), hashes.data());
+    if (corrupt_hashes)
+    {
+      hashes[1].h0[2][0] ^= 0xff;
+      hashes[blocks - 1].padding_2[31] = 0xab;
+    }
+
+    VolumeWii::EncryptHashedGroup(data.data(), hashes.data(), title_key, &group);
+    std::copy_n(group.data(), blocks * VolumeWii::BLOCK_TOTAL_SIZE,
+                image.data() + PARTITION_DATA_OFFSET + i * VolumeWii::BLOCK_TOTAL_SIZE);
+  }
+
+  return image;
+}
+
+void WriteImage(const std::string& path, const std::vector<u8>& image)
+{
+  File::IOFile file(path, "wb");
+  ASSERT_TRUE(file.WriteBytes(image.data(), image.size()));
+}
+
+void ExpectSameImage(const std::string& manifest_path, const std::vector<u8>& expected)
+{
+  std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(manifest_path);
+  ASSERT_NE(reader, nullptr);
+  ASSERT_EQ(reader->GetBlobType(), DiscIO::BlobType::DEDUP);
+  ASSERT_EQ(reader->GetDataSize(), expected.size());
+
+  std::vector<u8> actual(expected.size());
+  ASSERT_TRUE(reader->Read(0, actual.size(), actual.data()));
+  const auto mismatch = std::mismatch(actual.begin(), actual.end(), expected.begin());
+  EXPECT_EQ(mismatch.first, actual.end())
+      << "First difference at offset " << (mismatch.first - actual.begin());
+
+  // Reads that don't start or end on a chunk or block boundary
+  for (u64 offset = 0x1234; offset < expected.size(); offset += 0x2F123)
+  {
+    const u64 size = std::min<u64>(0x11111, expected.size() - offset);
+    std::vector<u8> part(size);
+    ASSERT_TRUE(reader->Read(offset, size, part.data()));
+    EXPECT_TRUE(std::equal(part.begin(), part.end(), expected.begin() + offset))
+        << "Read at offset " << offset;
+  }
+}
+
+u64 ChunkCount(const std::vector<u8>& image)
+{
+  return (image.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+}
+}  // namespace
+
+class DedupBlobTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_directory = File::CreateTempDir();
+    ASSERT_FALSE(m_directory.empty());
+    m_directory += '/';
+    UICommon::SetUserDirectory(m_directory + "User");
+  }
+
+  void TearDown() override { File::DeleteDirRecursively(m_directory); }
+
+  std::string AddImage(DiscIO::DedupStoreWriter* writer, const std::string& name,
+                       const std::vector<u8>& image)
+  {
+    const std::string path = m_directory + name;
+    WriteImage(path, image);
+
+    std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(path);
+    std::unique_ptr<DiscIO::VolumeDisc> volume = DiscIO::CreateDisc(path);
+    const std::string manifest_path = writer->GetManifestPath(path);
+    EXPECT_TRUE(writer->AddImage(reader.get(), volume.get(), path, manifest_path,
+                                 NOOP_STATUS_CALLBACK));
+    return manifest_path;
+  }
+
+  DiscIO::DedupStoreHeader ReadStoreHeader()
+  {
+    DiscIO::DedupStoreHeader header{};
+    File::IOFile file(StorePath(), "rb");
+    EXPECT_TRUE(file.ReadArray(&header, 1));
+    return header;
+  }
+
+  // The index must be the last thing in the store, so that adding images doesn't leave old
+  // indexes behind
+  void ExpectCompactStore()
+  {
+    const DiscIO::DedupStoreHeader header = ReadStoreHeader();
+    EXPECT_NE(header.index_offset, 0u);
+    EXPECT_EQ(File::GetSize(StorePath()),
+              header.index_offset + header.num_chunks * sizeof(DiscIO::DedupChunkEntry));
+  }
+
+  std::string StorePath() const { return m_directory + "store.ddst"; }
+
+  std::string m_directory;
+};
+
+TEST_F(DedupBlobTest, RoundTrip)
+{
+  std::mt19937 rng(1);
+  const std::vector<u8> gc_image = MakeGameCubeImage(&rng, CHUNK_SIZE * 20 + 0x123);
+  std::vector<u8> gc_revision = gc_image;
+  gc_revision[CHUNK_SIZE * 3 + 5] ^= 0xff;
+  const std::vector<u8> partition_data =
+      RandomBytes(&rng, PARTITION_BLOCKS * VolumeWii::BLOCK_DATA_SIZE);
+  const std::vector<u8> wii_image =
+      MakeWiiImage(partition_data, {1, 2, 3}, 0x00010000'52534245, true);
+
+  auto writer = DiscIO::DedupStoreWriter::Open(StorePath(), CHUNK_SIZE, 5);
+  ASSERT_NE(writer, nullptr);
+
+  const std::string gc_manifest = AddImage(writer.get(), "gc.iso", gc_image);
+  EXPECT_EQ(writer->GetNewChunkCount(), ChunkCount(gc_image));
+
+  const std::string gc_revision_manifest = AddImage(writer.get(), "gc_revision.gcm", gc_revision);
+  EXPECT_EQ(writer->GetNewChunkCount(), ChunkCount(gc_image) + 1);
+
+  const std::string wii_manifest = AddImage(writer.get(), "wii.iso", wii_image);
+  ASSERT_TRUE(writer->Finish());
+  writer.reset();
+
+  ExpectSameImage(gc_manifest, gc_image);
+  ExpectSameImage(gc_revision_manifest, gc_revision);
+  ExpectSameImage(wii_manifest, wii_image);
+  ExpectCompactStore();
+
+  // The partition data can also be read without going through the encryption
+  std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(wii_manifest);
+  ASSERT_TRUE(reader->SupportsReadWiiDecrypted(0, partition_data.size(), PARTITION_DATA_OFFSET));
+  std::vector<u8> decrypted(partition_data.size());
+  ASSERT_TRUE(reader->ReadWiiDecrypted(0, decrypted.size(), decrypted.data(),
+                                       PARTITION_DATA_OFFSET));
+  EXPECT_EQ(decrypted, partition_data);
+
+  auto dedup_reader =
+      DiscIO::DedupFileReader::Create(File::IOFile(wii_manifest, "rb"), wii_manifest);
+  ASSERT_NE(dedup_reader, nullptr);
+  EXPECT_EQ(dedup_reader->Verify(NOOP_STATUS_CALLBACK), 0u);
+}
+
+TEST_F(DedupBlobTest, WiiPartitionsAreDeduplicatedDecrypted)
+{
+  std::mt19937 rng(2);
+  const std::vector<u8> partition_data =
+      RandomBytes(&rng, PARTITION_BLOCKS * VolumeWii::BLOCK_DATA_SIZE);
+  const std::vector<u8> image_a =
+      MakeWiiImage(partition_data, {0x11, 0x22}, 0x00010000'52534245, false);
+  const std::vector<u8> image_b =
+      MakeWiiImage(partition_data, {0x33, 0x44}, 0x00010000'5253424A, true);
+  ASSERT_NE(image_a, image_b);
+
+  auto writer = DiscIO::DedupStoreWriter::Open(StorePath(), CHUNK_SIZE, 5);
+  ASSERT_NE(writer, nullptr);
+
+  const std::string manifest_a = AddImage(writer.get(), "a.iso", image_a);
+  const u64 chunks_before = writer->GetNewChunkCount();
+  const std::string manifest_b = AddImage(writer.get(), "b.iso", image_b);
+
+  // Only the chunk holding the ticket differs, even though every encrypted byte is different
+  EXPECT_EQ(writer->GetNewChunkCount(), chunks_before + 1);
+
+  ASSERT_TRUE(writer->Finish());
+  writer.reset();
+
+  ExpectSameImage(manifest_a, image_a);
+  ExpectSameImage(manifest_b, image_b);
+}
+
+TEST_F(DedupBlobTest, IndexIsRewrittenInPlace)
+{
+  std::mt19937 rng(3);
+  const std::vector<u8> image_a = MakeGameCubeImage(&rng, CHUNK_SIZE * 40);
+  const std::vector<u8> image_b = MakeGameCubeImage(&rng, CHUNK_SIZE * 3 + 0x10);
+
+  auto writer = DiscIO::DedupStoreWriter::Open(StorePath(), CHUNK_SIZE, 5);
+  ASSERT_NE(writer, nullptr);
+  const std::string manifest_a = AddImage(writer.get(), "a.iso", image_a);
+  ASSERT_TRUE(writer->Finish());
+  writer.reset();
+  ExpectCompactStore();
+
+  // The new index is shorter than the chunks and the old index together, so the end of the old
+  // index must be cut off
+  writer = DiscIO::DedupStoreWriter::Open(StorePath(), CHUNK_SIZE, 5);
+  ASSERT_NE(writer, nullptr);
+  const std::string manifest_b = AddImage(writer.get(), "b.iso", image_b);
+  ASSERT_TRUE(writer->Finish());
+  ASSERT_TRUE(writer->Finish());
+  writer.reset();
+  ExpectCompactStore();
+  EXPECT_EQ(ReadStoreHeader().num_chunks, ChunkCount(image_a) + ChunkCount(image_b));
+
+  // Finishing without adding anything leaves the store as it is
+  const u64 size = File::GetSize(StorePath());
+  writer = DiscIO::DedupStoreWriter::Open(StorePath(), CHUNK_SIZE, 5);
+  ASSERT_NE(writer, nullptr);
+  ASSERT_TRUE(writer->Finish());
+  writer.reset();
+  EXPECT_EQ(File::GetSize(StorePath()), size);
+
+  ExpectSameImage(manifest_a, image_a);
+  ExpectSameImage(manifest_b, image_b);
+}
+
+TEST_F(DedupBlobTest, IndexIsRebuiltAfterInterruption)
+{
+  std::mt19937 rng(4);
+  const std::vector<u8> image_a = MakeGameCubeImage(&rng, CHUNK_SIZE * 10);
+  const std::vector<u8> image_b = MakeGameCubeImage(&rng, CHUNK_SIZE * 6 + 0x200);
+  const std::vector<u8> image_c = MakeGameCubeImage(&rng, CHUNK_SIZE * 2);
+
+  auto writer = DiscIO::DedupStoreWriter::Open(StorePath(), CHUNK_SIZE, 5);
+  ASSERT_NE(writer, nullptr);
+  const std::string manifest_a = AddImage(writer.get(), "a.iso", image_a);
+  ASSERT_TRUE(writer->Finish());
+  writer.reset();
+
+  // Simulate a run that is interrupted before it gets to Finish
+  writer = DiscIO::DedupStoreWriter::Open(StorePath(), CHUNK_SIZE, 5);
+  ASSERT_NE(writer, nullptr);
+  const std::string manifest_b = AddImage(writer.get(), "b.iso", image_b);
+  writer.reset();
+  EXPECT_EQ(ReadStoreHeader().index_offset, 0u);
+
+  writer = DiscIO::DedupStoreWriter::Open(StorePath(), CHUNK_SIZE, 5);
+  ASSERT_NE(writer, nullptr);
+  const std::string manifest_c = AddImage(writer.get(), "c.iso", image_c);
+  EXPECT_EQ(writer->GetNewChunkCount(), ChunkCount(image_c));
+  ASSERT_TRUE(writer->Finish());
+  writer.reset();
+  ExpectCompactStore();
+  EXPECT_EQ(ReadStoreHeader().num_chunks,
+            ChunkCount(image_a) + ChunkCount(image_b) + ChunkCount(image_c));
+
+  ExpectSameImage(manifest_a, image_a);
+  ExpectSameImage(manifest_b, image_b);
+  ExpectSameImage(manifest_c, image_c);
+}
+
+TEST_F(DedupBlobTest, ManifestPathsAreUnique)
+{
+  auto writer = DiscIO::DedupStoreWriter::Open(StorePath(), CHUNK_SIZE, 5);
+  ASSERT_NE(writer, nullptr);
+
+  ASSERT_TRUE(File::CreateDir(m_directory + "USA"));
+  ASSERT_TRUE(File::CreateDir(m_directory + "EUR"));
+
+  const std::string usa = writer->GetManifestPath(m_directory + "USA/Game.iso");
+  const std::string eur = writer->GetManifestPath(m_directory + "EUR/Game.iso");
+  const std::string wbfs = writer->GetManifestPath(m_directory + "USA/Game.wbfs");
+  EXPECT_EQ(usa, m_directory + "Game.iso.dedup");
+  EXPECT_EQ(eur, m_directory + "Game.iso (2).dedup");
+  EXPECT_EQ(wbfs, m_directory + "Game.wbfs.dedup");
+
+  // Manifests left over from earlier runs are not overwritten either
+  File::IOFile(m_directory + "Other.iso.dedup", "wb");
+  EXPECT_EQ(writer->GetManifestPath(m_directory + "Other.iso"),
+            m_directory + "Other.iso (2).dedup");
+}
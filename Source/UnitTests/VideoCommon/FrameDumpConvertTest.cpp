@@ -0,0 +1,158 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/FrameDumpConvert.h"
+
+namespace
+{
+struct Image
+{
+  Image(int width_, int height_, int padding = 0)
+      : width(width_), height(height_), stride(width_ * 4 + padding),
+        rgba(static_cast<size_t>(stride) * height_)
+  {
+    std::mt19937 rng(width * 1000 + height);
+    for (u8& byte : rgba)
+      byte = static_cast<u8>(rng());
+  }
+
+  int width;
+  int height;
+  int stride;
+  std::vector<u8> rgba;
+};
+
+struct YUVBuffer
+{
+  YUVBuffer(int width, int height)
+      : chroma_width((width + 1) / 2), chroma_height((height + 1) / 2),
+        y(static_cast<size_t>(width) * height), u(static_cast<size_t>(chroma_width) * chroma_height),
+        v(u.size())
+  {
+    planes = {y.data(), u.data(), v.data(), width, chroma_width, chroma_width};
+  }
+
+  int chroma_width;
+  int chroma_height;
+  std::vector<u8> y, u, v;
+  YUV420Planes planes;
+};
+
+// Straightforward per-pixel version of the conversion.
+void ReferenceConvert(const Image& image, YUVBuffer* out)
+{
+  const auto pixel = [&image](int x, int y) {
+    x = std::min(x, image.width - 1);
+    y = std::min(y, image.height - 1);
+    return &image.rgba[static_cast<size_t>(y) * image.stride + x * 4];
+  };
+
+  for (int y = 0; y < image.height; ++y)
+  {
+    for (int x = 0; x < image.width; ++x)
+    {
+      const u8* p = pixel(x, y);
+      out->y[y * image.width + x] =
+          static_cast<u8>(((66 * p[0] + 129 * p[1] + 25 * p[2] + 128) >> 8) + 16);
+    }
+  }
+
+  for (int cy = 0; cy < out->chroma_height; ++cy)
+  {
+    for (int cx = 0; cx < out->chroma_width; ++cx)
+    {
+      int rgb[3];
+      for (int c = 0; c < 3; ++c)
+      {
+        rgb[c] = (pixel(cx * 2, cy * 2)[c] + pixel(cx * 2 + 1, cy * 2)[c] +
+                  pixel(cx * 2, cy * 2 + 1)[c] + pixel(cx * 2 + 1, cy * 2 + 1)[c] + 2) >>
+                 2;
+      }
+      const auto [r, g, b] = rgb;
+      out->u[cy * out->chroma_width + cx] =
+          static_cast<u8>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+      out->v[cy * out->chroma_width + cx] =
+          static_cast<u8>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+    }
+  }
+}
+
+void ExpectMatchesReference(const Image& image, size_t worker_count)
+{
+  YUVBuffer expected(image.width, image.height);
+  ReferenceConvert(image, &expected);
+
+  YUVBuffer actual(image.width, image.height);
+  FrameDumpConverter converter(worker_count);
+  converter.ConvertToYUV420(image.rgba.data(), image.width, image.height, image.stride,
+                            actual.planes);
+
+  EXPECT_EQ(actual.y, expected.y) << image.width << "x" << image.height;
+  EXPECT_EQ(actual.u, expected.u) << image.width << "x" << image.height;
+  EXPECT_EQ(actual.v, expected.v) << image.width << "x" << image.height;
+}
+}  // namespace
+
+TEST(FrameDumpConvert, MatchesReference)
+{
+  for (const auto& [width, height] : {std::pair{64, 32}, {640, 528}, {17, 9}, {33, 1}, {1, 1}})
+    ExpectMatchesReference(Image(width, height), 0);
+}
+
+TEST(FrameDumpConvert, PaddedRows)
+{
+  ExpectMatchesReference(Image(100, 50, 48), 0);
+}
+
+TEST(FrameDumpConvert, Extremes)
+{
+  for (const u8 value : {0, 255})
+  {
+    Image image(48, 4);
+    std::fill(image.rgba.begin(), image.rgba.end(), value);
+    ExpectMatchesReference(image, 0);
+  }
+}
+
+TEST(FrameDumpConvert, Threaded)
+{
+  for (const size_t workers : {1, 3, 7})
+  {
+    ExpectMatchesReference(Image(640, 480), workers);
+    ExpectMatchesReference(Image(31, 7), workers);
+  }
+}
+
+// Compares the serial and threaded conversion speed of 4K frames. The output itself is checked by
+// the Threaded test, so this only runs with --gtest_also_run_disabled_tests.
+TEST(FrameDumpConvert, DISABLED_Benchmark)
+{
+  constexpr int WIDTH = 3840;
+  constexpr int HEIGHT = 2160;
+  constexpr int FRAMES = 10;
+
+  const Image image(WIDTH, HEIGHT);
+  YUVBuffer yuv(WIDTH, HEIGHT);
+
+  for (const size_t workers : {size_t{0}, FrameDumpConverter::GetDefaultWorkerCount()})
+  {
+    FrameDumpConverter converter(workers);
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < FRAMES; ++i)
+      converter.ConvertToYUV420(image.rgba.data(), WIDTH, HEIGHT, image.stride, yuv.planes);
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    fmt::print("{}x{} RGBA to YUV420 with {} worker(s): {:.2f} ms per frame\n", WIDTH, HEIGHT,
+               workers, elapsed.count() / FRAMES);
+  }
+}